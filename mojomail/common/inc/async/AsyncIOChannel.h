@@ -26,6 +26,7 @@
 #include "stream/BaseOutputStream.h"
 #include "CommonErrors.h"
 #include <boost/exception_ptr.hpp>
+#include <sys/uio.h>
 
 /**
  * Asynchronous IO channel
@@ -68,6 +69,13 @@ public:
 	 * @return number of bytes written into buffer (possibly 0)
 	 */
 	virtual size_t Write(const char* src, size_t count) = 0;
+
+	/**
+	 * Writes several buffers to the channel, in order, with as few copies as possible.
+	 * The default implementation calls Write for each buffer.
+	 * @return number of bytes written (possibly 0)
+	 */
+	virtual size_t WriteV(const struct iovec* iov, int iovcnt);
 	
 	virtual const InputStreamPtr&		GetInputStream() = 0;
 	virtual const OutputStreamPtr&		GetOutputStream() = 0;
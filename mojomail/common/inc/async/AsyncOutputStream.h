@@ -41,6 +41,7 @@ public:
 
 protected:
 	void FlushBuffer();
+	void WriteThrough(const char* src, size_t length);
 	MojErr ChannelWriteable();
 	MojErr ChannelClosed();
 	
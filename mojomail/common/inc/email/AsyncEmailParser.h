@@ -111,7 +111,7 @@ protected:
 	void HandleEndBody(bool complete);
 
 	void HandleContentType(const std::string& type, const std::string& subtype, const std::map<std::string, std::string>& headers);
-	void HandleHeader(const std::string& fieldName, const std::string& line);
+	void HandleHeaderField(HeaderFieldNames::FieldId fieldId, const char* name, size_t nameLength, const std::string& value);
 
 	// Other stuff
 	virtual void Pause();
@@ -0,0 +1,69 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#ifndef CHARSETCONVERTERPOOL_H_
+#define CHARSETCONVERTERPOOL_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <unicode/ucnv.h>
+
+/**
+ * Process-wide pool of ICU converters, keyed by canonical converter name.
+ *
+ * Opening a converter means looking up aliases and loading conversion tables,
+ * which is expensive compared to converting a typical email part. Converters
+ * are reset when they're returned to the pool, so callers always get one in
+ * its initial state. Callers shouldn't change converter options, such as
+ * the callbacks, since those aren't reset.
+ *
+ * Not thread-safe; only use from the main thread.
+ */
+class CharsetConverterPool
+{
+public:
+	// Gets a converter for the given charset. The charset name is passed
+	// through CharsetSupport::SelectCharset first.
+	// Returns NULL and sets err if the charset isn't supported.
+	static UConverter* Acquire(const char* charset, UErrorCode* err);
+
+	// Resets the converter and returns it to the pool
+	static void Release(UConverter* converter);
+
+	// Closes all pooled converters
+	static void Clear();
+
+	// Maximum number of idle converters to keep for each charset
+	static const size_t MAX_IDLE_PER_CHARSET = 4;
+
+protected:
+	typedef std::map<std::string, std::string>					NameMap;
+	typedef std::map<std::string, std::vector<UConverter*> >	ConverterMap;
+
+	// Charset name as requested -> canonical converter name
+	static NameMap		s_canonicalNames;
+
+	// Canonical converter name -> idle converters
+	static ConverterMap	s_idleConverters;
+
+private:
+	CharsetConverterPool();
+};
+
+#endif /* CHARSETCONVERTERPOOL_H_ */
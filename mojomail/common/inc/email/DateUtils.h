@@ -30,10 +30,23 @@
 class DateUtils
 {
 public:
-	// Currently a wrapper for curl_getdate(). Returns -1 on error.
+	// Parses an RFC 822/2822 date or an RFC 3501 date-time without allocating
+	// or depending on the locale. Other formats are handed to curl_getdate().
+	// Returns -1 on error.
 	static time_t ParseRfc822Date(const char* str);
 
+	// Parser for the common formats, used by ParseRfc822Date().
+	// Returns false if the string isn't in one of those formats.
+	static bool ParseCommonDate(const char* str, time_t& time);
+
+	// Formats the UTC date as an RFC 3501 date, e.g. "04-Jun-2013"
+	static const std::string FormatRfc3501Date(time_t time);
+
 	static const MojInt64 GetCurrentTimeMillis();
+
+	// Monotonic clock in milliseconds, for measuring how long something takes.
+	// Not related to the wall clock time.
+	static const MojInt64 GetMonotonicTimeMillis();
 	static const std::string GetUTC2DateString(MojInt64 val, const char* format);
 	static const std::string GetLocalDateString(MojInt64 val, const char* format);
 	static const std::string GetLocalDateStringFromUTC(MojInt64 utcVal, const char* format);
@@ -24,6 +24,11 @@
 
 namespace HtmlEntities
 {
+	// Look up an HTML5 named entity, e.g. "amp" (without the '&' and ';').
+	// Returns 0 if the name isn't a known entity. A few entities map to two
+	// characters; if secondChar is non-NULL it's set to the second one (or 0).
+	gunichar LookupEntity(const char* name, size_t length, gunichar* secondChar = NULL);
+
 	gunichar LookupEntity(const std::string& entityName);
 };
 
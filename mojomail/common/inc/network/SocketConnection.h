@@ -22,11 +22,25 @@
 #include "async/GIOChannelWrapper.h"
 #include "stream/BaseInputStream.h"
 #include "stream/BaseOutputStream.h"
+#include <map>
 #include <string>
 #include "util/Timer.h"
 
 class PslErrorException;
 
+/**
+ * Socket connection using libpalmsocket, which also does the DNS lookup and the TLS handshake.
+ *
+ * Every new connection does a full TLS handshake; there's no TLS session resumption.
+ * PmSslSocketConnect and PmSetSocketEncryption create the SSL object and start the handshake
+ * in the same call, and OpenSSL only resumes a client session if SSL_set_session is called
+ * on it before the handshake starts. (The PmSockOpenssl calls in CurlSSLVerifier work on
+ * curl's own SSL_CTX and don't affect these sockets.) The hostname is passed to libpalmsocket
+ * as-is, since it's also what the server certificate is checked against, so DNS results
+ * aren't cached here either.
+ *
+ * What's avoided instead is the connection itself: see MarkReused.
+ */
 class SocketConnection : public GIOChannelWrapper
 {
 public:
@@ -69,9 +83,35 @@ public:
 	 */
 	virtual const std::string& GetBindAddress() const { return m_bindAddress; }
 
+	/**
+	 * Record that this already established connection has been handed over to a new user
+	 * (e.g. another folder session) instead of connecting and logging in again.
+	 * This is counted separately from handshakes; it isn't TLS session resumption.
+	 */
+	virtual void MarkReused();
+
 	virtual void Status(MojObject& status) const;
 
+	/**
+	 * Report handshake stats for all hosts connected to by this process.
+	 */
+	static void HostStatus(MojObject& status);
+
 protected:
+	// Handshake and connection reuse stats for a host, shared by all connections to it
+	struct HostStats
+	{
+		HostStats() : handshakeCount(0), handshakeMillis(0), reuseCount(0) {}
+
+		MojInt64	handshakeCount;
+		MojInt64	handshakeMillis;
+		MojInt64	reuseCount;
+	};
+
+	typedef std::map<std::string, HostStats> HostStatsMap;
+
+	static void HostStatsToObject(const HostStats& stats, MojObject& obj);
+
 	SocketConnection(GIOChannel* channel, bool useSsl);
 	
 	static gboolean SocketConnectCb(GIOChannel* channel, gpointer data, const GError* error);
@@ -96,6 +136,19 @@ protected:
 	int							m_connectTimeout;
 	Timer<SocketConnection>		m_connectTimer;
 
+	// hostname:port, for looking up the host stats
+	std::string		m_hostKey;
+
+	// Time spent connecting (including the SSL handshake for SSL connections), and in STARTTLS
+	MojInt64		m_connectStartTime;
+	MojInt64		m_connectMillis;
+	MojInt64		m_tlsStartTime;
+	MojInt64		m_tlsMillis;
+
+	int				m_reuseCount;
+
+	static HostStatsMap	s_hostStats;
+
 	InputStreamPtr		m_inputStream;
 	OutputStreamPtr		m_outputStream;
 	
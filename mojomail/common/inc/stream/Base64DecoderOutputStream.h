@@ -20,6 +20,7 @@
 #define BASE64DECODEROUTPUTSTREAM_H_
 #include <glib.h>
 #include "stream/BaseOutputStream.h"
+#include "util/Base64.h"
 #include <boost/shared_array.hpp>
 
 class Base64DecoderOutputStream : public ChainedOutputStream
@@ -38,8 +39,7 @@ public:
 
 protected:
 	boost::shared_array<char>	m_outbuf;
-	gint						m_state;
-	guint						m_save;
+	Base64Decoder				m_decoder;
 };
 
 #endif /* BASE64DECODEROUTPUTSTREAM_H_ */
@@ -21,6 +21,7 @@
 
 #include <glib.h>
 #include "stream/BaseOutputStream.h"
+#include "util/Base64.h"
 #include <boost/shared_array.hpp>
 
 class Base64EncoderOutputStream : public ChainedOutputStream
@@ -40,11 +41,8 @@ public:
 	virtual void Flush(FlushType flushType = FullFlush);
 
 protected:
-	guint FixLineEndings(char * buffer, size_t len);
-
 	boost::shared_array<char>	m_outbuf;
-	gint						m_state;
-	gint						m_save;
+	Base64Encoder				m_encoder;
 };
 
 #endif /*BASE64OUTPUTSTREAM_H_*/
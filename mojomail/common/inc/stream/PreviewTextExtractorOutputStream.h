@@ -20,22 +20,24 @@
 #define PREVIEWTEXTEXTRACTOROUTPUTSTREAM_H_
 
 #include "stream/BaseOutputStream.h"
+#include "email/PreviewTextExtractor.h"
 #include <string>
 
 class PreviewTextExtractorOutputStream : public ChainedOutputStream
 {
 public:
-	PreviewTextExtractorOutputStream(const OutputStreamPtr& sink, size_t previewLength);
+	// previewLength is the maximum length of the generated preview text, in bytes
+	PreviewTextExtractorOutputStream(const OutputStreamPtr& sink, size_t previewLength, bool html);
 	virtual ~PreviewTextExtractorOutputStream();
 
 	// Overrides BaseOutputStream
 	void Write(const char* src, size_t length);
 
-	const std::string& GetPreviewText();
+	// Returns the preview text (with tags and extra whitespace stripped)
+	std::string GetPreviewText();
 
 protected:
-	size_t			m_previewLength;
-	std::string		m_previewBuf;
+	PreviewTextExtractor	m_extractor;
 };
 
 #endif /* PREVIEWTEXTEXTRACTOROUTPUTSTREAM_H_ */
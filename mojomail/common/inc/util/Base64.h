@@ -0,0 +1,87 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#ifndef BASE64_H_
+#define BASE64_H_
+
+#include <cstddef>
+
+/**
+ * Streaming base64 encoder. Input can be split at any byte boundary.
+ *
+ * Output lines are wrapped with CRLF, as required for MIME bodies.
+ */
+class Base64Encoder
+{
+public:
+	static const size_t MIME_LINE_LENGTH = 76;
+
+	// lineLength must be a multiple of 4; 0 disables line wrapping
+	Base64Encoder(size_t lineLength = MIME_LINE_LENGTH);
+
+	// Maximum number of bytes written by Encode() for the given input length
+	size_t MaxEncodedSize(size_t length) const;
+
+	// Maximum number of bytes written by Finish()
+	static const size_t MAX_FINISH_SIZE = 8;
+
+	/**
+	 * Encodes data. Up to two bytes may be held back until the next call.
+	 * @return number of bytes written to dst
+	 */
+	size_t Encode(const char* src, size_t length, char* dst);
+
+	/**
+	 * Writes out any remaining bytes with padding, followed by CRLF if line
+	 * wrapping is enabled. The encoder can be reused afterwards.
+	 * @return number of bytes written to dst
+	 */
+	size_t Finish(char* dst);
+
+protected:
+	size_t			m_lineLength;
+	size_t			m_currentLineLength;
+	unsigned char	m_pending[3];
+	size_t			m_numPending;
+};
+
+/**
+ * Streaming base64 decoder. Input can be split at any byte boundary.
+ *
+ * Line breaks and other characters outside the base64 alphabet are skipped.
+ */
+class Base64Decoder
+{
+public:
+	Base64Decoder();
+
+	// Maximum number of bytes written by Decode() for the given input length
+	static size_t MaxDecodedSize(size_t length) { return (length / 4 + 1) * 3; }
+
+	/**
+	 * Decodes data. An incomplete group of four characters is held until the next call.
+	 * @return number of bytes written to dst
+	 */
+	size_t Decode(const char* src, size_t length, char* dst);
+
+protected:
+	unsigned int	m_bits;
+	int				m_count; // number of characters in m_bits
+};
+
+#endif /* BASE64_H_ */
@@ -0,0 +1,38 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#ifndef UTF8VALIDATOR_H_
+#define UTF8VALIDATOR_H_
+
+#include <cstddef>
+
+namespace UTF8Validator {
+	// Returns the length of the longest prefix of the data that consists of
+	// complete, well-formed UTF-8 sequences (overlong forms, surrogates and
+	// values above U+10FFFF are rejected). If the result is less than length,
+	// the data at that offset is either invalid or an incomplete sequence.
+	size_t ValidLength(const char* data, size_t length);
+
+	inline bool IsValid(const char* data, size_t length) { return ValidLength(data, length) == length; }
+
+	// Returns true if the data is the start of a valid multi-byte sequence
+	// that needs more bytes to be complete.
+	bool IsIncompleteSequence(const char* data, size_t length);
+};
+
+#endif /* UTF8VALIDATOR_H_ */
@@ -40,6 +40,7 @@ public:
 	
 	virtual size_t Read(char* dst, size_t count, bool& eof);
 	virtual size_t Write(const char* src, size_t count);
+	virtual size_t WriteV(const struct iovec* iov, int iovcnt);
 	
 	virtual const InputStreamPtr&		GetInputStream();
 	virtual const OutputStreamPtr&		GetOutputStream();
@@ -54,6 +55,7 @@ protected:
 	static gboolean ChannelCallback(GIOChannel* channel, GIOCondition cond, gpointer data);
 	
 	virtual void ErrorOrEOF();
+	void WriteError(GError* gerr);
 
 	virtual void SetWatchReadable(bool watch);
 	virtual void SetWatchWriteable(bool watch);
@@ -64,6 +66,7 @@ protected:
 	guint			m_watchReadId;
 	guint			m_watchWriteId;
 	bool			m_closed;
+	bool			m_directWrite; // unbuffered channel; writes can go straight to the fd
 
 	boost::exception_ptr	m_exception;
 };
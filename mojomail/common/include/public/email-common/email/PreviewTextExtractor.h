@@ -0,0 +1,101 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#ifndef PREVIEWTEXTEXTRACTOR_H_
+#define PREVIEWTEXTEXTRACTOR_H_
+
+#include <string>
+#include <glib.h>
+
+/**
+ * Incrementally converts HTML or plain text into a short preview string.
+ *
+ * Text is processed in a single pass using a small state machine: tags and
+ * comments are stripped, the contents of <head>, <style> and <script> blocks
+ * are skipped, entities are decoded and whitespace is collapsed. Once more
+ * than maxLength bytes of text have been collected, any further input is
+ * ignored, so the cost is proportional to the size of the preview rather
+ * than the size of the document.
+ */
+class PreviewTextExtractor
+{
+public:
+	PreviewTextExtractor(size_t maxLength, bool html);
+	~PreviewTextExtractor();
+
+	// Feed more data. Data can be split at any point, including in the
+	// middle of a tag, entity or UTF-8 character.
+	void Append(const char* src, size_t length);
+
+	// Returns true if enough text has been collected
+	bool IsFull() const { return m_text.length() > m_maxLength; }
+
+	// Returns the trimmed preview text, truncated to at most maxLength bytes
+	std::string GetPreviewText() const;
+
+	// Decode an entity name (without the leading '&' and trailing ';'),
+	// e.g. "amp", "#169" or "#xA9". Returns 0 if it's not a valid entity.
+	// If secondChar is non-NULL, it's set to the second character of
+	// entities that map to two characters, or 0 otherwise.
+	static gunichar DecodeEntity(const char* name, size_t length, gunichar* secondChar = NULL);
+
+	// Longest entity name we'll try to decode
+	static const size_t MAX_ENTITY_LENGTH = 32;
+
+protected:
+	enum State {
+		State_Text,
+		State_Entity,
+		State_TagOpen,		// just read '<'
+		State_TagName,
+		State_Tag,
+		State_Comment,
+		State_SkipBlock,	// inside a <head>, <style> or <script> block
+		State_SkipBlockLessThan
+	};
+
+	// Maximum tag name length we care about; longer names are truncated
+	static const size_t MAX_TAG_NAME_LENGTH = 8;
+
+	inline void AppendChar(char c);
+	inline void AppendSpace() { m_pendingSpace = true; }
+	void AppendUnicode(gunichar c);
+
+	void EndEntity(bool terminated);
+	void EndTag();
+	bool IsBlockTag() const;
+
+	size_t		m_maxLength;
+	bool		m_html;
+
+	State		m_state;
+	bool		m_pendingSpace;
+
+	// Current entity name or tag name
+	std::string	m_entity;
+	std::string	m_tagName;
+	bool		m_closingTag;
+	bool		m_selfClosing;
+	bool		m_skipping;		// true if we're looking for the end of a block
+	std::string	m_blockName;	// name of the block we're skipping
+	int			m_dashCount;	// used for detecting "-->"
+
+	std::string	m_text;
+};
+
+#endif /* PREVIEWTEXTEXTRACTOR_H_ */
@@ -19,16 +19,22 @@
 #ifndef RFC2047DECODER_H_
 #define RFC2047DECODER_H_
 
+#include <cstddef>
 #include <string>
 
 namespace Rfc2047Decoder {
-	// Encode a UTF-8 string using RFC 2047 Q-encoding or B-encoding
+	// Decode a single RFC 2047 encoded-word to UTF-8
 	void Decode(const std::string& text, std::string& output);
 
 	// Decode a block of text, which may contain a mix of ASCII and encoded text
 	// The text will be assigned to the out parameter
 	void DecodeText(const std::string& text, std::string& out);
 
+	// Decode a block of text and append it to out. Text without any "=?" is
+	// only sanitized. Adjacent encoded-words in the same charset are converted
+	// together, so multi-byte characters split between them are kept intact.
+	void AppendDecodedText(const char* text, size_t length, std::string& out);
+
 	// Decodes a block of text. Ensures no exceptions will be thrown.
 	std::string SafeDecodeText(const std::string& text);
 };
@@ -22,6 +22,7 @@
 #include <map>
 #include <stdexcept>
 #include "data/CommonData.h"
+#include "mimeparser/HeaderFieldNames.h"
 
 class Rfc822StringTokenizer;
 
@@ -45,6 +46,10 @@ public:
 	bool ParseEmailHeaderField(Email& email, const std::string& fieldNameLower, const std::string& fieldValue);
 	bool ParsePartHeaderField(EmailPart& part, const std::string& fieldNameLower, const std::string& fieldValue);
 
+	// Same as above, using a field id from HeaderFieldNames::Lookup
+	bool ParseEmailHeaderField(Email& email, HeaderFieldNames::FieldId fieldId, const std::string& fieldValue);
+	bool ParsePartHeaderField(EmailPart& part, HeaderFieldNames::FieldId fieldId, const std::string& fieldValue);
+
 protected:
 	void ParseFieldParameters(Rfc822StringTokenizer& tokenizer, ParameterMap& outParameters);
 	void ParseAddressList(Rfc822StringTokenizer& tokenizer, EmailAddressList& outAddressList, bool mailboxOnly);
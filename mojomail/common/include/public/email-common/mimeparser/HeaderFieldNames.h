@@ -0,0 +1,48 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#ifndef HEADERFIELDNAMES_H_
+#define HEADERFIELDNAMES_H_
+
+#include <cstddef>
+
+// Header fields that the email parser knows how to handle
+namespace HeaderFieldNames {
+	enum FieldId {
+		Field_Other,
+		Field_To,
+		Field_Cc,
+		Field_Bcc,
+		Field_From,
+		Field_ReplyTo,
+		Field_Date,
+		Field_Subject,
+		Field_InReplyTo,
+		Field_XPriority,
+		Field_ContentType,
+		Field_ContentTransferEncoding,
+		Field_ContentDisposition,
+		Field_ContentId
+	};
+
+	// Case-insensitive lookup of a field name (without the colon).
+	// Returns Field_Other for any field not listed above.
+	FieldId Lookup(const char* name, size_t length);
+}
+
+#endif /* HEADERFIELDNAMES_H_ */
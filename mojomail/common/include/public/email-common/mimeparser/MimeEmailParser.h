@@ -24,6 +24,7 @@
 #include <vector>
 #include <map>
 #include <boost/shared_ptr.hpp>
+#include "mimeparser/HeaderFieldNames.h"
 
 class ParseEventHandler
 {
@@ -43,7 +44,15 @@ public:
 	virtual void HandleEndBody(bool incomplete) = 0;
 
 	virtual void HandleContentType(const std::string& type, const std::string& subtype, const std::map<std::string, std::string>& headers) = 0;
-	virtual void HandleHeader(const std::string& fieldName, const std::string& line) = 0;
+	virtual void HandleHeader(const std::string& fieldName, const std::string& line) {}
+
+	// Called for each header field, with the field name and value trimmed.
+	// The name and value are only valid for the duration of the call.
+	// By default, this calls HandleHeader with a copy of the field name.
+	virtual void HandleHeaderField(HeaderFieldNames::FieldId fieldId, const char* name, size_t nameLength, const std::string& value)
+	{
+		HandleHeader(std::string(name, nameLength), value);
+	}
 
 protected:
 	ParseEventHandler() {}
@@ -100,8 +109,7 @@ protected:
 		bool			partStarted;
 	};
 
-	void ParseHeaderLine(const std::string& line);
-	void ParseBodyLine(const std::string& line);
+	void ParseHeaderLine(const char* lineData, size_t lineLength);
 
 	void BeginPart();
 	void EndPart(bool complete);
@@ -122,6 +130,10 @@ protected:
 	};
 
 	static bool MatchBoundary(const std::vector<BoundaryState>& boundaries, const char* lineData, size_t lineLength, BoundaryMatchResult& result);
+	bool MatchBoundary(const char* lineData, size_t lineLength, BoundaryMatchResult& result);
+
+	void PushBoundary(const std::string& boundary);
+	void UpdateBoundaryFilter();
 
 	bool CheckBoundaries(const char* lineData, size_t lineLength);
 	void ProcessBoundaryMatch(BoundaryMatchResult& result);
@@ -134,7 +146,14 @@ public:
 	bool				m_isMultipart;
 	std::vector<BoundaryState>	m_boundaryStack;
 
+	// Quick filter for boundary lines: shortest boundary length and
+	// the set of first characters of all active boundaries
+	size_t				m_minBoundaryLength;
+	bool				m_boundaryFirstChars[256];
+
+	// Reused buffers for unfolding header lines and for the field value
 	std::string			m_lastLineBuffer;
+	std::string			m_fieldValue;
 	bool				m_paused;
 };
 
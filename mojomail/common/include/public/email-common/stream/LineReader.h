@@ -89,6 +89,13 @@ public:
 	 */
 	size_t ReadData(char* dst, size_t length);
 
+	/**
+	 * Appends data from the buffer directly to the end of a string.
+	 * 
+	 * Must only be called from within a function called by the slot passed to WaitForLine.
+	 */
+	size_t AppendData(std::string& dst, size_t length);
+
 	/**
 	 * Write data from buffer to a stream
 	 */
@@ -129,6 +136,9 @@ protected:
 	
 	inline void SetupBufferPointers(const char* data, size_t length);
 	static const char* FindEndOfLine(NewlineMode newlineMode, const char* start, const char* end, const char*& newlinePos);
+
+	// Same as above, but skips newline characters before scanFrom (already searched)
+	static const char* FindEndOfLine(NewlineMode newlineMode, const char* start, const char* scanFrom, const char* end, const char*& newlinePos);
 	
 	enum ExpectType {
 		EXPECT_NONE,
@@ -151,6 +161,7 @@ protected:
 	bool			m_timeoutExceeded;
 	size_t			m_maximumLineLength;
 	guint			m_timeoutId;
+	size_t			m_scannedLength; // bytes of the pending buffer already searched for a newline
 
 	NewlineMode		m_newlineMode;
 
@@ -38,6 +38,7 @@ public:
 
 protected:
 	boost::shared_array<char>	m_outbuf;
+	size_t						m_outbufSize;
 	gint						m_state;
 	guint						m_save;
 	guint						m_hi;
@@ -39,7 +39,10 @@ public:
 	virtual void Flush(FlushType fullFlush = FullFlush);
 
 protected:
+	char* GetOutputBuffer(size_t size);
+
 	boost::shared_array<char>	m_outbuf;
+	size_t						m_outbufSize;
 	gint						m_state;
 	gint						m_col;
 };
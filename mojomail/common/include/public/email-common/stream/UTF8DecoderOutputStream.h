@@ -21,6 +21,7 @@
 #include <glib.h>
 #include "stream/BaseOutputStream.h"
 #include <boost/scoped_array.hpp>
+#include <string>
 #include <unicode/ucnv.h>
 #include <unicode/uenum.h>
 #include "core/MojString.h"
@@ -41,18 +42,32 @@ public:
 	// Close the stream
 	void Close();
 
+	// Returns true if data is being passed through without conversion
+	bool IsPassthrough() const { return m_passthrough; }
+
 protected:
 	void Write(const char* src, size_t length, bool eof);
 
+	// Validate UTF-8 (or ASCII) input and write it directly to the sink
+	void WritePassthrough(const char* src, size_t length, bool eof);
+
+	// Convert to UTF-8 using ICU
+	void Convert(const char* src, size_t length, bool eof);
+
+	// Switch from passthrough mode to converting with ICU
+	void StartConverter();
+
+	std::string	m_charset;
+	bool		m_passthrough;
+
+	// Incomplete UTF-8 sequence left over from the last write in passthrough mode
+	char		m_pending[4];
+	size_t		m_pendingLength;
+
 	bool		m_initialized;
 	UConverter*	m_sourceCnv;
 	boost::scoped_array<UChar>	m_pivotBuf;
 	UChar*		m_pivotSource;
 	UChar*		m_pivotTarget;
-
-private:
-	//std::map< const MojString, boost::shared_ptr<UConverter> > m_cacheConverterMap;
-	static UConverter* GetCacheConverter(const char* converterName, UErrorCode *err);
-	static void ReleaseCacheConverter(UConverter* conv);
 };
 #endif /* UTF8DECODEROUTPUTSTREAM_H_ */
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# @@@LICENSE
+#
+#      Copyright (c) 2010-2013 LG Electronics, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# LICENSE@@@
+
+# Regenerates the HTML5 named entity table in src/email/HtmlEntities.cpp.
+#
+# The table is a minimal perfect hash using the "hash, displace" scheme:
+# each name is hashed into a bucket, and each bucket stores a displacement
+# (seed) that maps all of its names into unique slots of the entity table.
+# Buckets with a single name store the slot directly as -(slot + 1).
+#
+# The entity list comes from Python's html.entities.html5, which mirrors
+# the WHATWG list. Only the names terminated by ';' are used.
+#
+# Usage: gen-html-entities.py [path/to/HtmlEntities.cpp]
+
+import os
+import sys
+from html.entities import html5
+
+BEGIN_MARKER = "// BEGIN GENERATED ENTITY TABLE"
+END_MARKER = "// END GENERATED ENTITY TABLE"
+
+def fnv_hash(name, seed):
+    # Must match EntityHash() in HtmlEntities.cpp
+    h = (2166136261 ^ seed) & 0xffffffff
+    for c in name.encode("ascii"):
+        h ^= c
+        h = (h * 16777619) & 0xffffffff
+    return h
+
+def build_table(names):
+    n = len(names)
+    buckets = [[] for _ in range(n)]
+    for name in names:
+        buckets[fnv_hash(name, 0) % n].append(name)
+
+    slots = [None] * n
+    disp = [0] * n
+
+    order = sorted(range(n), key=lambda b: len(buckets[b]), reverse=True)
+    for b in order:
+        bucket = buckets[b]
+        if len(bucket) <= 1:
+            break
+
+        seed = 1
+        while True:
+            positions = [fnv_hash(name, seed) % n for name in bucket]
+            if len(set(positions)) == len(positions) and all(slots[p] is None for p in positions):
+                break
+            seed += 1
+
+        for name, p in zip(bucket, positions):
+            slots[p] = name
+        disp[b] = seed
+
+    free = [i for i in range(n) if slots[i] is None]
+    for b in order:
+        bucket = buckets[b]
+        if len(bucket) != 1:
+            continue
+        p = free.pop()
+        slots[p] = bucket[0]
+        disp[b] = -p - 1
+
+    assert max(disp) < 32768 and min(disp) >= -32768
+    return slots, disp
+
+def generate():
+    entities = {}
+    for key, value in html5.items():
+        if key.endswith(";"):
+            entities[key[:-1]] = [ord(c) for c in value]
+
+    names = sorted(entities)
+    slots, disp = build_table(names)
+
+    out = []
+    out.append(BEGIN_MARKER)
+    out.append("// Generated by scripts/gen-html-entities.py; do not edit by hand.")
+    out.append("")
+    out.append("static const size_t ENTITY_COUNT = %d;" % len(names))
+    out.append("static const size_t MAX_ENTITY_NAME_LENGTH = %d;" % max(len(name) for name in names))
+    out.append("")
+    out.append("static const EntityDef s_entityTable[ENTITY_COUNT] = {")
+    for name in slots:
+        chars = entities[name] + [0]
+        out.append('\t{ "%s", %d, 0x%04X, 0x%04X },' % (name, len(name), chars[0], chars[1]))
+    out.append("};")
+    out.append("")
+    out.append("static const gint16 s_entityDisplacement[ENTITY_COUNT] = {")
+    for i in range(0, len(disp), 12):
+        out.append("\t" + ", ".join("%d" % d for d in disp[i:i + 12]) + ",")
+    out.append("};")
+    out.append("")
+    out.append(END_MARKER)
+    return "\n".join(out)
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    path = sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, "..", "src", "email", "HtmlEntities.cpp")
+
+    with open(path) as f:
+        source = f.read()
+
+    begin = source.index(BEGIN_MARKER)
+    end = source.index(END_MARKER) + len(END_MARKER)
+
+    with open(path, "w") as f:
+        f.write(source[:begin] + generate() + source[end:])
+
+if __name__ == "__main__":
+    main()
@@ -45,6 +45,22 @@ void AsyncIOChannel::SetException(const std::exception& e)
 	m_errorInfo = ExceptionUtils::GetErrorInfo(e);
 }
 
+size_t AsyncIOChannel::WriteV(const struct iovec* iov, int iovcnt)
+{
+	size_t totalWritten = 0;
+
+	for(int i = 0; i < iovcnt; ++i) {
+		size_t bytesWritten = Write((const char*) iov[i].iov_base, iov[i].iov_len);
+		totalWritten += bytesWritten;
+
+		if(bytesWritten < iov[i].iov_len) {
+			break;
+		}
+	}
+
+	return totalWritten;
+}
+
 const boost::exception_ptr& AsyncIOChannel::GetException() const
 {
 	return m_exception;
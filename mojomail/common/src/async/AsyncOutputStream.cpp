@@ -51,8 +51,12 @@ void AsyncOutputStream::Write(const char* src, size_t length)
 		throw MailNetworkDisconnectionException("can't write to closed channel", __FILE__, __LINE__);
 	}
 	
-	ByteBufferOutputStream::Write(src, length);
-	//fprintf(stderr, "adding %d bytes to buffer, %d total\n", length, m_buffer.length());
+	if(m_buffer.length() + length >= m_softSizeLimit) {
+		WriteThrough(src, length);
+	} else {
+		ByteBufferOutputStream::Write(src, length);
+		//fprintf(stderr, "adding %d bytes to buffer, %d total\n", length, m_buffer.length());
+	}
 
 	// When the buffer is full, start writing out data
 	if(IsFull()) {
@@ -97,6 +101,49 @@ void AsyncOutputStream::Unwatch()
 	}
 }
 
+// Writes the buffer and the new data to the channel in one gather write,
+// so that large writes don't get copied into the buffer first.
+// Anything the channel doesn't accept is buffered as usual.
+void AsyncOutputStream::WriteThrough(const char* src, size_t length)
+{
+	struct iovec iov[2];
+	int iovcnt = 0;
+
+	size_t bufferLength = m_buffer.length();
+
+	if(bufferLength > 0) {
+		iov[iovcnt].iov_base = const_cast<char*>(m_buffer.data());
+		iov[iovcnt].iov_len = bufferLength;
+		++iovcnt;
+	}
+
+	iov[iovcnt].iov_base = const_cast<char*>(src);
+	iov[iovcnt].iov_len = length;
+	++iovcnt;
+
+	size_t bytesWritten;
+
+	try {
+		bytesWritten = m_channel->WriteV(iov, iovcnt);
+	} catch(const std::exception& e) {
+		Error(e);
+		throw;
+	}
+
+	if(bytesWritten >= bufferLength) {
+		m_buffer.clear();
+
+		src += bytesWritten - bufferLength;
+		length -= bytesWritten - bufferLength;
+	} else {
+		m_buffer.erase(0, bytesWritten);
+	}
+
+	if(length > 0) {
+		ByteBufferOutputStream::Write(src, length);
+	}
+}
+
 bool AsyncOutputStream::ShouldFlushBuffer() const
 {
 	return m_buffer.length() >= m_softSizeLimit || m_flush;
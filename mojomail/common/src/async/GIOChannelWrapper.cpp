@@ -19,6 +19,8 @@
 #include "async/GIOChannelWrapper.h"
 #include <boost/shared_ptr.hpp>
 #include <glib.h>
+#include <errno.h>
+#include <unistd.h>
 #include "exceptions/MailException.h"
 #include "exceptions/GErrorException.h"
 #include "CommonPrivate.h"
@@ -33,7 +35,8 @@ GIOChannelWrapper::GIOChannelWrapper(GIOChannel* channel)
   m_writers(0),
   m_watchReadId(0),
   m_watchWriteId(0),
-  m_closed(false)
+  m_closed(false),
+  m_directWrite(false)
 {
 }
 
@@ -63,6 +66,10 @@ MojRefCountedPtr<AsyncIOChannel> GIOChannelWrapper::CreateFileIOChannel(const ch
 	
 	g_io_channel_set_encoding(aioChannel->m_channel, NULL, &gerr);
 	GErrorToException(gerr);
+
+	// AsyncInputStream/AsyncOutputStream already buffer; skip the extra copy into the GIOChannel buffer
+	g_io_channel_set_buffered(aioChannel->m_channel, false);
+	aioChannel->m_directWrite = true;
 	
 	return aioChannel;
 }
@@ -124,22 +131,56 @@ size_t GIOChannelWrapper::Write(const char* src, size_t count)
 	case G_IO_STATUS_AGAIN:
 		return 0;
 	case G_IO_STATUS_ERROR:
-		if(gerr) {
-			GErrorException exc(gerr, __FILE__, __LINE__);
-			g_error_free(gerr);
-			SetException(exc);
+		WriteError(gerr);
+	}
+	
+	return bytesWritten;
+}
 
-			ErrorOrEOF();
-			throw exc;
-		} else {
-			// shouldn't ever get here
-			throw MailException("unknown write error", __FILE__, __LINE__);
+size_t GIOChannelWrapper::WriteV(const struct iovec* iov, int iovcnt)
+{
+	// Socket channels may be encrypted, so only plain unbuffered files can use writev
+	if(!m_directWrite) {
+		return AsyncIOChannel::WriteV(iov, iovcnt);
+	}
+
+	if(m_closed) {
+		throw MailNetworkDisconnectionException("attempted to write to closed channel", __FILE__, __LINE__);
+	}
+
+	ssize_t bytesWritten;
+
+	do {
+		bytesWritten = writev(GetFD(), iov, iovcnt);
+	} while(bytesWritten < 0 && errno == EINTR);
+
+	if(bytesWritten < 0) {
+		if(errno == EAGAIN || errno == EWOULDBLOCK) {
+			return 0;
 		}
+
+		int errnum = errno;
+		WriteError(g_error_new_literal(G_IO_CHANNEL_ERROR, g_io_channel_error_from_errno(errnum), g_strerror(errnum)));
 	}
-	
+
 	return bytesWritten;
 }
 
+void GIOChannelWrapper::WriteError(GError* gerr)
+{
+	if(gerr) {
+		GErrorException exc(gerr, __FILE__, __LINE__);
+		g_error_free(gerr);
+		SetException(exc);
+
+		ErrorOrEOF();
+		throw exc;
+	} else {
+		// shouldn't ever get here
+		throw MailException("unknown write error", __FILE__, __LINE__);
+	}
+}
+
 void GIOChannelWrapper::SetWatchReadable(bool watch)
 {
 	if(watch) {
@@ -27,14 +27,12 @@
 #include "stream/Base64DecoderOutputStream.h"
 #include "stream/PreviewTextExtractorOutputStream.h"
 #include <boost/algorithm/string/predicate.hpp>
-#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/foreach.hpp>
 #include "data/EmailPart.h"
 #include "util/LogUtils.h"
 #include "data/Email.h"
 #include "email/Rfc2047Decoder.h"
 #include "mimeparser/EmailHeaderFieldParser.h"
-#include "email/PreviewTextGenerator.h"
 
 using namespace std;
 
@@ -217,20 +215,24 @@ void AsyncEmailParser::HandleContentType(const std::string& type, const std::str
 	}
 }
 
-void AsyncEmailParser::HandleHeader(const std::string& origFieldName, const std::string& fieldValue)
+void AsyncEmailParser::HandleHeaderField(HeaderFieldNames::FieldId fieldId, const char* name, size_t nameLength, const std::string& fieldValue)
 {
+	if (fieldId == HeaderFieldNames::Field_Other) {
+		// not a field we care about
+		return;
+	}
+
 	EmailHeaderFieldParser headerParser;
-	std::string fieldNameLower = boost::to_lower_copy(origFieldName);
 
 	try {
-		if (m_parseEmailBodies && headerParser.ParsePartHeaderField(CurrentPart(), fieldNameLower, fieldValue)) {
+		if (m_parseEmailBodies && headerParser.ParsePartHeaderField(CurrentPart(), fieldId, fieldValue)) {
 			// found a part header and parsed it into the part
 		} else if (m_parseEmailHeaders && m_partStack.size() == 1 && m_email.get()) {
 			// only try to parse email fields for the email headers, not other parts
-			headerParser.ParseEmailHeaderField(*m_email, fieldNameLower, fieldValue);
+			headerParser.ParseEmailHeaderField(*m_email, fieldId, fieldValue);
 		}
 	} catch (const exception& e) {
-		MojLogError(s_log, "error parsing header line: %s: %s", origFieldName.c_str(), fieldValue.c_str());
+		MojLogError(s_log, "error parsing header line: %s: %s", string(name, nameLength).c_str(), fieldValue.c_str());
 	}
 }
 
@@ -305,7 +307,9 @@ MojErr AsyncEmailParser::FileCacheInsertResponse(MojObject& response, MojErr err
 		// Extract preview text
 		if (m_previewTextSize > 0) {
 			if (!CurrentPart().IsAttachment()) {
-				m_previewTextExtractorOutputStream.reset(new PreviewTextExtractorOutputStream(m_outputStream, 8192));
+				bool isHtml = boost::iequals(CurrentPart().GetMimeType(), "text/html");
+
+				m_previewTextExtractorOutputStream.reset(new PreviewTextExtractorOutputStream(m_outputStream, m_previewTextSize, isHtml));
 				m_outputStream = m_previewTextExtractorOutputStream;
 			}
 		}
@@ -401,9 +405,6 @@ MojErr AsyncEmailParser::ChannelClosed()
 	// Extract preview text
 	if (m_previewTextExtractorOutputStream.get() && m_partBeingWritten.get()) {
 		string previewText = m_previewTextExtractorOutputStream->GetPreviewText();
-		string mimeType = m_partBeingWritten->GetMimeType();
-
-		previewText = PreviewTextGenerator::GeneratePreviewText(previewText, m_previewTextSize, boost::iequals(mimeType, "text/html"));
 		m_partBeingWritten->SetPreviewText(previewText);
 	}
 
@@ -0,0 +1,91 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "email/CharsetConverterPool.h"
+#include "email/CharsetSupport.h"
+
+using namespace std;
+
+const size_t CharsetConverterPool::MAX_IDLE_PER_CHARSET;
+
+CharsetConverterPool::NameMap CharsetConverterPool::s_canonicalNames;
+CharsetConverterPool::ConverterMap CharsetConverterPool::s_idleConverters;
+
+UConverter* CharsetConverterPool::Acquire(const char* charset, UErrorCode* err)
+{
+	const char* selected = CharsetSupport::SelectCharset(charset);
+
+	// Check for an idle converter, if we've seen this name before
+	NameMap::const_iterator nameIt = s_canonicalNames.find(selected);
+
+	if (nameIt != s_canonicalNames.end()) {
+		ConverterMap::iterator it = s_idleConverters.find(nameIt->second);
+
+		if (it != s_idleConverters.end() && !it->second.empty()) {
+			UConverter* converter = it->second.back();
+			it->second.pop_back();
+			return converter;
+		}
+	}
+
+	UConverter* converter = ucnv_open(selected, err);
+
+	if (converter != NULL && U_SUCCESS(*err) && nameIt == s_canonicalNames.end()) {
+		UErrorCode nameErr = U_ZERO_ERROR;
+		const char* canonicalName = ucnv_getName(converter, &nameErr);
+
+		if (U_SUCCESS(nameErr)) {
+			s_canonicalNames[selected] = canonicalName;
+		}
+	}
+
+	return converter;
+}
+
+void CharsetConverterPool::Release(UConverter* converter)
+{
+	if (converter == NULL) {
+		return;
+	}
+
+	UErrorCode err = U_ZERO_ERROR;
+	const char* canonicalName = ucnv_getName(converter, &err);
+
+	if (U_SUCCESS(err)) {
+		vector<UConverter*>& idle = s_idleConverters[canonicalName];
+
+		if (idle.size() < MAX_IDLE_PER_CHARSET) {
+			ucnv_reset(converter);
+			idle.push_back(converter);
+			return;
+		}
+	}
+
+	ucnv_close(converter);
+}
+
+void CharsetConverterPool::Clear()
+{
+	for (ConverterMap::iterator it = s_idleConverters.begin(); it != s_idleConverters.end(); ++it) {
+		for (size_t i = 0; i < it->second.size(); i++) {
+			ucnv_close(it->second[i]);
+		}
+	}
+
+	s_idleConverters.clear();
+}
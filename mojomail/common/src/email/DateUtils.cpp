@@ -21,19 +21,303 @@
  */
 #include "email/DateUtils.h"
 #include <curl/curl.h>
+#include <stdio.h>
+#include <string.h>
 
+static const char* const MONTH_NAMES[12] = {
+	"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+};
+
+struct ZoneDef
+{
+	const char*	name;
+	int			offset; // minutes east of UTC
+};
+
+// Obsolete zone names from RFC 822
+static const ZoneDef ZONES[] = {
+	{ "UT", 0 }, { "GMT", 0 }, { "UTC", 0 },
+	{ "EST", -5 * 60 }, { "EDT", -4 * 60 },
+	{ "CST", -6 * 60 }, { "CDT", -5 * 60 },
+	{ "MST", -7 * 60 }, { "MDT", -6 * 60 },
+	{ "PST", -8 * 60 }, { "PDT", -7 * 60 }
+};
+
+static const size_t NUM_ZONES = sizeof(ZONES) / sizeof(ZONES[0]);
+
+static inline bool IsDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static inline bool IsAlpha(char c)
+{
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static inline char ToUpper(char c)
+{
+	return (c >= 'a' && c <= 'z') ? c - 'a' + 'A' : c;
+}
+
+static inline bool IsWhitespace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static inline void SkipWhitespace(const char*& p)
+{
+	while(IsWhitespace(*p)) {
+		p++;
+	}
+}
+
+// Skips whitespace; returns false if there wasn't any
+static inline bool SkipRequiredWhitespace(const char*& p)
+{
+	const char* start = p;
+	SkipWhitespace(p);
+
+	return p != start;
+}
+
+// Reads an unsigned number with between minDigits and maxDigits digits
+static bool ReadNumber(const char*& p, int minDigits, int maxDigits, int& value)
+{
+	int numDigits = 0;
+	value = 0;
+
+	while(IsDigit(*p) && numDigits < maxDigits) {
+		value = value * 10 + (*p++ - '0');
+		numDigits++;
+	}
+
+	return numDigits >= minDigits && !IsDigit(*p);
+}
+
+// Reads a word into buf, uppercased. Returns 0 if it has more than maxLength letters.
+static size_t ReadWord(const char*& p, char* buf, size_t maxLength)
+{
+	size_t length = 0;
+
+	while(IsAlpha(*p)) {
+		if(length == maxLength) {
+			return 0;
+		}
+
+		buf[length++] = ToUpper(*p++);
+	}
+
+	buf[length] = '\0';
+	return length;
+}
+
+// Returns the month (0-11) for a three-letter abbreviation, or -1
+static int ParseMonth(const char*& p)
+{
+	char word[4];
+
+	if(ReadWord(p, word, 3) == 3) {
+		for(int i = 0; i < 12; i++) {
+			if(word[0] == MONTH_NAMES[i][0] && word[1] == ToUpper(MONTH_NAMES[i][1]) && word[2] == ToUpper(MONTH_NAMES[i][2])) {
+				return i;
+			}
+		}
+	}
+
+	return -1;
+}
+
+// Parses "+hhmm", "-hhmm" or a zone name. Returns false if it's not recognized.
+static bool ParseZone(const char*& p, int& offset)
+{
+	if(*p == '+' || *p == '-') {
+		int sign = (*p++ == '-') ? -1 : 1;
+		int value;
+
+		const char* start = p;
+		if(!ReadNumber(p, 4, 4, value) || p - start != 4 || value % 100 > 59) {
+			return false;
+		}
+
+		offset = sign * ((value / 100) * 60 + value % 100);
+		return true;
+	}
+
+	char word[4];
+	size_t length = ReadWord(p, word, 3);
+
+	if(length == 0) {
+		return false;
+	} else if(length == 1) {
+		// Military zones were specified with the wrong sign in RFC 822,
+		// so RFC 2822 says to treat them as unknown (UTC).
+		offset = 0;
+		return word[0] != 'J';
+	}
+
+	for(size_t i = 0; i < NUM_ZONES; i++) {
+		if(strcmp(word, ZONES[i].name) == 0) {
+			offset = ZONES[i].offset;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Number of days in a month (0-11) of the Gregorian calendar
+static int DaysInMonth(int year, int month)
+{
+	static const int DAYS[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+	if(month == 1 && (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0))) {
+		return 29;
+	}
+
+	return DAYS[month];
+}
+
+// Number of days from 1970-01-01 to the given date in the proleptic
+// Gregorian calendar. Month is 1-12.
+static long long DaysFromCivil(int year, int month, int day)
+{
+	year -= month <= 2;
+
+	long long era = (year >= 0 ? year : year - 399) / 400;
+	int yearOfEra = year - era * 400;
+	int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+	int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+
+	return era * 146097 + dayOfEra - 719468;
+}
+
+bool DateUtils::ParseCommonDate(const char* str, time_t& time)
+{
+	const char* p = str;
+	SkipWhitespace(p);
+
+	// Optional day of the week, e.g. "Tue,"
+	if(IsAlpha(*p)) {
+		while(IsAlpha(*p)) {
+			p++;
+		}
+
+		if(*p == ',') {
+			p++;
+		}
+
+		SkipWhitespace(p);
+	}
+
+	int day, month, year, hour, minute, second = 0;
+
+	if(!ReadNumber(p, 1, 2, day)) {
+		return false;
+	}
+
+	// RFC 3501 uses dashes, e.g. "04-Jun-2013"
+	bool dashes = (*p == '-');
+
+	if(dashes ? *p++ != '-' : !SkipRequiredWhitespace(p)) {
+		return false;
+	}
+
+	month = ParseMonth(p);
+
+	if(month < 0 || (dashes ? *p++ != '-' : !SkipRequiredWhitespace(p))) {
+		return false;
+	}
+
+	const char* yearStart = p;
+
+	if(!ReadNumber(p, 2, 4, year)) {
+		return false;
+	}
+
+	// Two and three digit years are obsolete (RFC 2822 section 4.3)
+	if(p - yearStart == 2) {
+		year += (year < 50) ? 2000 : 1900;
+	} else if(p - yearStart == 3) {
+		year += 1900;
+	}
+
+	if(!SkipRequiredWhitespace(p) || !ReadNumber(p, 1, 2, hour) || *p++ != ':' || !ReadNumber(p, 2, 2, minute)) {
+		return false;
+	}
+
+	if(*p == ':') {
+		p++;
+
+		if(!ReadNumber(p, 2, 2, second)) {
+			return false;
+		}
+	}
+
+	// Dates before 1970, and days past the end of the month (e.g. "31 Feb"),
+	// are left to the fallback parser
+	if(year < 1970 || day < 1 || day > DaysInMonth(year, month) || hour > 23 || minute > 59 || second > 60) {
+		return false;
+	}
+
+	// Dates without a zone are treated as UTC
+	int offset = 0;
+	SkipWhitespace(p);
+
+	if(*p != '\0' && *p != '(' && !ParseZone(p, offset)) {
+		return false;
+	}
+
+	// Allow a trailing comment, e.g. "-0700 (PDT)"
+	SkipWhitespace(p);
+
+	if(*p != '\0' && *p != '(') {
+		return false;
+	}
+
+	long long seconds = DaysFromCivil(year, month + 1, day) * 86400LL
+			+ hour * 3600 + minute * 60 + second - offset * 60;
+
+	time = (time_t) seconds;
+	return (long long) time == seconds && time != -1;
+}
 
 time_t DateUtils::ParseRfc822Date(const char* str)
 {
+	time_t time;
+
+	if(ParseCommonDate(str, time)) {
+		return time;
+	}
+
+	// Handles all the other formats found in the wild
 	return curl_getdate(str, NULL);
 }
 
+const std::string DateUtils::FormatRfc3501Date(time_t time)
+{
+	struct tm tm;
+	gmtime_r(&time, &tm);
+
+	char buffer[16];
+	snprintf(buffer, sizeof(buffer), "%02d-%s-%04d", tm.tm_mday, MONTH_NAMES[tm.tm_mon], tm.tm_year + 1900);
+	return buffer;
+}
+
 const MojInt64 DateUtils::GetCurrentTimeMillis()
 {
 	time_t nowSec = time(NULL);
 	return MojInt64(nowSec) * 1000;
 }
 
+const MojInt64 DateUtils::GetMonotonicTimeMillis()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return MojInt64(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
 const std::string DateUtils::GetUTC2DateString(MojInt64 val, const char* format)
 {
 	char buffer [50];
@@ -17,294 +17,2379 @@
 // LICENSE@@@
 
 #include "email/HtmlEntities.h"
-#include <map>
-#include <string>
-#include "CommonPrivate.h"
+#include <cstring>
 
-using namespace std;
+struct EntityDef {
+	const char*	name;
+	guint8		length;
+	gunichar	value;
+	gunichar	value2;		// second character, for the few entities that map to two
+};
 
-static map<const string, gunichar> s_entityMap;
+// BEGIN GENERATED ENTITY TABLE
+// Generated by scripts/gen-html-entities.py; do not edit by hand.
 
-struct EntityDef {
-	const string name;
-	gunichar value;
+static const size_t ENTITY_COUNT = 2125;
+static const size_t MAX_ENTITY_NAME_LENGTH = 31;
+
+static const EntityDef s_entityTable[ENTITY_COUNT] = {
+	{ "lne", 3, 0x2A87, 0x0000 },
+	{ "pscr", 4, 0x1D4C5, 0x0000 },
+	{ "thetav", 6, 0x03D1, 0x0000 },
+	{ "ltrie", 5, 0x22B4, 0x0000 },
+	{ "RightUpDownVector", 17, 0x294F, 0x0000 },
+	{ "Uarrocir", 8, 0x2949, 0x0000 },
+	{ "Tcedil", 6, 0x0162, 0x0000 },
+	{ "vsupne", 6, 0x228B, 0xFE00 },
+	{ "upsilon", 7, 0x03C5, 0x0000 },
+	{ "kjcy", 4, 0x045C, 0x0000 },
+	{ "divonx", 6, 0x22C7, 0x0000 },
+	{ "subdot", 6, 0x2ABD, 0x0000 },
+	{ "gtrapprox", 9, 0x2A86, 0x0000 },
+	{ "amp", 3, 0x0026, 0x0000 },
+	{ "equest", 6, 0x225F, 0x0000 },
+	{ "sqcup", 5, 0x2294, 0x0000 },
+	{ "multimap", 8, 0x22B8, 0x0000 },
+	{ "mp", 2, 0x2213, 0x0000 },
+	{ "puncsp", 6, 0x2008, 0x0000 },
+	{ "Eacute", 6, 0x00C9, 0x0000 },
+	{ "wedbar", 6, 0x2A5F, 0x0000 },
+	{ "circledast", 10, 0x229B, 0x0000 },
+	{ "lesdotor", 8, 0x2A83, 0x0000 },
+	{ "diam", 4, 0x22C4, 0x0000 },
+	{ "qfr", 3, 0x1D52E, 0x0000 },
+	{ "gnE", 3, 0x2269, 0x0000 },
+	{ "bot", 3, 0x22A5, 0x0000 },
+	{ "nvinfin", 7, 0x29DE, 0x0000 },
+	{ "leftrightharpoons", 17, 0x21CB, 0x0000 },
+	{ "complement", 10, 0x2201, 0x0000 },
+	{ "dd", 2, 0x2146, 0x0000 },
+	{ "rAtail", 6, 0x291C, 0x0000 },
+	{ "Zopf", 4, 0x2124, 0x0000 },
+	{ "frac16", 6, 0x2159, 0x0000 },
+	{ "lopar", 5, 0x2985, 0x0000 },
+	{ "simdot", 6, 0x2A6A, 0x0000 },
+	{ "CircleTimes", 11, 0x2297, 0x0000 },
+	{ "Sum", 3, 0x2211, 0x0000 },
+	{ "Pi", 2, 0x03A0, 0x0000 },
+	{ "DoubleContourIntegral", 21, 0x222F, 0x0000 },
+	{ "mfr", 3, 0x1D52A, 0x0000 },
+	{ "Beta", 4, 0x0392, 0x0000 },
+	{ "mapstoleft", 10, 0x21A4, 0x0000 },
+	{ "odblac", 6, 0x0151, 0x0000 },
+	{ "subsup", 6, 0x2AD3, 0x0000 },
+	{ "sqsupe", 6, 0x2292, 0x0000 },
+	{ "hstrok", 6, 0x0127, 0x0000 },
+	{ "maltese", 7, 0x2720, 0x0000 },
+	{ "Bfr", 3, 0x1D505, 0x0000 },
+	{ "VerticalSeparator", 17, 0x2758, 0x0000 },
+	{ "InvisibleComma", 14, 0x2063, 0x0000 },
+	{ "barvee", 6, 0x22BD, 0x0000 },
+	{ "blank", 5, 0x2423, 0x0000 },
+	{ "doteq", 5, 0x2250, 0x0000 },
+	{ "UpTee", 5, 0x22A5, 0x0000 },
+	{ "frac12", 6, 0x00BD, 0x0000 },
+	{ "COPY", 4, 0x00A9, 0x0000 },
+	{ "square", 6, 0x25A1, 0x0000 },
+	{ "uharr", 5, 0x21BE, 0x0000 },
+	{ "rarrfs", 6, 0x291E, 0x0000 },
+	{ "hcirc", 5, 0x0125, 0x0000 },
+	{ "csup", 4, 0x2AD0, 0x0000 },
+	{ "ruluhar", 7, 0x2968, 0x0000 },
+	{ "Xscr", 4, 0x1D4B3, 0x0000 },
+	{ "Square", 6, 0x25A1, 0x0000 },
+	{ "ang", 3, 0x2220, 0x0000 },
+	{ "Uring", 5, 0x016E, 0x0000 },
+	{ "rarrap", 6, 0x2975, 0x0000 },
+	{ "Congruent", 9, 0x2261, 0x0000 },
+	{ "MediumSpace", 11, 0x205F, 0x0000 },
+	{ "int", 3, 0x222B, 0x0000 },
+	{ "nsupseteq", 9, 0x2289, 0x0000 },
+	{ "rBarr", 5, 0x290F, 0x0000 },
+	{ "iuml", 4, 0x00EF, 0x0000 },
+	{ "SucceedsSlantEqual", 18, 0x227D, 0x0000 },
+	{ "bigcap", 6, 0x22C2, 0x0000 },
+	{ "lnap", 4, 0x2A89, 0x0000 },
+	{ "homtht", 6, 0x223B, 0x0000 },
+	{ "vprop", 5, 0x221D, 0x0000 },
+	{ "curlyeqsucc", 11, 0x22DF, 0x0000 },
+	{ "Amacr", 5, 0x0100, 0x0000 },
+	{ "Dcaron", 6, 0x010E, 0x0000 },
+	{ "alpha", 5, 0x03B1, 0x0000 },
+	{ "searrow", 7, 0x2198, 0x0000 },
+	{ "gap", 3, 0x2A86, 0x0000 },
+	{ "NotRightTriangle", 16, 0x22EB, 0x0000 },
+	{ "malt", 4, 0x2720, 0x0000 },
+	{ "ngt", 3, 0x226F, 0x0000 },
+	{ "doublebarwedge", 14, 0x2306, 0x0000 },
+	{ "div", 3, 0x00F7, 0x0000 },
+	{ "zopf", 4, 0x1D56B, 0x0000 },
+	{ "risingdotseq", 12, 0x2253, 0x0000 },
+	{ "gcy", 3, 0x0433, 0x0000 },
+	{ "lfisht", 6, 0x297C, 0x0000 },
+	{ "uuml", 4, 0x00FC, 0x0000 },
+	{ "because", 7, 0x2235, 0x0000 },
+	{ "upharpoonright", 14, 0x21BE, 0x0000 },
+	{ "nvge", 4, 0x2265, 0x20D2 },
+	{ "NotReverseElement", 17, 0x220C, 0x0000 },
+	{ "backsim", 7, 0x223D, 0x0000 },
+	{ "frac13", 6, 0x2153, 0x0000 },
+	{ "NotPrecedesSlantEqual", 21, 0x22E0, 0x0000 },
+	{ "varsupsetneq", 12, 0x228B, 0xFE00 },
+	{ "imacr", 5, 0x012B, 0x0000 },
+	{ "Sub", 3, 0x22D0, 0x0000 },
+	{ "ssetmn", 6, 0x2216, 0x0000 },
+	{ "pfr", 3, 0x1D52D, 0x0000 },
+	{ "rightleftarrows", 15, 0x21C4, 0x0000 },
+	{ "rbrace", 6, 0x007D, 0x0000 },
+	{ "ccedil", 6, 0x00E7, 0x0000 },
+	{ "prap", 4, 0x2AB7, 0x0000 },
+	{ "bottom", 6, 0x22A5, 0x0000 },
+	{ "mopf", 4, 0x1D55E, 0x0000 },
+	{ "angmsdab", 8, 0x29A9, 0x0000 },
+	{ "DiacriticalGrave", 16, 0x0060, 0x0000 },
+	{ "Uarr", 4, 0x219F, 0x0000 },
+	{ "diamond", 7, 0x22C4, 0x0000 },
+	{ "Mopf", 4, 0x1D544, 0x0000 },
+	{ "lparlt", 6, 0x2993, 0x0000 },
+	{ "ogon", 4, 0x02DB, 0x0000 },
+	{ "UpArrow", 7, 0x2191, 0x0000 },
+	{ "Zcaron", 6, 0x017D, 0x0000 },
+	{ "NegativeVeryThinSpace", 21, 0x200B, 0x0000 },
+	{ "block", 5, 0x2588, 0x0000 },
+	{ "nu", 2, 0x03BD, 0x0000 },
+	{ "plusdo", 6, 0x2214, 0x0000 },
+	{ "Sfr", 3, 0x1D516, 0x0000 },
+	{ "iprod", 5, 0x2A3C, 0x0000 },
+	{ "cirfnint", 8, 0x2A10, 0x0000 },
+	{ "epsiv", 5, 0x03F5, 0x0000 },
+	{ "leqq", 4, 0x2266, 0x0000 },
+	{ "Ll", 2, 0x22D8, 0x0000 },
+	{ "nsmid", 5, 0x2224, 0x0000 },
+	{ "Product", 7, 0x220F, 0x0000 },
+	{ "cwint", 5, 0x2231, 0x0000 },
+	{ "cupcap", 6, 0x2A46, 0x0000 },
+	{ "bcong", 5, 0x224C, 0x0000 },
+	{ "gg", 2, 0x226B, 0x0000 },
+	{ "topfork", 7, 0x2ADA, 0x0000 },
+	{ "ltrPar", 6, 0x2996, 0x0000 },
+	{ "GreaterTilde", 12, 0x2273, 0x0000 },
+	{ "lates", 5, 0x2AAD, 0xFE00 },
+	{ "Jfr", 3, 0x1D50D, 0x0000 },
+	{ "equals", 6, 0x003D, 0x0000 },
+	{ "RightAngleBracket", 17, 0x27E9, 0x0000 },
+	{ "lesseqqgtr", 10, 0x2A8B, 0x0000 },
+	{ "reg", 3, 0x00AE, 0x0000 },
+	{ "wr", 2, 0x2240, 0x0000 },
+	{ "ovbar", 5, 0x233D, 0x0000 },
+	{ "notin", 5, 0x2209, 0x0000 },
+	{ "bbrk", 4, 0x23B5, 0x0000 },
+	{ "wcirc", 5, 0x0175, 0x0000 },
+	{ "eqvparsl", 8, 0x29E5, 0x0000 },
+	{ "digamma", 7, 0x03DD, 0x0000 },
+	{ "sqsub", 5, 0x228F, 0x0000 },
+	{ "supdsub", 7, 0x2AD8, 0x0000 },
+	{ "fork", 4, 0x22D4, 0x0000 },
+	{ "dollar", 6, 0x0024, 0x0000 },
+	{ "IOcy", 4, 0x0401, 0x0000 },
+	{ "backepsilon", 11, 0x03F6, 0x0000 },
+	{ "lowbar", 6, 0x005F, 0x0000 },
+	{ "isinE", 5, 0x22F9, 0x0000 },
+	{ "triangleright", 13, 0x25B9, 0x0000 },
+	{ "Dopf", 4, 0x1D53B, 0x0000 },
+	{ "thicksim", 8, 0x223C, 0x0000 },
+	{ "nshortparallel", 14, 0x2226, 0x0000 },
+	{ "lbrkslu", 7, 0x298D, 0x0000 },
+	{ "vBar", 4, 0x2AE8, 0x0000 },
+	{ "boxtimes", 8, 0x22A0, 0x0000 },
+	{ "bdquo", 5, 0x201E, 0x0000 },
+	{ "Emacr", 5, 0x0112, 0x0000 },
+	{ "swnwar", 6, 0x292A, 0x0000 },
+	{ "ntlg", 4, 0x2278, 0x0000 },
+	{ "YAcy", 4, 0x042F, 0x0000 },
+	{ "nLt", 3, 0x226A, 0x20D2 },
+	{ "boxuL", 5, 0x255B, 0x0000 },
+	{ "coloneq", 7, 0x2254, 0x0000 },
+	{ "suplarr", 7, 0x297B, 0x0000 },
+	{ "thetasym", 8, 0x03D1, 0x0000 },
+	{ "Sc", 2, 0x2ABC, 0x0000 },
+	{ "nbumpe", 6, 0x224F, 0x0338 },
+	{ "ncongdot", 8, 0x2A6D, 0x0338 },
+	{ "boxVr", 5, 0x255F, 0x0000 },
+	{ "xrarr", 5, 0x27F6, 0x0000 },
+	{ "mapstoup", 8, 0x21A5, 0x0000 },
+	{ "leftharpoondown", 15, 0x21BD, 0x0000 },
+	{ "cudarrr", 7, 0x2935, 0x0000 },
+	{ "nopf", 4, 0x1D55F, 0x0000 },
+	{ "LeftVectorBar", 13, 0x2952, 0x0000 },
+	{ "orarr", 5, 0x21BB, 0x0000 },
+	{ "napprox", 7, 0x2249, 0x0000 },
+	{ "circledS", 8, 0x24C8, 0x0000 },
+	{ "Scedil", 6, 0x015E, 0x0000 },
+	{ "Lacute", 6, 0x0139, 0x0000 },
+	{ "angmsdaa", 8, 0x29A8, 0x0000 },
+	{ "RightTee", 8, 0x22A2, 0x0000 },
+	{ "tcedil", 6, 0x0163, 0x0000 },
+	{ "succeq", 6, 0x2AB0, 0x0000 },
+	{ "NotHumpEqual", 12, 0x224F, 0x0338 },
+	{ "sqsupseteq", 10, 0x2292, 0x0000 },
+	{ "RightArrow", 10, 0x2192, 0x0000 },
+	{ "nvlArr", 6, 0x2902, 0x0000 },
+	{ "Conint", 6, 0x222F, 0x0000 },
+	{ "oacute", 6, 0x00F3, 0x0000 },
+	{ "marker", 6, 0x25AE, 0x0000 },
+	{ "ntrianglerighteq", 16, 0x22ED, 0x0000 },
+	{ "lnsim", 5, 0x22E6, 0x0000 },
+	{ "boxhu", 5, 0x2534, 0x0000 },
+	{ "comma", 5, 0x002C, 0x0000 },
+	{ "dHar", 4, 0x2965, 0x0000 },
+	{ "nlE", 3, 0x2266, 0x0338 },
+	{ "lnapprox", 8, 0x2A89, 0x0000 },
+	{ "check", 5, 0x2713, 0x0000 },
+	{ "smashp", 6, 0x2A33, 0x0000 },
+	{ "napE", 4, 0x2A70, 0x0338 },
+	{ "curarrm", 7, 0x293C, 0x0000 },
+	{ "angmsdag", 8, 0x29AE, 0x0000 },
+	{ "utdot", 5, 0x22F0, 0x0000 },
+	{ "NotSubset", 9, 0x2282, 0x20D2 },
+	{ "RightTriangleBar", 16, 0x29D0, 0x0000 },
+	{ "mu", 2, 0x03BC, 0x0000 },
+	{ "Pcy", 3, 0x041F, 0x0000 },
+	{ "imof", 4, 0x22B7, 0x0000 },
+	{ "RightCeiling", 12, 0x2309, 0x0000 },
+	{ "succnsim", 8, 0x22E9, 0x0000 },
+	{ "aacute", 6, 0x00E1, 0x0000 },
+	{ "Acy", 3, 0x0410, 0x0000 },
+	{ "bemptyv", 7, 0x29B0, 0x0000 },
+	{ "star", 4, 0x2606, 0x0000 },
+	{ "auml", 4, 0x00E4, 0x0000 },
+	{ "drcrop", 6, 0x230C, 0x0000 },
+	{ "ordm", 4, 0x00BA, 0x0000 },
+	{ "ZeroWidthSpace", 14, 0x200B, 0x0000 },
+	{ "nvltrie", 7, 0x22B4, 0x20D2 },
+	{ "mid", 3, 0x2223, 0x0000 },
+	{ "tritime", 7, 0x2A3B, 0x0000 },
+	{ "iinfin", 6, 0x29DC, 0x0000 },
+	{ "trianglelefteq", 14, 0x22B4, 0x0000 },
+	{ "rlarr", 5, 0x21C4, 0x0000 },
+	{ "ReverseElement", 14, 0x220B, 0x0000 },
+	{ "scedil", 6, 0x015F, 0x0000 },
+	{ "OpenCurlyQuote", 14, 0x2018, 0x0000 },
+	{ "uogon", 5, 0x0173, 0x0000 },
+	{ "ubreve", 6, 0x016D, 0x0000 },
+	{ "nwnear", 6, 0x2927, 0x0000 },
+	{ "midcir", 6, 0x2AF0, 0x0000 },
+	{ "szlig", 5, 0x00DF, 0x0000 },
+	{ "Zeta", 4, 0x0396, 0x0000 },
+	{ "lharul", 6, 0x296A, 0x0000 },
+	{ "nsucc", 5, 0x2281, 0x0000 },
+	{ "gla", 3, 0x2AA5, 0x0000 },
+	{ "Rarr", 4, 0x21A0, 0x0000 },
+	{ "fcy", 3, 0x0444, 0x0000 },
+	{ "langd", 5, 0x2991, 0x0000 },
+	{ "Vfr", 3, 0x1D519, 0x0000 },
+	{ "cacute", 6, 0x0107, 0x0000 },
+	{ "prE", 3, 0x2AB3, 0x0000 },
+	{ "phiv", 4, 0x03D5, 0x0000 },
+	{ "dotminus", 8, 0x2238, 0x0000 },
+	{ "bigvee", 6, 0x22C1, 0x0000 },
+	{ "lopf", 4, 0x1D55D, 0x0000 },
+	{ "NotPrecedesEqual", 16, 0x2AAF, 0x0338 },
+	{ "Tab", 3, 0x0009, 0x0000 },
+	{ "AElig", 5, 0x00C6, 0x0000 },
+	{ "ngeq", 4, 0x2271, 0x0000 },
+	{ "ngeqq", 5, 0x2267, 0x0338 },
+	{ "VeryThinSpace", 13, 0x200A, 0x0000 },
+	{ "clubsuit", 8, 0x2663, 0x0000 },
+	{ "bnot", 4, 0x2310, 0x0000 },
+	{ "ltri", 4, 0x25C3, 0x0000 },
+	{ "boxHU", 5, 0x2569, 0x0000 },
+	{ "dotsquare", 9, 0x22A1, 0x0000 },
+	{ "NotEqual", 8, 0x2260, 0x0000 },
+	{ "nbsp", 4, 0x00A0, 0x0000 },
+	{ "acy", 3, 0x0430, 0x0000 },
+	{ "Subset", 6, 0x22D0, 0x0000 },
+	{ "capand", 6, 0x2A44, 0x0000 },
+	{ "Scy", 3, 0x0421, 0x0000 },
+	{ "Tfr", 3, 0x1D517, 0x0000 },
+	{ "gt", 2, 0x003E, 0x0000 },
+	{ "supsetneqq", 10, 0x2ACC, 0x0000 },
+	{ "sime", 4, 0x2243, 0x0000 },
+	{ "Uogon", 5, 0x0172, 0x0000 },
+	{ "UpTeeArrow", 10, 0x21A5, 0x0000 },
+	{ "bbrktbrk", 8, 0x23B6, 0x0000 },
+	{ "triangleq", 9, 0x225C, 0x0000 },
+	{ "parallel", 8, 0x2225, 0x0000 },
+	{ "ExponentialE", 12, 0x2147, 0x0000 },
+	{ "VerticalBar", 11, 0x2223, 0x0000 },
+	{ "uwangle", 7, 0x29A7, 0x0000 },
+	{ "Epsilon", 7, 0x0395, 0x0000 },
+	{ "latail", 6, 0x2919, 0x0000 },
+	{ "Popf", 4, 0x2119, 0x0000 },
+	{ "ntilde", 6, 0x00F1, 0x0000 },
+	{ "uArr", 4, 0x21D1, 0x0000 },
+	{ "delta", 5, 0x03B4, 0x0000 },
+	{ "ecir", 4, 0x2256, 0x0000 },
+	{ "rnmid", 5, 0x2AEE, 0x0000 },
+	{ "Kfr", 3, 0x1D50E, 0x0000 },
+	{ "smte", 4, 0x2AAC, 0x0000 },
+	{ "omicron", 7, 0x03BF, 0x0000 },
+	{ "dfisht", 6, 0x297F, 0x0000 },
+	{ "rmoust", 6, 0x23B1, 0x0000 },
+	{ "ntrianglelefteq", 15, 0x22EC, 0x0000 },
+	{ "qopf", 4, 0x1D562, 0x0000 },
+	{ "verbar", 6, 0x007C, 0x0000 },
+	{ "qscr", 4, 0x1D4C6, 0x0000 },
+	{ "Lscr", 4, 0x2112, 0x0000 },
+	{ "bscr", 4, 0x1D4B7, 0x0000 },
+	{ "quatint", 7, 0x2A16, 0x0000 },
+	{ "ltcir", 5, 0x2A79, 0x0000 },
+	{ "Uopf", 4, 0x1D54C, 0x0000 },
+	{ "swarhk", 6, 0x2926, 0x0000 },
+	{ "lAarr", 5, 0x21DA, 0x0000 },
+	{ "bigtriangleup", 13, 0x25B3, 0x0000 },
+	{ "Sacute", 6, 0x015A, 0x0000 },
+	{ "acE", 3, 0x223E, 0x0333 },
+	{ "lrcorner", 8, 0x231F, 0x0000 },
+	{ "gtreqqless", 10, 0x2A8C, 0x0000 },
+	{ "supsub", 6, 0x2AD4, 0x0000 },
+	{ "hslash", 6, 0x210F, 0x0000 },
+	{ "smid", 4, 0x2223, 0x0000 },
+	{ "yacy", 4, 0x044F, 0x0000 },
+	{ "zdot", 4, 0x017C, 0x0000 },
+	{ "bigoplus", 8, 0x2A01, 0x0000 },
+	{ "olarr", 5, 0x21BA, 0x0000 },
+	{ "tfr", 3, 0x1D531, 0x0000 },
+	{ "oast", 4, 0x229B, 0x0000 },
+	{ "sum", 3, 0x2211, 0x0000 },
+	{ "Iuml", 4, 0x00CF, 0x0000 },
+	{ "cdot", 4, 0x010B, 0x0000 },
+	{ "plusmn", 6, 0x00B1, 0x0000 },
+	{ "ncy", 3, 0x043D, 0x0000 },
+	{ "DZcy", 4, 0x040F, 0x0000 },
+	{ "SquareSuperset", 14, 0x2290, 0x0000 },
+	{ "sup3", 4, 0x00B3, 0x0000 },
+	{ "piv", 3, 0x03D6, 0x0000 },
+	{ "Implies", 7, 0x21D2, 0x0000 },
+	{ "gtcir", 5, 0x2A7A, 0x0000 },
+	{ "vartheta", 8, 0x03D1, 0x0000 },
+	{ "fjlig", 5, 0x0066, 0x006A },
+	{ "ShortRightArrow", 15, 0x2192, 0x0000 },
+	{ "copysr", 6, 0x2117, 0x0000 },
+	{ "ccirc", 5, 0x0109, 0x0000 },
+	{ "rbrke", 5, 0x298C, 0x0000 },
+	{ "emptyv", 6, 0x2205, 0x0000 },
+	{ "eqsim", 5, 0x2242, 0x0000 },
+	{ "lfr", 3, 0x1D529, 0x0000 },
+	{ "glj", 3, 0x2AA4, 0x0000 },
+	{ "sext", 4, 0x2736, 0x0000 },
+	{ "OpenCurlyDoubleQuote", 20, 0x201C, 0x0000 },
+	{ "xutri", 5, 0x25B3, 0x0000 },
+	{ "aleph", 5, 0x2135, 0x0000 },
+	{ "kfr", 3, 0x1D528, 0x0000 },
+	{ "ulcorn", 6, 0x231C, 0x0000 },
+	{ "Kopf", 4, 0x1D542, 0x0000 },
+	{ "lmidot", 6, 0x0140, 0x0000 },
+	{ "Bernoullis", 10, 0x212C, 0x0000 },
+	{ "Vdashl", 6, 0x2AE6, 0x0000 },
+	{ "notniva", 7, 0x220C, 0x0000 },
+	{ "lbrack", 6, 0x005B, 0x0000 },
+	{ "downharpoonright", 16, 0x21C2, 0x0000 },
+	{ "DDotrahd", 8, 0x2911, 0x0000 },
+	{ "UpEquilibrium", 13, 0x296E, 0x0000 },
+	{ "minusd", 6, 0x2238, 0x0000 },
+	{ "lBarr", 5, 0x290E, 0x0000 },
+	{ "KJcy", 4, 0x040C, 0x0000 },
+	{ "rarrc", 5, 0x2933, 0x0000 },
+	{ "RightVectorBar", 14, 0x2953, 0x0000 },
+	{ "smtes", 5, 0x2AAC, 0xFE00 },
+	{ "midast", 6, 0x002A, 0x0000 },
+	{ "DoubleUpArrow", 13, 0x21D1, 0x0000 },
+	{ "geq", 3, 0x2265, 0x0000 },
+	{ "gnap", 4, 0x2A8A, 0x0000 },
+	{ "Hacek", 5, 0x02C7, 0x0000 },
+	{ "dotplus", 7, 0x2214, 0x0000 },
+	{ "easter", 6, 0x2A6E, 0x0000 },
+	{ "blacklozenge", 12, 0x29EB, 0x0000 },
+	{ "lat", 3, 0x2AAB, 0x0000 },
+	{ "ouml", 4, 0x00F6, 0x0000 },
+	{ "DownLeftTeeVector", 17, 0x295E, 0x0000 },
+	{ "Jukcy", 5, 0x0404, 0x0000 },
+	{ "wedge", 5, 0x2227, 0x0000 },
+	{ "Ucy", 3, 0x0423, 0x0000 },
+	{ "eDDot", 5, 0x2A77, 0x0000 },
+	{ "middot", 6, 0x00B7, 0x0000 },
+	{ "gvnE", 4, 0x2269, 0xFE00 },
+	{ "Prime", 5, 0x2033, 0x0000 },
+	{ "boxuR", 5, 0x2558, 0x0000 },
+	{ "lessdot", 7, 0x22D6, 0x0000 },
+	{ "Cscr", 4, 0x1D49E, 0x0000 },
+	{ "csub", 4, 0x2ACF, 0x0000 },
+	{ "supseteq", 8, 0x2287, 0x0000 },
+	{ "imagline", 8, 0x2110, 0x0000 },
+	{ "rfr", 3, 0x1D52F, 0x0000 },
+	{ "LeftRightVector", 15, 0x294E, 0x0000 },
+	{ "bigodot", 7, 0x2A00, 0x0000 },
+	{ "Lfr", 3, 0x1D50F, 0x0000 },
+	{ "nsc", 3, 0x2281, 0x0000 },
+	{ "rightarrowtail", 14, 0x21A3, 0x0000 },
+	{ "uharl", 5, 0x21BF, 0x0000 },
+	{ "boxVL", 5, 0x2563, 0x0000 },
+	{ "hopf", 4, 0x1D559, 0x0000 },
+	{ "intlarhk", 8, 0x2A17, 0x0000 },
+	{ "rbarr", 5, 0x290D, 0x0000 },
+	{ "Map", 3, 0x2905, 0x0000 },
+	{ "solbar", 6, 0x233F, 0x0000 },
+	{ "gacute", 6, 0x01F5, 0x0000 },
+	{ "larr", 4, 0x2190, 0x0000 },
+	{ "pound", 5, 0x00A3, 0x0000 },
+	{ "times", 5, 0x00D7, 0x0000 },
+	{ "racute", 6, 0x0155, 0x0000 },
+	{ "bumpe", 5, 0x224F, 0x0000 },
+	{ "Rang", 4, 0x27EB, 0x0000 },
+	{ "Poincareplane", 13, 0x210C, 0x0000 },
+	{ "Intersection", 12, 0x22C2, 0x0000 },
+	{ "capcap", 6, 0x2A4B, 0x0000 },
+	{ "cupdot", 6, 0x228D, 0x0000 },
+	{ "dharr", 5, 0x21C2, 0x0000 },
+	{ "gsime", 5, 0x2A8E, 0x0000 },
+	{ "frasl", 5, 0x2044, 0x0000 },
+	{ "succneqq", 8, 0x2AB6, 0x0000 },
+	{ "swArr", 5, 0x21D9, 0x0000 },
+	{ "downarrow", 9, 0x2193, 0x0000 },
+	{ "NotLess", 7, 0x226E, 0x0000 },
+	{ "dtrif", 5, 0x25BE, 0x0000 },
+	{ "bowtie", 6, 0x22C8, 0x0000 },
+	{ "orslope", 7, 0x2A57, 0x0000 },
+	{ "jukcy", 5, 0x0454, 0x0000 },
+	{ "EmptyVerySmallSquare", 20, 0x25AB, 0x0000 },
+	{ "demptyv", 7, 0x29B1, 0x0000 },
+	{ "scy", 3, 0x0441, 0x0000 },
+	{ "NotRightTriangleBar", 19, 0x29D0, 0x0338 },
+	{ "lnE", 3, 0x2268, 0x0000 },
+	{ "chi", 3, 0x03C7, 0x0000 },
+	{ "dzcy", 4, 0x045F, 0x0000 },
+	{ "jfr", 3, 0x1D527, 0x0000 },
+	{ "Sup", 3, 0x22D1, 0x0000 },
+	{ "circledR", 8, 0x00AE, 0x0000 },
+	{ "jcy", 3, 0x0439, 0x0000 },
+	{ "pcy", 3, 0x043F, 0x0000 },
+	{ "el", 2, 0x2A99, 0x0000 },
+	{ "omega", 5, 0x03C9, 0x0000 },
+	{ "boxhU", 5, 0x2568, 0x0000 },
+	{ "hairsp", 6, 0x200A, 0x0000 },
+	{ "epar", 4, 0x22D5, 0x0000 },
+	{ "horbar", 6, 0x2015, 0x0000 },
+	{ "rightharpoonup", 14, 0x21C0, 0x0000 },
+	{ "abreve", 6, 0x0103, 0x0000 },
+	{ "ratail", 6, 0x291A, 0x0000 },
+	{ "vscr", 4, 0x1D4CB, 0x0000 },
+	{ "sharp", 5, 0x266F, 0x0000 },
+	{ "nwArr", 5, 0x21D6, 0x0000 },
+	{ "nap", 3, 0x2249, 0x0000 },
+	{ "ContourIntegral", 15, 0x222E, 0x0000 },
+	{ "lang", 4, 0x27E8, 0x0000 },
+	{ "quot", 4, 0x0022, 0x0000 },
+	{ "xmap", 4, 0x27FC, 0x0000 },
+	{ "nsubE", 5, 0x2AC5, 0x0338 },
+	{ "sqsubset", 8, 0x228F, 0x0000 },
+	{ "els", 3, 0x2A95, 0x0000 },
+	{ "dlcorn", 6, 0x231E, 0x0000 },
+	{ "GJcy", 4, 0x0403, 0x0000 },
+	{ "caron", 5, 0x02C7, 0x0000 },
+	{ "LT", 2, 0x003C, 0x0000 },
+	{ "order", 5, 0x2134, 0x0000 },
+	{ "circeq", 6, 0x2257, 0x0000 },
+	{ "Leftrightarrow", 14, 0x21D4, 0x0000 },
+	{ "ntriangleright", 14, 0x22EB, 0x0000 },
+	{ "gesdot", 6, 0x2A80, 0x0000 },
+	{ "awconint", 8, 0x2233, 0x0000 },
+	{ "ncap", 4, 0x2A43, 0x0000 },
+	{ "QUOT", 4, 0x0022, 0x0000 },
+	{ "searhk", 6, 0x2925, 0x0000 },
+	{ "gnapprox", 8, 0x2A8A, 0x0000 },
+	{ "lEg", 3, 0x2A8B, 0x0000 },
+	{ "mapstodown", 10, 0x21A7, 0x0000 },
+	{ "boxvl", 5, 0x2524, 0x0000 },
+	{ "top", 3, 0x22A4, 0x0000 },
+	{ "rarrpl", 6, 0x2945, 0x0000 },
+	{ "escr", 4, 0x212F, 0x0000 },
+	{ "sqcap", 5, 0x2293, 0x0000 },
+	{ "xoplus", 6, 0x2A01, 0x0000 },
+	{ "Scirc", 5, 0x015C, 0x0000 },
+	{ "Hcirc", 5, 0x0124, 0x0000 },
+	{ "sup", 3, 0x2283, 0x0000 },
+	{ "zwj", 3, 0x200D, 0x0000 },
+	{ "gtlPar", 6, 0x2995, 0x0000 },
+	{ "otimes", 6, 0x2297, 0x0000 },
+	{ "llcorner", 8, 0x231E, 0x0000 },
+	{ "spadesuit", 9, 0x2660, 0x0000 },
+	{ "DownRightVector", 15, 0x21C1, 0x0000 },
+	{ "lbbrk", 5, 0x2772, 0x0000 },
+	{ "yen", 3, 0x00A5, 0x0000 },
+	{ "Mu", 2, 0x039C, 0x0000 },
+	{ "PartialD", 8, 0x2202, 0x0000 },
+	{ "itilde", 6, 0x0129, 0x0000 },
+	{ "dwangle", 7, 0x29A6, 0x0000 },
+	{ "andd", 4, 0x2A5C, 0x0000 },
+	{ "rharul", 6, 0x296C, 0x0000 },
+	{ "yacute", 6, 0x00FD, 0x0000 },
+	{ "Psi", 3, 0x03A8, 0x0000 },
+	{ "nisd", 4, 0x22FA, 0x0000 },
+	{ "mscr", 4, 0x1D4C2, 0x0000 },
+	{ "NotGreaterGreater", 17, 0x226B, 0x0338 },
+	{ "LeftFloor", 9, 0x230A, 0x0000 },
+	{ "Yfr", 3, 0x1D51C, 0x0000 },
+	{ "nhArr", 5, 0x21CE, 0x0000 },
+	{ "Chi", 3, 0x03A7, 0x0000 },
+	{ "TRADE", 5, 0x2122, 0x0000 },
+	{ "Jscr", 4, 0x1D4A5, 0x0000 },
+	{ "apid", 4, 0x224B, 0x0000 },
+	{ "isin", 4, 0x2208, 0x0000 },
+	{ "boxDL", 5, 0x2557, 0x0000 },
+	{ "rtrie", 5, 0x22B5, 0x0000 },
+	{ "leftrightsquigarrow", 19, 0x21AD, 0x0000 },
+	{ "umacr", 5, 0x016B, 0x0000 },
+	{ "gesdotol", 8, 0x2A84, 0x0000 },
+	{ "mumap", 5, 0x22B8, 0x0000 },
+	{ "DoubleLeftArrow", 15, 0x21D0, 0x0000 },
+	{ "boxVR", 5, 0x2560, 0x0000 },
+	{ "Lcedil", 6, 0x013B, 0x0000 },
+	{ "propto", 6, 0x221D, 0x0000 },
+	{ "cudarrl", 7, 0x2938, 0x0000 },
+	{ "eparsl", 6, 0x29E3, 0x0000 },
+	{ "prnsim", 6, 0x22E8, 0x0000 },
+	{ "subne", 5, 0x228A, 0x0000 },
+	{ "lesssim", 7, 0x2272, 0x0000 },
+	{ "NotSuperset", 11, 0x2283, 0x20D2 },
+	{ "ge", 2, 0x2265, 0x0000 },
+	{ "therefore", 9, 0x2234, 0x0000 },
+	{ "lg", 2, 0x2276, 0x0000 },
+	{ "boxdL", 5, 0x2555, 0x0000 },
+	{ "ratio", 5, 0x2236, 0x0000 },
+	{ "lrm", 3, 0x200E, 0x0000 },
+	{ "nleftrightarrow", 15, 0x21AE, 0x0000 },
+	{ "RightTeeVector", 14, 0x295B, 0x0000 },
+	{ "notnivb", 7, 0x22FE, 0x0000 },
+	{ "LongRightArrow", 14, 0x27F6, 0x0000 },
+	{ "boxDr", 5, 0x2553, 0x0000 },
+	{ "Wcirc", 5, 0x0174, 0x0000 },
+	{ "NotElement", 10, 0x2209, 0x0000 },
+	{ "natural", 7, 0x266E, 0x0000 },
+	{ "LeftDownVectorBar", 17, 0x2959, 0x0000 },
+	{ "xharr", 5, 0x27F7, 0x0000 },
+	{ "DiacriticalDot", 14, 0x02D9, 0x0000 },
+	{ "iexcl", 5, 0x00A1, 0x0000 },
+	{ "Gg", 2, 0x22D9, 0x0000 },
+	{ "nspar", 5, 0x2226, 0x0000 },
+	{ "erarr", 5, 0x2971, 0x0000 },
+	{ "Cconint", 7, 0x2230, 0x0000 },
+	{ "ApplyFunction", 13, 0x2061, 0x0000 },
+	{ "rtri", 4, 0x25B9, 0x0000 },
+	{ "af", 2, 0x2061, 0x0000 },
+	{ "Lt", 2, 0x226A, 0x0000 },
+	{ "NestedLessLess", 14, 0x226A, 0x0000 },
+	{ "nequiv", 6, 0x2262, 0x0000 },
+	{ "diamondsuit", 11, 0x2666, 0x0000 },
+	{ "DiacriticalDoubleAcute", 22, 0x02DD, 0x0000 },
+	{ "notinvc", 7, 0x22F6, 0x0000 },
+	{ "lsquo", 5, 0x2018, 0x0000 },
+	{ "Bscr", 4, 0x212C, 0x0000 },
+	{ "bnequiv", 7, 0x2261, 0x20E5 },
+	{ "Omacr", 5, 0x014C, 0x0000 },
+	{ "nlarr", 5, 0x219A, 0x0000 },
+	{ "downdownarrows", 14, 0x21CA, 0x0000 },
+	{ "searr", 5, 0x2198, 0x0000 },
+	{ "langle", 6, 0x27E8, 0x0000 },
+	{ "duarr", 5, 0x21F5, 0x0000 },
+	{ "lbrace", 6, 0x007B, 0x0000 },
+	{ "Aring", 5, 0x00C5, 0x0000 },
+	{ "radic", 5, 0x221A, 0x0000 },
+	{ "frac38", 6, 0x215C, 0x0000 },
+	{ "wreath", 6, 0x2240, 0x0000 },
+	{ "DownRightTeeVector", 18, 0x295F, 0x0000 },
+	{ "gtrarr", 6, 0x2978, 0x0000 },
+	{ "lambda", 6, 0x03BB, 0x0000 },
+	{ "Ecy", 3, 0x042D, 0x0000 },
+	{ "ufisht", 6, 0x297E, 0x0000 },
+	{ "forkv", 5, 0x2AD9, 0x0000 },
+	{ "dfr", 3, 0x1D521, 0x0000 },
+	{ "doteqdot", 8, 0x2251, 0x0000 },
+	{ "cupbrcap", 8, 0x2A48, 0x0000 },
+	{ "ifr", 3, 0x1D526, 0x0000 },
+	{ "lrarr", 5, 0x21C6, 0x0000 },
+	{ "zfr", 3, 0x1D537, 0x0000 },
+	{ "commat", 6, 0x0040, 0x0000 },
+	{ "xfr", 3, 0x1D535, 0x0000 },
+	{ "npolint", 7, 0x2A14, 0x0000 },
+	{ "gamma", 5, 0x03B3, 0x0000 },
+	{ "lesges", 6, 0x2A93, 0x0000 },
+	{ "Otilde", 6, 0x00D5, 0x0000 },
+	{ "cups", 4, 0x222A, 0xFE00 },
+	{ "sdotb", 5, 0x22A1, 0x0000 },
+	{ "epsilon", 7, 0x03B5, 0x0000 },
+	{ "ogt", 3, 0x29C1, 0x0000 },
+	{ "prcue", 5, 0x227C, 0x0000 },
+	{ "sc", 2, 0x227B, 0x0000 },
+	{ "ncedil", 6, 0x0146, 0x0000 },
+	{ "Icy", 3, 0x0418, 0x0000 },
+	{ "compfn", 6, 0x2218, 0x0000 },
+	{ "bull", 4, 0x2022, 0x0000 },
+	{ "rang", 4, 0x27E9, 0x0000 },
+	{ "minusdu", 7, 0x2A2A, 0x0000 },
+	{ "ocy", 3, 0x043E, 0x0000 },
+	{ "upuparrows", 10, 0x21C8, 0x0000 },
+	{ "omid", 4, 0x29B6, 0x0000 },
+	{ "nltri", 5, 0x22EA, 0x0000 },
+	{ "nlsim", 5, 0x2274, 0x0000 },
+	{ "Wfr", 3, 0x1D51A, 0x0000 },
+	{ "amacr", 5, 0x0101, 0x0000 },
+	{ "udblac", 6, 0x0171, 0x0000 },
+	{ "bsemi", 5, 0x204F, 0x0000 },
+	{ "gneqq", 5, 0x2269, 0x0000 },
+	{ "hookleftarrow", 13, 0x21A9, 0x0000 },
+	{ "isinv", 5, 0x2208, 0x0000 },
+	{ "ecirc", 5, 0x00EA, 0x0000 },
+	{ "Ifr", 3, 0x2111, 0x0000 },
+	{ "bigcup", 6, 0x22C3, 0x0000 },
+	{ "nvdash", 6, 0x22AC, 0x0000 },
+	{ "asympeq", 7, 0x224D, 0x0000 },
+	{ "utri", 4, 0x25B5, 0x0000 },
+	{ "Assign", 6, 0x2254, 0x0000 },
+	{ "dash", 4, 0x2010, 0x0000 },
+	{ "Wscr", 4, 0x1D4B2, 0x0000 },
+	{ "LeftArrowBar", 12, 0x21E4, 0x0000 },
+	{ "zigrarr", 7, 0x21DD, 0x0000 },
+	{ "Oacute", 6, 0x00D3, 0x0000 },
+	{ "shcy", 4, 0x0448, 0x0000 },
+	{ "SquareUnion", 11, 0x2294, 0x0000 },
+	{ "lstrok", 6, 0x0142, 0x0000 },
+	{ "LeftUpVector", 12, 0x21BF, 0x0000 },
+	{ "ccaps", 5, 0x2A4D, 0x0000 },
+	{ "HumpDownHump", 12, 0x224E, 0x0000 },
+	{ "nrtrie", 6, 0x22ED, 0x0000 },
+	{ "DownRightVectorBar", 18, 0x2957, 0x0000 },
+	{ "loz", 3, 0x25CA, 0x0000 },
+	{ "Zfr", 3, 0x2128, 0x0000 },
+	{ "lArr", 4, 0x21D0, 0x0000 },
+	{ "cuwed", 5, 0x22CF, 0x0000 },
+	{ "excl", 4, 0x0021, 0x0000 },
+	{ "oline", 5, 0x203E, 0x0000 },
+	{ "intprod", 7, 0x2A3C, 0x0000 },
+	{ "plustwo", 7, 0x2A27, 0x0000 },
+	{ "NotTildeTilde", 13, 0x2249, 0x0000 },
+	{ "isindot", 7, 0x22F5, 0x0000 },
+	{ "sup2", 4, 0x00B2, 0x0000 },
+	{ "backprime", 9, 0x2035, 0x0000 },
+	{ "boxDl", 5, 0x2556, 0x0000 },
+	{ "Cacute", 6, 0x0106, 0x0000 },
+	{ "conint", 6, 0x222E, 0x0000 },
+	{ "rtimes", 6, 0x22CA, 0x0000 },
+	{ "bcy", 3, 0x0431, 0x0000 },
+	{ "shchcy", 6, 0x0449, 0x0000 },
+	{ "boxUr", 5, 0x2559, 0x0000 },
+	{ "boxvh", 5, 0x253C, 0x0000 },
+	{ "copy", 4, 0x00A9, 0x0000 },
+	{ "Ncaron", 6, 0x0147, 0x0000 },
+	{ "Uparrow", 7, 0x21D1, 0x0000 },
+	{ "tcaron", 6, 0x0165, 0x0000 },
+	{ "laemptyv", 8, 0x29B4, 0x0000 },
+	{ "simrarr", 7, 0x2972, 0x0000 },
+	{ "rdsh", 4, 0x21B3, 0x0000 },
+	{ "iiiint", 6, 0x2A0C, 0x0000 },
+	{ "rightsquigarrow", 15, 0x219D, 0x0000 },
+	{ "CircleDot", 9, 0x2299, 0x0000 },
+	{ "Nscr", 4, 0x1D4A9, 0x0000 },
+	{ "shortmid", 8, 0x2223, 0x0000 },
+	{ "khcy", 4, 0x0445, 0x0000 },
+	{ "DJcy", 4, 0x0402, 0x0000 },
+	{ "lescc", 5, 0x2AA8, 0x0000 },
+	{ "Wedge", 5, 0x22C0, 0x0000 },
+	{ "Aopf", 4, 0x1D538, 0x0000 },
+	{ "rarrlp", 6, 0x21AC, 0x0000 },
+	{ "rarrbfs", 7, 0x2920, 0x0000 },
+	{ "supne", 5, 0x228B, 0x0000 },
+	{ "bigtriangledown", 15, 0x25BD, 0x0000 },
+	{ "LeftTeeArrow", 12, 0x21A4, 0x0000 },
+	{ "atilde", 6, 0x00E3, 0x0000 },
+	{ "supplus", 7, 0x2AC0, 0x0000 },
+	{ "Mellintrf", 9, 0x2133, 0x0000 },
+	{ "sqsubseteq", 10, 0x2291, 0x0000 },
+	{ "lcaron", 6, 0x013E, 0x0000 },
+	{ "Kcy", 3, 0x041A, 0x0000 },
+	{ "CapitalDifferentialD", 20, 0x2145, 0x0000 },
+	{ "rlhar", 5, 0x21CC, 0x0000 },
+	{ "dopf", 4, 0x1D555, 0x0000 },
+	{ "asymp", 5, 0x2248, 0x0000 },
+	{ "sbquo", 5, 0x201A, 0x0000 },
+	{ "Jcirc", 5, 0x0134, 0x0000 },
+	{ "circledcirc", 11, 0x229A, 0x0000 },
+	{ "emsp14", 6, 0x2005, 0x0000 },
+	{ "LessGreater", 11, 0x2276, 0x0000 },
+	{ "cirmid", 6, 0x2AEF, 0x0000 },
+	{ "sub", 3, 0x2282, 0x0000 },
+	{ "lozenge", 7, 0x25CA, 0x0000 },
+	{ "bsolhsub", 8, 0x27C8, 0x0000 },
+	{ "HumpEqual", 9, 0x224F, 0x0000 },
+	{ "lrtri", 5, 0x22BF, 0x0000 },
+	{ "ldquor", 6, 0x201E, 0x0000 },
+	{ "lneq", 4, 0x2A87, 0x0000 },
+	{ "notindot", 8, 0x22F5, 0x0338 },
+	{ "llhard", 6, 0x296B, 0x0000 },
+	{ "natur", 5, 0x266E, 0x0000 },
+	{ "trade", 5, 0x2122, 0x0000 },
+	{ "nrightarrow", 11, 0x219B, 0x0000 },
+	{ "xsqcup", 6, 0x2A06, 0x0000 },
+	{ "RoundImplies", 12, 0x2970, 0x0000 },
+	{ "profline", 8, 0x2312, 0x0000 },
+	{ "NotPrecedes", 11, 0x2280, 0x0000 },
+	{ "ges", 3, 0x2A7E, 0x0000 },
+	{ "DiacriticalTilde", 16, 0x02DC, 0x0000 },
+	{ "nabla", 5, 0x2207, 0x0000 },
+	{ "Ouml", 4, 0x00D6, 0x0000 },
+	{ "Ubreve", 6, 0x016C, 0x0000 },
+	{ "sdot", 4, 0x22C5, 0x0000 },
+	{ "subnE", 5, 0x2ACB, 0x0000 },
+	{ "dArr", 4, 0x21D3, 0x0000 },
+	{ "ll", 2, 0x226A, 0x0000 },
+	{ "vDash", 5, 0x22A8, 0x0000 },
+	{ "Lambda", 6, 0x039B, 0x0000 },
+	{ "supe", 4, 0x2287, 0x0000 },
+	{ "Gt", 2, 0x226B, 0x0000 },
+	{ "nedot", 5, 0x2250, 0x0338 },
+	{ "DownLeftVectorBar", 17, 0x2956, 0x0000 },
+	{ "Cedilla", 7, 0x00B8, 0x0000 },
+	{ "CloseCurlyQuote", 15, 0x2019, 0x0000 },
+	{ "fopf", 4, 0x1D557, 0x0000 },
+	{ "NegativeThinSpace", 17, 0x200B, 0x0000 },
+	{ "andv", 4, 0x2A5A, 0x0000 },
+	{ "ctdot", 5, 0x22EF, 0x0000 },
+	{ "Fcy", 3, 0x0424, 0x0000 },
+	{ "hyphen", 6, 0x2010, 0x0000 },
+	{ "bumpE", 5, 0x2AAE, 0x0000 },
+	{ "NegativeMediumSpace", 19, 0x200B, 0x0000 },
+	{ "tilde", 5, 0x02DC, 0x0000 },
+	{ "lpar", 4, 0x0028, 0x0000 },
+	{ "ngE", 3, 0x2267, 0x0338 },
+	{ "Mcy", 3, 0x041C, 0x0000 },
+	{ "Ccaron", 6, 0x010C, 0x0000 },
+	{ "cent", 4, 0x00A2, 0x0000 },
+	{ "lobrk", 5, 0x27E6, 0x0000 },
+	{ "DoubleUpDownArrow", 17, 0x21D5, 0x0000 },
+	{ "approx", 6, 0x2248, 0x0000 },
+	{ "simlE", 5, 0x2A9F, 0x0000 },
+	{ "Nacute", 6, 0x0143, 0x0000 },
+	{ "filig", 5, 0xFB01, 0x0000 },
+	{ "curlyvee", 8, 0x22CE, 0x0000 },
+	{ "lsimg", 5, 0x2A8F, 0x0000 },
+	{ "bkarow", 6, 0x290D, 0x0000 },
+	{ "Xopf", 4, 0x1D54F, 0x0000 },
+	{ "NotVerticalBar", 14, 0x2224, 0x0000 },
+	{ "minusb", 6, 0x229F, 0x0000 },
+	{ "slarr", 5, 0x2190, 0x0000 },
+	{ "oplus", 5, 0x2295, 0x0000 },
+	{ "spar", 4, 0x2225, 0x0000 },
+	{ "eplus", 5, 0x2A71, 0x0000 },
+	{ "toea", 4, 0x2928, 0x0000 },
+	{ "rsh", 3, 0x21B1, 0x0000 },
+	{ "nsupset", 7, 0x2283, 0x20D2 },
+	{ "zwnj", 4, 0x200C, 0x0000 },
+	{ "colon", 5, 0x003A, 0x0000 },
+	{ "loarr", 5, 0x21FD, 0x0000 },
+	{ "lvertneqq", 9, 0x2268, 0xFE00 },
+	{ "gesles", 6, 0x2A94, 0x0000 },
+	{ "ReverseUpEquilibrium", 20, 0x296F, 0x0000 },
+	{ "xdtri", 5, 0x25BD, 0x0000 },
+	{ "ii", 2, 0x2148, 0x0000 },
+	{ "Element", 7, 0x2208, 0x0000 },
+	{ "tscr", 4, 0x1D4C9, 0x0000 },
+	{ "ngtr", 4, 0x226F, 0x0000 },
+	{ "Agrave", 6, 0x00C0, 0x0000 },
+	{ "rbrkslu", 7, 0x2990, 0x0000 },
+	{ "SquareIntersection", 18, 0x2293, 0x0000 },
+	{ "ltlarr", 6, 0x2976, 0x0000 },
+	{ "frac56", 6, 0x215A, 0x0000 },
+	{ "cir", 3, 0x25CB, 0x0000 },
+	{ "frac15", 6, 0x2155, 0x0000 },
+	{ "plusdu", 6, 0x2A25, 0x0000 },
+	{ "ZHcy", 4, 0x0416, 0x0000 },
+	{ "NotSquareSubset", 15, 0x228F, 0x0338 },
+	{ "tstrok", 6, 0x0167, 0x0000 },
+	{ "Ffr", 3, 0x1D509, 0x0000 },
+	{ "EmptySmallSquare", 16, 0x25FB, 0x0000 },
+	{ "wp", 2, 0x2118, 0x0000 },
+	{ "SHCHcy", 6, 0x0429, 0x0000 },
+	{ "Iukcy", 5, 0x0406, 0x0000 },
+	{ "varr", 4, 0x2195, 0x0000 },
+	{ "gEl", 3, 0x2A8C, 0x0000 },
+	{ "duhar", 5, 0x296F, 0x0000 },
+	{ "infintie", 8, 0x29DD, 0x0000 },
+	{ "apos", 4, 0x0027, 0x0000 },
+	{ "angrtvbd", 8, 0x299D, 0x0000 },
+	{ "ggg", 3, 0x22D9, 0x0000 },
+	{ "realine", 7, 0x211B, 0x0000 },
+	{ "NotLessEqual", 12, 0x2270, 0x0000 },
+	{ "ap", 2, 0x2248, 0x0000 },
+	{ "uscr", 4, 0x1D4CA, 0x0000 },
+	{ "trisb", 5, 0x29CD, 0x0000 },
+	{ "topbot", 6, 0x2336, 0x0000 },
+	{ "lessgtr", 7, 0x2276, 0x0000 },
+	{ "OverBar", 7, 0x203E, 0x0000 },
+	{ "nsup", 4, 0x2285, 0x0000 },
+	{ "iquest", 6, 0x00BF, 0x0000 },
+	{ "or", 2, 0x2228, 0x0000 },
+	{ "acd", 3, 0x223F, 0x0000 },
+	{ "lHar", 4, 0x2962, 0x0000 },
+	{ "precneqq", 8, 0x2AB5, 0x0000 },
+	{ "gesl", 4, 0x22DB, 0xFE00 },
+	{ "roang", 5, 0x27ED, 0x0000 },
+	{ "cwconint", 8, 0x2232, 0x0000 },
+	{ "Gamma", 5, 0x0393, 0x0000 },
+	{ "para", 4, 0x00B6, 0x0000 },
+	{ "varphi", 6, 0x03D5, 0x0000 },
+	{ "lsim", 4, 0x2272, 0x0000 },
+	{ "Proportion", 10, 0x2237, 0x0000 },
+	{ "Ograve", 6, 0x00D2, 0x0000 },
+	{ "ltrif", 5, 0x25C2, 0x0000 },
+	{ "rsqb", 4, 0x005D, 0x0000 },
+	{ "origof", 6, 0x22B6, 0x0000 },
+	{ "lAtail", 6, 0x291B, 0x0000 },
+	{ "SubsetEqual", 11, 0x2286, 0x0000 },
+	{ "Ccirc", 5, 0x0108, 0x0000 },
+	{ "supmult", 7, 0x2AC2, 0x0000 },
+	{ "YUcy", 4, 0x042E, 0x0000 },
+	{ "luruhar", 7, 0x2966, 0x0000 },
+	{ "DoubleLongLeftRightArrow", 24, 0x27FA, 0x0000 },
+	{ "Uacute", 6, 0x00DA, 0x0000 },
+	{ "Longleftarrow", 13, 0x27F8, 0x0000 },
+	{ "Lstrok", 6, 0x0141, 0x0000 },
+	{ "oS", 2, 0x24C8, 0x0000 },
+	{ "pr", 2, 0x227A, 0x0000 },
+	{ "Ucirc", 5, 0x00DB, 0x0000 },
+	{ "leftthreetimes", 14, 0x22CB, 0x0000 },
+	{ "straightphi", 11, 0x03D5, 0x0000 },
+	{ "efDot", 5, 0x2252, 0x0000 },
+	{ "loplus", 6, 0x2A2D, 0x0000 },
+	{ "in", 2, 0x2208, 0x0000 },
+	{ "nwarrow", 7, 0x2196, 0x0000 },
+	{ "orv", 3, 0x2A5B, 0x0000 },
+	{ "kcedil", 6, 0x0137, 0x0000 },
+	{ "phone", 5, 0x260E, 0x0000 },
+	{ "hbar", 4, 0x210F, 0x0000 },
+	{ "ocirc", 5, 0x00F4, 0x0000 },
+	{ "lmoustache", 10, 0x23B0, 0x0000 },
+	{ "leg", 3, 0x22DA, 0x0000 },
+	{ "Fopf", 4, 0x1D53D, 0x0000 },
+	{ "Rcaron", 6, 0x0158, 0x0000 },
+	{ "nLeftrightarrow", 15, 0x21CE, 0x0000 },
+	{ "boxbox", 6, 0x29C9, 0x0000 },
+	{ "les", 3, 0x2A7D, 0x0000 },
+	{ "angsph", 6, 0x2222, 0x0000 },
+	{ "otilde", 6, 0x00F5, 0x0000 },
+	{ "Atilde", 6, 0x00C3, 0x0000 },
+	{ "Lcaron", 6, 0x013D, 0x0000 },
+	{ "iota", 4, 0x03B9, 0x0000 },
+	{ "iecy", 4, 0x0435, 0x0000 },
+	{ "boxh", 4, 0x2500, 0x0000 },
+	{ "YIcy", 4, 0x0407, 0x0000 },
+	{ "Gcedil", 6, 0x0122, 0x0000 },
+	{ "succcurlyeq", 11, 0x227D, 0x0000 },
+	{ "cirscir", 7, 0x29C2, 0x0000 },
+	{ "ycirc", 5, 0x0177, 0x0000 },
+	{ "ClockwiseContourIntegral", 24, 0x2232, 0x0000 },
+	{ "sstarf", 6, 0x22C6, 0x0000 },
+	{ "mnplus", 6, 0x2213, 0x0000 },
+	{ "cire", 4, 0x2257, 0x0000 },
+	{ "apE", 3, 0x2A70, 0x0000 },
+	{ "rbrack", 6, 0x005D, 0x0000 },
+	{ "Qfr", 3, 0x1D514, 0x0000 },
+	{ "tbrk", 4, 0x23B4, 0x0000 },
+	{ "Racute", 6, 0x0154, 0x0000 },
+	{ "DScy", 4, 0x0405, 0x0000 },
+	{ "rpargt", 6, 0x2994, 0x0000 },
+	{ "sqsupset", 8, 0x2290, 0x0000 },
+	{ "Efr", 3, 0x1D508, 0x0000 },
+	{ "curlyeqprec", 11, 0x22DE, 0x0000 },
+	{ "ETH", 3, 0x00D0, 0x0000 },
+	{ "iscr", 4, 0x1D4BE, 0x0000 },
+	{ "FilledSmallSquare", 17, 0x25FC, 0x0000 },
+	{ "rarrw", 5, 0x219D, 0x0000 },
+	{ "LessLess", 8, 0x2AA1, 0x0000 },
+	{ "Exists", 6, 0x2203, 0x0000 },
+	{ "bsol", 4, 0x005C, 0x0000 },
+	{ "sigmaf", 6, 0x03C2, 0x0000 },
+	{ "LeftDoubleBracket", 17, 0x27E6, 0x0000 },
+	{ "nge", 3, 0x2271, 0x0000 },
+	{ "larrb", 5, 0x21E4, 0x0000 },
+	{ "pluse", 5, 0x2A72, 0x0000 },
+	{ "jcirc", 5, 0x0135, 0x0000 },
+	{ "fllig", 5, 0xFB02, 0x0000 },
+	{ "larrtl", 6, 0x21A2, 0x0000 },
+	{ "planck", 6, 0x210F, 0x0000 },
+	{ "leftharpoonup", 13, 0x21BC, 0x0000 },
+	{ "Ecaron", 6, 0x011A, 0x0000 },
+	{ "Colon", 5, 0x2237, 0x0000 },
+	{ "hArr", 4, 0x21D4, 0x0000 },
+	{ "nscr", 4, 0x1D4C3, 0x0000 },
+	{ "Yacute", 6, 0x00DD, 0x0000 },
+	{ "subplus", 7, 0x2ABF, 0x0000 },
+	{ "utrif", 5, 0x25B4, 0x0000 },
+	{ "setmn", 5, 0x2216, 0x0000 },
+	{ "bigstar", 7, 0x2605, 0x0000 },
+	{ "OverParenthesis", 15, 0x23DC, 0x0000 },
+	{ "supE", 4, 0x2AC6, 0x0000 },
+	{ "imped", 5, 0x01B5, 0x0000 },
+	{ "Lsh", 3, 0x21B0, 0x0000 },
+	{ "Gscr", 4, 0x1D4A2, 0x0000 },
+	{ "crarr", 5, 0x21B5, 0x0000 },
+	{ "REG", 3, 0x00AE, 0x0000 },
+	{ "centerdot", 9, 0x00B7, 0x0000 },
+	{ "Ofr", 3, 0x1D512, 0x0000 },
+	{ "Oopf", 4, 0x1D546, 0x0000 },
+	{ "vsupnE", 6, 0x2ACC, 0xFE00 },
+	{ "Fouriertrf", 10, 0x2131, 0x0000 },
+	{ "blacktriangle", 13, 0x25B4, 0x0000 },
+	{ "Bopf", 4, 0x1D539, 0x0000 },
+	{ "emptyset", 8, 0x2205, 0x0000 },
+	{ "ring", 4, 0x02DA, 0x0000 },
+	{ "subset", 6, 0x2282, 0x0000 },
+	{ "Sscr", 4, 0x1D4AE, 0x0000 },
+	{ "subrarr", 7, 0x2979, 0x0000 },
+	{ "NotTildeFullEqual", 17, 0x2247, 0x0000 },
+	{ "eng", 3, 0x014B, 0x0000 },
+	{ "gtrless", 7, 0x2277, 0x0000 },
+	{ "scsim", 5, 0x227F, 0x0000 },
+	{ "percnt", 6, 0x0025, 0x0000 },
+	{ "esim", 4, 0x2242, 0x0000 },
+	{ "vartriangleleft", 15, 0x22B2, 0x0000 },
+	{ "angle", 5, 0x2220, 0x0000 },
+	{ "efr", 3, 0x1D522, 0x0000 },
+	{ "Ubrcy", 5, 0x040E, 0x0000 },
+	{ "rHar", 4, 0x2964, 0x0000 },
+	{ "rmoustache", 10, 0x23B1, 0x0000 },
+	{ "Ncedil", 6, 0x0145, 0x0000 },
+	{ "gbreve", 6, 0x011F, 0x0000 },
+	{ "larrbfs", 7, 0x291F, 0x0000 },
+	{ "exist", 5, 0x2203, 0x0000 },
+	{ "Bumpeq", 6, 0x224E, 0x0000 },
+	{ "seswar", 6, 0x2929, 0x0000 },
+	{ "Odblac", 6, 0x0150, 0x0000 },
+	{ "longmapsto", 10, 0x27FC, 0x0000 },
+	{ "straightepsilon", 15, 0x03F5, 0x0000 },
+	{ "profsurf", 8, 0x2313, 0x0000 },
+	{ "NotLessGreater", 14, 0x2278, 0x0000 },
+	{ "CupCap", 6, 0x224D, 0x0000 },
+	{ "NotEqualTilde", 13, 0x2242, 0x0338 },
+	{ "rsaquo", 6, 0x203A, 0x0000 },
+	{ "lotimes", 7, 0x2A34, 0x0000 },
+	{ "urtri", 5, 0x25F9, 0x0000 },
+	{ "xodot", 5, 0x2A00, 0x0000 },
+	{ "Ocy", 3, 0x041E, 0x0000 },
+	{ "acute", 5, 0x00B4, 0x0000 },
+	{ "Yuml", 4, 0x0178, 0x0000 },
+	{ "gE", 2, 0x2267, 0x0000 },
+	{ "longrightarrow", 14, 0x27F6, 0x0000 },
+	{ "barwed", 6, 0x2305, 0x0000 },
+	{ "nvrtrie", 7, 0x22B5, 0x20D2 },
+	{ "lneqq", 5, 0x2268, 0x0000 },
+	{ "Uscr", 4, 0x1D4B0, 0x0000 },
+	{ "looparrowright", 14, 0x21AC, 0x0000 },
+	{ "Alpha", 5, 0x0391, 0x0000 },
+	{ "angmsdad", 8, 0x29AB, 0x0000 },
+	{ "UnderBrace", 10, 0x23DF, 0x0000 },
+	{ "Nu", 2, 0x039D, 0x0000 },
+	{ "xuplus", 6, 0x2A04, 0x0000 },
+	{ "nbump", 5, 0x224E, 0x0338 },
+	{ "models", 6, 0x22A7, 0x0000 },
+	{ "sqsube", 6, 0x2291, 0x0000 },
+	{ "circlearrowright", 16, 0x21BB, 0x0000 },
+	{ "Hstrok", 6, 0x0126, 0x0000 },
+	{ "LowerRightArrow", 15, 0x2198, 0x0000 },
+	{ "zacute", 6, 0x017A, 0x0000 },
+	{ "ubrcy", 5, 0x045E, 0x0000 },
+	{ "boxvL", 5, 0x2561, 0x0000 },
+	{ "zcy", 3, 0x0437, 0x0000 },
+	{ "lesg", 4, 0x22DA, 0xFE00 },
+	{ "afr", 3, 0x1D51E, 0x0000 },
+	{ "die", 3, 0x00A8, 0x0000 },
+	{ "angmsdaf", 8, 0x29AD, 0x0000 },
+	{ "rfloor", 6, 0x230B, 0x0000 },
+	{ "Wopf", 4, 0x1D54E, 0x0000 },
+	{ "DoubleRightArrow", 16, 0x21D2, 0x0000 },
+	{ "xcup", 4, 0x22C3, 0x0000 },
+	{ "cup", 3, 0x222A, 0x0000 },
+	{ "RightUpVector", 13, 0x21BE, 0x0000 },
+	{ "boxV", 4, 0x2551, 0x0000 },
+	{ "xopf", 4, 0x1D569, 0x0000 },
+	{ "Gbreve", 6, 0x011E, 0x0000 },
+	{ "dlcrop", 6, 0x230D, 0x0000 },
+	{ "numsp", 5, 0x2007, 0x0000 },
+	{ "bsime", 5, 0x22CD, 0x0000 },
+	{ "sung", 4, 0x266A, 0x0000 },
+	{ "blacktriangleleft", 17, 0x25C2, 0x0000 },
+	{ "forall", 6, 0x2200, 0x0000 },
+	{ "PrecedesEqual", 13, 0x2AAF, 0x0000 },
+	{ "ccupssm", 7, 0x2A50, 0x0000 },
+	{ "simg", 4, 0x2A9E, 0x0000 },
+	{ "scpolint", 8, 0x2A13, 0x0000 },
+	{ "Precedes", 8, 0x227A, 0x0000 },
+	{ "uacute", 6, 0x00FA, 0x0000 },
+	{ "topcir", 6, 0x2AF1, 0x0000 },
+	{ "gimel", 5, 0x2137, 0x0000 },
+	{ "SOFTcy", 6, 0x042C, 0x0000 },
+	{ "lceil", 5, 0x2308, 0x0000 },
+	{ "RightTeeArrow", 13, 0x21A6, 0x0000 },
+	{ "nleq", 4, 0x2270, 0x0000 },
+	{ "SquareSubsetEqual", 17, 0x2291, 0x0000 },
+	{ "Because", 7, 0x2235, 0x0000 },
+	{ "lmoust", 6, 0x23B0, 0x0000 },
+	{ "nLtv", 4, 0x226A, 0x0338 },
+	{ "ecolon", 6, 0x2255, 0x0000 },
+	{ "RightUpVectorBar", 16, 0x2954, 0x0000 },
+	{ "longleftrightarrow", 18, 0x27F7, 0x0000 },
+	{ "frac58", 6, 0x215D, 0x0000 },
+	{ "gescc", 5, 0x2AA9, 0x0000 },
+	{ "euml", 4, 0x00EB, 0x0000 },
+	{ "Colone", 6, 0x2A74, 0x0000 },
+	{ "GreaterSlantEqual", 17, 0x2A7E, 0x0000 },
+	{ "supdot", 6, 0x2ABE, 0x0000 },
+	{ "nwarr", 5, 0x2196, 0x0000 },
+	{ "Fscr", 4, 0x2131, 0x0000 },
+	{ "Aogon", 5, 0x0104, 0x0000 },
+	{ "hamilt", 6, 0x210B, 0x0000 },
+	{ "strns", 5, 0x00AF, 0x0000 },
+	{ "Umacr", 5, 0x016A, 0x0000 },
+	{ "frac23", 6, 0x2154, 0x0000 },
+	{ "plusacir", 8, 0x2A23, 0x0000 },
+	{ "leftarrow", 9, 0x2190, 0x0000 },
+	{ "Esim", 4, 0x2A73, 0x0000 },
+	{ "gtdot", 5, 0x22D7, 0x0000 },
+	{ "NotLeftTriangleBar", 18, 0x29CF, 0x0338 },
+	{ "mldr", 4, 0x2026, 0x0000 },
+	{ "robrk", 5, 0x27E7, 0x0000 },
+	{ "rharu", 5, 0x21C0, 0x0000 },
+	{ "TSHcy", 5, 0x040B, 0x0000 },
+	{ "ThickSpace", 10, 0x205F, 0x200A },
+	{ "blacktriangleright", 18, 0x25B8, 0x0000 },
+	{ "trianglerighteq", 15, 0x22B5, 0x0000 },
+	{ "nesear", 6, 0x2928, 0x0000 },
+	{ "eg", 2, 0x2A9A, 0x0000 },
+	{ "Star", 4, 0x22C6, 0x0000 },
+	{ "sqcups", 6, 0x2294, 0xFE00 },
+	{ "lbrksld", 7, 0x298F, 0x0000 },
+	{ "PrecedesTilde", 13, 0x227E, 0x0000 },
+	{ "hearts", 6, 0x2665, 0x0000 },
+	{ "NotSquareSubsetEqual", 20, 0x22E2, 0x0000 },
+	{ "Hscr", 4, 0x210B, 0x0000 },
+	{ "Afr", 3, 0x1D504, 0x0000 },
+	{ "hybull", 6, 0x2043, 0x0000 },
+	{ "subsetneqq", 10, 0x2ACB, 0x0000 },
+	{ "biguplus", 8, 0x2A04, 0x0000 },
+	{ "Gopf", 4, 0x1D53E, 0x0000 },
+	{ "FilledVerySmallSquare", 21, 0x25AA, 0x0000 },
+	{ "rho", 3, 0x03C1, 0x0000 },
+	{ "ni", 2, 0x220B, 0x0000 },
+	{ "lfloor", 6, 0x230A, 0x0000 },
+	{ "RightDoubleBracket", 18, 0x27E7, 0x0000 },
+	{ "lbarr", 5, 0x290C, 0x0000 },
+	{ "range", 5, 0x29A5, 0x0000 },
+	{ "complexes", 9, 0x2102, 0x0000 },
+	{ "TildeTilde", 10, 0x2248, 0x0000 },
+	{ "NestedGreaterGreater", 20, 0x226B, 0x0000 },
+	{ "HilbertSpace", 12, 0x210B, 0x0000 },
+	{ "vnsub", 5, 0x2282, 0x20D2 },
+	{ "daleth", 6, 0x2138, 0x0000 },
+	{ "utilde", 6, 0x0169, 0x0000 },
+	{ "vopf", 4, 0x1D567, 0x0000 },
+	{ "larrsim", 7, 0x2973, 0x0000 },
+	{ "Proportional", 12, 0x221D, 0x0000 },
+	{ "GreaterEqual", 12, 0x2265, 0x0000 },
+	{ "mDDot", 5, 0x223A, 0x0000 },
+	{ "DownTeeArrow", 12, 0x21A7, 0x0000 },
+	{ "gsim", 4, 0x2273, 0x0000 },
+	{ "Kscr", 4, 0x1D4A6, 0x0000 },
+	{ "lbrke", 5, 0x298B, 0x0000 },
+	{ "ascr", 4, 0x1D4B6, 0x0000 },
+	{ "blk12", 5, 0x2592, 0x0000 },
+	{ "UpArrowBar", 10, 0x2912, 0x0000 },
+	{ "urcorner", 8, 0x231D, 0x0000 },
+	{ "pertenk", 7, 0x2031, 0x0000 },
+	{ "LeftRightArrow", 14, 0x2194, 0x0000 },
+	{ "GT", 2, 0x003E, 0x0000 },
+	{ "Therefore", 9, 0x2234, 0x0000 },
+	{ "and", 3, 0x2227, 0x0000 },
+	{ "kopf", 4, 0x1D55C, 0x0000 },
+	{ "caps", 4, 0x2229, 0xFE00 },
+	{ "SucceedsTilde", 13, 0x227F, 0x0000 },
+	{ "varrho", 6, 0x03F1, 0x0000 },
+	{ "supedot", 7, 0x2AC4, 0x0000 },
+	{ "quest", 5, 0x003F, 0x0000 },
+	{ "Gdot", 4, 0x0120, 0x0000 },
+	{ "egs", 3, 0x2A96, 0x0000 },
+	{ "Cross", 5, 0x2A2F, 0x0000 },
+	{ "RBarr", 5, 0x2910, 0x0000 },
+	{ "twixt", 5, 0x226C, 0x0000 },
+	{ "qprime", 6, 0x2057, 0x0000 },
+	{ "ulcorner", 8, 0x231C, 0x0000 },
+	{ "gtrsim", 6, 0x2273, 0x0000 },
+	{ "equiv", 5, 0x2261, 0x0000 },
+	{ "angrt", 5, 0x221F, 0x0000 },
+	{ "Ycirc", 5, 0x0176, 0x0000 },
+	{ "rrarr", 5, 0x21C9, 0x0000 },
+	{ "Coproduct", 9, 0x2210, 0x0000 },
+	{ "nfr", 3, 0x1D52B, 0x0000 },
+	{ "inodot", 6, 0x0131, 0x0000 },
+	{ "esdot", 5, 0x2250, 0x0000 },
+	{ "scnsim", 6, 0x22E9, 0x0000 },
+	{ "Diamond", 7, 0x22C4, 0x0000 },
+	{ "sigmav", 6, 0x03C2, 0x0000 },
+	{ "ijlig", 5, 0x0133, 0x0000 },
+	{ "nleftarrow", 10, 0x219A, 0x0000 },
+	{ "odot", 4, 0x2299, 0x0000 },
+	{ "rtrif", 5, 0x25B8, 0x0000 },
+	{ "bsim", 4, 0x223D, 0x0000 },
+	{ "Leftarrow", 9, 0x21D0, 0x0000 },
+	{ "Mfr", 3, 0x1D510, 0x0000 },
+	{ "ape", 3, 0x224A, 0x0000 },
+	{ "uopf", 4, 0x1D566, 0x0000 },
+	{ "triminus", 8, 0x2A3A, 0x0000 },
+	{ "curren", 6, 0x00A4, 0x0000 },
+	{ "boxUR", 5, 0x255A, 0x0000 },
+	{ "supsetneq", 9, 0x228B, 0x0000 },
+	{ "dblac", 5, 0x02DD, 0x0000 },
+	{ "curvearrowleft", 14, 0x21B6, 0x0000 },
+	{ "Upsi", 4, 0x03D2, 0x0000 },
+	{ "lhard", 5, 0x21BD, 0x0000 },
+	{ "scnap", 5, 0x2ABA, 0x0000 },
+	{ "part", 4, 0x2202, 0x0000 },
+	{ "Otimes", 6, 0x2A37, 0x0000 },
+	{ "loang", 5, 0x27EC, 0x0000 },
+	{ "dharl", 5, 0x21C3, 0x0000 },
+	{ "LeftTee", 7, 0x22A3, 0x0000 },
+	{ "LeftUpTeeVector", 15, 0x2960, 0x0000 },
+	{ "Dagger", 6, 0x2021, 0x0000 },
+	{ "dbkarow", 7, 0x290F, 0x0000 },
+	{ "xnis", 4, 0x22FB, 0x0000 },
+	{ "gtquest", 7, 0x2A7C, 0x0000 },
+	{ "Idot", 4, 0x0130, 0x0000 },
+	{ "dsol", 4, 0x29F6, 0x0000 },
+	{ "rarrhk", 6, 0x21AA, 0x0000 },
+	{ "lt", 2, 0x003C, 0x0000 },
+	{ "yopf", 4, 0x1D56A, 0x0000 },
+	{ "lgE", 3, 0x2A91, 0x0000 },
+	{ "CounterClockwiseContourIntegral", 31, 0x2233, 0x0000 },
+	{ "bfr", 3, 0x1D51F, 0x0000 },
+	{ "cross", 5, 0x2717, 0x0000 },
+	{ "NotCupCap", 9, 0x226D, 0x0000 },
+	{ "bullet", 6, 0x2022, 0x0000 },
+	{ "frac25", 6, 0x2156, 0x0000 },
+	{ "zscr", 4, 0x1D4CF, 0x0000 },
+	{ "curvearrowright", 15, 0x21B7, 0x0000 },
+	{ "cularr", 6, 0x21B6, 0x0000 },
+	{ "nsqsupe", 7, 0x22E3, 0x0000 },
+	{ "supnE", 5, 0x2ACC, 0x0000 },
+	{ "DoubleRightTee", 14, 0x22A8, 0x0000 },
+	{ "rect", 4, 0x25AD, 0x0000 },
+	{ "Sqrt", 4, 0x221A, 0x0000 },
+	{ "Breve", 5, 0x02D8, 0x0000 },
+	{ "le", 2, 0x2264, 0x0000 },
+	{ "topf", 4, 0x1D565, 0x0000 },
+	{ "gneq", 4, 0x2A88, 0x0000 },
+	{ "disin", 5, 0x22F2, 0x0000 },
+	{ "circleddash", 11, 0x229D, 0x0000 },
+	{ "sdote", 5, 0x2A66, 0x0000 },
+	{ "Iopf", 4, 0x1D540, 0x0000 },
+	{ "looparrowleft", 13, 0x21AB, 0x0000 },
+	{ "micro", 5, 0x00B5, 0x0000 },
+	{ "LJcy", 4, 0x0409, 0x0000 },
+	{ "Scaron", 6, 0x0160, 0x0000 },
+	{ "cap", 3, 0x2229, 0x0000 },
+	{ "nVdash", 6, 0x22AE, 0x0000 },
+	{ "divide", 6, 0x00F7, 0x0000 },
+	{ "lrhard", 6, 0x296D, 0x0000 },
+	{ "macr", 4, 0x00AF, 0x0000 },
+	{ "egsdot", 6, 0x2A98, 0x0000 },
+	{ "angmsd", 6, 0x2221, 0x0000 },
+	{ "nsubset", 7, 0x2282, 0x20D2 },
+	{ "nexists", 7, 0x2204, 0x0000 },
+	{ "SquareSupersetEqual", 19, 0x2292, 0x0000 },
+	{ "Cdot", 4, 0x010A, 0x0000 },
+	{ "VerticalLine", 12, 0x007C, 0x0000 },
+	{ "TildeEqual", 10, 0x2243, 0x0000 },
+	{ "varsubsetneq", 12, 0x228A, 0xFE00 },
+	{ "npr", 3, 0x2280, 0x0000 },
+	{ "Uuml", 4, 0x00DC, 0x0000 },
+	{ "gne", 3, 0x2A88, 0x0000 },
+	{ "GreaterLess", 11, 0x2277, 0x0000 },
+	{ "awint", 5, 0x2A11, 0x0000 },
+	{ "ulcrop", 6, 0x230F, 0x0000 },
+	{ "LeftCeiling", 11, 0x2308, 0x0000 },
+	{ "rcy", 3, 0x0440, 0x0000 },
+	{ "ltimes", 6, 0x22C9, 0x0000 },
+	{ "Del", 3, 0x2207, 0x0000 },
+	{ "leftrightarrow", 14, 0x2194, 0x0000 },
+	{ "vee", 3, 0x2228, 0x0000 },
+	{ "And", 3, 0x2A53, 0x0000 },
+	{ "Hopf", 4, 0x210D, 0x0000 },
+	{ "npart", 5, 0x2202, 0x0338 },
+	{ "npre", 4, 0x2AAF, 0x0338 },
+	{ "AMP", 3, 0x0026, 0x0000 },
+	{ "Pr", 2, 0x2ABB, 0x0000 },
+	{ "Or", 2, 0x2A54, 0x0000 },
+	{ "sect", 4, 0x00A7, 0x0000 },
+	{ "Not", 3, 0x2AEC, 0x0000 },
+	{ "sigma", 5, 0x03C3, 0x0000 },
+	{ "Dot", 3, 0x00A8, 0x0000 },
+	{ "permil", 6, 0x2030, 0x0000 },
+	{ "setminus", 8, 0x2216, 0x0000 },
+	{ "ffllig", 6, 0xFB04, 0x0000 },
+	{ "dcy", 3, 0x0434, 0x0000 },
+	{ "bigsqcup", 8, 0x2A06, 0x0000 },
+	{ "colone", 6, 0x2254, 0x0000 },
+	{ "angrtvb", 7, 0x22BE, 0x0000 },
+	{ "acirc", 5, 0x00E2, 0x0000 },
+	{ "Udblac", 6, 0x0170, 0x0000 },
+	{ "DoubleDownArrow", 15, 0x21D3, 0x0000 },
+	{ "Rscr", 4, 0x211B, 0x0000 },
+	{ "uml", 3, 0x00A8, 0x0000 },
+	{ "rx", 2, 0x211E, 0x0000 },
+	{ "Pfr", 3, 0x1D513, 0x0000 },
+	{ "xvee", 4, 0x22C1, 0x0000 },
+	{ "NotSquareSupersetEqual", 22, 0x22E3, 0x0000 },
+	{ "lthree", 6, 0x22CB, 0x0000 },
+	{ "nVDash", 6, 0x22AF, 0x0000 },
+	{ "udarr", 5, 0x21C5, 0x0000 },
+	{ "ominus", 6, 0x2296, 0x0000 },
+	{ "SupersetEqual", 13, 0x2287, 0x0000 },
+	{ "oscr", 4, 0x2134, 0x0000 },
+	{ "coprod", 6, 0x2210, 0x0000 },
+	{ "pitchfork", 9, 0x22D4, 0x0000 },
+	{ "Ufr", 3, 0x1D518, 0x0000 },
+	{ "laquo", 5, 0x00AB, 0x0000 },
+	{ "subsim", 6, 0x2AC7, 0x0000 },
+	{ "Jopf", 4, 0x1D541, 0x0000 },
+	{ "CircleMinus", 11, 0x2296, 0x0000 },
+	{ "Nfr", 3, 0x1D511, 0x0000 },
+	{ "gnsim", 5, 0x22E7, 0x0000 },
+	{ "bump", 4, 0x224E, 0x0000 },
+	{ "boxVh", 5, 0x256B, 0x0000 },
+	{ "ultri", 5, 0x25F8, 0x0000 },
+	{ "Vee", 3, 0x22C1, 0x0000 },
+	{ "NotGreaterTilde", 15, 0x2275, 0x0000 },
+	{ "DoubleLongRightArrow", 20, 0x27F9, 0x0000 },
+	{ "SHcy", 4, 0x0428, 0x0000 },
+	{ "ange", 4, 0x29A4, 0x0000 },
+	{ "NotGreaterFullEqual", 19, 0x2267, 0x0338 },
+	{ "RightArrowBar", 13, 0x21E5, 0x0000 },
+	{ "Zdot", 4, 0x017B, 0x0000 },
+	{ "Vscr", 4, 0x1D4B1, 0x0000 },
+	{ "TScy", 4, 0x0426, 0x0000 },
+	{ "scap", 4, 0x2AB8, 0x0000 },
+	{ "omacr", 5, 0x014D, 0x0000 },
+	{ "nsupe", 5, 0x2289, 0x0000 },
+	{ "VerticalTilde", 13, 0x2240, 0x0000 },
+	{ "rarrtl", 6, 0x21A3, 0x0000 },
+	{ "suphsub", 7, 0x2AD7, 0x0000 },
+	{ "phi", 3, 0x03C6, 0x0000 },
+	{ "iogon", 5, 0x012F, 0x0000 },
+	{ "eta", 3, 0x03B7, 0x0000 },
+	{ "mlcp", 4, 0x2ADB, 0x0000 },
+	{ "ropar", 5, 0x2986, 0x0000 },
+	{ "sube", 4, 0x2286, 0x0000 },
+	{ "llarr", 5, 0x21C7, 0x0000 },
+	{ "bumpeq", 6, 0x224F, 0x0000 },
+	{ "bigotimes", 9, 0x2A02, 0x0000 },
+	{ "dscy", 4, 0x0455, 0x0000 },
+	{ "infin", 5, 0x221E, 0x0000 },
+	{ "rdca", 4, 0x2937, 0x0000 },
+	{ "Dfr", 3, 0x1D507, 0x0000 },
+	{ "vert", 4, 0x007C, 0x0000 },
+	{ "boxhd", 5, 0x252C, 0x0000 },
+	{ "wedgeq", 6, 0x2259, 0x0000 },
+	{ "LessFullEqual", 13, 0x2266, 0x0000 },
+	{ "HorizontalLine", 14, 0x2500, 0x0000 },
+	{ "NegativeThickSpace", 18, 0x200B, 0x0000 },
+	{ "djcy", 4, 0x0452, 0x0000 },
+	{ "Qopf", 4, 0x211A, 0x0000 },
+	{ "GreaterGreater", 14, 0x2AA2, 0x0000 },
+	{ "jscr", 4, 0x1D4BF, 0x0000 },
+	{ "larrfs", 6, 0x291D, 0x0000 },
+	{ "Iogon", 5, 0x012E, 0x0000 },
+	{ "KHcy", 4, 0x0425, 0x0000 },
+	{ "rationals", 9, 0x211A, 0x0000 },
+	{ "Acirc", 5, 0x00C2, 0x0000 },
+	{ "rightrightarrows", 16, 0x21C9, 0x0000 },
+	{ "there4", 6, 0x2234, 0x0000 },
+	{ "squ", 3, 0x25A1, 0x0000 },
+	{ "yuml", 4, 0x00FF, 0x0000 },
+	{ "RightDownVector", 15, 0x21C2, 0x0000 },
+	{ "Euml", 4, 0x00CB, 0x0000 },
+	{ "triangle", 8, 0x25B5, 0x0000 },
+	{ "dstrok", 6, 0x0111, 0x0000 },
+	{ "gcirc", 5, 0x011D, 0x0000 },
+	{ "Copf", 4, 0x2102, 0x0000 },
+	{ "LeftTriangleBar", 15, 0x29CF, 0x0000 },
+	{ "Longrightarrow", 14, 0x27F9, 0x0000 },
+	{ "nvDash", 6, 0x22AD, 0x0000 },
+	{ "nleqslant", 9, 0x2A7D, 0x0338 },
+	{ "icy", 3, 0x0438, 0x0000 },
+	{ "rhov", 4, 0x03F1, 0x0000 },
+	{ "iff", 3, 0x21D4, 0x0000 },
+	{ "nrtri", 5, 0x22EB, 0x0000 },
+	{ "NotTilde", 8, 0x2241, 0x0000 },
+	{ "Aacute", 6, 0x00C1, 0x0000 },
+	{ "sacute", 6, 0x015B, 0x0000 },
+	{ "parsl", 5, 0x2AFD, 0x0000 },
+	{ "rbrksld", 7, 0x298E, 0x0000 },
+	{ "dagger", 6, 0x2020, 0x0000 },
+	{ "fscr", 4, 0x1D4BB, 0x0000 },
+	{ "LessTilde", 9, 0x2272, 0x0000 },
+	{ "PrecedesSlantEqual", 18, 0x227C, 0x0000 },
+	{ "oslash", 6, 0x00F8, 0x0000 },
+	{ "frown", 5, 0x2322, 0x0000 },
+	{ "boxplus", 7, 0x229E, 0x0000 },
+	{ "ncong", 5, 0x2247, 0x0000 },
+	{ "Zacute", 6, 0x0179, 0x0000 },
+	{ "boxminus", 8, 0x229F, 0x0000 },
+	{ "ltcc", 4, 0x2AA6, 0x0000 },
+	{ "ldrushar", 8, 0x294B, 0x0000 },
+	{ "eqcirc", 6, 0x2256, 0x0000 },
+	{ "Bcy", 3, 0x0411, 0x0000 },
+	{ "tridot", 6, 0x25EC, 0x0000 },
+	{ "Dstrok", 6, 0x0110, 0x0000 },
+	{ "bprime", 6, 0x2035, 0x0000 },
+	{ "jsercy", 6, 0x0458, 0x0000 },
+	{ "nsccue", 6, 0x22E1, 0x0000 },
+	{ "nsime", 5, 0x2244, 0x0000 },
+	{ "swarr", 5, 0x2199, 0x0000 },
+	{ "NoBreak", 7, 0x2060, 0x0000 },
+	{ "CloseCurlyDoubleQuote", 21, 0x201D, 0x0000 },
+	{ "ccups", 5, 0x2A4C, 0x0000 },
+	{ "Verbar", 6, 0x2016, 0x0000 },
+	{ "Longleftrightarrow", 18, 0x27FA, 0x0000 },
+	{ "bigwedge", 8, 0x22C0, 0x0000 },
+	{ "xotime", 6, 0x2A02, 0x0000 },
+	{ "primes", 6, 0x2119, 0x0000 },
+	{ "Laplacetrf", 10, 0x2112, 0x0000 },
+	{ "urcorn", 6, 0x231D, 0x0000 },
+	{ "ycy", 3, 0x044B, 0x0000 },
+	{ "scaron", 6, 0x0161, 0x0000 },
+	{ "NotGreaterSlantEqual", 20, 0x2A7E, 0x0338 },
+	{ "olt", 3, 0x29C0, 0x0000 },
+	{ "csube", 5, 0x2AD1, 0x0000 },
+	{ "qint", 4, 0x2A0C, 0x0000 },
+	{ "nearr", 5, 0x2197, 0x0000 },
+	{ "varepsilon", 10, 0x03F5, 0x0000 },
+	{ "longleftarrow", 13, 0x27F5, 0x0000 },
+	{ "GreaterFullEqual", 16, 0x2267, 0x0000 },
+	{ "ShortLeftArrow", 14, 0x2190, 0x0000 },
+	{ "rdquor", 6, 0x201D, 0x0000 },
+	{ "ThinSpace", 9, 0x2009, 0x0000 },
+	{ "thksim", 6, 0x223C, 0x0000 },
+	{ "Lmidot", 6, 0x013F, 0x0000 },
+	{ "gdot", 4, 0x0121, 0x0000 },
+	{ "Rho", 3, 0x03A1, 0x0000 },
+	{ "ntgl", 4, 0x2279, 0x0000 },
+	{ "scE", 3, 0x2AB4, 0x0000 },
+	{ "leftrightarrows", 15, 0x21C6, 0x0000 },
+	{ "bigcirc", 7, 0x25EF, 0x0000 },
+	{ "kappa", 5, 0x03BA, 0x0000 },
+	{ "ord", 3, 0x2A5D, 0x0000 },
+	{ "darr", 4, 0x2193, 0x0000 },
+	{ "NotCongruent", 12, 0x2262, 0x0000 },
+	{ "THORN", 5, 0x00DE, 0x0000 },
+	{ "frac45", 6, 0x2158, 0x0000 },
+	{ "rlm", 3, 0x200F, 0x0000 },
+	{ "uhblk", 5, 0x2580, 0x0000 },
+	{ "NotSucceedsEqual", 16, 0x2AB0, 0x0338 },
+	{ "nsupseteqq", 10, 0x2AC6, 0x0338 },
+	{ "nsub", 4, 0x2284, 0x0000 },
+	{ "plankv", 6, 0x210F, 0x0000 },
+	{ "simeq", 5, 0x2243, 0x0000 },
+	{ "cupcup", 6, 0x2A4A, 0x0000 },
+	{ "uarr", 4, 0x2191, 0x0000 },
+	{ "Ocirc", 5, 0x00D4, 0x0000 },
+	{ "Eogon", 5, 0x0118, 0x0000 },
+	{ "frac78", 6, 0x215E, 0x0000 },
+	{ "exponentiale", 12, 0x2147, 0x0000 },
+	{ "preceq", 6, 0x2AAF, 0x0000 },
+	{ "OverBrace", 9, 0x23DE, 0x0000 },
+	{ "copf", 4, 0x1D554, 0x0000 },
+	{ "alefsym", 7, 0x2135, 0x0000 },
+	{ "blk14", 5, 0x2591, 0x0000 },
+	{ "LeftTriangle", 12, 0x22B2, 0x0000 },
+	{ "ucirc", 5, 0x00FB, 0x0000 },
+	{ "it", 2, 0x2062, 0x0000 },
+	{ "scirc", 5, 0x015D, 0x0000 },
+	{ "tau", 3, 0x03C4, 0x0000 },
+	{ "Yopf", 4, 0x1D550, 0x0000 },
+	{ "Oscr", 4, 0x1D4AA, 0x0000 },
+	{ "oelig", 5, 0x0153, 0x0000 },
+	{ "Iacute", 6, 0x00CD, 0x0000 },
+	{ "subsub", 6, 0x2AD5, 0x0000 },
+	{ "ee", 2, 0x2147, 0x0000 },
+	{ "aopf", 4, 0x1D552, 0x0000 },
+	{ "Ccedil", 6, 0x00C7, 0x0000 },
+	{ "Egrave", 6, 0x00C8, 0x0000 },
+	{ "harrcir", 7, 0x2948, 0x0000 },
+	{ "squarf", 6, 0x25AA, 0x0000 },
+	{ "tosa", 4, 0x2929, 0x0000 },
+	{ "LessSlantEqual", 14, 0x2A7D, 0x0000 },
+	{ "napid", 5, 0x224B, 0x0338 },
+	{ "otimesas", 8, 0x2A36, 0x0000 },
+	{ "female", 6, 0x2640, 0x0000 },
+	{ "lsime", 5, 0x2A8D, 0x0000 },
+	{ "DownArrowBar", 12, 0x2913, 0x0000 },
+	{ "Lcy", 3, 0x041B, 0x0000 },
+	{ "fflig", 5, 0xFB00, 0x0000 },
+	{ "LeftVector", 10, 0x21BC, 0x0000 },
+	{ "UpDownArrow", 11, 0x2195, 0x0000 },
+	{ "dtdot", 5, 0x22F1, 0x0000 },
+	{ "gel", 3, 0x22DB, 0x0000 },
+	{ "Rightarrow", 10, 0x21D2, 0x0000 },
+	{ "SquareSubset", 12, 0x228F, 0x0000 },
+	{ "psi", 3, 0x03C8, 0x0000 },
+	{ "ecy", 3, 0x044D, 0x0000 },
+	{ "equivDD", 7, 0x2A78, 0x0000 },
+	{ "RightTriangle", 13, 0x22B3, 0x0000 },
+	{ "LessEqualGreater", 16, 0x22DA, 0x0000 },
+	{ "LongLeftArrow", 13, 0x27F5, 0x0000 },
+	{ "nearrow", 7, 0x2197, 0x0000 },
+	{ "integers", 8, 0x2124, 0x0000 },
+	{ "vsubnE", 6, 0x2ACB, 0xFE00 },
+	{ "igrave", 6, 0x00EC, 0x0000 },
+	{ "weierp", 6, 0x2118, 0x0000 },
+	{ "Gcy", 3, 0x0413, 0x0000 },
+	{ "timesb", 6, 0x22A0, 0x0000 },
+	{ "eqslantgtr", 10, 0x2A96, 0x0000 },
+	{ "hksearow", 8, 0x2925, 0x0000 },
+	{ "ell", 3, 0x2113, 0x0000 },
+	{ "Phi", 3, 0x03A6, 0x0000 },
+	{ "imagpart", 8, 0x2111, 0x0000 },
+	{ "nltrie", 6, 0x22EC, 0x0000 },
+	{ "heartsuit", 9, 0x2665, 0x0000 },
+	{ "Kappa", 5, 0x039A, 0x0000 },
+	{ "NJcy", 4, 0x040A, 0x0000 },
+	{ "Rcedil", 6, 0x0156, 0x0000 },
+	{ "rthree", 6, 0x22CC, 0x0000 },
+	{ "LeftArrowRightArrow", 19, 0x21C6, 0x0000 },
+	{ "nvle", 4, 0x2264, 0x20D2 },
+	{ "DoubleLeftTee", 13, 0x2AE4, 0x0000 },
+	{ "nvgt", 4, 0x003E, 0x20D2 },
+	{ "aogon", 5, 0x0105, 0x0000 },
+	{ "nless", 5, 0x226E, 0x0000 },
+	{ "sim", 3, 0x223C, 0x0000 },
+	{ "InvisibleTimes", 14, 0x2062, 0x0000 },
+	{ "veeeq", 5, 0x225A, 0x0000 },
+	{ "boxv", 4, 0x2502, 0x0000 },
+	{ "osol", 4, 0x2298, 0x0000 },
+	{ "ufr", 3, 0x1D532, 0x0000 },
+	{ "rightharpoondown", 16, 0x21C1, 0x0000 },
+	{ "ffr", 3, 0x1D523, 0x0000 },
+	{ "bepsi", 5, 0x03F6, 0x0000 },
+	{ "Rarrtl", 6, 0x2916, 0x0000 },
+	{ "andand", 6, 0x2A55, 0x0000 },
+	{ "Larr", 4, 0x219E, 0x0000 },
+	{ "backsimeq", 9, 0x22CD, 0x0000 },
+	{ "srarr", 5, 0x2192, 0x0000 },
+	{ "varpropto", 9, 0x221D, 0x0000 },
+	{ "NotSucceedsSlantEqual", 21, 0x22E1, 0x0000 },
+	{ "IEcy", 4, 0x0415, 0x0000 },
+	{ "ldrdhar", 7, 0x2967, 0x0000 },
+	{ "epsi", 4, 0x03B5, 0x0000 },
+	{ "Sigma", 5, 0x03A3, 0x0000 },
+	{ "yicy", 4, 0x0457, 0x0000 },
+	{ "ldsh", 4, 0x21B2, 0x0000 },
+	{ "ecaron", 6, 0x011B, 0x0000 },
+	{ "smt", 3, 0x2AAA, 0x0000 },
+	{ "barwedge", 8, 0x2305, 0x0000 },
+	{ "smallsetminus", 13, 0x2216, 0x0000 },
+	{ "subsetneq", 9, 0x228A, 0x0000 },
+	{ "lvnE", 4, 0x2268, 0xFE00 },
+	{ "simgE", 5, 0x2AA0, 0x0000 },
+	{ "subseteq", 8, 0x2286, 0x0000 },
+	{ "Tscr", 4, 0x1D4AF, 0x0000 },
+	{ "hscr", 4, 0x1D4BD, 0x0000 },
+	{ "Int", 3, 0x222C, 0x0000 },
+	{ "ohbar", 5, 0x29B5, 0x0000 },
+	{ "DotDot", 6, 0x20DC, 0x0000 },
+	{ "NotLessSlantEqual", 17, 0x2A7D, 0x0338 },
+	{ "Escr", 4, 0x2130, 0x0000 },
+	{ "precsim", 7, 0x227E, 0x0000 },
+	{ "Eta", 3, 0x0397, 0x0000 },
+	{ "nsubseteqq", 10, 0x2AC5, 0x0338 },
+	{ "nLeftarrow", 10, 0x21CD, 0x0000 },
+	{ "varkappa", 8, 0x03F0, 0x0000 },
+	{ "amalg", 5, 0x2A3F, 0x0000 },
+	{ "Iscr", 4, 0x2110, 0x0000 },
+	{ "image", 5, 0x2111, 0x0000 },
+	{ "nparsl", 6, 0x2AFD, 0x20E5 },
+	{ "Topf", 4, 0x1D54B, 0x0000 },
+	{ "Yscr", 4, 0x1D4B4, 0x0000 },
+	{ "yfr", 3, 0x1D536, 0x0000 },
+	{ "elsdot", 6, 0x2A97, 0x0000 },
+	{ "tprime", 6, 0x2034, 0x0000 },
+	{ "succnapprox", 11, 0x2ABA, 0x0000 },
+	{ "notinvb", 7, 0x22F7, 0x0000 },
+	{ "harrw", 5, 0x21AD, 0x0000 },
+	{ "RightArrowLeftArrow", 19, 0x21C4, 0x0000 },
+	{ "wopf", 4, 0x1D568, 0x0000 },
+	{ "vnsup", 5, 0x2283, 0x20D2 },
+	{ "LeftTriangleEqual", 17, 0x22B4, 0x0000 },
+	{ "rdquo", 5, 0x201D, 0x0000 },
+	{ "NotLessLess", 11, 0x226A, 0x0338 },
+	{ "flat", 4, 0x266D, 0x0000 },
+	{ "mapsto", 6, 0x21A6, 0x0000 },
+	{ "andslope", 8, 0x2A58, 0x0000 },
+	{ "CirclePlus", 10, 0x2295, 0x0000 },
+	{ "roplus", 6, 0x2A2E, 0x0000 },
+	{ "supsim", 6, 0x2AC8, 0x0000 },
+	{ "supset", 6, 0x2283, 0x0000 },
+	{ "ImaginaryI", 10, 0x2148, 0x0000 },
+	{ "emacr", 5, 0x0113, 0x0000 },
+	{ "nldr", 4, 0x2025, 0x0000 },
+	{ "ljcy", 4, 0x0459, 0x0000 },
+	{ "Vdash", 5, 0x22A9, 0x0000 },
+	{ "iiint", 5, 0x222D, 0x0000 },
+	{ "NotRightTriangleEqual", 21, 0x22ED, 0x0000 },
+	{ "approxeq", 8, 0x224A, 0x0000 },
+	{ "gvertneqq", 9, 0x2269, 0xFE00 },
+	{ "frac14", 6, 0x00BC, 0x0000 },
+	{ "nsqsube", 7, 0x22E2, 0x0000 },
+	{ "prurel", 6, 0x22B0, 0x0000 },
+	{ "Cayleys", 7, 0x212D, 0x0000 },
+	{ "UpArrowDownArrow", 16, 0x21C5, 0x0000 },
+	{ "ntriangleleft", 13, 0x22EA, 0x0000 },
+	{ "UnderBar", 8, 0x005F, 0x0000 },
+	{ "xlArr", 5, 0x27F8, 0x0000 },
+	{ "thickapprox", 11, 0x2248, 0x0000 },
+	{ "nearhk", 6, 0x2924, 0x0000 },
+	{ "capcup", 6, 0x2A47, 0x0000 },
+	{ "ncaron", 6, 0x0148, 0x0000 },
+	{ "lltri", 5, 0x25FA, 0x0000 },
+	{ "Delta", 5, 0x0394, 0x0000 },
+	{ "nmid", 4, 0x2224, 0x0000 },
+	{ "NotGreater", 10, 0x226F, 0x0000 },
+	{ "triplus", 7, 0x2A39, 0x0000 },
+	{ "boxVH", 5, 0x256C, 0x0000 },
+	{ "uplus", 5, 0x228E, 0x0000 },
+	{ "incare", 6, 0x2105, 0x0000 },
+	{ "LeftDownTeeVector", 17, 0x2961, 0x0000 },
+	{ "nGtv", 4, 0x226B, 0x0338 },
+	{ "uHar", 4, 0x2963, 0x0000 },
+	{ "spades", 6, 0x2660, 0x0000 },
+	{ "brvbar", 6, 0x00A6, 0x0000 },
+	{ "rArr", 4, 0x21D2, 0x0000 },
+	{ "RightTriangleEqual", 18, 0x22B5, 0x0000 },
+	{ "gtcc", 4, 0x2AA7, 0x0000 },
+	{ "Tcy", 3, 0x0422, 0x0000 },
+	{ "odash", 5, 0x229D, 0x0000 },
+	{ "SucceedsEqual", 13, 0x2AB0, 0x0000 },
+	{ "DownLeftRightVector", 19, 0x2950, 0x0000 },
+	{ "glE", 3, 0x2A92, 0x0000 },
+	{ "icirc", 5, 0x00EE, 0x0000 },
+	{ "circlearrowleft", 15, 0x21BA, 0x0000 },
+	{ "Tilde", 5, 0x223C, 0x0000 },
+	{ "varsupsetneqq", 13, 0x2ACC, 0xFE00 },
+	{ "Supset", 6, 0x22D1, 0x0000 },
+	{ "ropf", 4, 0x1D563, 0x0000 },
+	{ "bne", 3, 0x003D, 0x20E5 },
+	{ "checkmark", 9, 0x2713, 0x0000 },
+	{ "Pscr", 4, 0x1D4AB, 0x0000 },
+	{ "downharpoonleft", 15, 0x21C3, 0x0000 },
+	{ "nleqq", 5, 0x2266, 0x0338 },
+	{ "theta", 5, 0x03B8, 0x0000 },
+	{ "Gammad", 6, 0x03DC, 0x0000 },
+	{ "LongLeftRightArrow", 18, 0x27F7, 0x0000 },
+	{ "capdot", 6, 0x2A40, 0x0000 },
+	{ "Ncy", 3, 0x041D, 0x0000 },
+	{ "larrlp", 6, 0x21AB, 0x0000 },
+	{ "nvsim", 5, 0x223C, 0x20D2 },
+	{ "xcirc", 5, 0x25EF, 0x0000 },
+	{ "dashv", 5, 0x22A3, 0x0000 },
+	{ "iacute", 6, 0x00ED, 0x0000 },
+	{ "ldca", 4, 0x2936, 0x0000 },
+	{ "sscr", 4, 0x1D4C8, 0x0000 },
+	{ "suphsol", 7, 0x27C9, 0x0000 },
+	{ "precnsim", 8, 0x22E8, 0x0000 },
+	{ "NotSubsetEqual", 14, 0x2288, 0x0000 },
+	{ "diams", 5, 0x2666, 0x0000 },
+	{ "frac35", 6, 0x2157, 0x0000 },
+	{ "eth", 3, 0x00F0, 0x0000 },
+	{ "seArr", 5, 0x21D8, 0x0000 },
+	{ "rpar", 4, 0x0029, 0x0000 },
+	{ "prec", 4, 0x227A, 0x0000 },
+	{ "pi", 2, 0x03C0, 0x0000 },
+	{ "xhArr", 5, 0x27FA, 0x0000 },
+	{ "mcy", 3, 0x043C, 0x0000 },
+	{ "DotEqual", 8, 0x2250, 0x0000 },
+	{ "niv", 3, 0x220B, 0x0000 },
+	{ "isinsv", 6, 0x22F3, 0x0000 },
+	{ "vartriangleright", 16, 0x22B3, 0x0000 },
+	{ "iiota", 5, 0x2129, 0x0000 },
+	{ "Edot", 4, 0x0116, 0x0000 },
+	{ "olcross", 7, 0x29BB, 0x0000 },
+	{ "lE", 2, 0x2266, 0x0000 },
+	{ "naturals", 8, 0x2115, 0x0000 },
+	{ "EqualTilde", 10, 0x2242, 0x0000 },
+	{ "lurdshar", 8, 0x294A, 0x0000 },
+	{ "boxvr", 5, 0x251C, 0x0000 },
+	{ "softcy", 6, 0x044C, 0x0000 },
+	{ "upharpoonleft", 13, 0x21BF, 0x0000 },
+	{ "Vopf", 4, 0x1D54D, 0x0000 },
+	{ "Gcirc", 5, 0x011C, 0x0000 },
+	{ "Darr", 4, 0x21A1, 0x0000 },
+	{ "submult", 7, 0x2AC1, 0x0000 },
+	{ "lesdoto", 7, 0x2A81, 0x0000 },
+	{ "pm", 2, 0x00B1, 0x0000 },
+	{ "notinva", 7, 0x2209, 0x0000 },
+	{ "DoubleLongLeftArrow", 19, 0x27F8, 0x0000 },
+	{ "ddagger", 7, 0x2021, 0x0000 },
+	{ "rsquor", 6, 0x2019, 0x0000 },
+	{ "between", 7, 0x226C, 0x0000 },
+	{ "plusb", 5, 0x229E, 0x0000 },
+	{ "harr", 4, 0x2194, 0x0000 },
+	{ "rdldhar", 7, 0x2969, 0x0000 },
+	{ "nsupE", 5, 0x2AC6, 0x0338 },
+	{ "Xfr", 3, 0x1D51B, 0x0000 },
+	{ "kscr", 4, 0x1D4C0, 0x0000 },
+	{ "boxur", 5, 0x2514, 0x0000 },
+	{ "gtreqless", 9, 0x22DB, 0x0000 },
+	{ "timesd", 6, 0x2A30, 0x0000 },
+	{ "lacute", 6, 0x013A, 0x0000 },
+	{ "perp", 4, 0x22A5, 0x0000 },
+	{ "dzigrarr", 8, 0x27FF, 0x0000 },
+	{ "boxHu", 5, 0x2567, 0x0000 },
+	{ "OElig", 5, 0x0152, 0x0000 },
+	{ "nsim", 4, 0x2241, 0x0000 },
+	{ "npreceq", 7, 0x2AAF, 0x0338 },
+	{ "xrArr", 5, 0x27F9, 0x0000 },
+	{ "nLl", 3, 0x22D8, 0x0338 },
+	{ "RightDownVectorBar", 18, 0x2955, 0x0000 },
+	{ "Iota", 4, 0x0399, 0x0000 },
+	{ "roarr", 5, 0x21FE, 0x0000 },
+	{ "nprec", 5, 0x2280, 0x0000 },
+	{ "Ecirc", 5, 0x00CA, 0x0000 },
+	{ "ddarr", 5, 0x21CA, 0x0000 },
+	{ "ograve", 6, 0x00F2, 0x0000 },
+	{ "nRightarrow", 11, 0x21CF, 0x0000 },
+	{ "gjcy", 4, 0x0453, 0x0000 },
+	{ "nvap", 4, 0x224D, 0x20D2 },
+	{ "RightUpTeeVector", 16, 0x295C, 0x0000 },
+	{ "euro", 4, 0x20AC, 0x0000 },
+	{ "timesbar", 8, 0x2A31, 0x0000 },
+	{ "tshcy", 5, 0x045B, 0x0000 },
+	{ "Gfr", 3, 0x1D50A, 0x0000 },
+	{ "Zcy", 3, 0x0417, 0x0000 },
+	{ "vdash", 5, 0x22A2, 0x0000 },
+	{ "varpi", 5, 0x03D6, 0x0000 },
+	{ "DoubleDot", 9, 0x00A8, 0x0000 },
+	{ "prnap", 5, 0x2AB9, 0x0000 },
+	{ "uring", 5, 0x016F, 0x0000 },
+	{ "RightDownTeeVector", 18, 0x295D, 0x0000 },
+	{ "iopf", 4, 0x1D55A, 0x0000 },
+	{ "olcir", 5, 0x29BE, 0x0000 },
+	{ "boxdl", 5, 0x2510, 0x0000 },
+	{ "notni", 5, 0x220C, 0x0000 },
+	{ "scnE", 4, 0x2AB6, 0x0000 },
+	{ "RuleDelayed", 11, 0x29F4, 0x0000 },
+	{ "boxdr", 5, 0x250C, 0x0000 },
+	{ "lharu", 5, 0x21BC, 0x0000 },
+	{ "Ugrave", 6, 0x00D9, 0x0000 },
+	{ "vrtri", 5, 0x22B3, 0x0000 },
+	{ "NotNestedGreaterGreater", 23, 0x2AA2, 0x0338 },
+	{ "preccurlyeq", 11, 0x227C, 0x0000 },
+	{ "ic", 2, 0x2063, 0x0000 },
+	{ "triangledown", 12, 0x25BF, 0x0000 },
+	{ "late", 4, 0x2AAD, 0x0000 },
+	{ "dot", 3, 0x02D9, 0x0000 },
+	{ "mstpos", 6, 0x223E, 0x0000 },
+	{ "Theta", 5, 0x0398, 0x0000 },
+	{ "gopf", 4, 0x1D558, 0x0000 },
+	{ "DifferentialD", 13, 0x2146, 0x0000 },
+	{ "bNot", 4, 0x2AED, 0x0000 },
+	{ "yscr", 4, 0x1D4CE, 0x0000 },
+	{ "succsim", 7, 0x227F, 0x0000 },
+	{ "rhard", 5, 0x21C1, 0x0000 },
+	{ "leq", 3, 0x2264, 0x0000 },
+	{ "comp", 4, 0x2201, 0x0000 },
+	{ "dscr", 4, 0x1D4B9, 0x0000 },
+	{ "Dscr", 4, 0x1D49F, 0x0000 },
+	{ "pre", 3, 0x2AAF, 0x0000 },
+	{ "precnapprox", 11, 0x2AB9, 0x0000 },
+	{ "DiacriticalAcute", 16, 0x00B4, 0x0000 },
+	{ "DoubleLeftRightArrow", 20, 0x21D4, 0x0000 },
+	{ "iukcy", 5, 0x0456, 0x0000 },
+	{ "angmsdac", 8, 0x29AA, 0x0000 },
+	{ "gl", 2, 0x2277, 0x0000 },
+	{ "real", 4, 0x211C, 0x0000 },
+	{ "boxul", 5, 0x2518, 0x0000 },
+	{ "rarrsim", 7, 0x2974, 0x0000 },
+	{ "kcy", 3, 0x043A, 0x0000 },
+	{ "LowerLeftArrow", 14, 0x2199, 0x0000 },
+	{ "nsce", 4, 0x2AB0, 0x0338 },
+	{ "map", 3, 0x21A6, 0x0000 },
+	{ "nexist", 6, 0x2204, 0x0000 },
+	{ "LeftDownVector", 14, 0x21C3, 0x0000 },
+	{ "fpartint", 8, 0x2A0D, 0x0000 },
+	{ "nrarr", 5, 0x219B, 0x0000 },
+	{ "vcy", 3, 0x0432, 0x0000 },
+	{ "prnE", 4, 0x2AB5, 0x0000 },
+	{ "mdash", 5, 0x2014, 0x0000 },
+	{ "NotLeftTriangle", 15, 0x22EA, 0x0000 },
+	{ "not", 3, 0x00AC, 0x0000 },
+	{ "blacksquare", 11, 0x25AA, 0x0000 },
+	{ "reals", 5, 0x211D, 0x0000 },
+	{ "Rsh", 3, 0x21B1, 0x0000 },
+	{ "vangrt", 6, 0x299C, 0x0000 },
+	{ "njcy", 4, 0x045A, 0x0000 },
+	{ "ccaron", 6, 0x010D, 0x0000 },
+	{ "nvrArr", 6, 0x2903, 0x0000 },
+	{ "cularrp", 7, 0x293D, 0x0000 },
+	{ "rppolint", 8, 0x2A12, 0x0000 },
+	{ "pointint", 8, 0x2A15, 0x0000 },
+	{ "lsh", 3, 0x21B0, 0x0000 },
+	{ "eDot", 4, 0x2251, 0x0000 },
+	{ "veebar", 6, 0x22BB, 0x0000 },
+	{ "Omicron", 7, 0x039F, 0x0000 },
+	{ "napos", 5, 0x0149, 0x0000 },
+	{ "hkswarow", 8, 0x2926, 0x0000 },
+	{ "NonBreakingSpace", 16, 0x00A0, 0x0000 },
+	{ "Ntilde", 6, 0x00D1, 0x0000 },
+	{ "angmsdae", 8, 0x29AC, 0x0000 },
+	{ "UpperLeftArrow", 14, 0x2196, 0x0000 },
+	{ "sfr", 3, 0x1D530, 0x0000 },
+	{ "minus", 5, 0x2212, 0x0000 },
+	{ "lrhar", 5, 0x21CB, 0x0000 },
+	{ "ltquest", 7, 0x2A7B, 0x0000 },
+	{ "raemptyv", 8, 0x29B3, 0x0000 },
+	{ "sqsup", 5, 0x2290, 0x0000 },
+	{ "zeetrf", 6, 0x2128, 0x0000 },
+	{ "Vcy", 3, 0x0412, 0x0000 },
+	{ "capbrcup", 8, 0x2A49, 0x0000 },
+	{ "semi", 4, 0x003B, 0x0000 },
+	{ "Succeeds", 8, 0x227B, 0x0000 },
+	{ "lap", 3, 0x2A85, 0x0000 },
+	{ "Omega", 5, 0x03A9, 0x0000 },
+	{ "boxvR", 5, 0x255E, 0x0000 },
+	{ "rightarrow", 10, 0x2192, 0x0000 },
+	{ "Upsilon", 7, 0x03A5, 0x0000 },
+	{ "yucy", 4, 0x044E, 0x0000 },
+	{ "circ", 4, 0x02C6, 0x0000 },
+	{ "UnionPlus", 9, 0x228E, 0x0000 },
+	{ "boxDR", 5, 0x2554, 0x0000 },
+	{ "gtrdot", 6, 0x22D7, 0x0000 },
+	{ "nsube", 5, 0x2288, 0x0000 },
+	{ "egrave", 6, 0x00E8, 0x0000 },
+	{ "rarrb", 5, 0x21E5, 0x0000 },
+	{ "gscr", 4, 0x210A, 0x0000 },
+	{ "planckh", 7, 0x210E, 0x0000 },
+	{ "agrave", 6, 0x00E0, 0x0000 },
+	{ "ofr", 3, 0x1D52C, 0x0000 },
+	{ "ddotseq", 7, 0x2A77, 0x0000 },
+	{ "odsold", 6, 0x29BC, 0x0000 },
+	{ "ReverseEquilibrium", 18, 0x21CB, 0x0000 },
+	{ "Qscr", 4, 0x1D4AC, 0x0000 },
+	{ "precapprox", 10, 0x2AB7, 0x0000 },
+	{ "lowast", 6, 0x2217, 0x0000 },
+	{ "xlarr", 5, 0x27F5, 0x0000 },
+	{ "NotSucceedsTilde", 16, 0x227F, 0x0338 },
+	{ "ForAll", 6, 0x2200, 0x0000 },
+	{ "sce", 3, 0x2AB0, 0x0000 },
+	{ "rcub", 4, 0x007D, 0x0000 },
+	{ "hfr", 3, 0x1D525, 0x0000 },
+	{ "rarr", 4, 0x2192, 0x0000 },
+	{ "trie", 4, 0x225C, 0x0000 },
+	{ "DownLeftVector", 14, 0x21BD, 0x0000 },
+	{ "Barv", 4, 0x2AE7, 0x0000 },
+	{ "VDash", 5, 0x22AB, 0x0000 },
+	{ "cfr", 3, 0x1D520, 0x0000 },
+	{ "updownarrow", 11, 0x2195, 0x0000 },
+	{ "thinsp", 6, 0x2009, 0x0000 },
+	{ "lhblk", 5, 0x2584, 0x0000 },
+	{ "Dcy", 3, 0x0414, 0x0000 },
+	{ "emsp", 4, 0x2003, 0x0000 },
+	{ "RightVector", 11, 0x21C0, 0x0000 },
+	{ "nsimeq", 6, 0x2244, 0x0000 },
+	{ "lessapprox", 10, 0x2A85, 0x0000 },
+	{ "Updownarrow", 11, 0x21D5, 0x0000 },
+	{ "isins", 5, 0x22F4, 0x0000 },
+	{ "rightleftharpoons", 17, 0x21CC, 0x0000 },
+	{ "UnderParenthesis", 16, 0x23DD, 0x0000 },
+	{ "Vert", 4, 0x2016, 0x0000 },
+	{ "varsubsetneqq", 13, 0x2ACB, 0xFE00 },
+	{ "lscr", 4, 0x1D4C1, 0x0000 },
+	{ "sfrown", 6, 0x2322, 0x0000 },
+	{ "UpperRightArrow", 15, 0x2197, 0x0000 },
+	{ "expectation", 11, 0x2130, 0x0000 },
+	{ "vBarv", 5, 0x2AE9, 0x0000 },
+	{ "angst", 5, 0x00C5, 0x0000 },
+	{ "ocir", 4, 0x229A, 0x0000 },
+	{ "lsqb", 4, 0x005B, 0x0000 },
+	{ "DownTee", 7, 0x22A4, 0x0000 },
+	{ "rangle", 6, 0x27E9, 0x0000 },
+	{ "succ", 4, 0x227B, 0x0000 },
+	{ "boxH", 4, 0x2550, 0x0000 },
+	{ "boxhD", 5, 0x2565, 0x0000 },
+	{ "drbkarow", 8, 0x2910, 0x0000 },
+	{ "eacute", 6, 0x00E9, 0x0000 },
+	{ "nlt", 3, 0x226E, 0x0000 },
+	{ "Itilde", 6, 0x0128, 0x0000 },
+	{ "nGg", 3, 0x22D9, 0x0338 },
+	{ "rangd", 5, 0x2992, 0x0000 },
+	{ "telrec", 6, 0x2315, 0x0000 },
+	{ "DownArrow", 9, 0x2193, 0x0000 },
+	{ "HARDcy", 6, 0x042A, 0x0000 },
+	{ "frac34", 6, 0x00BE, 0x0000 },
+	{ "Equal", 5, 0x2A75, 0x0000 },
+	{ "pluscir", 7, 0x2A22, 0x0000 },
+	{ "MinusPlus", 9, 0x2213, 0x0000 },
+	{ "curlywedge", 10, 0x22CF, 0x0000 },
+	{ "prsim", 5, 0x227E, 0x0000 },
+	{ "angzarr", 7, 0x237C, 0x0000 },
+	{ "apacir", 6, 0x2A6F, 0x0000 },
+	{ "solb", 4, 0x29C4, 0x0000 },
+	{ "varnothing", 10, 0x2205, 0x0000 },
+	{ "larrpl", 6, 0x2939, 0x0000 },
+	{ "nesim", 5, 0x2242, 0x0338 },
+	{ "Lang", 4, 0x27EA, 0x0000 },
+	{ "cscr", 4, 0x1D4B8, 0x0000 },
+	{ "half", 4, 0x00BD, 0x0000 },
+	{ "Mscr", 4, 0x2133, 0x0000 },
+	{ "numero", 6, 0x2116, 0x0000 },
+	{ "plussim", 7, 0x2A26, 0x0000 },
+	{ "supsup", 6, 0x2AD6, 0x0000 },
+	{ "wscr", 4, 0x1D4CC, 0x0000 },
+	{ "NotLessTilde", 12, 0x2274, 0x0000 },
+	{ "boxUL", 5, 0x255D, 0x0000 },
+	{ "Tau", 3, 0x03A4, 0x0000 },
+	{ "vltri", 5, 0x22B2, 0x0000 },
+	{ "gammad", 6, 0x03DD, 0x0000 },
+	{ "upsi", 4, 0x03C5, 0x0000 },
+	{ "siml", 4, 0x2A9D, 0x0000 },
+	{ "rfisht", 6, 0x297D, 0x0000 },
+	{ "par", 3, 0x2225, 0x0000 },
+	{ "hoarr", 5, 0x21FF, 0x0000 },
+	{ "Downarrow", 9, 0x21D3, 0x0000 },
+	{ "shortparallel", 13, 0x2225, 0x0000 },
+	{ "tscy", 4, 0x0446, 0x0000 },
+	{ "clubs", 5, 0x2663, 0x0000 },
+	{ "ordf", 4, 0x00AA, 0x0000 },
+	{ "succapprox", 10, 0x2AB8, 0x0000 },
+	{ "Rcy", 3, 0x0420, 0x0000 },
+	{ "NotHumpDownHump", 15, 0x224E, 0x0338 },
+	{ "leftleftarrows", 14, 0x21C7, 0x0000 },
+	{ "xi", 2, 0x03BE, 0x0000 },
+	{ "quaternions", 11, 0x210D, 0x0000 },
+	{ "zcaron", 6, 0x017E, 0x0000 },
+	{ "becaus", 6, 0x2235, 0x0000 },
+	{ "ENG", 3, 0x014A, 0x0000 },
+	{ "boxUl", 5, 0x255C, 0x0000 },
+	{ "Lopf", 4, 0x1D543, 0x0000 },
+	{ "starf", 5, 0x2605, 0x0000 },
+	{ "target", 6, 0x2316, 0x0000 },
+	{ "SmallCircle", 11, 0x2218, 0x0000 },
+	{ "vsubne", 6, 0x228A, 0xFE00 },
+	{ "nle", 3, 0x2270, 0x0000 },
+	{ "dtri", 4, 0x25BF, 0x0000 },
+	{ "Utilde", 6, 0x0168, 0x0000 },
+	{ "boxHd", 5, 0x2564, 0x0000 },
+	{ "varsigma", 8, 0x03C2, 0x0000 },
+	{ "NotSucceeds", 11, 0x2281, 0x0000 },
+	{ "Dashv", 5, 0x2AE4, 0x0000 },
+	{ "LeftUpVectorBar", 15, 0x2958, 0x0000 },
+	{ "Ycy", 3, 0x042B, 0x0000 },
+	{ "Backslash", 9, 0x2216, 0x0000 },
+	{ "PlusMinus", 9, 0x00B1, 0x0000 },
+	{ "NewLine", 7, 0x000A, 0x0000 },
+	{ "NotSquareSuperset", 17, 0x2290, 0x0338 },
+	{ "nis", 3, 0x22FC, 0x0000 },
+	{ "Hat", 3, 0x005E, 0x0000 },
+	{ "oopf", 4, 0x1D560, 0x0000 },
+	{ "ne", 2, 0x2260, 0x0000 },
+	{ "NotExists", 9, 0x2204, 0x0000 },
+	{ "npar", 4, 0x2226, 0x0000 },
+	{ "backcong", 8, 0x224C, 0x0000 },
+	{ "nges", 4, 0x2A7E, 0x0338 },
+	{ "boxvH", 5, 0x256A, 0x0000 },
+	{ "caret", 5, 0x2041, 0x0000 },
+	{ "Xi", 2, 0x039E, 0x0000 },
+	{ "Vvdash", 6, 0x22AA, 0x0000 },
+	{ "Cap", 3, 0x22D2, 0x0000 },
+	{ "squf", 4, 0x25AA, 0x0000 },
+	{ "cupor", 5, 0x2A45, 0x0000 },
+	{ "Ascr", 4, 0x1D49C, 0x0000 },
+	{ "subedot", 7, 0x2AC3, 0x0000 },
+	{ "Cup", 3, 0x22D3, 0x0000 },
+	{ "leqslant", 8, 0x2A7D, 0x0000 },
+	{ "rsquo", 5, 0x2019, 0x0000 },
+	{ "lesdot", 6, 0x2A7F, 0x0000 },
+	{ "dcaron", 6, 0x010F, 0x0000 },
+	{ "NotNestedLessLess", 17, 0x2AA1, 0x0338 },
+	{ "rcedil", 6, 0x0157, 0x0000 },
+	{ "cuvee", 5, 0x22CE, 0x0000 },
+	{ "rightthreetimes", 15, 0x22CC, 0x0000 },
+	{ "UnderBracket", 12, 0x23B5, 0x0000 },
+	{ "NotDoubleVerticalBar", 20, 0x2226, 0x0000 },
+	{ "Integral", 8, 0x222B, 0x0000 },
+	{ "fltns", 5, 0x25B1, 0x0000 },
+	{ "bopf", 4, 0x1D553, 0x0000 },
+	{ "eogon", 5, 0x0119, 0x0000 },
+	{ "RightFloor", 10, 0x230B, 0x0000 },
+	{ "odiv", 4, 0x2A38, 0x0000 },
+	{ "rbbrk", 5, 0x2773, 0x0000 },
+	{ "kgreen", 6, 0x0138, 0x0000 },
+	{ "Union", 5, 0x22C3, 0x0000 },
+	{ "smile", 5, 0x2323, 0x0000 },
+	{ "sqcaps", 6, 0x2293, 0xFE00 },
+	{ "chcy", 4, 0x0447, 0x0000 },
+	{ "lozf", 4, 0x29EB, 0x0000 },
+	{ "kappav", 6, 0x03F0, 0x0000 },
+	{ "Jsercy", 6, 0x0408, 0x0000 },
+	{ "bernou", 6, 0x212C, 0x0000 },
+	{ "TildeFullEqual", 14, 0x2245, 0x0000 },
+	{ "curarr", 6, 0x21B7, 0x0000 },
+	{ "rscr", 4, 0x1D4C7, 0x0000 },
+	{ "Igrave", 6, 0x00CC, 0x0000 },
+	{ "vellip", 6, 0x22EE, 0x0000 },
+	{ "nGt", 3, 0x226B, 0x20D2 },
+	{ "xwedge", 6, 0x22C0, 0x0000 },
+	{ "iocy", 4, 0x0451, 0x0000 },
+	{ "ohm", 3, 0x03A9, 0x0000 },
+	{ "frac18", 6, 0x215B, 0x0000 },
+	{ "phmmat", 6, 0x2133, 0x0000 },
+	{ "hercon", 6, 0x22B9, 0x0000 },
+	{ "plus", 4, 0x002B, 0x0000 },
+	{ "shy", 3, 0x00AD, 0x0000 },
+	{ "bsolb", 5, 0x29C5, 0x0000 },
+	{ "imath", 5, 0x0131, 0x0000 },
+	{ "nhpar", 5, 0x2AF2, 0x0000 },
+	{ "prod", 4, 0x220F, 0x0000 },
+	{ "sopf", 4, 0x1D564, 0x0000 },
+	{ "Icirc", 5, 0x00CE, 0x0000 },
+	{ "nacute", 6, 0x0144, 0x0000 },
+	{ "rAarr", 5, 0x21DB, 0x0000 },
+	{ "nvlt", 4, 0x003C, 0x20D2 },
+	{ "notnivc", 7, 0x22FD, 0x0000 },
+	{ "thkap", 5, 0x2248, 0x0000 },
+	{ "Im", 2, 0x2111, 0x0000 },
+	{ "lesseqgtr", 9, 0x22DA, 0x0000 },
+	{ "trpezium", 8, 0x23E2, 0x0000 },
+	{ "geqq", 4, 0x2267, 0x0000 },
+	{ "oror", 4, 0x2A56, 0x0000 },
+	{ "num", 3, 0x0023, 0x0000 },
+	{ "uparrow", 7, 0x2191, 0x0000 },
+	{ "Rrightarrow", 11, 0x21DB, 0x0000 },
+	{ "aring", 5, 0x00E5, 0x0000 },
+	{ "zeta", 4, 0x03B6, 0x0000 },
+	{ "LeftArrow", 9, 0x2190, 0x0000 },
+	{ "nang", 4, 0x2220, 0x20D2 },
+	{ "LeftAngleBracket", 16, 0x27E8, 0x0000 },
+	{ "Barwed", 6, 0x2306, 0x0000 },
+	{ "ensp", 4, 0x2002, 0x0000 },
+	{ "vzigzag", 7, 0x299A, 0x0000 },
+	{ "larrhk", 6, 0x21A9, 0x0000 },
+	{ "subE", 4, 0x2AC5, 0x0000 },
+	{ "ShortUpArrow", 12, 0x2191, 0x0000 },
+	{ "gsiml", 5, 0x2A90, 0x0000 },
+	{ "nprcue", 6, 0x22E0, 0x0000 },
+	{ "aelig", 5, 0x00E6, 0x0000 },
+	{ "LeftTeeVector", 13, 0x295A, 0x0000 },
+	{ "sccue", 5, 0x227D, 0x0000 },
+	{ "Kcedil", 6, 0x0136, 0x0000 },
+	{ "mho", 3, 0x2127, 0x0000 },
+	{ "Tstrok", 6, 0x0166, 0x0000 },
+	{ "DownArrowUpArrow", 16, 0x21F5, 0x0000 },
+	{ "cedil", 5, 0x00B8, 0x0000 },
+	{ "ac", 2, 0x223E, 0x0000 },
+	{ "boxHD", 5, 0x2566, 0x0000 },
+	{ "NotSupersetEqual", 16, 0x2289, 0x0000 },
+	{ "NotGreaterLess", 14, 0x2279, 0x0000 },
+	{ "nrArr", 5, 0x21CF, 0x0000 },
+	{ "oint", 4, 0x222E, 0x0000 },
+	{ "uuarr", 5, 0x21C8, 0x0000 },
+	{ "cylcty", 6, 0x232D, 0x0000 },
+	{ "fallingdotseq", 13, 0x2252, 0x0000 },
+	{ "eopf", 4, 0x1D556, 0x0000 },
+	{ "leftarrowtail", 13, 0x21A2, 0x0000 },
+	{ "OverBracket", 11, 0x23B4, 0x0000 },
+	{ "tint", 4, 0x222D, 0x0000 },
+	{ "hellip", 6, 0x2026, 0x0000 },
+	{ "Sopf", 4, 0x1D54A, 0x0000 },
+	{ "male", 4, 0x2642, 0x0000 },
+	{ "udhar", 5, 0x296E, 0x0000 },
+	{ "Eopf", 4, 0x1D53C, 0x0000 },
+	{ "notinE", 6, 0x22F9, 0x0338 },
+	{ "NotGreaterEqual", 15, 0x2271, 0x0000 },
+	{ "eqcolon", 7, 0x2255, 0x0000 },
+	{ "nparallel", 9, 0x2226, 0x0000 },
+	{ "sol", 3, 0x002F, 0x0000 },
+	{ "smeparsl", 8, 0x29E4, 0x0000 },
+	{ "Nopf", 4, 0x2115, 0x0000 },
+	{ "xcap", 4, 0x22C2, 0x0000 },
+	{ "jopf", 4, 0x1D55B, 0x0000 },
+	{ "operp", 5, 0x29B9, 0x0000 },
+	{ "ast", 3, 0x002A, 0x0000 },
+	{ "rceil", 5, 0x2309, 0x0000 },
+	{ "eqslantless", 11, 0x2A95, 0x0000 },
+	{ "tcy", 3, 0x0442, 0x0000 },
+	{ "cong", 4, 0x2245, 0x0000 },
+	{ "Lleftarrow", 10, 0x21DA, 0x0000 },
+	{ "Zscr", 4, 0x1D4B5, 0x0000 },
+	{ "popf", 4, 0x1D561, 0x0000 },
+	{ "nwarhk", 6, 0x2923, 0x0000 },
+	{ "DoubleVerticalBar", 17, 0x2225, 0x0000 },
+	{ "erDot", 5, 0x2253, 0x0000 },
+	{ "hookrightarrow", 14, 0x21AA, 0x0000 },
+	{ "grave", 5, 0x0060, 0x0000 },
+	{ "Hfr", 3, 0x210C, 0x0000 },
+	{ "rtriltri", 8, 0x29CE, 0x0000 },
+	{ "nvHarr", 6, 0x2904, 0x0000 },
+	{ "lcy", 3, 0x043B, 0x0000 },
+	{ "wfr", 3, 0x1D534, 0x0000 },
+	{ "cemptyv", 7, 0x29B2, 0x0000 },
+	{ "measuredangle", 13, 0x2221, 0x0000 },
+	{ "profalar", 8, 0x232E, 0x0000 },
+	{ "DD", 2, 0x2145, 0x0000 },
+	{ "ssmile", 6, 0x2323, 0x0000 },
+	{ "geqslant", 8, 0x2A7E, 0x0000 },
+	{ "Rfr", 3, 0x211C, 0x0000 },
+	{ "gfr", 3, 0x1D524, 0x0000 },
+	{ "fnof", 4, 0x0192, 0x0000 },
+	{ "sup1", 4, 0x00B9, 0x0000 },
+	{ "ofcir", 5, 0x29BF, 0x0000 },
+	{ "questeq", 7, 0x225F, 0x0000 },
+	{ "elinters", 8, 0x23E7, 0x0000 },
+	{ "jmath", 5, 0x0237, 0x0000 },
+	{ "Abreve", 6, 0x0102, 0x0000 },
+	{ "zhcy", 4, 0x0436, 0x0000 },
+	{ "tdot", 4, 0x20DB, 0x0000 },
+	{ "mcomma", 6, 0x2A29, 0x0000 },
+	{ "Oslash", 6, 0x00D8, 0x0000 },
+	{ "raquo", 5, 0x00BB, 0x0000 },
+	{ "cuesc", 5, 0x22DF, 0x0000 },
+	{ "Superset", 8, 0x2283, 0x0000 },
+	{ "neArr", 5, 0x21D7, 0x0000 },
+	{ "blk34", 5, 0x2593, 0x0000 },
+	{ "triangleleft", 12, 0x25C3, 0x0000 },
+	{ "DownBreve", 9, 0x0311, 0x0000 },
+	{ "NotLeftTriangleEqual", 20, 0x22EC, 0x0000 },
+	{ "nsucceq", 7, 0x2AB0, 0x0338 },
+	{ "nharr", 5, 0x21AE, 0x0000 },
+	{ "TripleDot", 9, 0x20DB, 0x0000 },
+	{ "parsim", 6, 0x2AF3, 0x0000 },
+	{ "beta", 4, 0x03B2, 0x0000 },
+	{ "simplus", 7, 0x2A24, 0x0000 },
+	{ "edot", 4, 0x0117, 0x0000 },
+	{ "gesdoto", 7, 0x2A82, 0x0000 },
+	{ "ffilig", 6, 0xFB03, 0x0000 },
+	{ "nsubseteq", 9, 0x2288, 0x0000 },
+	{ "opar", 4, 0x29B7, 0x0000 },
+	{ "period", 6, 0x002E, 0x0000 },
+	{ "angmsdah", 8, 0x29AF, 0x0000 },
+	{ "orderof", 7, 0x2134, 0x0000 },
+	{ "upsih", 5, 0x03D2, 0x0000 },
+	{ "drcorn", 6, 0x231F, 0x0000 },
+	{ "empty", 5, 0x2205, 0x0000 },
+	{ "blacktriangledown", 17, 0x25BE, 0x0000 },
+	{ "ncup", 4, 0x2A42, 0x0000 },
+	{ "subseteqq", 9, 0x2AC5, 0x0000 },
+	{ "ngsim", 5, 0x2275, 0x0000 },
+	{ "ucy", 3, 0x0443, 0x0000 },
+	{ "Ropf", 4, 0x211D, 0x0000 },
+	{ "ShortDownArrow", 14, 0x2193, 0x0000 },
+	{ "Imacr", 5, 0x012A, 0x0000 },
+	{ "lcedil", 6, 0x013C, 0x0000 },
+	{ "ngeqslant", 9, 0x2A7E, 0x0338 },
+	{ "congdot", 7, 0x2A6D, 0x0000 },
+	{ "CHcy", 4, 0x0427, 0x0000 },
+	{ "SuchThat", 8, 0x220B, 0x0000 },
+	{ "Equilibrium", 11, 0x21CC, 0x0000 },
+	{ "emsp13", 6, 0x2004, 0x0000 },
+	{ "Re", 2, 0x211C, 0x0000 },
+	{ "Cfr", 3, 0x212D, 0x0000 },
+	{ "rcaron", 6, 0x0159, 0x0000 },
+	{ "thorn", 5, 0x00FE, 0x0000 },
+	{ "vfr", 3, 0x1D533, 0x0000 },
+	{ "intcal", 6, 0x22BA, 0x0000 },
+	{ "prop", 4, 0x221D, 0x0000 },
+	{ "csupe", 5, 0x2AD2, 0x0000 },
+	{ "prime", 5, 0x2032, 0x0000 },
+	{ "Vbar", 4, 0x2AEB, 0x0000 },
+	{ "boxVl", 5, 0x2562, 0x0000 },
+	{ "Auml", 4, 0x00C4, 0x0000 },
+	{ "ldquo", 5, 0x201C, 0x0000 },
+	{ "hardcy", 6, 0x044A, 0x0000 },
+	{ "nrarrw", 6, 0x219D, 0x0338 },
+	{ "xscr", 4, 0x1D4CD, 0x0000 },
+	{ "divideontimes", 13, 0x22C7, 0x0000 },
+	{ "realpart", 8, 0x211C, 0x0000 },
+	{ "breve", 5, 0x02D8, 0x0000 },
+	{ "nrarrc", 6, 0x2933, 0x0338 },
+	{ "boxdR", 5, 0x2552, 0x0000 },
+	{ "nshortmid", 9, 0x2224, 0x0000 },
+	{ "simne", 5, 0x2246, 0x0000 },
+	{ "CenterDot", 9, 0x00B7, 0x0000 },
+	{ "LeftUpDownVector", 16, 0x2951, 0x0000 },
+	{ "lsaquo", 6, 0x2039, 0x0000 },
+	{ "twoheadrightarrow", 17, 0x21A0, 0x0000 },
+	{ "Jcy", 3, 0x0419, 0x0000 },
+	{ "supseteqq", 9, 0x2AC6, 0x0000 },
+	{ "nlArr", 5, 0x21CD, 0x0000 },
+	{ "rotimes", 7, 0x2A35, 0x0000 },
+	{ "Tcaron", 6, 0x0164, 0x0000 },
+	{ "lsquor", 6, 0x201A, 0x0000 },
+	{ "lagran", 6, 0x2112, 0x0000 },
+	{ "ndash", 5, 0x2013, 0x0000 },
+	{ "IJlig", 5, 0x0132, 0x0000 },
+	{ "beth", 4, 0x2136, 0x0000 },
+	{ "nles", 4, 0x2A7D, 0x0338 },
+	{ "intercal", 8, 0x22BA, 0x0000 },
+	{ "GreaterEqualLess", 16, 0x22DB, 0x0000 },
+	{ "NotTildeEqual", 13, 0x2244, 0x0000 },
+	{ "deg", 3, 0x00B0, 0x0000 },
+	{ "cuepr", 5, 0x22DE, 0x0000 },
+	{ "vArr", 4, 0x21D5, 0x0000 },
+	{ "ltdot", 5, 0x22D6, 0x0000 },
+	{ "ugrave", 6, 0x00F9, 0x0000 },
+	{ "swarrow", 7, 0x2199, 0x0000 },
+	{ "twoheadleftarrow", 16, 0x219E, 0x0000 },
+	{ "race", 4, 0x223D, 0x0331 },
+	{ "cirE", 4, 0x29C3, 0x0000 },
+	{ "lcub", 4, 0x007B, 0x0000 },
+	{ "urcrop", 6, 0x230E, 0x0000 },
 };
 
-static EntityDef s_entityArray [] = {
-	{ "quot", 34 },
-	{ "amp", 38 },
-	{ "lt", 60 },
-	{ "gt", 62 },
-	{ "nbsp", 160 },
-	{ "iexcl", 161 },
-	{ "cent", 162 },
-	{ "pound", 163 },
-	{ "curren", 164 },
-	{ "yen", 165 },
-	{ "brvbar", 166 },
-	{ "sect", 167 },
-	{ "uml", 168 },
-	{ "copy", 169 },
-	{ "ordf", 170 },
-	{ "laquo", 171 },
-	{ "not", 172 },
-	{ "shy", 173 },
-	{ "reg", 174 },
-	{ "macr", 175 },
-	{ "deg", 176 },
-	{ "plusmn", 177 },
-	{ "sup2", 178 },
-	{ "sup3", 179 },
-	{ "acute", 180 },
-	{ "micro", 181 },
-	{ "para", 182 },
-	{ "middot", 183 },
-	{ "cedil", 184 },
-	{ "sup1", 185 },
-	{ "ordm", 186 },
-	{ "raquo", 187 },
-	{ "frac14", 188 },
-	{ "frac12", 189 },
-	{ "frac34", 190 },
-	{ "iquest", 191 },
-	{ "Agrave", 192 },
-	{ "Aacute", 193 },
-	{ "Acirc", 194 },
-	{ "Atilde", 195 },
-	{ "Auml", 196 },
-	{ "Aring", 197 },
-	{ "AElig", 198 },
-	{ "Ccedil", 199 },
-	{ "Egrave", 200 },
-	{ "Eacute", 201 },
-	{ "Ecirc", 202 },
-	{ "Euml", 203 },
-	{ "Igrave", 204 },
-	{ "Iacute", 205 },
-	{ "Icirc", 206 },
-	{ "Iuml", 207 },
-	{ "ETH", 208 },
-	{ "Ntilde", 209 },
-	{ "Ograve", 210 },
-	{ "Oacute", 211 },
-	{ "Ocirc", 212 },
-	{ "Otilde", 213 },
-	{ "Ouml", 214 },
-	{ "times", 215 },
-	{ "Oslash", 216 },
-	{ "Ugrave", 217 },
-	{ "Uacute", 218 },
-	{ "Ucirc", 219 },
-	{ "Uuml", 220 },
-	{ "Yacute", 221 },
-	{ "THORN", 222 },
-	{ "szlig", 223 },
-	{ "agrave", 224 },
-	{ "aacute", 225 },
-	{ "acirc", 226 },
-	{ "atilde", 227 },
-	{ "auml", 228 },
-	{ "aring", 229 },
-	{ "aelig", 230 },
-	{ "ccedil", 231 },
-	{ "egrave", 232 },
-	{ "eacute", 233 },
-	{ "ecirc", 234 },
-	{ "euml", 235 },
-	{ "igrave", 236 },
-	{ "iacute", 237 },
-	{ "icirc", 238 },
-	{ "iuml", 239 },
-	{ "eth", 240 },
-	{ "ntilde", 241 },
-	{ "ograve", 242 },
-	{ "oacute", 243 },
-	{ "ocirc", 244 },
-	{ "otilde", 245 },
-	{ "ouml", 246 },
-	{ "divide", 247 },
-	{ "oslash", 248 },
-	{ "ugrave", 249 },
-	{ "uacute", 250 },
-	{ "ucirc", 251 },
-	{ "uuml", 252 },
-	{ "yacute", 253 },
-	{ "thorn", 254 },
-	{ "yuml", 255 },
-	{ "OElig", 338 },
-	{ "oelig", 339 },
-	{ "Scaron", 352 },
-	{ "scaron", 353 },
-	{ "Yuml", 376 },
-	{ "fnof", 402 },
-	{ "circ", 710 },
-	{ "tilde", 732 },
-	{ "Alpha", 913 },
-	{ "Beta", 914 },
-	{ "Gamma", 915 },
-	{ "Delta", 916 },
-	{ "Epsilon", 917 },
-	{ "Zeta", 918 },
-	{ "Eta", 919 },
-	{ "Theta", 920 },
-	{ "Iota", 921 },
-	{ "Kappa", 922 },
-	{ "Lambda", 923 },
-	{ "Mu", 924 },
-	{ "Nu", 925 },
-	{ "Xi", 926 },
-	{ "Omicron", 927 },
-	{ "Pi", 928 },
-	{ "Rho", 929 },
-	{ "Sigma", 931 },
-	{ "Tau", 932 },
-	{ "Upsilon", 933 },
-	{ "Phi", 934 },
-	{ "Chi", 935 },
-	{ "Psi", 936 },
-	{ "Omega", 937 },
-	{ "alpha", 945 },
-	{ "beta", 946 },
-	{ "gamma", 947 },
-	{ "delta", 948 },
-	{ "epsilon", 949 },
-	{ "zeta", 950 },
-	{ "eta", 951 },
-	{ "theta", 952 },
-	{ "iota", 953 },
-	{ "kappa", 954 },
-	{ "lambda", 955 },
-	{ "mu", 956 },
-	{ "nu", 957 },
-	{ "xi", 958 },
-	{ "omicron", 959 },
-	{ "pi", 960 },
-	{ "rho", 961 },
-	{ "sigmaf", 962 },
-	{ "sigma", 963 },
-	{ "tau", 964 },
-	{ "upsilon", 965 },
-	{ "phi", 966 },
-	{ "chi", 967 },
-	{ "psi", 968 },
-	{ "omega", 969 },
-	{ "thetasym", 977 },
-	{ "upsih", 978 },
-	{ "piv", 982 },
-	{ "ensp", 8194 },
-	{ "emsp", 8195 },
-	{ "thinsp", 8201 },
-	{ "zwnj", 8204 },
-	{ "zwj", 8205 },
-	{ "lrm", 8206 },
-	{ "rlm", 8207 },
-	{ "ndash", 8211 },
-	{ "mdash", 8212 },
-	{ "lsquo", 8216 },
-	{ "rsquo", 8217 },
-	{ "sbquo", 8218 },
-	{ "ldquo", 8220 },
-	{ "rdquo", 8221 },
-	{ "bdquo", 8222 },
-	{ "dagger", 8224 },
-	{ "Dagger", 8225 },
-	{ "bull", 8226 },
-	{ "hellip", 8230 },
-	{ "permil", 8240 },
-	{ "prime", 8242 },
-	{ "Prime", 8243 },
-	{ "lsaquo", 8249 },
-	{ "rsaquo", 8250 },
-	{ "oline", 8254 },
-	{ "frasl", 8260 },
-	{ "euro", 8364 },
-	{ "image", 8465 },
-	{ "weierp", 8472 },
-	{ "real", 8476 },
-	{ "trade", 8482 },
-	{ "alefsym", 8501 },
-	{ "larr", 8592 },
-	{ "uarr", 8593 },
-	{ "rarr", 8594 },
-	{ "darr", 8595 },
-	{ "harr", 8596 },
-	{ "crarr", 8629 },
-	{ "lArr", 8656 },
-	{ "uArr", 8657 },
-	{ "rArr", 8658 },
-	{ "dArr", 8659 },
-	{ "hArr", 8660 },
-	{ "forall", 8704 },
-	{ "part", 8706 },
-	{ "exist", 8707 },
-	{ "empty", 8709 },
-	{ "nabla", 8711 },
-	{ "isin", 8712 },
-	{ "notin", 8713 },
-	{ "ni", 8715 },
-	{ "prod", 8719 },
-	{ "sum", 8721 },
-	{ "minus", 8722 },
-	{ "lowast", 8727 },
-	{ "radic", 8730 },
-	{ "prop", 8733 },
-	{ "infin", 8734 },
-	{ "ang", 8736 },
-	{ "and", 8743 },
-	{ "or", 8744 },
-	{ "cap", 8745 },
-	{ "cup", 8746 },
-	{ "int", 8747 },
-	{ "there4", 8756 },
-	{ "sim", 8764 },
-	{ "cong", 8773 },
-	{ "asymp", 8776 },
-	{ "ne", 8800 },
-	{ "equiv", 8801 },
-	{ "le", 8804 },
-	{ "ge", 8805 },
-	{ "sub", 8834 },
-	{ "sup", 8835 },
-	{ "nsub", 8836 },
-	{ "sube", 8838 },
-	{ "supe", 8839 },
-	{ "oplus", 8853 },
-	{ "otimes", 8855 },
-	{ "perp", 8869 },
-	{ "sdot", 8901 },
-	{ "lceil", 8968 },
-	{ "rceil", 8969 },
-	{ "lfloor", 8970 },
-	{ "rfloor", 8971 },
-	{ "lang", 9001 },
-	{ "rang", 9002 },
-	{ "loz", 9674 },
-	{ "spades", 9824 },
-	{ "clubs", 9827 },
-	{ "hearts", 9829 },
-	{ "diams", 9830 },
-	{ "", 0 }
+static const gint16 s_entityDisplacement[ENTITY_COUNT] = {
+	-2123, 8, 0, 5, 3, -2119, 1, -2117, 0, 1, 0, 0,
+	1, 1, 0, 5, 0, 0, 1, 0, 0, -2115, 0, -2111,
+	4, 0, 1, 0, 3, 0, -2109, 0, -2107, 1, -2101, -2096,
+	1, 0, 0, 1, 3, 0, -2095, 0, 1, -2090, -2085, -2084,
+	0, 0, 0, 1, 1, 1, -2081, -2079, 0, 0, -2077, -2074,
+	7, 0, 0, 0, 4, -2072, -2070, 0, -2069, 0, -2068, 1,
+	0, -2067, -2061, 0, 3, 1, 0, 1, -2060, 0, -2054, 3,
+	0, 0, 0, 1, 0, -2053, 1, 2, 1, -2047, 0, 3,
+	0, 8, -2044, 2, 1, -2042, -2040, -2039, -2037, 2, -2036, -2032,
+	-2030, 0, 2, 3, 1, 2, 0, -2027, 1, 0, 0, -2026,
+	2, 0, 0, -2024, -2023, -2022, -2021, -2018, 0, 3, -2016, -2015,
+	-2012, 1, -2011, 0, 1, 1, 0, 0, 1, 0, -2010, 1,
+	0, -2009, 0, 0, 0, 1, 0, -2004, 0, 2, 0, -1999,
+	2, 0, 1, -1996, 0, 1, -1991, -1986, 0, -1978, 2, 0,
+	1, 0, 1, 0, 0, -1975, 1, 0, -1971, 0, 0, -1970,
+	0, 0, 1, 0, -1961, 3, 1, 2, -1959, 2, 1, 1,
+	-1958, -1957, 0, -1955, 1, -1940, -1939, 0, 0, 0, 2, -1935,
+	1, 0, -1934, 0, 0, -1932, 0, -1926, 0, 1, 7, -1924,
+	3, -1921, 2, 1, 0, 3, 0, 0, 0, -1920, -1916, -1913,
+	0, 0, 1, -1911, 1, 1, -1905, 0, 0, 1, 2, -1904,
+	-1894, 0, 0, 0, 0, -1892, 0, -1888, -1887, -1885, 1, 9,
+	2, -1884, 1, 0, 0, -1883, -1882, -1875, -1873, -1872, -1871, 0,
+	-1867, -1864, -1862, -1859, -1858, -1855, 0, 0, 1, -1847, -1846, 13,
+	0, 0, 1, 0, 0, -1843, -1842, -1841, -1839, 0, -1838, 0,
+	0, -1835, 1, -1834, 3, 0, 3, 0, -1829, 0, 2, 0,
+	-1826, 0, 0, -1824, 1, 2, 5, -1823, -1821, -1808, 1, 1,
+	0, 0, 1, 4, 0, 1, -1807, 5, 0, -1805, 2, 0,
+	3, 1, 1, -1803, -1802, 2, 0, 0, 1, -1797, -1795, -1794,
+	0, 1, -1791, -1790, 1, -1789, -1781, 3, -1779, -1778, 0, -1777,
+	0, -1776, 0, 0, -1771, 0, 3, -1768, 1, -1767, 0, 0,
+	1, -1765, 2, -1764, 0, -1763, 0, -1760, 0, 10, 0, 0,
+	0, -1756, 0, -1743, 0, -1742, -1740, 0, -1736, 1, 1, -1733,
+	-1732, -1730, 6, 2, 2, 0, 1, 1, 0, -1727, -1726, 0,
+	0, -1725, -1724, 1, -1720, 0, 3, -1718, 0, -1717, -1715, -1714,
+	0, 0, -1713, 2, 0, -1712, 1, 1, 0, -1710, 2, 1,
+	-1709, 1, 0, 0, 0, -1707, 6, -1705, 2, 0, -1703, -1701,
+	-1700, 1, 1, 0, 0, 0, 2, -1693, 0, -1689, -1687, 1,
+	0, 3, -1685, -1684, -1682, 4, -1681, 0, -1680, 1, 0, -1674,
+	2, 0, -1671, -1669, 0, 0, 0, 3, -1667, 0, 0, 1,
+	0, 0, 2, 1, 1, -1664, 0, 0, -1663, 3, 0, 0,
+	1, -1658, -1657, -1656, 0, 1, -1654, -1652, 0, 1, 1, 0,
+	0, 2, -1649, 0, -1646, 0, 0, 0, 0, 0, 0, 3,
+	-1635, -1634, 0, 0, -1629, 1, -1627, -1626, 0, 0, -1623, 0,
+	0, -1616, 5, 1, -1614, 0, 0, 0, 0, -1611, 1, -1610,
+	0, -1603, -1601, -1600, 0, 0, 3, 2, -1598, -1597, 0, -1592,
+	0, 0, 1, 0, 1, 4, -1590, -1589, 1, 0, 0, -1588,
+	-1587, -1584, 0, 0, -1583, 0, -1581, -1574, 5, 2, -1571, -1568,
+	1, 0, 1, 0, -1566, -1562, -1559, 1, 0, 3, -1556, 0,
+	-1554, -1550, 1, 4, -1549, -1542, 0, 0, -1538, -1537, 3, 8,
+	-1535, 0, 0, 3, -1533, 3, -1523, 1, 2, 0, 0, 6,
+	-1521, 0, 0, 0, 0, 7, -1519, 0, 2, 1, -1514, 0,
+	1, -1513, 0, 0, 0, 0, -1508, -1506, -1505, 0, 1, 0,
+	3, -1501, 2, 1, 0, 0, -1500, -1499, 0, 0, -1498, 0,
+	3, 0, 0, 2, -1497, 0, 0, 1, 0, 1, 5, 0,
+	-1490, 3, -1489, 0, 0, 0, 0, 3, -1487, 3, 0, -1486,
+	0, -1480, 7, -1476, 1, 1, 0, -1475, -1474, 2, -1473, 3,
+	1, 1, -1469, 0, 0, 0, 2, -1467, -1463, -1462, 1, 0,
+	0, 5, -1460, 0, -1459, 1, 0, 1, -1455, 0, 0, 0,
+	0, -1453, 0, 0, -1452, 2, 0, -1449, -1448, 1, 0, -1447,
+	4, -1446, -1441, -1438, -1436, 3, 3, 0, -1433, 0, -1432, -1431,
+	-1429, 1, 1, 0, 1, 0, 0, 4, -1428, 1, 0, -1427,
+	1, -1426, 0, -1422, 0, 1, -1420, 1, 3, 0, 0, -1417,
+	-1416, 1, -1415, -1411, 0, -1409, -1407, 1, 1, 6, 0, 2,
+	-1406, 0, 1, 0, 5, 0, 0, 0, -1403, 0, 7, -1402,
+	0, 0, -1399, -1398, 0, -1397, -1395, -1394, -1392, 0, -1386, 0,
+	-1381, -1379, 4, -1377, 0, 8, -1376, -1375, -1371, 0, 2, -1366,
+	0, 0, 0, 2, 1, -1363, -1358, 0, 7, -1353, 4, 0,
+	0, 0, -1350, 2, -1349, 1, -1345, 0, 0, -1340, 1, -1338,
+	-1336, -1335, 0, -1334, 0, 1, 4, -1331, 1, -1330, -1323, 0,
+	-1319, -1317, -1316, -1314, -1311, -1307, 0, 0, -1301, 0, 1, 0,
+	0, 2, 1, 0, -1297, 1, -1295, 1, 0, 6, 0, -1293,
+	-1291, -1288, 1, -1287, 0, -1283, 0, -1281, 0, 0, -1269, 2,
+	-1268, -1264, 2, -1261, 1, 0, 0, 0, 2, 1, -1256, 0,
+	0, 2, 1, -1252, 1, -1250, 0, 0, 0, 0, -1245, 0,
+	-1244, 4, -1242, 0, 0, 0, 0, 0, 0, 0, -1240, 7,
+	0, 0, 0, 0, 2, 2, 0, 11, -1238, 2, 1, -1237,
+	-1235, -1225, -1224, 3, 0, 0, 0, -1221, -1218, 2, 0, -1213,
+	1, -1211, 3, 1, 1, -1210, -1208, 2, -1204, -1199, -1198, 0,
+	0, 0, -1196, -1193, 3, -1190, 0, 2, 1, -1182, -1181, 0,
+	0, -1176, 1, 1, -1169, 0, 5, 0, 0, -1168, -1166, 0,
+	0, 1, 2, -1165, -1164, 0, -1161, 1, 0, 0, -1160, -1157,
+	1, -1155, 0, -1147, 2, 0, 0, 0, -1145, 0, 2, 0,
+	0, 0, 0, -1143, 0, 1, -1141, -1140, -1137, 0, 0, 2,
+	5, 1, -1130, 0, 0, -1128, 0, 0, -1126, 0, 0, 2,
+	0, -1124, -1120, 0, 0, -1117, -1115, 2, -1110, 0, -1106, -1104,
+	0, -1103, -1101, 8, -1099, 2, -1098, 3, 0, -1093, 0, 0,
+	0, 0, 0, -1092, 0, -1089, -1082, 0, 0, -1078, 0, 3,
+	0, -1077, 0, -1075, 1, 1, 1, -1072, 0, 1, 0, 1,
+	0, 0, 1, 2, -1066, -1065, -1063, -1059, -1056, 1, -1054, 4,
+	4, -1053, 0, 1, 0, 0, -1045, 0, -1043, -1040, 10, -1039,
+	2, -1036, -1033, 6, 0, 7, -1031, 1, -1030, 0, 0, -1029,
+	-1023, 13, -1022, 1, -1021, 0, 0, 0, 0, 3, 6, -1019,
+	0, 0, -1016, 1, -1015, 0, 0, 0, -1014, 0, 5, -1011,
+	0, 1, 2, -1009, 0, -1003, -1002, 3, -997, 4, 0, 0,
+	-994, -992, 24, -991, 0, 1, -989, 1, -987, 5, -982, -981,
+	0, 0, -980, 0, 1, -978, 1, 1, 13, 0, 5, 0,
+	-975, -974, 0, 0, 0, -970, 0, 0, 0, 0, -968, -966,
+	0, 18, 6, 2, -964, 1, 4, -960, 0, -959, 0, -955,
+	-953, 12, 1, -950, -948, 0, 0, 0, 0, -945, -937, 0,
+	0, 0, 0, 1, -936, -935, 0, -931, 0, 0, 0, -930,
+	-929, 14, 2, 0, 11, -919, -918, 0, -917, -914, 0, 1,
+	0, 0, 1, 2, -904, 0, 0, -902, 0, 0, 0, 0,
+	-901, -900, 0, -899, -898, 0, -896, 1, -895, 0, -893, -892,
+	-891, 0, 1, 0, 2, 0, 0, 0, 0, 3, -889, 7,
+	0, 7, -886, 0, 0, -884, 3, 3, -883, 0, 0, 7,
+	-880, 0, -878, 8, 0, 1, 3, 1, 0, -876, 0, 0,
+	0, -871, -870, 6, 2, 4, 0, 1, 2, 4, -863, 0,
+	0, -861, 2, 4, -857, -855, -854, -845, 1, -844, 0, 0,
+	-843, 10, 1, 1, -842, 0, -841, 1, -840, 0, 0, -839,
+	1, 8, -837, -836, 3, 15, 0, -834, 0, -833, -829, 0,
+	-827, 21, 0, -826, -825, -821, 0, 8, 0, -820, 0, 5,
+	0, 0, 2, -817, -815, 2, -805, 0, -802, 0, 0, 1,
+	-794, -793, 2, 4, 1, 0, 0, 0, 3, -792, 4, -791,
+	0, 3, 2, -780, 0, 0, 7, -777, -775, -771, 0, -770,
+	2, 0, 0, 4, 0, -766, -764, 0, 0, -763, 0, 0,
+	0, 12, -761, -760, -758, 0, -757, 1, -753, -751, 31, -750,
+	0, -749, 1, 0, 0, -743, -742, 0, 1, 3, -741, 0,
+	0, 0, 2, -739, -737, 0, -736, -731, 0, -730, 0, 1,
+	-726, -722, 1, 11, 1, 0, -717, 1, -716, 0, 0, 0,
+	0, 1, 0, 0, 0, -711, -708, 1, 8, 3, 0, -705,
+	-703, 0, -701, 0, 0, 4, 0, 0, -700, 0, 1, 0,
+	0, -696, -694, 1, -693, -691, 7, 0, 0, 0, 12, -690,
+	0, 0, 0, 0, -687, -685, -684, -683, -679, -673, 0, -672,
+	11, -671, 0, 6, 4, -667, 0, -666, -663, -662, 0, 2,
+	-661, -658, 2, 1, 4, 12, 0, -653, -652, 0, 0, 0,
+	0, 4, 0, -648, -647, -643, -642, 0, 0, 0, -640, 2,
+	0, 0, 0, 0, -638, -636, -635, -632, -631, 0, 0, 0,
+	-624, -621, 0, -619, 0, 2, -618, -617, -614, -608, 0, -607,
+	0, 0, 0, -606, -605, -603, 18, 0, 0, -602, -599, 1,
+	-598, 0, 7, 15, 1, 0, -597, 0, -593, -591, -589, 14,
+	3, 0, 1, 1, -586, 0, 1, 1, 2, 13, 0, 0,
+	0, 18, -585, 0, 0, 0, -584, -581, 0, -575, -574, -573,
+	-567, 3, 0, -564, -563, -558, 7, 0, -556, 0, 0, -554,
+	0, -541, 0, 0, -540, 0, -539, 10, 4, 0, -537, -532,
+	-530, 0, -529, 0, 1, -519, 41, -518, 0, -511, -507, 2,
+	-505, -500, -499, 0, 3, -498, -496, 0, -493, -491, 0, 0,
+	0, 0, 0, 0, -485, 1, 1, 10, -484, 0, 3, -480,
+	0, 0, 24, 0, 1, 2, 0, 2, 4, -479, 0, 0,
+	0, -477, 0, 11, 0, 0, 10, -475, 2, 0, 0, 0,
+	0, 3, 4, -465, 1, 25, -464, 0, 0, 1, -457, 0,
+	-456, -455, -452, 5, 0, -448, 0, 0, 0, -446, 2, 2,
+	0, -437, 9, -429, 2, -428, -427, -426, -421, -413, 0, -405,
+	-398, 0, 0, 18, 7, -397, 2, -394, 1, 5, -390, 0,
+	-389, 2, 0, 0, 0, 0, -383, 0, 0, 0, 0, -379,
+	0, -378, 0, -359, 2, -357, -356, 0, 6, 24, 0, 0,
+	0, -355, -354, 0, 0, 1, -353, 0, -352, 23, 1, -351,
+	-348, -345, 1, 0, 1, 0, 21, 2, 4, 0, 3, 0,
+	-343, -342, 0, 0, -338, -337, 1, 0, -331, 0, 17, 2,
+	3, -328, 0, 2, -325, 15, -322, -320, 54, 1, 0, 0,
+	45, -317, 0, 5, 11, 0, 0, 0, -314, 0, 0, 5,
+	0, 0, 0, -311, 10, -304, -302, 0, 0, 0, 1, 14,
+	2, -300, 0, 0, -299, -297, -295, -294, 1, 4, 12, 0,
+	0, 16, 66, 0, 0, 0, 0, 9, -292, 0, 0, -290,
+	-289, 0, -288, 0, -284, -283, 2, -278, 14, 0, 0, 0,
+	0, 1, 2, -267, 5, -260, 0, 0, -259, 0, -258, 2,
+	-251, -249, 0, 3, -246, 0, 0, 0, -242, 0, -226, 0,
+	1, 0, 0, 1, 0, 10, 0, 13, 0, -223, 1, 2,
+	2, -221, -217, 0, -216, 0, -212, -210, -194, 0, -191, 0,
+	0, 0, -190, -189, -188, 1, 0, -187, 0, 0, -186, 0,
+	3, 3, 0, -184, 0, 0, 0, 0, 64, 0, 3, 0,
+	-182, -175, 0, 0, -173, 12, -171, 0, 0, 4, 1, 3,
+	14, 0, 0, -169, 2, 0, -161, -159, 5, 0, 0, 0,
+	-153, 4, 2, 0, -151, 0, -149, 3, 0, -147, -146, 0,
+	0, -145, 0, 5, -142, 5, -140, 0, 12, 12, 1, 0,
+	8, 7, 1, -136, 0, 1, 0, 0, 0, 9, 0, 0,
+	-135, 0, 1, -134, -131, 0, 0, 0, 7, 2, -130, -122,
+	-118, -114, -113, 0, 0, 0, 0, 6, 2, -110, 0, 37,
+	0, 0, 0, 0, 0, 0, 1, 0, 17, -107, 1, 1,
+	0, -103, 2, 0, 0, 0, 2, 0, -101, 15, 0, -100,
+	0, 0, 1, -99, -96, -95, -86, -85, -84, 0, 0, 0,
+	0, 12, -83, 0, -77, -73, 0, -71, -70, -69, 1, 1,
+	-66, -65, 0, 0, -63, 0, 0, -59, -54, -52, 5, 5,
+	0, 0, 1, 0, 24, 0, 5, 0, 0, -51, -49, 4,
+	9, 2, 0, 0, -43, 0, 0, 0, 0, 0, 1, 0,
+	-42, 0, -39, -38, 7, 0, -37, -33, 0, -30, 0, 1,
+	0, -29, -27, -23, 0, -22, 0, -17, 0, 0, 5, -16,
+	0, 0, -15, 0, 1, -14, -13, -12, -11, -10, 0, -7,
+	0,
 };
 
-// Initialize s_entityMap using s_entityArray
-static void Init()
+// END GENERATED ENTITY TABLE
+
+// FNV-1a hash; must match fnv_hash() in scripts/gen-html-entities.py
+static inline guint32 EntityHash(const char* name, size_t length, guint32 seed)
 {
-	for(int i = 0; s_entityArray[i].name != ""; i++) {
-		s_entityMap[s_entityArray[i].name] = s_entityArray[i].value;
+	guint32 hash = 2166136261U ^ seed;
+
+	for(size_t i = 0; i < length; i++) {
+		hash ^= (unsigned char) name[i];
+		hash *= 16777619U;
 	}
+
+	return hash;
 }
 
-gunichar HtmlEntities::LookupEntity(const std::string& name)
+gunichar HtmlEntities::LookupEntity(const char* name, size_t length, gunichar* secondChar)
 {
-	if( unlikely(s_entityMap.empty()) ) {
-		Init();
+	if(secondChar != NULL) {
+		*secondChar = 0;
+	}
+
+	if(length == 0 || length > MAX_ENTITY_NAME_LENGTH) {
+		return 0;
 	}
 
-	// Note that we can't just use s_entityMap[name] because it'll create new blank entries
-	map<const string, gunichar>::const_iterator it = s_entityMap.find(name);
+	// Find the slot using the perfect hash, then check that it's really the same name
+	gint16 displacement = s_entityDisplacement[EntityHash(name, length, 0) % ENTITY_COUNT];
 
-	if(it != s_entityMap.end())
-		return it->second;
-	else
+	size_t slot;
+	if(displacement < 0) {
+		slot = -displacement - 1;
+	} else {
+		slot = EntityHash(name, length, displacement) % ENTITY_COUNT;
+	}
+
+	const EntityDef& entity = s_entityTable[slot];
+
+	if(entity.length != length || memcmp(entity.name, name, length) != 0) {
 		return 0;
+	}
+
+	if(secondChar != NULL) {
+		*secondChar = entity.value2;
+	}
+
+	return entity.value;
+}
+
+gunichar HtmlEntities::LookupEntity(const std::string& name)
+{
+	return LookupEntity(name.data(), name.length());
 }
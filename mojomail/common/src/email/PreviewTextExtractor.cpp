@@ -0,0 +1,353 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "email/PreviewTextExtractor.h"
+#include "email/PreviewTextGenerator.h"
+#include "email/HtmlEntities.h"
+#include <cstring>
+
+using namespace std;
+
+const size_t PreviewTextExtractor::MAX_ENTITY_LENGTH;
+const size_t PreviewTextExtractor::MAX_TAG_NAME_LENGTH;
+
+// Same set of characters as "\s" in a regex
+static inline bool IsSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static inline bool IsAlpha(char c)
+{
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static inline bool IsAlnum(char c)
+{
+	return IsAlpha(c) || (c >= '0' && c <= '9');
+}
+
+static inline char ToLower(char c)
+{
+	return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+static inline int HexValue(char c)
+{
+	if(c >= '0' && c <= '9')
+		return c - '0';
+	else if(c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	else if(c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	else
+		return -1;
+}
+
+PreviewTextExtractor::PreviewTextExtractor(size_t maxLength, bool html)
+: m_maxLength(maxLength),
+  m_html(html),
+  m_state(State_Text),
+  m_pendingSpace(false),
+  m_closingTag(false),
+  m_selfClosing(false),
+  m_skipping(false),
+  m_dashCount(0)
+{
+	m_text.reserve(maxLength + 8);
+}
+
+PreviewTextExtractor::~PreviewTextExtractor()
+{
+}
+
+inline void PreviewTextExtractor::AppendChar(char c)
+{
+	// Collapse whitespace into a single space, and drop leading whitespace
+	if(m_pendingSpace) {
+		if(!m_text.empty())
+			m_text.push_back(' ');
+		m_pendingSpace = false;
+	}
+
+	m_text.push_back(c);
+}
+
+void PreviewTextExtractor::AppendUnicode(gunichar c)
+{
+	if(c < 0x80 && IsSpace(c)) {
+		AppendSpace();
+	} else {
+		// Convert to UTF-8; buffer size must be at least 6 bytes
+		char buf[6];
+		gint length = g_unichar_to_utf8(c, buf);
+
+		for(gint i = 0; i < length; i++)
+			AppendChar(buf[i]);
+	}
+}
+
+void PreviewTextExtractor::Append(const char* src, size_t length)
+{
+	size_t i = 0;
+
+	if(!m_html) {
+		// Plain text; just collapse whitespace
+		for(; i < length && !IsFull(); i++) {
+			if(IsSpace(src[i]))
+				AppendSpace();
+			else
+				AppendChar(src[i]);
+		}
+		return;
+	}
+
+	while(i < length && !IsFull()) {
+		char c = src[i];
+
+		switch(m_state) {
+		case State_Text:
+			if(c == '<') {
+				m_state = State_TagOpen;
+			} else if(c == '&') {
+				m_entity.clear();
+				m_state = State_Entity;
+			} else if(IsSpace(c)) {
+				AppendSpace();
+			} else {
+				AppendChar(c);
+			}
+			break;
+
+		case State_Entity:
+			if(c == ';') {
+				EndEntity(true);
+			} else if((IsAlnum(c) || c == '#') && m_entity.length() < MAX_ENTITY_LENGTH) {
+				m_entity.push_back(c);
+			} else {
+				// Not an entity; output the text as-is and reprocess this character
+				EndEntity(false);
+				continue;
+			}
+			break;
+
+		case State_TagOpen:
+			if(IsAlpha(c) || c == '/' || c == '!' || c == '?') {
+				m_tagName.clear();
+				m_closingTag = (c == '/');
+				m_selfClosing = false;
+
+				if(c == '!' || IsAlpha(c))
+					m_tagName.push_back(ToLower(c));
+
+				m_state = State_TagName;
+			} else {
+				// Not a tag; output the '<' and reprocess this character
+				m_state = State_Text;
+				AppendChar('<');
+				continue;
+			}
+			break;
+
+		case State_TagName:
+			if(c == '>') {
+				EndTag();
+			} else if(IsSpace(c) || c == '/') {
+				// Allow whitespace between "</" and the tag name
+				if(!m_tagName.empty() || !m_closingTag) {
+					m_selfClosing = (c == '/');
+					m_state = State_Tag;
+				}
+			} else {
+				if(m_tagName.length() < MAX_TAG_NAME_LENGTH)
+					m_tagName.push_back(ToLower(c));
+
+				if(m_tagName == "!--") {
+					m_dashCount = 0;
+					m_state = State_Comment;
+				}
+			}
+			break;
+
+		case State_Tag:
+			if(c == '>') {
+				EndTag();
+			} else if(c == '/') {
+				m_selfClosing = true;
+			} else if(!IsSpace(c)) {
+				m_selfClosing = false;
+			}
+			break;
+
+		case State_Comment:
+			if(c == '-') {
+				m_dashCount++;
+			} else if(c == '>' && m_dashCount >= 2) {
+				m_state = State_Text;
+				AppendSpace();
+			} else {
+				m_dashCount = 0;
+			}
+			break;
+
+		case State_SkipBlock:
+		{
+			// Jump straight to the next '<'
+			const char* lt = (const char*) memchr(src + i, '<', length - i);
+
+			if(lt == NULL) {
+				i = length;
+			} else {
+				i = (lt - src) + 1;
+				m_state = State_SkipBlockLessThan;
+			}
+			continue;
+		}
+
+		case State_SkipBlockLessThan:
+			if(c == '/') {
+				m_tagName.clear();
+				m_closingTag = true;
+				m_selfClosing = false;
+				m_state = State_TagName;
+			} else if(!IsSpace(c)) {
+				// Not a closing tag; keep looking
+				m_state = State_SkipBlock;
+				continue;
+			}
+			break;
+		}
+
+		i++;
+	}
+}
+
+void PreviewTextExtractor::EndEntity(bool terminated)
+{
+	m_state = State_Text;
+
+	if(terminated) {
+		if(m_entity == "nbsp") {
+			AppendSpace();
+			return;
+		}
+
+		gunichar secondChar;
+		gunichar charValue = DecodeEntity(m_entity.data(), m_entity.length(), &secondChar);
+
+		if(charValue > 0) {
+			AppendUnicode(charValue);
+
+			if(secondChar > 0)
+				AppendUnicode(secondChar);
+			return;
+		}
+	}
+
+	// Couldn't convert into a Unicode char; output the original text
+	AppendChar('&');
+	for(size_t i = 0; i < m_entity.length(); i++)
+		AppendChar(m_entity[i]);
+
+	if(terminated)
+		AppendChar(';');
+}
+
+bool PreviewTextExtractor::IsBlockTag() const
+{
+	return m_tagName == "style" || m_tagName == "head" || m_tagName == "script";
+}
+
+void PreviewTextExtractor::EndTag()
+{
+	if(m_skipping) {
+		// Only the matching closing tag ends the block
+		if(m_closingTag && m_tagName == m_blockName) {
+			m_skipping = false;
+			m_state = State_Text;
+		} else {
+			m_state = State_SkipBlock;
+		}
+	} else if(!m_closingTag && !m_selfClosing && IsBlockTag()) {
+		m_skipping = true;
+		m_blockName = m_tagName;
+		m_state = State_SkipBlock;
+	} else {
+		// Tags are replaced by whitespace
+		m_state = State_Text;
+		AppendSpace();
+	}
+}
+
+std::string PreviewTextExtractor::GetPreviewText() const
+{
+	string text = m_text;
+
+	// Output any incomplete entity or '<' at the end of the input as-is
+	if(!IsFull() && (m_state == State_Entity || m_state == State_TagOpen)) {
+		if(m_pendingSpace && !text.empty())
+			text.push_back(' ');
+
+		if(m_state == State_Entity)
+			text.append("&").append(m_entity);
+		else
+			text.push_back('<');
+	}
+
+	PreviewTextGenerator::TruncateUTF8(text, m_maxLength);
+	return text;
+}
+
+gunichar PreviewTextExtractor::DecodeEntity(const char* name, size_t length, gunichar* secondChar)
+{
+	if(secondChar != NULL)
+		*secondChar = 0;
+
+	if(length >= 2 && name[0] == '#') {
+		// Numeric value entities, e.g. &#1234; or &#x00A2;
+		bool hex = (name[1] == 'x' || name[1] == 'X');
+		size_t start = hex ? 2 : 1;
+		gunichar charValue = 0;
+
+		if(start >= length)
+			return 0;
+
+		for(size_t i = start; i < length; i++) {
+			int digit = hex ? HexValue(name[i]) : ((name[i] >= '0' && name[i] <= '9') ? name[i] - '0' : -1);
+
+			if(digit < 0)
+				return 0;
+
+			charValue = charValue * (hex ? 16 : 10) + digit;
+
+			// Stop before it can overflow
+			if(charValue > 0x10FFFF)
+				return 0;
+		}
+
+		// Check if it's a valid Unicode value
+		if(charValue == 0 || !g_unichar_validate(charValue))
+			return 0;
+
+		return charValue;
+	} else if(length > 0) {
+		return HtmlEntities::LookupEntity(name, length, secondChar);
+	}
+
+	return 0;
+}
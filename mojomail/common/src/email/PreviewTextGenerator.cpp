@@ -17,112 +17,70 @@
 // LICENSE@@@
 
 #include "email/PreviewTextGenerator.h"
-#include <boost/regex.hpp>
+#include "email/PreviewTextExtractor.h"
 #include <boost/algorithm/string/trim.hpp>
-#include <boost/algorithm/string/find_format.hpp>
-#include <boost/algorithm/string/regex_find_format.hpp>
-#include <sstream>
+#include <boost/algorithm/string/classification.hpp>
 #include <glib.h>
-#include <exception>
-#include "email/HtmlEntities.h"
 
 using namespace std;
 
-#define BLOCK_TAG(x) "<[[:space:]]*" x "[^>]*>.*?<[[:space:]]*/" x "[[:space:]]*>"
-
-boost::regex headerTagRegex(BLOCK_TAG("style") "|" BLOCK_TAG("head") "|" BLOCK_TAG("script"), boost::regex::icase);
-boost::regex htmlTagRegex("<[^<][^<>]*(>|$)|&nbsp;", boost::regex::icase);
-boost::regex whitespaceRegex("\\s+");
-boost::regex entityRegex("&[^;]+;");
-
 string PreviewTextGenerator::GeneratePreviewText(const string& text, size_t maxLength, bool html)
 {
-	string temp = text;
+	PreviewTextExtractor extractor(maxLength, html);
+	extractor.Append(text.data(), text.length());
 
-	if(html) {
-		boost::smatch m;
+	return extractor.GetPreviewText();
+}
 
-		// strip header, script, and style tags
-		temp = boost::regex_replace(temp, headerTagRegex, "");
+string PreviewTextGenerator::ReplaceEntities(const string& text)
+{
+	string out;
+	out.reserve(text.length());
 
-		// strip html tags
-		temp = boost::regex_replace(temp, htmlTagRegex, " ");
+	size_t pos = 0;
 
-		// Fixup HTML entities
-		// Note that unescaping must be done in one pass to avoid double-unescaping,
-		// e.g. '&amp;gt;' should appear as '&gt;' not '<'
-		temp = ReplaceEntities(temp);
-	}
+	while(pos < text.length()) {
+		size_t amp = text.find('&', pos);
 
-	// cleanup whitespace
-	temp = boost::regex_replace(temp, whitespaceRegex, " ");
+		if(amp == string::npos) {
+			out.append(text, pos, string::npos);
+			break;
+		}
 
-	boost::trim(temp);
-	TruncateUTF8(temp, maxLength);
+		out.append(text, pos, amp - pos);
 
-	return temp;
-}
+		// Find the end of the entity name
+		size_t end = amp + 1;
+		while(end < text.length() && end - amp <= PreviewTextExtractor::MAX_ENTITY_LENGTH
+				&& (g_ascii_isalnum(text[end]) || text[end] == '#')) {
+			end++;
+		}
 
-class EntityFormatter
-{
-public:
-	template<typename IteratorT>
-	string operator()(const boost::iterator_range<IteratorT>& range) const
-	{
-		gunichar charValue = 0;
-
-		try {
-			// Numeric value entities
-			if(range.size() > 3 && range[1] == '#') {
-				if(range[2] == 'x' || range[2] == 'X') { // hex, e.g. &#x00A2;
-					istringstream ss( string(range.begin() + 3, range.end() - 1) );
-					ss >> std::hex >> charValue;
-
-					// Not valid if it couldn't read the whole string
-					if(ss.fail() || !ss.eof()) {
-						charValue = 0;
-					}
-
-				} else { // decimal, e.g. &#1234
-					istringstream ss( string(range.begin() + 2, range.end() - 1) );
-					ss >> std::dec >> charValue;
-
-					// Not valid if it couldn't read the whole string
-					if(ss.fail() || !ss.eof()) {
-						charValue = 0;
-					}
-				}
-
-				// Check if it's a valid Unicode value
-				if(charValue <= 0 || !g_unichar_validate(charValue)) {
-					charValue = 0;
-				}
-			} else if(range.size() > 2) {
-				string entityName = string(range.begin() + 1, range.end() - 1);
-
-				charValue = HtmlEntities::LookupEntity(entityName);
-			}
-		} catch(...) {
-			// ignore exceptions
+		gunichar charValue = 0, secondChar = 0;
+		if(end < text.length() && text[end] == ';') {
+			charValue = PreviewTextExtractor::DecodeEntity(text.data() + amp + 1, end - amp - 1, &secondChar);
 		}
 
-		// Make sure it's a valid value
 		if(charValue > 0) {
 			// Convert to UTF-8; buffer size must be at least 6 bytes
 			char buf[6];
 			gint length = g_unichar_to_utf8(charValue, buf);
+			out.append(buf, length);
 
-			return string(buf, length);
+			if(secondChar > 0) {
+				length = g_unichar_to_utf8(secondChar, buf);
+				out.append(buf, length);
+			}
+
+			pos = end + 1;
 		} else {
-			// Couldn't convert into a Unicode char; return the original string
-			return string(range.begin(), range.end());
+			// Couldn't convert into a Unicode char; keep the original text
+			out.push_back('&');
+			pos = amp + 1;
 		}
 	}
-};
 
-string PreviewTextGenerator::ReplaceEntities(const string& text)
-{
-	return boost::find_format_all_copy(text, boost::regex_finder(entityRegex), EntityFormatter());
+	return out;
 }
 
 void PreviewTextGenerator::TruncateUTF8(string& text, size_t maxLength) {
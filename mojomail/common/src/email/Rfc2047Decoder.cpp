@@ -15,265 +15,352 @@
 // limitations under the License.
 //
 // LICENSE@@@
-
 #include "email/Rfc2047Decoder.h"
 
-// for debug
-#include <iostream>
-using namespace std;
-
+#include <cstring>
+#include <strings.h>
 #include <unicode/utypes.h>
 #include <unicode/ucnv.h>
-#include <unicode/ustring.h>
-
-#include "glib/gbase64.h"
-#include "glib.h"
 
-#include <boost/algorithm/string/predicate.hpp>
-#include <boost/shared_array.hpp>
-#include "email/CharsetSupport.h"
+#include "email/CharsetConverterPool.h"
 #include "exceptions/MailException.h"
+#include "util/Base64.h"
 #include "util/StringUtils.h"
+#include "util/UTF8Validator.h"
 
-void Rfc2047Decoder::Decode(const std::string& text, std::string& out)
+using namespace std;
+
+// Location of an encoded-word: "=?charset?encoding?encoded-text?="
+struct EncodedWord
 {
-	// check for "=?" at beginning and "?=" at end
-	if((text[0] != '=') || (text[1] != '?') || (text[text.length() - 2] != '?') || (text[text.length() - 1] != '=')) {
-		throw MailException("invalid RFC 2047", __FILE__, __LINE__);
-	}
+	const char*	start;
+	const char*	end;				// just past the closing "?="
 
-	unsigned int encodingPos = text.find('?', 2);
-	if(encodingPos == string::npos) {
-		// '?' not found
-		throw MailException("invalid RFC 2047", __FILE__, __LINE__);
-	}
+	const char*	charset;
+	size_t		charsetLength;		// excludes any RFC 2231 language suffix
 
-	// todo add test cases!
-	if(text.length() < (encodingPos + 5) || text[encodingPos + 2] != '?') {
-		// another expected '?' not found or string not long enough.
-		throw MailException("invalid RFC 2047", __FILE__, __LINE__);
-	}
+	char		encoding;
+	const char*	encodedText;
+	size_t		encodedTextLength;
 
-	string charset(text.substr(2, encodingPos - 2));
-	charset = CharsetSupport::SelectCharset(charset.c_str());
+	// false if the encoding isn't a single 'B' or 'Q'
+	bool		wellFormed;
+};
 
-	bool doConversionToUTF8 = false;
-	if(!boost::iequals(charset, "utf-8")) {
-		// need to do conversion
-		doConversionToUTF8 = true;
-	}
+// Encoded-words in the same charset, separated only by whitespace.
+// They're decoded into one buffer and converted together, since a
+// multi-byte character may be split between two words.
+struct PendingRun
+{
+	PendingRun() : rawStart(NULL), rawEnd(NULL) {}
+
+	string		charset;
+	string		data;
 
-	string outTemp;
-	string& outRef = outTemp;
+	// original text, used if the charset can't be converted
+	const char*	rawStart;
+	const char*	rawEnd;
+};
 
-	switch(text[encodingPos + 1]) {
-	case 'b': case 'B': // base64 encoded
-	{
-		gsize outSize;
-		string b64string(text.substr(encodingPos+3,text.length() - (encodingPos + 5)));
+static const size_t PIVOT_BUF_SIZE = 256;
+
+static inline bool IsPlainASCII(unsigned char c)
+{
+	// Same set as boost::is_print() || boost::is_space() in the C locale
+	return (c >= 0x20 && c < 0x7F) || (c >= '\t' && c <= '\r');
+}
+
+static inline bool IsLinearWhitespace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static inline int HexValue(char c)
+{
+	if(c >= '0' && c <= '9')
+		return c - '0';
+	else if(c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	else if(c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	else
+		return -1;
+}
+
+// Appends text, replacing each run of unprintable characters with the
+// replacement character (like StringUtils::SanitizeASCII).
+static void AppendSanitizedASCII(string& out, const char* text, size_t length)
+{
+	const char* end = text + length;
 
-		if (b64string.length() == 0) {
-			// g_base64_decode doesn't like it if the string is empty
-			return;
+	while(text < end) {
+		const char* plainStart = text;
+		while(text < end && IsPlainASCII(*text)) {
+			text++;
 		}
 
-		guchar *outStr = g_base64_decode(b64string.c_str(), &outSize);
+		out.append(plainStart, text - plainStart);
 
-		if (outStr) {
-			outRef.assign((char *)outStr);
-			g_free(outStr);
+		if(text < end) {
+			out.append(StringUtils::UTF8_REPLACEMENT_CHAR);
+
+			while(text < end && !IsPlainASCII(*text)) {
+				text++;
+			}
 		}
+	}
+}
+
+static bool IsWhitespaceOnly(const char* text, const char* end)
+{
+	for(; text < end; text++) {
+		if(!IsLinearWhitespace(*text))
+			return false;
+	}
 
-		break;
+	return true;
+}
+
+// Finds the first occurrence of the two characters in a row
+static const char* FindPair(const char* text, const char* end, char first, char second)
+{
+	while(end - text >= 2) {
+		const char* found = (const char*) memchr(text, first, end - text - 1);
+
+		if(found == NULL)
+			return NULL;
+		else if(found[1] == second)
+			return found;
+
+		text = found + 1;
 	}
-	case 'q': case 'Q': // Q encoded
-		outRef.assign("");
-		for(unsigned int i = encodingPos + 3; i < (text.length() - 2); ++i) {
-			const char ch = text[i];
+
+	return NULL;
+}
+
+// Finds the next encoded-word in the text. Returns false if there isn't a complete one.
+static bool FindEncodedWord(const char* text, const char* end, EncodedWord& word)
+{
+	const char* start = FindPair(text, end, '=', '?');
+	if(start == NULL)
+		return false;
+
+	const char* charsetEnd = (const char*) memchr(start + 2, '?', end - (start + 2));
+	if(charsetEnd == NULL)
+		return false;
+
+	const char* encodingEnd = (const char*) memchr(charsetEnd + 1, '?', end - (charsetEnd + 1));
+	if(encodingEnd == NULL)
+		return false;
+
+	const char* textEnd = FindPair(encodingEnd + 1, end, '?', '=');
+	if(textEnd == NULL)
+		return false;
+
+	word.start = start;
+	word.end = textEnd + 2;
+
+	// RFC 2231 allows a language after the charset, e.g. "=?US-ASCII*EN?Q?...?="
+	word.charset = start + 2;
+	const char* languageStart = (const char*) memchr(word.charset, '*', charsetEnd - word.charset);
+	word.charsetLength = (languageStart ? languageStart : charsetEnd) - word.charset;
+
+	word.encoding = charsetEnd[1];
+	word.encodedText = encodingEnd + 1;
+	word.encodedTextLength = textEnd - word.encodedText;
+
+	word.wellFormed = encodingEnd == charsetEnd + 2 && strchr("BbQq", word.encoding) != NULL;
+	return true;
+}
+
+// Decodes the B or Q encoded text of a word and appends the raw bytes
+static void AppendDecodedBytes(const EncodedWord& word, string& out)
+{
+	const char* src = word.encodedText;
+	const char* end = src + word.encodedTextLength;
+
+	if(word.encoding == 'B' || word.encoding == 'b') {
+		Base64Decoder decoder;
+
+		size_t used = out.length();
+		out.resize(used + Base64Decoder::MaxDecodedSize(word.encodedTextLength));
+
+		size_t decodedLength = decoder.Decode(src, word.encodedTextLength, &out[used]);
+		out.resize(used + decodedLength);
+	} else {
+		while(src < end) {
+			char ch = *src++;
+
 			if(ch == '_') {
-				outRef.push_back(' ');
-			} else if(ch == '=') {
-				if(i < (text.length() - 4)) {
-					int chInt = 0;
-					switch(tolower(text[i+1])) {
-					case '0': chInt = 0  << 4; break;
-					case '1': chInt = 1  << 4; break;
-					case '2': chInt = 2  << 4; break;
-					case '3': chInt = 3  << 4; break;
-					case '4': chInt = 4  << 4; break;
-					case '5': chInt = 5  << 4; break;
-					case '6': chInt = 6  << 4; break;
-					case '7': chInt = 7  << 4; break;
-					case '8': chInt = 8  << 4; break;
-					case '9': chInt = 9  << 4; break;
-					case 'a': chInt = 10 << 4; break;
-					case 'b': chInt = 11 << 4; break;
-					case 'c': chInt = 12 << 4; break;
-					case 'd': chInt = 13 << 4; break;
-					case 'e': chInt = 14 << 4; break;
-					case 'f': chInt = 15 << 4; break;
-					default: outRef.push_back(ch); continue; // possible error case
-					}
-					switch(tolower(text[i+2])) {
-					case '0': chInt += 0 ; break;
-					case '1': chInt += 1 ; break;
-					case '2': chInt += 2 ; break;
-					case '3': chInt += 3 ; break;
-					case '4': chInt += 4 ; break;
-					case '5': chInt += 5 ; break;
-					case '6': chInt += 6 ; break;
-					case '7': chInt += 7 ; break;
-					case '8': chInt += 8 ; break;
-					case '9': chInt += 9 ; break;
-					case 'a': chInt += 10; break;
-					case 'b': chInt += 11; break;
-					case 'c': chInt += 12; break;
-					case 'd': chInt += 13; break;
-					case 'e': chInt += 14; break;
-					case 'f': chInt += 15; break;
-					default: outRef.push_back(ch); continue; // possible error case
-					}
-
-					outRef.push_back((char)chInt);
-					i += 2;
+				out.push_back(' ');
+			} else if(ch == '=' && end - src >= 2) {
+				int high = HexValue(src[0]);
+				int low = HexValue(src[1]);
+
+				if(high >= 0 && low >= 0) {
+					out.push_back((char) ((high << 4) | low));
+					src += 2;
 				} else {
-					// perhaps malformed text
-					outRef.push_back(ch);
+					// possible error case
+					out.push_back(ch);
 				}
 			} else {
-				outRef.push_back(ch);
+				out.push_back(ch);
 			}
-
 		}
 	}
+}
 
-	if(doConversionToUTF8) {
+static bool IsUTF8Charset(const string& charset)
+{
+	return strcasecmp(charset.c_str(), "utf-8") == 0 || strcasecmp(charset.c_str(), "utf8") == 0;
+}
 
-		UErrorCode errorCode(U_ZERO_ERROR);
-		UConverter* toUnicodeConverter = NULL;
-		UConverter* toUtf8Converter = NULL;
+// Converts data to UTF-8 and appends it to out.
+// Returns false, leaving out unchanged, if the data can't be converted.
+static bool AppendAsUTF8(const string& charset, const string& data, string& out)
+{
+	if(IsUTF8Charset(charset)) {
+		if(!UTF8Validator::IsValid(data.data(), data.length())) {
+			return false;
+		}
 
-		try {
-			toUnicodeConverter = ucnv_open(charset.c_str(), &errorCode);
+		out.append(data);
+		return true;
+	}
 
-			if(toUnicodeConverter == NULL) {
-				throw MailException(("error opening converter for charset " + charset).c_str(), __FILE__, __LINE__);
-			}
+	UErrorCode errorCode = U_ZERO_ERROR;
 
-			toUtf8Converter = ucnv_open("UTF-8", &errorCode);
+	UConverter* sourceCnv = CharsetConverterPool::Acquire(charset.c_str(), &errorCode);
+	if(sourceCnv == NULL) {
+		return false;
+	}
 
-			if(toUtf8Converter == NULL) {
-				throw MailException("error opening UTF-8 converter", __FILE__, __LINE__);
-			}
+	UConverter* targetCnv = CharsetConverterPool::Acquire("UTF-8", &errorCode);
+	if(targetCnv == NULL) {
+		CharsetConverterPool::Release(sourceCnv);
+		return false;
+	}
 
-			int srcMinCharSize = ucnv_getMinCharSize(toUnicodeConverter);
-			if(srcMinCharSize < 1)
-				srcMinCharSize = 1; // avoid divide-by-zero
+	UChar pivotBuf[PIVOT_BUF_SIZE];
+	UChar* pivotSource = pivotBuf;
+	UChar* pivotTarget = pivotBuf;
 
-			int maxUtfCharSize = ucnv_getMaxCharSize(toUtf8Converter);
-			int destLen = UCNV_GET_MAX_BYTES_FOR_STRING(outRef.length() / srcMinCharSize, maxUtfCharSize) + 10;
-			// was this: int destLen = outRef.length() * 2 + 99;
+	const char* src = data.data();
+	const char* srcEnd = src + data.length();
 
-			boost::shared_array<char> dest (new char[destLen]); // todo get a better handle on how long this needs to be.
-			int finalDestLen = ucnv_convert("UTF-8", charset.c_str(),
-					dest.get(), destLen - 1,
-					outRef.c_str(), outRef.length(),
-					&errorCode);
+	size_t originalLength = out.length();
+	bool reset = true;
 
-			if(finalDestLen >= destLen || errorCode != U_ZERO_ERROR) {
-				throw MailException("conversion to UTF-8 failed", __FILE__, __LINE__);
-			}
+	do {
+		// Enough for most single and double-byte charsets in one pass
+		size_t used = out.length();
+		out.resize(used + data.length() * 3 + 16);
 
-			out.assign(dest.get());
+		char* target = &out[used];
+		char* targetEnd = &out[0] + out.length();
 
-		} catch(...) {
-			if(toUnicodeConverter) {
-				ucnv_close(toUnicodeConverter);
-				toUnicodeConverter = NULL;
-			}
+		errorCode = U_ZERO_ERROR;
+		ucnv_convertEx(targetCnv, sourceCnv, &target, targetEnd, &src, srcEnd,
+				pivotBuf, &pivotSource, &pivotTarget, pivotBuf + PIVOT_BUF_SIZE,
+				reset, true, &errorCode);
+		reset = false;
 
-			if(toUtf8Converter) {
-				ucnv_close(toUtf8Converter);
-				toUtf8Converter = NULL;
-			}
+		out.resize(target - out.data());
+	} while(errorCode == U_BUFFER_OVERFLOW_ERROR);
 
-			// rethrow exception
-			throw;
-		}
+	CharsetConverterPool::Release(sourceCnv);
+	CharsetConverterPool::Release(targetCnv);
 
-		if(toUnicodeConverter)
-			ucnv_close(toUnicodeConverter);
+	if(U_FAILURE(errorCode)) {
+		out.resize(originalLength);
+		return false;
+	}
 
-		if(toUtf8Converter)
-			ucnv_close(toUtf8Converter);
-	} else {
-		// Make sure the text is valid UTF8
-		if(!g_utf8_validate(outRef.data(), outRef.size(), NULL)) {
-			throw MailException("invalid UTF-8", __FILE__, __LINE__);
-		}
+	return true;
+}
+
+static void FlushRun(PendingRun& run, string& out)
+{
+	if(run.rawStart == NULL) {
+		return;
+	}
 
-		out = outRef;
+	if(!AppendAsUTF8(run.charset, run.data, out)) {
+		// Couldn't decode; just append the text without decoding
+		AppendSanitizedASCII(out, run.rawStart, run.rawEnd - run.rawStart);
 	}
+
+	run.data.clear();
+	run.rawStart = run.rawEnd = NULL;
 }
 
-void Rfc2047Decoder::DecodeText(const string& text, string& out)
+void Rfc2047Decoder::Decode(const std::string& text, std::string& out)
 {
-	out.clear();
+	const char* end = text.data() + text.length();
+	EncodedWord word;
 
-	size_t lastBlockEnd = 0;
+	if(!FindEncodedWord(text.data(), end, word) || word.start != text.data() || word.end != end || !word.wellFormed) {
+		throw MailException("invalid RFC 2047", __FILE__, __LINE__);
+	}
 
-	while(true) {
-		size_t blockStart = text.find("=?", lastBlockEnd);
-		if(blockStart != string::npos && blockStart < text.size() - 2) {
-			size_t encodingStart = text.find('?', blockStart + 2);
-			if(encodingStart == string::npos || encodingStart == text.size()) {
-				break;
-			}
+	string charset(word.charset, word.charsetLength);
+	string data;
+	AppendDecodedBytes(word, data);
 
-			size_t encodingEnd = text.find('?', encodingStart + 1);
-			if(encodingEnd == string::npos || encodingEnd == text.size()) {
-				break;
-			}
+	out.clear();
 
-			size_t blockEnd = text.find("?=", encodingEnd + 1);
+	if(!AppendAsUTF8(charset, data, out)) {
+		throw MailException(("error converting from charset " + charset).c_str(), __FILE__, __LINE__);
+	}
+}
 
-			if(blockEnd != string::npos) {
-				blockEnd += 2; // skip over ?=
+void Rfc2047Decoder::AppendDecodedText(const char* text, size_t length, string& out)
+{
+	const char* pos = text;
+	const char* end = text + length;
 
-				string preceding = text.substr(lastBlockEnd, blockStart - lastBlockEnd);
+	PendingRun run;
+	EncodedWord word;
 
-				// check if there was anything besides whitespace since last block
-				if(lastBlockEnd == 0 || preceding.find_first_not_of(" \n\r\t") != string::npos) {
-					// append everything since the last block
-					StringUtils::SanitizeASCII(preceding);
-					out.append(preceding);
-				}
+	while(FindEncodedWord(pos, end, word)) {
+		// Whitespace between two encoded-words is ignored
+		if(pos == text || !IsWhitespaceOnly(pos, word.start)) {
+			FlushRun(run, out);
+			AppendSanitizedASCII(out, pos, word.start - pos);
+		}
 
-				// decode text and append it
-				string decoded;
-				try {
-					Decode(text.substr(blockStart, blockEnd - blockStart), decoded);
-					out.append(decoded);
-				} catch(const std::exception& e) {
-					// Couldn't decode; just append the text without decoding
-					string temp = text.substr(blockStart, blockEnd - blockStart);
-					StringUtils::SanitizeASCII(temp);
-					out.append(temp);
-				}
+		if(!word.wellFormed) {
+			FlushRun(run, out);
+			AppendSanitizedASCII(out, word.start, word.end - word.start);
+		} else {
+			if(run.rawStart != NULL && (run.charset.length() != word.charsetLength
+					|| strncasecmp(run.charset.data(), word.charset, word.charsetLength) != 0)) {
+				FlushRun(run, out);
+			}
 
-				lastBlockEnd = blockEnd;
-			} else {
-				break;
+			if(run.rawStart == NULL) {
+				run.charset.assign(word.charset, word.charsetLength);
+				run.rawStart = word.start;
 			}
-		} else {
-			break;
+
+			AppendDecodedBytes(word, run.data);
+			run.rawEnd = word.end;
 		}
+
+		pos = word.end;
 	}
 
-	// end of string; append remaining text
-	string temp = text.substr(lastBlockEnd);
-	StringUtils::SanitizeASCII(temp);
-	out.append(temp);
+	FlushRun(run, out);
+
+	// append remaining text
+	AppendSanitizedASCII(out, pos, end - pos);
+}
+
+void Rfc2047Decoder::DecodeText(const string& text, string& out)
+{
+	out.clear();
+	AppendDecodedText(text.data(), text.length(), out);
 }
 
 string Rfc2047Decoder::SafeDecodeText(const std::string& text)
@@ -229,47 +229,72 @@ void EmailHeaderFieldParser::ParseDateField(const std::string& line, time_t& tim
 
 bool EmailHeaderFieldParser::ParseEmailHeaderField(Email& email, const string& fieldNameLower, const string& fieldValue)
 {
-	if (fieldNameLower == "subject") {
+	return ParseEmailHeaderField(email, HeaderFieldNames::Lookup(fieldNameLower.data(), fieldNameLower.length()), fieldValue);
+}
+
+bool EmailHeaderFieldParser::ParsePartHeaderField(EmailPart& part, const string& fieldNameLower, const string& fieldValue)
+{
+	return ParsePartHeaderField(part, HeaderFieldNames::Lookup(fieldNameLower.data(), fieldNameLower.length()), fieldValue);
+}
+
+bool EmailHeaderFieldParser::ParseEmailHeaderField(Email& email, HeaderFieldNames::FieldId fieldId, const string& fieldValue)
+{
+	using namespace HeaderFieldNames;
+
+	switch (fieldId) {
+	case Field_Subject: {
 		// decode subject
 		string subject;
 		ParseTextField(fieldValue, subject);
 		email.SetSubject(subject);
-	} else if (fieldNameLower == "date") {
+		break;
+	}
+	case Field_Date: {
 		time_t date;
 		ParseDateField(fieldValue, date);
 
 		// Technically this is the date sent, not received
 		email.SetDateReceived( MojInt64(date) * 1000L);
-	} else if (fieldNameLower == "from" || fieldNameLower == "reply-to" || fieldNameLower == "to" || fieldNameLower == "cc" || fieldNameLower == "bcc") {
+		break;
+	}
+	case Field_From:
+	case Field_ReplyTo:
+	case Field_To:
+	case Field_Cc:
+	case Field_Bcc: {
 		EmailAddressListPtr addressListPtr(new EmailAddressList());
 		ParseAddressListField(fieldValue, *addressListPtr);
 
-		if (fieldNameLower == "to") {
+		if (fieldId == Field_To) {
 			email.SetTo(addressListPtr);
-		} else if (fieldNameLower == "cc") {
+		} else if (fieldId == Field_Cc) {
 			email.SetCc(addressListPtr);
-		} else if (fieldNameLower == "bcc") {
+		} else if (fieldId == Field_Bcc) {
 			email.SetBcc(addressListPtr);
-		} else if (fieldNameLower == "from") {
+		} else if (fieldId == Field_From) {
 			// get first address
 			if (!addressListPtr->empty()) {
 				email.SetFrom(addressListPtr->at(0));
 			}
-		} else if (fieldNameLower == "reply-to") {
+		} else if (fieldId == Field_ReplyTo) {
 			// get first address
 			if (!addressListPtr->empty()) {
 				email.SetReplyTo(addressListPtr->at(0));
 			}
 		}
-	} else if (fieldNameLower == "in-reply-to") {
+		break;
+	}
+	case Field_InReplyTo:
 		email.SetInReplyTo( StringUtils::GetSanitizedASCII(fieldValue) );
-	} else if (fieldNameLower == "x-priority") {
+		break;
+	case Field_XPriority:
 		if(fieldValue == "1" || fieldValue == "2") {
 			email.SetPriority(Email::Priority_High);
 		} else if (fieldValue == "4" || fieldValue == "5") {
 			email.SetPriority(Email::Priority_Low);
 		}
-	} else {
+		break;
+	default:
 		// no match
 		return false;
 	}
@@ -277,11 +302,13 @@ bool EmailHeaderFieldParser::ParseEmailHeaderField(Email& email, const string& f
 	return true;
 }
 
-bool EmailHeaderFieldParser::ParsePartHeaderField(EmailPart& part, const string& fieldNameLower, const string& fieldValue)
+bool EmailHeaderFieldParser::ParsePartHeaderField(EmailPart& part, HeaderFieldNames::FieldId fieldId, const string& fieldValue)
 {
-	if (fieldNameLower == "content-transfer-encoding") {
+	using namespace HeaderFieldNames;
+
+	if (fieldId == Field_ContentTransferEncoding) {
 		part.SetEncoding( StringUtils::GetSanitizedASCII(fieldValue) );
-	} else if (fieldNameLower == "content-disposition") {
+	} else if (fieldId == Field_ContentDisposition) {
 		EmailHeaderFieldParser::ParameterMap params;
 
 		string disposition;
@@ -298,7 +325,7 @@ bool EmailHeaderFieldParser::ParsePartHeaderField(EmailPart& part, const string&
 			filename = Rfc2047Decoder::SafeDecodeText(filename);
 			part.SetDisplayName(filename);
 		}
-	} else if (fieldNameLower == "content-id") {
+	} else if (fieldId == Field_ContentId) {
 		string contentId = fieldValue;
 		size_t sz = contentId.length();
 
@@ -312,4 +339,3 @@ bool EmailHeaderFieldParser::ParsePartHeaderField(EmailPart& part, const string&
 
 	return true;
 }
-
@@ -0,0 +1,71 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "mimeparser/HeaderFieldNames.h"
+#include <strings.h>
+
+using namespace HeaderFieldNames;
+
+struct FieldNameDef {
+	const char*	name;
+	size_t		length;
+	FieldId		id;
+};
+
+#define FIELD(name, id) { name, sizeof(name) - 1, id }
+
+// Sorted by length so the length check rejects most entries
+static const FieldNameDef s_fieldNames[] = {
+	FIELD("to", Field_To),
+	FIELD("cc", Field_Cc),
+	FIELD("bcc", Field_Bcc),
+	FIELD("from", Field_From),
+	FIELD("date", Field_Date),
+	FIELD("subject", Field_Subject),
+	FIELD("reply-to", Field_ReplyTo),
+	FIELD("x-priority", Field_XPriority),
+	FIELD("content-id", Field_ContentId),
+	FIELD("in-reply-to", Field_InReplyTo),
+	FIELD("content-type", Field_ContentType),
+	FIELD("content-disposition", Field_ContentDisposition),
+	FIELD("content-transfer-encoding", Field_ContentTransferEncoding)
+};
+
+#undef FIELD
+
+static const size_t NUM_FIELD_NAMES = sizeof(s_fieldNames) / sizeof(s_fieldNames[0]);
+
+FieldId HeaderFieldNames::Lookup(const char* name, size_t length)
+{
+	if (length == 0) {
+		return Field_Other;
+	}
+
+	// Field names are ASCII, so OR-ing with 0x20 lowercases letters
+	char first = name[0] | 0x20;
+
+	for (size_t i = 0; i < NUM_FIELD_NAMES && s_fieldNames[i].length <= length; ++i) {
+		const FieldNameDef& def = s_fieldNames[i];
+
+		if (def.length == length && def.name[0] == first && strncasecmp(def.name, name, length) == 0) {
+			return def.id;
+		}
+	}
+
+	return Field_Other;
+}
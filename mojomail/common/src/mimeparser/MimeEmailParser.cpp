@@ -23,14 +23,16 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/foreach.hpp>
 #include <iostream>
+#include <cstring>
 #include "mimeparser/Rfc822Tokenizer.h"
 #include "mimeparser/EmailHeaderFieldParser.h"
 
 using namespace std;
 
 MimeEmailParser::MimeEmailParser(ParseEventHandler& handler)
-: m_handler(handler), m_state(State_Initial), m_isMultipart(false), m_paused(false)
+: m_handler(handler), m_state(State_Initial), m_isMultipart(false), m_minBoundaryLength(0), m_paused(false)
 {
+	memset(m_boundaryFirstChars, 0, sizeof(m_boundaryFirstChars));
 }
 
 MimeEmailParser::~MimeEmailParser()
@@ -39,9 +41,23 @@ MimeEmailParser::~MimeEmailParser()
 
 const char* MimeEmailParser::FindEndOfLine(const char* start, const char* end, bool isEOF, const char*& newlinePos)
 {
+	if (!isEOF) {
+		// A bare CR doesn't end a line unless it's at the end of the input,
+		// so we only need to look for LF
+		const char* lf = (const char*) memchr(start, '\n', end - start);
+
+		if (lf) {
+			newlinePos = (lf > start && lf[-1] == '\r') ? lf - 1 : lf;
+			return lf + 1;
+		}
+
+		newlinePos = NULL;
+		return NULL;
+	}
+
 	for(const char* pos = start; pos < end; ++pos) {
 		if(pos[0] == '\r') {
-			if(end - pos > 0 && pos[1] == '\n') {
+			if(end - pos > 1 && pos[1] == '\n') {
 				newlinePos = pos;
 				return pos + 2; // \r\n
 			} else if (isEOF) {
@@ -85,7 +101,7 @@ size_t MimeEmailParser::ParseData(const char* data, size_t length, bool isEOF)
 			if (m_state == State_Body) {
 				// Add lines to buffer until we hit boundary or end of current input
 				BoundaryMatchResult result;
-				if (MatchBoundary(m_boundaryStack, pos, endOfLine - pos, result)) {
+				if (MatchBoundary(pos, endOfLine - pos, result)) {
 					// Process buffer
 					if (bodyStart && bodyEnd) {
 						m_handler.HandleBodyData(bodyStart, bodyEnd - bodyStart);
@@ -165,7 +181,7 @@ void MimeEmailParser::ParseLine(const char* lineData, size_t lineLength)
 
 			// Parse last header line
 			if (!m_lastLineBuffer.empty()) {
-				ParseHeaderLine(m_lastLineBuffer);
+				ParseHeaderLine(m_lastLineBuffer.data(), m_lastLineBuffer.length());
 				m_lastLineBuffer.clear();
 			}
 
@@ -177,10 +193,10 @@ void MimeEmailParser::ParseLine(const char* lineData, size_t lineLength)
 		} else {
 			// New header line; parse last header line
 			if (!m_lastLineBuffer.empty()) {
-				ParseHeaderLine(m_lastLineBuffer);
+				ParseHeaderLine(m_lastLineBuffer.data(), m_lastLineBuffer.length());
 			}
 
-			// replace line buffer with new line
+			// replace line buffer with new line (reuses the buffer's storage)
 			m_lastLineBuffer.assign(lineData, headerLineLength);
 		}
 
@@ -235,31 +251,49 @@ void MimeEmailParser::EndHeaders()
 	}
 }
 
-void MimeEmailParser::ParseHeaderLine(const string& line)
+static inline bool IsHeaderSpace(char c)
 {
-	string fieldName;
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+void MimeEmailParser::ParseHeaderLine(const char* lineData, size_t lineLength)
+{
+	const char* end = lineData + lineLength;
+	const char* colon = (const char*) memchr(lineData, ':', lineLength);
 
-	size_t colonIndex = line.find(':');
-	if (!colonIndex) {
+	if (colon == NULL || colon == lineData) {
 		// FIXME throw exception
 		return;
 	}
 
-	fieldName = line.substr(0, colonIndex);
-	boost::trim(fieldName);
+	// Trim field name
+	const char* nameStart = lineData;
+	const char* nameEnd = colon;
+
+	while (nameStart < nameEnd && IsHeaderSpace(*nameStart)) ++nameStart;
+	while (nameEnd > nameStart && IsHeaderSpace(nameEnd[-1])) --nameEnd;
 
-	string fieldValue = line.substr(colonIndex + 1);
-	boost::trim(fieldValue);
+	// Trim field value
+	const char* valueStart = colon + 1;
+	const char* valueEnd = end;
 
-	m_handler.HandleHeader(fieldName, fieldValue);
+	while (valueStart < valueEnd && IsHeaderSpace(*valueStart)) ++valueStart;
+	while (valueEnd > valueStart && IsHeaderSpace(valueEnd[-1])) --valueEnd;
+
+	m_fieldValue.assign(valueStart, valueEnd - valueStart);
+
+	size_t nameLength = nameEnd - nameStart;
+	HeaderFieldNames::FieldId fieldId = HeaderFieldNames::Lookup(nameStart, nameLength);
+
+	m_handler.HandleHeaderField(fieldId, nameStart, nameLength, m_fieldValue);
 
 	// Parse content-type header so we can find the boundaries
-	if (boost::iequals(fieldName, "content-type")) {
+	if (fieldId == HeaderFieldNames::Field_ContentType) {
 		EmailHeaderFieldParser parser;
 
 		string type, subtype;
 		EmailHeaderFieldParser::ParameterMap params;
-		parser.ParseContentTypeField(fieldValue, type, subtype, params);
+		parser.ParseContentTypeField(m_fieldValue, type, subtype, params);
 
 		m_handler.HandleContentType(type, subtype, params);
 
@@ -268,7 +302,7 @@ void MimeEmailParser::ParseHeaderLine(const string& line)
 
 			if (!boundary.empty()) {
 				m_isMultipart = true;
-				m_boundaryStack.push_back( BoundaryState(boundary) );
+				PushBoundary(boundary);
 			}
 		}
 	}
@@ -304,7 +338,8 @@ bool MimeEmailParser::MatchBoundary(const std::vector<BoundaryState>& boundaries
 		for (int i = boundaries.size() - 1; i >= 0; --i) {
 			const string& boundary = boundaries[i].boundary;
 
-			if (boundary.compare(0, boundary.length(), lineData + 2, std::min(boundary.length(), lineLength - 2)) == 0) {
+			if (lineLength - 2 >= boundary.length() && lineData[2] == boundary[0]
+					&& memcmp(boundary.data(), lineData + 2, boundary.length()) == 0) {
 				result.matchIndex = i;
 
 				result.isEnd = (lineLength >= boundary.length() + 4
@@ -319,15 +354,48 @@ bool MimeEmailParser::MatchBoundary(const std::vector<BoundaryState>& boundaries
 	}
 }
 
-bool MimeEmailParser::CheckBoundaries(const char* lineData, size_t lineLength)
+// Same as above, but first checks the line against the boundary filter
+inline bool MimeEmailParser::MatchBoundary(const char* lineData, size_t lineLength, BoundaryMatchResult& result)
 {
-	if (lineLength > 2 && lineData[0] == '-' && lineData[1] == '-') {
-		BoundaryMatchResult result;
-		if (MatchBoundary(m_boundaryStack, lineData, lineLength, result)) {
-			ProcessBoundaryMatch(result);
-			return true;
+	if (lineLength < 3 || lineLength < m_minBoundaryLength + 2 || lineData[0] != '-' || lineData[1] != '-'
+			|| !m_boundaryFirstChars[(unsigned char) lineData[2]]) {
+		result.matchIndex = -1;
+		result.isEnd = false;
+		return false;
+	}
+
+	return MatchBoundary(m_boundaryStack, lineData, lineLength, result);
+}
+
+void MimeEmailParser::PushBoundary(const std::string& boundary)
+{
+	m_boundaryStack.push_back( BoundaryState(boundary) );
+	UpdateBoundaryFilter();
+}
+
+void MimeEmailParser::UpdateBoundaryFilter()
+{
+	memset(m_boundaryFirstChars, 0, sizeof(m_boundaryFirstChars));
+	m_minBoundaryLength = 0;
+
+	for (size_t i = 0; i < m_boundaryStack.size(); ++i) {
+		const string& boundary = m_boundaryStack[i].boundary;
+
+		m_boundaryFirstChars[(unsigned char) boundary[0]] = true;
+
+		if (i == 0 || boundary.length() < m_minBoundaryLength) {
+			m_minBoundaryLength = boundary.length();
 		}
 	}
+}
+
+bool MimeEmailParser::CheckBoundaries(const char* lineData, size_t lineLength)
+{
+	BoundaryMatchResult result;
+	if (MatchBoundary(lineData, lineLength, result)) {
+		ProcessBoundaryMatch(result);
+		return true;
+	}
 	return false;
 }
 
@@ -361,6 +429,7 @@ void MimeEmailParser::PopBoundaries(int startIndex)
 	for (int i = m_boundaryStack.size() - 1; i >= startIndex; --i) {
 		bool partStarted = m_boundaryStack.at(i).partStarted;
 		m_boundaryStack.erase(m_boundaryStack.begin() + i);
+		UpdateBoundaryFilter();
 
 		if (partStarted) {
 			bool incomplete = (i != startIndex);
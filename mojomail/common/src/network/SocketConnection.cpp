@@ -21,6 +21,7 @@
 #include "CommonPrivate.h"
 #include "exceptions/GErrorException.h"
 #include <sstream>
+#include "email/DateUtils.h"
 #include "exceptions/ExceptionUtils.h"
 
 #ifdef MOJ_LINUX
@@ -31,11 +32,18 @@
 
 using namespace std;
 
+SocketConnection::HostStatsMap SocketConnection::s_hostStats;
+
 SocketConnection::SocketConnection(GIOChannel* channel, bool useSsl)
 : GIOChannelWrapper(channel),
   m_useSsl(useSsl),
   m_bindPort(0),
   m_connectTimeout(0),
+  m_connectStartTime(0),
+  m_connectMillis(0),
+  m_tlsStartTime(0),
+  m_tlsMillis(0),
+  m_reuseCount(0),
   m_connectedSignal(this),
   m_tlsReadySignal(this)
 {
@@ -70,6 +78,10 @@ MojRefCountedPtr<SocketConnection> SocketConnection::CreateSocket(const char* ho
 
 	aioChannel->m_bindAddress = bindAddress;
 
+	stringstream hostKey;
+	hostKey << hostname << ":" << port;
+	aioChannel->m_hostKey = hostKey.str();
+
 	return aioChannel;
 }
 
@@ -88,6 +100,8 @@ void SocketConnection::Connect(ConnectedSignal::SlotRef connectedSlot)
 		m_connectTimer.SetTimeout(m_connectTimeout, this, &SocketConnection::ConnectTimeout);
 	}
 
+	m_connectStartTime = DateUtils::GetMonotonicTimeMillis();
+
 	try {
 
 		if (m_useSsl)
@@ -138,6 +152,7 @@ void SocketConnection::NegotiateTLS(TLSReadySignal::SlotRef tlsReadySlot)
 {
 	GError* gerr = NULL; // must be initialized
 	m_tlsReadySignal.connect(tlsReadySlot);
+	m_tlsStartTime = DateUtils::GetMonotonicTimeMillis();
 	PmSetSocketEncryption(m_channel, true, gpointer(this), (PmSecureSocketSwitchCb) &SocketConnection::NegotiateTLSCb, &gerr);
 	GErrorToException(gerr);
 }
@@ -161,6 +176,11 @@ gboolean SocketConnection::NegotiateTLSCb(GIOChannel* gio, gboolean isSocketEncr
 
 void SocketConnection::TLSReady()
 {
+	if(m_tlsStartTime > 0) {
+		m_tlsMillis = DateUtils::GetMonotonicTimeMillis() - m_tlsStartTime;
+		s_hostStats[m_hostKey].handshakeMillis += m_tlsMillis;
+	}
+
 	m_tlsReadySignal.fire(NULL);
 }
 
@@ -193,6 +213,14 @@ void SocketConnection::TLSError(const GError* error)
 
 void SocketConnection::Connected()
 {
+	if(m_connectStartTime > 0) {
+		m_connectMillis = DateUtils::GetMonotonicTimeMillis() - m_connectStartTime;
+
+		HostStats& hostStats = s_hostStats[m_hostKey];
+		hostStats.handshakeCount++;
+		hostStats.handshakeMillis += m_connectMillis;
+	}
+
 	m_connectedSignal.fire(NULL);
 }
 
@@ -251,13 +279,90 @@ string SocketConnection::DescribeLocalSocket() const
 	return "";
 }
 
+void SocketConnection::MarkReused()
+{
+	m_reuseCount++;
+	s_hostStats[m_hostKey].reuseCount++;
+}
+
 void SocketConnection::Status(MojObject& status) const
 {
+	MojErr err;
+
 	GIOChannelWrapper::Status(status);
 
 	string localSocket = DescribeLocalSocket();
 	if(!localSocket.empty()) {
-		MojErr err = status.putString("localSocket", localSocket.c_str());
+		err = status.putString("localSocket", localSocket.c_str());
+		ErrorToException(err);
+	}
+
+	if(m_connectMillis > 0 || m_tlsMillis > 0) {
+		MojObject handshake;
+
+		err = handshake.put("connectMillis", m_connectMillis);
+		ErrorToException(err);
+
+		if(m_tlsMillis > 0) {
+			err = handshake.put("tlsMillis", m_tlsMillis);
+			ErrorToException(err);
+		}
+
+		err = status.put("handshake", handshake);
+		ErrorToException(err);
+	}
+
+	if(m_reuseCount > 0) {
+		err = status.put("reuseCount", m_reuseCount);
+		ErrorToException(err);
+	}
+
+	HostStatsMap::const_iterator it = s_hostStats.find(m_hostKey);
+	if(it != s_hostStats.end()) {
+		MojObject hostStatus;
+		HostStatsToObject(it->second, hostStatus);
+
+		err = hostStatus.putString("host", m_hostKey.c_str());
+		ErrorToException(err);
+
+		err = status.put("hostStats", hostStatus);
+		ErrorToException(err);
+	}
+}
+
+void SocketConnection::HostStatsToObject(const HostStats& stats, MojObject& obj)
+{
+	MojErr err;
+
+	err = obj.put("handshakeCount", stats.handshakeCount);
+	ErrorToException(err);
+
+	if(stats.handshakeCount > 0) {
+		err = obj.put("averageHandshakeMillis", stats.handshakeMillis / stats.handshakeCount);
+		ErrorToException(err);
+	}
+
+	err = obj.put("reuseCount", stats.reuseCount);
+	ErrorToException(err);
+
+	// Percentage of connection uses that didn't need a new connection (e.g. pooled IMAP connections)
+	MojInt64 total = stats.handshakeCount + stats.reuseCount;
+	if(total > 0) {
+		err = obj.put("reusePercent", (stats.reuseCount * 100) / total);
+		ErrorToException(err);
+	}
+}
+
+void SocketConnection::HostStatus(MojObject& status)
+{
+	MojErr err;
+
+	HostStatsMap::const_iterator it;
+	for(it = s_hostStats.begin(); it != s_hostStats.end(); ++it) {
+		MojObject hostStatus;
+		HostStatsToObject(it->second, hostStatus);
+
+		err = status.put(it->first.c_str(), hostStatus);
 		ErrorToException(err);
 	}
 }
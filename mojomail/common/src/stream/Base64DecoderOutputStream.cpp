@@ -23,14 +23,9 @@
 size_t Base64DecoderOutputStream::BLOCK_SIZE = 4096;
 
 Base64DecoderOutputStream::Base64DecoderOutputStream(const OutputStreamPtr& sink)
-: ChainedOutputStream(sink), m_state(0), m_save(0)
+: ChainedOutputStream(sink)
 {
-	//FIXME the buffer size should be smaller
-	size_t bufsize = ((BLOCK_SIZE / 3 + 1) * 4 + 4);
-
-	bufsize += bufsize / 72 + 1; // add space for newlines
-
-	m_outbuf.reset( new char[bufsize] );
+	m_outbuf.reset( new char[Base64Decoder::MaxDecodedSize(BLOCK_SIZE)] );
 }
 
 Base64DecoderOutputStream::~Base64DecoderOutputStream()
@@ -39,16 +34,15 @@ Base64DecoderOutputStream::~Base64DecoderOutputStream()
 
 void Base64DecoderOutputStream::Write(const char* src, size_t length)
 {
-	unsigned char *outbuf = (unsigned char *)m_outbuf.get();
+	char *outbuf = m_outbuf.get();
 
 	for(size_t offset = 0; offset < length; offset += BLOCK_SIZE) {
 		const char* start = src + offset;
 		size_t remaining = length - offset;
 		size_t blocklen = remaining < BLOCK_SIZE ? remaining : BLOCK_SIZE;
 
-		// FIXME need \r\n not \n newlines
-		gsize numBytesOut = g_base64_decode_step(start, blocklen, outbuf, &m_state, &m_save);
-		m_sink->Write((const char*)outbuf, numBytesOut);
+		size_t numBytesOut = m_decoder.Decode(start, blocklen, outbuf);
+		m_sink->Write(outbuf, numBytesOut);
 	}
 }
 
@@ -20,6 +20,13 @@
 #include "CommonPrivate.h"
 #include "stream/BaseOutputStream.h"
 #include <glib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 
 using namespace std;
 
@@ -32,6 +39,7 @@ LineReader::LineReader(const InputStreamPtr& inputStream)
   m_timeoutExceeded(false),
   m_maximumLineLength(1048576), // 1MB
   m_timeoutId(0),
+  m_scannedLength(0),
   m_newlineMode(NewlineMode_CRLF),
   m_dataAvailableSignal(this)
 {
@@ -63,6 +71,7 @@ void LineReader::WaitForLine(LineAvailableSignal::SlotRef slot, int timeout)
 	}
 	
 	m_expect = EXPECT_LINE;
+	m_scannedLength = 0;
 	m_dataAvailableSignal.connect(slot);
 	
 	SetTimeout(timeout);
@@ -114,6 +123,7 @@ void LineReader::SetTimeout(int timeout)
 void LineReader::SetNewlineMode(NewlineMode mode)
 {
 	m_newlineMode = mode;
+	m_scannedLength = 0;
 }
 
 void LineReader::CheckError()
@@ -174,6 +184,23 @@ size_t LineReader::ReadData(char* dst, size_t length)
 	return bytesToCopy;
 }
 
+size_t LineReader::AppendData(string& dst, size_t length)
+{
+	CheckError();
+	
+	if( unlikely(m_currentBufferPos == NULL) ) {
+		throw MailException("LineReader::AppendData called without WaitForLine", __FILE__, __LINE__);
+	}
+	
+	size_t bufferLength = m_currentBufferEnd - m_currentBufferPos;
+	size_t bytesToCopy = bufferLength < length ? bufferLength : length;
+	
+	dst.append(m_currentBufferPos, bytesToCopy);
+	m_currentBufferPos += bytesToCopy;
+	
+	return bytesToCopy;
+}
+
 size_t LineReader::WriteFromBuffer(const OutputStreamPtr& os, size_t length)
 {
 	CheckError();
@@ -185,8 +212,8 @@ size_t LineReader::WriteFromBuffer(const OutputStreamPtr& os, size_t length)
 	size_t bufferLength = m_currentBufferEnd - m_currentBufferPos;
 	size_t bytesToCopy = bufferLength < length ? bufferLength : length;
 
-	os->Write(m_currentBufferPos, length);
-	m_currentBufferPos += length;
+	os->Write(m_currentBufferPos, bytesToCopy);
+	m_currentBufferPos += bytesToCopy;
 
 	return bytesToCopy;
 }
@@ -209,34 +236,84 @@ bool LineReader::MoreLinesInBuffer()
 	return m_currentLineEnd != NULL;
 }
 
+// Returns a pointer to the first '\n' (or '\r', if matchCR is set) in [pos, end), or NULL.
+static inline const char* FindNewlineChar(const char* pos, const char* end, bool matchCR)
+{
+#if defined(__SSE2__)
+	// Check 16 bytes at a time; when matchCR is false both compares look for '\n'
+	const __m128i lf = _mm_set1_epi8('\n');
+	const __m128i cr = _mm_set1_epi8(matchCR ? '\r' : '\n');
+
+	for(; end - pos >= 16; pos += 16) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+		int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr)));
+
+		if(mask != 0) {
+			return pos + __builtin_ctz(mask);
+		}
+	}
+#elif defined(__ARM_NEON__)
+	// NEON has no movemask; find the block containing a match and let the loop below locate it
+	const uint8x16_t lf = vdupq_n_u8('\n');
+	const uint8x16_t cr = vdupq_n_u8(matchCR ? '\r' : '\n');
+
+	for(; end - pos >= 16; pos += 16) {
+		uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(pos));
+		uint8x16_t match = vorrq_u8(vceqq_u8(chunk, lf), vceqq_u8(chunk, cr));
+		uint8x8_t folded = vorr_u8(vget_low_u8(match), vget_high_u8(match));
+
+		if(vget_lane_u64(vreinterpret_u64_u8(folded), 0) != 0) {
+			break;
+		}
+	}
+#endif
+
+	if(!matchCR) {
+		return static_cast<const char*>(memchr(pos, '\n', end - pos));
+	}
+
+	for(; pos < end; ++pos) {
+		if(*pos == '\n' || *pos == '\r') {
+			return pos;
+		}
+	}
+
+	return NULL;
+}
+
 const char* LineReader::FindEndOfLine(NewlineMode newlineMode, const char* start, const char* end, const char*& newlinePos)
+{
+	return FindEndOfLine(newlineMode, start, start, end, newlinePos);
+}
+
+const char* LineReader::FindEndOfLine(NewlineMode newlineMode, const char* start, const char* scanFrom, const char* end, const char*& newlinePos)
 {
 	if(newlineMode == NewlineMode_CRLF) {
-		if(end - start >= 2) {
-			// If there's least two characters
+		// Look for a \n preceded by \r. A \n at scanFrom may complete a \r from the previous scan.
+		const char* pos = scanFrom > start ? scanFrom : start + 1;
 
-			--end; // only loop up to the next-to-last char
+		while(pos < end) {
+			const char* lf = FindNewlineChar(pos, end, false);
 
-			for(const char* pos = start; pos < end; ++pos) {
-				if(pos[0] == '\r' && pos[1] == '\n') {
-					newlinePos = pos;
-					return pos + 2; // skip \r\n
-				}
+			if(lf == NULL) {
+				break;
+			} else if(lf[-1] == '\r') {
+				newlinePos = lf - 1;
+				return lf + 1; // skip \r\n
 			}
+
+			pos = lf + 1;
 		}
 	} else if(newlineMode == NewlineMode_Auto) {
-		for(const char* pos = start; pos < end; ++pos) {
-			if(pos[0] == '\r') {
-				if(end - pos > 0 && pos[1] == '\n') {
-					newlinePos = pos;
-					return pos + 2; // \r\n
-				} else {
-					newlinePos = pos;
-					return pos + 1; // \n\r
-				}
-			} else if(pos[0] == '\n') {
-				newlinePos = pos;
-				return pos + 1;
+		const char* pos = FindNewlineChar(scanFrom, end, true);
+
+		if(pos != NULL) {
+			newlinePos = pos;
+
+			if(pos[0] == '\r' && end - pos > 1 && pos[1] == '\n') {
+				return pos + 2; // \r\n
+			} else {
+				return pos + 1; // \n or \r
 			}
 		}
 	}
@@ -261,9 +338,14 @@ size_t LineReader::HandleData(const char* data, size_t length, bool eof)
 
 	SetupBufferPointers(data, length);
 
+	// Bytes at the start of the buffer that were already searched for a newline.
+	// Unhandled data is passed back in the next call, so the search can resume there.
+	size_t scannedLength = m_scannedLength <= length ? m_scannedLength : 0;
+	m_scannedLength = 0;
+
 	if(m_expect == EXPECT_LINE) {
 		// Find \r\n sequence
-		const char* end = FindEndOfLine(m_newlineMode, data, data + length, m_currentNewlinePos);
+		const char* end = FindEndOfLine(m_newlineMode, data, data + scannedLength, data + length, m_currentNewlinePos);
 		
 		if (m_maximumLineLength > 0 && ((end != NULL && (size_t)(end - data) > m_maximumLineLength) ||
 										(end == NULL && length > m_maximumLineLength)) ) {
@@ -296,6 +378,9 @@ size_t LineReader::HandleData(const char* data, size_t length, bool eof)
 
 			m_expect = EXPECT_NONE; // must be set before callback
 			m_dataAvailableSignal.fire();
+		} else {
+			// Still waiting for the rest of the line
+			m_scannedLength = length;
 		}
 	} else if(m_expect == EXPECT_DATA) {
 		// Check if there's enough data to pass on, or EOF
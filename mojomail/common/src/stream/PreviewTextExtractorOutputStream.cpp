@@ -17,10 +17,9 @@
 // LICENSE@@@
 
 #include "stream/PreviewTextExtractorOutputStream.h"
-#include "email/PreviewTextGenerator.h"
 
-PreviewTextExtractorOutputStream::PreviewTextExtractorOutputStream(const OutputStreamPtr& sink, size_t previewLength)
-: ChainedOutputStream(sink), m_previewLength(previewLength)
+PreviewTextExtractorOutputStream::PreviewTextExtractorOutputStream(const OutputStreamPtr& sink, size_t previewLength, bool html)
+: ChainedOutputStream(sink), m_extractor(previewLength, html)
 {
 }
 
@@ -30,22 +29,15 @@ PreviewTextExtractorOutputStream::~PreviewTextExtractorOutputStream()
 
 void PreviewTextExtractorOutputStream::Write(const char* src, size_t length)
 {
-	if(m_previewBuf.length() >= m_previewLength) {
-		// already have enough text; do nothing
-	} else {
-		size_t space = m_previewLength - m_previewBuf.length();
-		size_t bytesToCopy = std::min(space, length);
-		m_previewBuf.append(src, bytesToCopy);
+	// Once there's enough text, the rest of the data just passes through
+	if(!m_extractor.IsFull()) {
+		m_extractor.Append(src, length);
 	}
 
 	ChainedOutputStream::Write(src, length);
 }
 
-const std::string& PreviewTextExtractorOutputStream::GetPreviewText()
+std::string PreviewTextExtractorOutputStream::GetPreviewText()
 {
-	// Chop off any partial UTF-8 characters
-
-	//fprintf(stdout, "m_previewBuf:%d and m_previewLength:%d", m_previewBuf.length(), m_previewLength);
-	PreviewTextGenerator::TruncateUTF8(m_previewBuf, m_previewLength);
-	return m_previewBuf;
+	return m_extractor.GetPreviewText();
 }
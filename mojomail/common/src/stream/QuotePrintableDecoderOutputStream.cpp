@@ -17,9 +17,10 @@
 // LICENSE@@@
 
 #include "stream/QuotePrintableDecoderOutputStream.h"
+#include <string.h>
 
 QuotePrintableDecoderOutputStream::QuotePrintableDecoderOutputStream(const OutputStreamPtr& out)
-: ChainedOutputStream(out), m_state(0), m_save(0), m_hi(0)
+: ChainedOutputStream(out), m_outbufSize(0), m_state(0), m_save(0), m_hi(0)
 {
 
 }
@@ -29,44 +30,85 @@ QuotePrintableDecoderOutputStream::~QuotePrintableDecoderOutputStream()
 
 }
 
+static inline int HexValue(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	else if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	else if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	else
+		return -1;
+}
+
 void QuotePrintableDecoderOutputStream::Write(const char* buf, size_t len)
 {
-	int offset = 0; 
-	int cnt = 0;
-	//fprintf(stdout, "Quoted Printable Output Stream %p before conversion [%s]\n", this, std::string(buf, len).c_str());
-	//FIXME check size, do not reallocate if it is big enough.
-	m_outbuf.reset( new char[len] );
+	const char* pos = buf;
+	const char* end = buf + len;
+
+	// Nothing to decode; pass the data straight through
+	if (m_state == 0 && memchr(buf, '=', len) == NULL) {
+		m_sink->Write(buf, len);
+		return;
+	}
+
+	// An invalid escape started in the last call can add two extra characters
+	if (len + 2 > m_outbufSize) {
+		m_outbufSize = len + 2;
+		m_outbuf.reset( new char[m_outbufSize] );
+	}
+
 	char *outbuf = m_outbuf.get();
-	for (unsigned int i=0;i<len;i++) {
-		char c = buf[offset+i];
-		switch (m_state) {
-		case 0: {
-			if (c!='=') {
-				outbuf[cnt++] = c;
-			}
-			else {
+	size_t cnt = 0;
+
+	while (pos < end) {
+		if (m_state == 0) {
+			// Copy everything up to the next escape
+			const char* escape = (const char*) memchr(pos, '=', end - pos);
+			const char* runEnd = escape ? escape : end;
+
+			memcpy(outbuf + cnt, pos, runEnd - pos);
+			cnt += runEnd - pos;
+			pos = runEnd;
+
+			if (escape) {
 				m_state = 1;
+				pos++;
 			}
-			break;
-		}
-		case 1: {
-			m_hi = c;
-			m_state = 2;
-			break;
+			continue;
 		}
-		case 2: {
-			int lo = c;
+
+		char c = *pos++;
+
+		if (m_state == 1) {
+			if (c == '\n') {
+				// Soft line break with a bare LF
+				m_state = 0;
+			} else {
+				m_hi = c;
+				m_state = 2;
+			}
+		} else {
 			m_state = 0;
-			if (m_hi=='\r' && lo=='\n')
-				break;
-			m_hi = (m_hi>='A' ? m_hi-'A'+10 : m_hi-'0');
-			lo = (lo>='A' ? lo-'A'+10 : lo-'0');
-			outbuf[cnt++] = ((m_hi<<4)+lo);
-			break;
-		}
+
+			// Soft line break
+			if (m_hi == '\r' && c == '\n')
+				continue;
+
+			int hi = HexValue(m_hi);
+			int lo = HexValue(c);
+
+			if (hi >= 0 && lo >= 0) {
+				outbuf[cnt++] = (hi << 4) + lo;
+			} else {
+				// Not a valid escape; keep the text as is and look at c again
+				outbuf[cnt++] = '=';
+				outbuf[cnt++] = m_hi;
+				pos--;
+			}
 		}
 	}
 
-	//fprintf(stdout, "Quoted Printable Output Stream %p after conversion [%s]\n", this, std::string(outbuf, cnt).c_str());
 	m_sink->Write(outbuf, cnt);
 }
@@ -17,9 +17,11 @@
 // LICENSE@@@
 
 #include "stream/QuotedPrintableEncoderOutputStream.h"
+#include <algorithm>
+#include <string.h>
 
 QuotedPrintableEncoderOutputStream::QuotedPrintableEncoderOutputStream(const OutputStreamPtr& out)
-: ChainedOutputStream(out), m_state(0), m_col(0){
+: ChainedOutputStream(out), m_outbufSize(0), m_state(0), m_col(0){
 
     m_col = 0;
 }
@@ -28,6 +30,23 @@ QuotedPrintableEncoderOutputStream::~QuotedPrintableEncoderOutputStream() {
 
 }
 
+// Reuses the output buffer unless it's too small
+char* QuotedPrintableEncoderOutputStream::GetOutputBuffer(size_t size)
+{
+	if(size > m_outbufSize) {
+		m_outbuf.reset( new char[size] );
+		m_outbufSize = size;
+	}
+
+	return m_outbuf.get();
+}
+
+// Characters that never need encoding or lookahead (excludes '=', space, tab and CR)
+static inline bool IsLiteralChar(char c)
+{
+	return c >= 33 && c <= 126 && c != '=';
+}
+
 #define output_char(c, force) do {					\
 	bool encode = force;							\
 	if (!((c == 32) || (c == 9) ||					\
@@ -66,15 +85,37 @@ void QuotedPrintableEncoderOutputStream::Write(const char* buf, size_t len) {
 	int offset = 0; 
 	int cnt = 0;
 	
-	//FIXME check size, do not reallocate if it is big enough.
     // worst case, repeated "\xFF" stream expands to "=FF" with line breaks every 25 1/3 input chars, of "=\r\n"
     // characters. (((25.3*3)+4) / (25*1). That's a bit less than 3.2, so multiply by 3.2 over 1.
-    
-    m_outbuf.reset( new char[((len + 1) * 32 / 10)] );
-	
-	char *outbuf = m_outbuf.get();
+	char *outbuf = GetOutputBuffer((len + 1) * 32 / 10);
+
 	for (unsigned int i=0;i<len;i++) {
 		char c = buf[offset+i];
+
+		// Copy runs of plain characters in bulk, up to the end of the line
+		if (m_state == 0 && IsLiteralChar(c)) {
+			if (m_col + 1 >= 76) {
+				outbuf[cnt++] = '=';
+				outbuf[cnt++] = '\r';
+				outbuf[cnt++] = '\n';
+				m_col = 0;
+			}
+
+			// Dots at the beginning of a line get encoded below
+			if (!(c == '.' && m_col == 0)) {
+				unsigned int runEnd = i + 1;
+				unsigned int maxEnd = std::min<unsigned int>(len, i + (75 - m_col));
+
+				while (runEnd < maxEnd && IsLiteralChar(buf[offset+runEnd]))
+					runEnd++;
+
+				memcpy(outbuf + cnt, buf + offset + i, runEnd - i);
+				cnt += runEnd - i;
+				m_col += runEnd - i;
+				i = runEnd - 1;
+				continue;
+			}
+		}
 		
 		switch (m_state) {
 		restart_state_0:
@@ -165,8 +206,7 @@ void QuotedPrintableEncoderOutputStream::Flush(FlushType flushType)
 {
 	int cnt = 0;
     
-	m_outbuf.reset( new char[10] );
-	char *outbuf = m_outbuf.get();
+	char *outbuf = GetOutputBuffer(10);
 
 	// Assume that the end of the stream is a significant barrier, so
 	// that any partial CRLF sequences should be encoded as they are
@@ -18,7 +18,12 @@
 
 #include "stream/UTF8DecoderOutputStream.h"
 #include "exceptions/MailException.h"
+#include "email/CharsetConverterPool.h"
 #include "email/CharsetSupport.h"
+#include "util/UTF8Validator.h"
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/algorithm/string/erase.hpp>
+#include <string.h>
 
 using namespace std;
 
@@ -30,26 +35,56 @@ const size_t UTF8DecoderOutputStream::PIVOT_BUF_SIZE = 10;
 
 UConverter *UTF8DecoderOutputStream::s_targetCnv;
 
+// Returns true if the charset is a subset of UTF-8, so valid input can be used as-is
+static bool IsUTF8Compatible(const char* charset)
+{
+	string normalized = charset;
+	boost::to_lower(normalized);
+	boost::erase_all(normalized, "-");
+	boost::erase_all(normalized, "_");
+
+	return normalized == "utf8" || normalized == "usascii" || normalized == "ascii";
+}
+
 UTF8DecoderOutputStream::UTF8DecoderOutputStream(const OutputStreamPtr& sink, const char* converterName)
 : ChainedOutputStream(sink),
+  m_charset(CharsetSupport::SelectCharset(converterName)),
+  m_passthrough(false),
+  m_pendingLength(0),
   m_initialized(false),
   m_sourceCnv(NULL),
   m_pivotSource(NULL),
   m_pivotTarget(NULL)
+{
+	// ASCII and UTF-8 text can be written directly once it's been validated
+	if(IsUTF8Compatible(m_charset.c_str())) {
+		m_passthrough = true;
+	} else {
+		StartConverter();
+	}
+}
+
+UTF8DecoderOutputStream::~UTF8DecoderOutputStream()
+{
+	CharsetConverterPool::Release(m_sourceCnv);
+}
+
+void UTF8DecoderOutputStream::StartConverter()
 {
 	UErrorCode err = U_ZERO_ERROR;
 
-	m_sourceCnv = GetCacheConverter(converterName, &err);
+	m_sourceCnv = CharsetConverterPool::Acquire(m_charset.c_str(), &err);
 
-	if(err) {
-		string errorMsg = "unable to get converter for charset '" + string(converterName) + "'";
+	if(U_FAILURE(err)) {
+		string errorMsg = "unable to get converter for charset '" + m_charset + "'";
 		throw MailException(errorMsg.c_str(), __FILE__, __LINE__);
 	}
 
 	if(s_targetCnv == NULL) {
-		s_targetCnv = GetCacheConverter("UTF-8", &err);
+		// Shared by all streams and never released
+		s_targetCnv = CharsetConverterPool::Acquire("UTF-8", &err);
 
-		if(err)
+		if(U_FAILURE(err))
 		{
 			throw MailException("unable to get UTF-8 converter", __FILE__, __LINE__);
 		}
@@ -59,15 +94,12 @@ UTF8DecoderOutputStream::UTF8DecoderOutputStream(const OutputStreamPtr& sink, co
 	m_pivotBuf.reset(new UChar[PIVOT_BUF_SIZE]);
 	m_pivotSource = m_pivotBuf.get();
 	m_pivotTarget = m_pivotBuf.get();
-}
 
-UTF8DecoderOutputStream::~UTF8DecoderOutputStream()
-{
-	if(m_sourceCnv)
-		ReleaseCacheConverter(m_sourceCnv);
+	m_initialized = false;
+	m_passthrough = false;
 }
 
-void UTF8DecoderOutputStream::Write(const char* src, size_t length, bool eof)
+void UTF8DecoderOutputStream::Convert(const char* src, size_t length, bool eof)
 {
 	UErrorCode ErrorCode;
 
@@ -100,43 +132,70 @@ void UTF8DecoderOutputStream::Write(const char* src, size_t length, bool eof)
 	}
 }
 
-void UTF8DecoderOutputStream::Write(const char* src, size_t length)
+void UTF8DecoderOutputStream::WritePassthrough(const char* src, size_t length, bool eof)
 {
-	Write(src, length, false);
+	// Finish any sequence that was split across writes
+	if(m_pendingLength > 0) {
+		while(length > 0 && UTF8Validator::IsIncompleteSequence(m_pending, m_pendingLength)) {
+			m_pending[m_pendingLength++] = *src++;
+			length--;
+		}
+
+		if(UTF8Validator::IsValid(m_pending, m_pendingLength)) {
+			m_sink->Write(m_pending, m_pendingLength);
+			m_pendingLength = 0;
+		} else if(length == 0 && !eof && UTF8Validator::IsIncompleteSequence(m_pending, m_pendingLength)) {
+			// Still need more data
+			return;
+		} else {
+			// Invalid or truncated; let ICU handle it from here
+			StartConverter();
+			Convert(m_pending, m_pendingLength, false);
+			m_pendingLength = 0;
+			Convert(src, length, eof);
+			return;
+		}
+	}
+
+	size_t validLength = UTF8Validator::ValidLength(src, length);
+
+	if(validLength > 0) {
+		m_sink->Write(src, validLength);
+	}
+
+	src += validLength;
+	length -= validLength;
+
+	if(length == 0) {
+		// done
+	} else if(!eof && UTF8Validator::IsIncompleteSequence(src, length)) {
+		// Save the start of the sequence until we get the rest of it
+		memcpy(m_pending, src, length);
+		m_pendingLength = length;
+	} else {
+		// Invalid data. Convert the rest of the stream with ICU, which will
+		// replace bad bytes with substitution characters.
+		StartConverter();
+		Convert(src, length, eof);
+	}
 }
 
-void UTF8DecoderOutputStream::Close()
+void UTF8DecoderOutputStream::Write(const char* src, size_t length, bool eof)
 {
-	Write("", 0, true);
-	m_sink->Close();
+	if(m_passthrough) {
+		WritePassthrough(src, length, eof);
+	} else {
+		Convert(src, length, eof);
+	}
 }
 
-//FIXME cache the converters
-// NOTE: need to be careful about state
-UConverter * UTF8DecoderOutputStream::GetCacheConverter(const char* converterName, UErrorCode *err)
+void UTF8DecoderOutputStream::Write(const char* src, size_t length)
 {
-	converterName = CharsetSupport::SelectCharset(converterName);
-
-	//int32_t length;
-	//UErrorCode status;
-	//std::map<const MojObject, boost::shared_ptr<UConverter> >::iterator it;
-	//MojObject(converterName);
-	//it=m_cacheConverterMap.find();
-	//if (it == m_cacheConverterMap.end()) {
-	//	MojLogInfo(m_log, "creating converter for account %s", converterName);
-	//return retCnv = ucnv_open(encodeName.data(), err);
-	//
-	//return retCnv = NULL;
-	//	m_cacheConverterMap[accountId] = retCnv;
-	//	client->SetAccount(accountId, false);
-	//} else {
-	//	client = it->second;
-	//}
-
-	return ucnv_open(converterName, err);
+	Write(src, length, false);
 }
 
-void UTF8DecoderOutputStream::ReleaseCacheConverter(UConverter* conv)
+void UTF8DecoderOutputStream::Close()
 {
-	ucnv_close(conv);
+	Write("", 0, true);
+	m_sink->Close();
 }
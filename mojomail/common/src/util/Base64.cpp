@@ -0,0 +1,324 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "util/Base64.h"
+#include <string.h>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+static const char s_encodeTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// 0xFF for characters outside the base64 alphabet (including '=')
+static const unsigned char INVALID = 0xFF;
+
+static const unsigned char s_decodeTable[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,   62, 0xFF, 0xFF, 0xFF,   63,
+	  52,   53,   54,   55,   56,   57,   58,   59,   60,   61, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF,    0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   14,
+	  15,   16,   17,   18,   19,   20,   21,   22,   23,   24,   25, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF,   26,   27,   28,   29,   30,   31,   32,   33,   34,   35,   36,   37,   38,   39,   40,
+	  41,   42,   43,   44,   45,   46,   47,   48,   49,   50,   51, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+static inline void EncodeTriplet(const unsigned char* in, char* out)
+{
+	unsigned int v = (in[0] << 16) | (in[1] << 8) | in[2];
+
+	out[0] = s_encodeTable[(v >> 18) & 0x3F];
+	out[1] = s_encodeTable[(v >> 12) & 0x3F];
+	out[2] = s_encodeTable[(v >> 6) & 0x3F];
+	out[3] = s_encodeTable[v & 0x3F];
+}
+
+#if defined(__SSSE3__)
+// Encodes 12 bytes into 16 characters. Reads 16 bytes from in.
+// Based on the pshufb method by Wojciech Mula and Daniel Lemire.
+static inline void EncodeBlock12(const unsigned char* in, char* out)
+{
+	__m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+
+	// Spread each 3 byte group over 4 bytes, then move each 6 bit field into its own byte
+	input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+	const __m128i t0 = _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00));
+	const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+	const __m128i t2 = _mm_and_si128(input, _mm_set1_epi32(0x003f03f0));
+	const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+	const __m128i indices = _mm_or_si128(t1, t3);
+
+	// Map 0..25, 26..51, 52..61, 62, 63 to an offset into the ASCII range
+	__m128i offsetIndex = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+	const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+	offsetIndex = _mm_or_si128(offsetIndex, _mm_and_si128(upper, _mm_set1_epi8(13)));
+
+	const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+	__m128i result = _mm_add_epi8(_mm_shuffle_epi8(offsets, offsetIndex), indices);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out), result);
+}
+
+// Decodes 16 characters into 12 bytes. Returns false, without writing anything,
+// if any of the characters is outside the base64 alphabet.
+static inline bool DecodeBlock16(const unsigned char* in, unsigned char* out)
+{
+	const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+
+	// Bytes >= 0x80 compare as negative and fall outside every range
+	const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(input, _mm_set1_epi8('Z' + 1)));
+	const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(input, _mm_set1_epi8('z' + 1)));
+	const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(input, _mm_set1_epi8('9' + 1)));
+	const __m128i plus = _mm_cmpeq_epi8(input, _mm_set1_epi8('+'));
+	const __m128i slash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+
+	const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(_mm_or_si128(digit, plus), slash));
+
+	if(_mm_movemask_epi8(valid) != 0xFFFF) {
+		return false;
+	}
+
+	__m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+	shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+	shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+	shift = _mm_or_si128(shift, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+	shift = _mm_or_si128(shift, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
+
+	const __m128i values = _mm_add_epi8(input, shift);
+
+	// Pack four 6 bit values into 24 bits, then gather the three bytes of each group
+	const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+	const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+	const __m128i packed = _mm_shuffle_epi8(groups, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+	char buf[16];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(buf), packed);
+	memcpy(out, buf, 12);
+
+	return true;
+}
+#endif
+
+Base64Encoder::Base64Encoder(size_t lineLength)
+: m_lineLength(lineLength), m_currentLineLength(0), m_numPending(0)
+{
+}
+
+size_t Base64Encoder::MaxEncodedSize(size_t length) const
+{
+	size_t encodedLength = (length + m_numPending + 2) / 3 * 4;
+
+	if(m_lineLength > 0) {
+		encodedLength += (encodedLength / m_lineLength + 1) * 2;
+	}
+
+	return encodedLength;
+}
+
+size_t Base64Encoder::Encode(const char* src, size_t length, char* dst)
+{
+	const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+	const unsigned char* end = in + length;
+	char* out = dst;
+
+	// Complete a group left over from the last call
+	if(m_numPending > 0) {
+		while(m_numPending < 3 && in < end) {
+			m_pending[m_numPending++] = *in++;
+		}
+
+		if(m_numPending < 3) {
+			return 0;
+		}
+
+		m_numPending = 0;
+
+		if(m_lineLength > 0 && m_currentLineLength >= m_lineLength) {
+			*out++ = '\r';
+			*out++ = '\n';
+			m_currentLineLength = 0;
+		}
+
+		EncodeTriplet(m_pending, out);
+		out += 4;
+		m_currentLineLength += 4;
+	}
+
+	while(end - in >= 3) {
+		// Number of groups that fit on the current line
+		size_t numGroups = (end - in) / 3;
+
+		if(m_lineLength > 0) {
+			if(m_currentLineLength >= m_lineLength) {
+				*out++ = '\r';
+				*out++ = '\n';
+				m_currentLineLength = 0;
+			}
+
+			size_t groupsLeftOnLine = (m_lineLength - m_currentLineLength) / 4;
+
+			if(numGroups > groupsLeftOnLine) {
+				numGroups = groupsLeftOnLine;
+			}
+		}
+
+		const unsigned char* groupsEnd = in + numGroups * 3;
+		m_currentLineLength += numGroups * 4;
+
+#if defined(__SSSE3__)
+		// Each block reads 16 bytes, so stop while there's still enough input left
+		while(groupsEnd - in >= 12 && end - in >= 16) {
+			EncodeBlock12(in, out);
+			in += 12;
+			out += 16;
+		}
+#endif
+
+		for(; in < groupsEnd; in += 3, out += 4) {
+			EncodeTriplet(in, out);
+		}
+	}
+
+	// Save leftover bytes for the next call
+	while(in < end) {
+		m_pending[m_numPending++] = *in++;
+	}
+
+	return out - dst;
+}
+
+size_t Base64Encoder::Finish(char* dst)
+{
+	char* out = dst;
+
+	if(m_numPending > 0) {
+		if(m_lineLength > 0 && m_currentLineLength >= m_lineLength) {
+			*out++ = '\r';
+			*out++ = '\n';
+		}
+
+		unsigned int v = m_pending[0] << 16;
+
+		if(m_numPending > 1) {
+			v |= m_pending[1] << 8;
+		}
+
+		*out++ = s_encodeTable[(v >> 18) & 0x3F];
+		*out++ = s_encodeTable[(v >> 12) & 0x3F];
+		*out++ = m_numPending > 1 ? s_encodeTable[(v >> 6) & 0x3F] : '=';
+		*out++ = '=';
+	}
+
+	if(m_lineLength > 0) {
+		*out++ = '\r';
+		*out++ = '\n';
+	}
+
+	m_currentLineLength = 0;
+	m_numPending = 0;
+
+	return out - dst;
+}
+
+Base64Decoder::Base64Decoder()
+: m_bits(0), m_count(0)
+{
+}
+
+size_t Base64Decoder::Decode(const char* src, size_t length, char* dst)
+{
+	const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+	const unsigned char* end = in + length;
+	unsigned char* out = reinterpret_cast<unsigned char*>(dst);
+
+	while(in < end) {
+		if(m_count == 0) {
+			// Fast path for runs of complete groups; stops at line breaks and padding
+#if defined(__SSSE3__)
+			while(end - in >= 16 && DecodeBlock16(in, out)) {
+				in += 16;
+				out += 12;
+			}
+#endif
+
+			while(end - in >= 4) {
+				unsigned int a = s_decodeTable[in[0]];
+				unsigned int b = s_decodeTable[in[1]];
+				unsigned int c = s_decodeTable[in[2]];
+				unsigned int d = s_decodeTable[in[3]];
+
+				if((a | b | c | d) == INVALID) {
+					break;
+				}
+
+				unsigned int v = (a << 18) | (b << 12) | (c << 6) | d;
+				out[0] = v >> 16;
+				out[1] = v >> 8;
+				out[2] = v;
+
+				in += 4;
+				out += 3;
+			}
+
+			if(in == end) {
+				break;
+			}
+		}
+
+		unsigned char ch = *in++;
+		unsigned int value = s_decodeTable[ch];
+
+		if(value != INVALID) {
+			m_bits = (m_bits << 6) | value;
+
+			if(++m_count == 4) {
+				out[0] = m_bits >> 16;
+				out[1] = m_bits >> 8;
+				out[2] = m_bits;
+				out += 3;
+
+				m_bits = 0;
+				m_count = 0;
+			}
+		} else if(ch == '=' && m_count >= 2) {
+			// Padding ends the group early
+			if(m_count == 2) {
+				*out++ = m_bits >> 4;
+			} else {
+				*out++ = m_bits >> 10;
+				*out++ = m_bits >> 2;
+			}
+
+			m_bits = 0;
+			m_count = 0;
+		}
+	}
+
+	return out - reinterpret_cast<unsigned char*>(dst);
+}
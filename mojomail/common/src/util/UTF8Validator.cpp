@@ -0,0 +1,249 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "util/UTF8Validator.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+// Result codes for CheckSequence
+static const int SEQUENCE_INVALID = -1;
+static const int SEQUENCE_INCOMPLETE = 0;
+
+// Checks the sequence starting at p, which must be a non-ASCII byte.
+// Returns the length of the sequence if it's valid.
+static inline int CheckSequence(const unsigned char* p, size_t avail)
+{
+	unsigned char c = p[0];
+	int length;
+	unsigned char min = 0x80, max = 0xBF; // allowed range for the second byte
+
+	if (c >= 0xC2 && c <= 0xDF) {
+		length = 2;
+	} else if (c >= 0xE0 && c <= 0xEF) {
+		length = 3;
+		if (c == 0xE0) min = 0xA0; // overlong
+		else if (c == 0xED) max = 0x9F; // surrogates
+	} else if (c >= 0xF0 && c <= 0xF4) {
+		length = 4;
+		if (c == 0xF0) min = 0x90; // overlong
+		else if (c == 0xF4) max = 0x8F; // above U+10FFFF
+	} else {
+		return SEQUENCE_INVALID;
+	}
+
+	if (avail < 2) return SEQUENCE_INCOMPLETE;
+	if (p[1] < min || p[1] > max) return SEQUENCE_INVALID;
+
+	for (int i = 2; i < length; i++) {
+		if ((size_t) i >= avail) return SEQUENCE_INCOMPLETE;
+		if ((p[i] & 0xC0) != 0x80) return SEQUENCE_INVALID;
+	}
+
+	return length;
+}
+
+static size_t ValidLengthScalar(const unsigned char* data, size_t start, size_t length)
+{
+	size_t i = start;
+
+	while (i < length) {
+		if (data[i] < 0x80) {
+			i++;
+		} else {
+			int seqLength = CheckSequence(data + i, length - i);
+
+			if (seqLength <= 0) {
+				break;
+			}
+
+			i += seqLength;
+		}
+	}
+
+	return i;
+}
+
+#if defined(__SSSE3__)
+
+// Vectorized check based on the "lookup" algorithm by Keiser and Lemire
+// ("Validating UTF-8 In Less Than One Instruction Per Byte", 2020).
+// Each pair of adjacent bytes is classified using three 16-entry tables,
+// indexed by the high and low nibble of the first byte and the high nibble
+// of the second byte; any error is a bit set in all three.
+
+static const unsigned char TOO_SHORT		= 1 << 0;
+static const unsigned char TOO_LONG			= 1 << 1;
+static const unsigned char OVERLONG_3		= 1 << 2;
+static const unsigned char TOO_LARGE		= 1 << 3;
+static const unsigned char SURROGATE		= 1 << 4;
+static const unsigned char OVERLONG_2		= 1 << 5;
+static const unsigned char TOO_LARGE_1000	= 1 << 6;
+static const unsigned char OVERLONG_4		= 1 << 6;
+static const unsigned char TWO_CONTS		= 1 << 7;
+static const unsigned char CARRY			= TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+static inline __m128i Lookup16(__m128i index, unsigned char t0, unsigned char t1, unsigned char t2, unsigned char t3,
+		unsigned char t4, unsigned char t5, unsigned char t6, unsigned char t7,
+		unsigned char t8, unsigned char t9, unsigned char t10, unsigned char t11,
+		unsigned char t12, unsigned char t13, unsigned char t14, unsigned char t15)
+{
+	__m128i table = _mm_setr_epi8(t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15);
+	return _mm_shuffle_epi8(table, index);
+}
+
+static inline __m128i HighNibble(__m128i v)
+{
+	return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F));
+}
+
+// Returns non-zero bytes where there's an error involving the current block,
+// including sequences that started in the previous block
+static inline __m128i CheckBlock(__m128i input, __m128i prev)
+{
+	__m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+
+	__m128i byte1High = Lookup16(HighNibble(prev1),
+		// 0_______ ________ <ASCII in byte 1>
+		TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+		TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+		// 10______ ________ <continuation in byte 1>
+		TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+		// 1100____ ________ <two byte lead in byte 1>
+		TOO_SHORT | OVERLONG_2,
+		// 1101____ ________ <two byte lead in byte 1>
+		TOO_SHORT,
+		// 1110____ ________ <three byte lead in byte 1>
+		TOO_SHORT | OVERLONG_3 | SURROGATE,
+		// 1111____ ________ <four+ byte lead in byte 1>
+		TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+
+	__m128i byte1Low = Lookup16(_mm_and_si128(prev1, _mm_set1_epi8(0x0F)),
+		// ____0000 ________
+		CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+		// ____0001 ________
+		CARRY | OVERLONG_2,
+		// ____001_ ________
+		CARRY,
+		CARRY,
+		// ____0100 ________
+		CARRY | TOO_LARGE,
+		// ____0101 ________
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		// ____011_ ________
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		// ____1___ ________
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		// ____1101 ________
+		CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000);
+
+	__m128i byte2High = Lookup16(HighNibble(input),
+		// ________ 0_______ <ASCII in byte 2>
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+		// ________ 1000____
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+		// ________ 1001____
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+		// ________ 101_____
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		// ________ 11______
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+
+	__m128i specialCases = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+	// The third and fourth bytes of 3 and 4 byte sequences must be continuations
+	__m128i prev2 = _mm_alignr_epi8(input, prev, 14);
+	__m128i prev3 = _mm_alignr_epi8(input, prev, 13);
+	__m128i isThirdByte = _mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80));
+	__m128i isFourthByte = _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80));
+	__m128i must23 = _mm_and_si128(_mm_or_si128(isThirdByte, isFourthByte), _mm_set1_epi8((char) 0x80));
+
+	return _mm_xor_si128(must23, specialCases);
+}
+
+#endif
+
+size_t UTF8Validator::ValidLength(const char* src, size_t length)
+{
+	const unsigned char* data = (const unsigned char*) src;
+	size_t i = 0;
+
+#if defined(__SSSE3__)
+	__m128i prev = _mm_setzero_si128();
+	__m128i prevIncomplete = _mm_setzero_si128();
+
+	// Bytes that would need more data after the end of a block
+	const __m128i maxValue = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			0xF0 - 1, 0xE0 - 1, 0xC0 - 1);
+
+	for (; i + 16 <= length; i += 16) {
+		__m128i input = _mm_loadu_si128((const __m128i*) (data + i));
+		__m128i error;
+
+		if (_mm_movemask_epi8(input) == 0) {
+			// All ASCII; only an error if the last block ended mid-sequence
+			error = prevIncomplete;
+			prevIncomplete = _mm_setzero_si128();
+		} else {
+			error = CheckBlock(input, prev);
+			prevIncomplete = _mm_subs_epu8(input, maxValue);
+		}
+
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF) {
+			// Find the exact position using the scalar code
+			break;
+		}
+
+		prev = input;
+	}
+
+	// Back up to the start of any sequence that crosses into this block;
+	// everything before that has already been validated.
+	for (size_t n = 1; n <= 3 && n <= i; n++) {
+		unsigned char c = data[i - n];
+
+		if (c >= 0xC0) {
+			i -= n;
+			break;
+		} else if (c < 0x80) {
+			break;
+		}
+	}
+#endif
+
+	return ValidLengthScalar(data, i, length);
+}
+
+bool UTF8Validator::IsIncompleteSequence(const char* data, size_t length)
+{
+	if (length == 0 || (unsigned char) data[0] < 0x80) {
+		return false;
+	}
+
+	return CheckSequence((const unsigned char*) data, length) == SEQUENCE_INCOMPLETE;
+}
@@ -0,0 +1,54 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+/**
+ * Timing helpers for the *Benchmark tests.
+ *
+ * Benchmarks are disabled so they don't slow down the regular test run.
+ * To run them: --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+ */
+
+#ifndef BENCHMARKUTILS_H_
+#define BENCHMARKUTILS_H_
+
+#include <time.h>
+#include <stdio.h>
+
+// Monotonic clock, in seconds
+static inline double GetTimeSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Prints the time and throughput for processing totalBytes
+static inline void PrintThroughput(const char* name, size_t totalBytes, double seconds)
+{
+	fprintf(stderr, "%s: %.1f MB, %.1f ms, %.1f MB/s\n", name, totalBytes / (1024.0 * 1024.0), seconds * 1000,
+			totalBytes / (1024.0 * 1024.0) / seconds);
+}
+
+// Prints the time and the average time per item, e.g. PrintRate("parse", 1000, "date", 0.01)
+static inline void PrintRate(const char* name, size_t count, const char* unit, double seconds)
+{
+	fprintf(stderr, "%s: %zu %ss, %.1f ms, %.1f ns/%s\n", name, count, unit, seconds * 1000, seconds * 1e9 / count, unit);
+}
+
+#endif /* BENCHMARKUTILS_H_ */
@@ -0,0 +1,132 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "async/AsyncOutputStream.h"
+#include "email/MockAsyncIOChannel.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+
+// Channel that is only writeable when the test says so, and optionally
+// accepts a limited number of bytes per write
+class TestWriteChannel : public MockAsyncIOChannel
+{
+public:
+	TestWriteChannel(MockAsyncIOChannelFactory* factory, size_t maxWrite = 0)
+	: MockAsyncIOChannel(factory, "test", "w"), m_maxWrite(maxWrite), m_shutdown(false) {}
+
+	virtual void WatchWriteable(WriteableSignal::SlotRef slot)
+	{
+		m_writeableSignal.connect(slot);
+	}
+
+	virtual size_t Write(const char* src, size_t length)
+	{
+		if(m_maxWrite > 0 && length > m_maxWrite) {
+			length = m_maxWrite;
+		}
+
+		return MockAsyncIOChannel::Write(src, length);
+	}
+
+	virtual void Shutdown()
+	{
+		m_shutdown = true;
+		MockAsyncIOChannel::Shutdown();
+	}
+
+	// Call writeable callbacks until the stream closes the channel
+	void RunUntilShutdown()
+	{
+		for(int i = 0; i < 1000 && !m_shutdown; ++i) {
+			m_writeableSignal.call();
+		}
+	}
+
+	size_t BytesWritten() const { return m_writeData.size(); }
+
+	size_t	m_maxWrite;
+	bool	m_shutdown;
+};
+
+static string MakeData(size_t length, char first)
+{
+	string data;
+	for(size_t i = 0; i < length; ++i) {
+		data.push_back(first + (i % 26));
+	}
+	return data;
+}
+
+TEST(AsyncOutputStreamTest, TestLargeWrites)
+{
+	MockAsyncIOChannelFactory factory;
+	MojRefCountedPtr<TestWriteChannel> channel(new TestWriteChannel(&factory));
+	OutputStreamPtr os = channel->GetOutputStream();
+
+	string expected;
+
+	// Small writes get buffered until the channel is writeable
+	string data = MakeData(100, 'a');
+	os->Write(data.data(), data.size());
+	expected.append(data);
+
+	EXPECT_EQ( (size_t) 0, channel->BytesWritten() );
+
+	// Large writes go to the channel right away, along with the buffered data
+	data = MakeData(40000, 'A');
+	os->Write(data.data(), data.size());
+	expected.append(data);
+
+	EXPECT_EQ( expected.size(), channel->BytesWritten() );
+
+	const size_t sizes[] = { 3000, 3000, 3000, 3000, 3000, 3000, 20, 100000 };
+
+	for(size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+		data = MakeData(sizes[i], i % 2 ? 'a' : 'A');
+		os->Write(data.data(), data.size());
+		expected.append(data);
+	}
+
+	os->Close();
+	channel->RunUntilShutdown();
+
+	EXPECT_EQ( expected, factory.GetWrittenData("test") );
+}
+
+TEST(AsyncOutputStreamTest, TestPartialWrites)
+{
+	MockAsyncIOChannelFactory factory;
+	MojRefCountedPtr<TestWriteChannel> channel(new TestWriteChannel(&factory, 5000));
+	OutputStreamPtr os = channel->GetOutputStream();
+
+	string expected;
+
+	for(int i = 0; i < 10; ++i) {
+		string data = MakeData(7000 * (i + 1), i % 2 ? 'a' : 'A');
+		os->Write(data.data(), data.size());
+		expected.append(data);
+
+		channel->m_maxWrite += 1000;
+	}
+
+	os->Close();
+	channel->RunUntilShutdown();
+
+	EXPECT_EQ( expected, factory.GetWrittenData("test") );
+}
@@ -0,0 +1,71 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+/**
+ * Date parsing speed on typical Date: header and INTERNALDATE values,
+ * compared with the previous implementation (curl_getdate).
+ */
+
+#include "email/DateUtils.h"
+#include "BenchmarkUtils.h"
+#include <gtest/gtest.h>
+#include <curl/curl.h>
+
+static const int ITERATIONS = 20000;
+
+static const char* s_dates[] = {
+	"Tue, 4 Jun 2013 12:34:56 +0000",
+	"Mon, 03 Jun 2013 17:02:11 -0700 (PDT)",
+	"Wed, 5 Jun 2013 09:15:00 +0200",
+	"04-Jun-2013 08:34:56 -0400",
+	" 7-Jun-2013 23:59:59 +0900",
+	"Fri, 07 Jun 2013 14:20:33 GMT",
+	"7 Jun 2013 10:00:00 EST",
+	"Thu, 6 Jun 13 22:45:10 +0100",
+	"Sat, 08 Jun 2013 01:02:03 +0000 (UTC)",
+	"Tue Jun  4 12:34:56 2013" // handled by the fallback
+};
+
+static const size_t NUM_DATES = sizeof(s_dates) / sizeof(s_dates[0]);
+
+TEST(DateUtilsBenchmark, DISABLED_TestParse)
+{
+	long long legacySum = 0, sum = 0;
+
+	double start = GetTimeSeconds();
+	for(int iter = 0; iter < ITERATIONS; iter++) {
+		for(size_t i = 0; i < NUM_DATES; i++) {
+			legacySum += curl_getdate(s_dates[i], NULL);
+		}
+	}
+	double legacyTime = GetTimeSeconds() - start;
+
+	start = GetTimeSeconds();
+	for(int iter = 0; iter < ITERATIONS; iter++) {
+		for(size_t i = 0; i < NUM_DATES; i++) {
+			sum += DateUtils::ParseRfc822Date(s_dates[i]);
+		}
+	}
+	double newTime = GetTimeSeconds() - start;
+
+	PrintRate("curl_getdate", NUM_DATES * ITERATIONS, "date", legacyTime);
+	PrintRate("ParseRfc822Date", NUM_DATES * ITERATIONS, "date", newTime);
+
+	// Every date in the list is parsed the same way by both
+	EXPECT_EQ( legacySum, sum );
+}
@@ -0,0 +1,184 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "email/DateUtils.h"
+#include <gtest/gtest.h>
+#include <curl/curl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+using namespace std;
+
+// Tue, 04 Jun 2013 12:34:56 UTC
+static const time_t SAMPLE_TIME = 1370349296;
+
+TEST(DateUtilsTest, TestParseRfc2822)
+{
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("Tue, 4 Jun 2013 12:34:56 +0000") );
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("Tue, 04 Jun 2013 05:34:56 -0700 (PDT)") );
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("  4 jun 2013 14:04:56 +0130") );
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("Tuesday, 4 Jun 2013 12:34:56") );
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("Tue,\r\n 4 Jun 2013\t12:34:56 +0000") );
+
+	// No seconds
+	EXPECT_EQ( SAMPLE_TIME - 56, DateUtils::ParseRfc822Date("Tue, 4 Jun 2013 12:34 +0000") );
+}
+
+TEST(DateUtilsTest, TestParseObsolete)
+{
+	// Two digit years
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("Tue, 04 Jun 13 05:34:56 PDT") );
+	EXPECT_EQ( 915148800, DateUtils::ParseRfc822Date("1 Jan 99 00:00:00 GMT") );
+
+	// Zone names
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("4 Jun 2013 07:34:56 EST") );
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("4 Jun 2013 08:34:56 edt") );
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("4 Jun 2013 12:34:56 UT") );
+
+	// Military zones are treated as UTC
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("4 Jun 2013 12:34:56 Z") );
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("4 Jun 2013 12:34:56 A") );
+}
+
+TEST(DateUtilsTest, TestParseInternalDate)
+{
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("04-Jun-2013 08:34:56 -0400") );
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date(" 4-Jun-2013 12:34:56 +0000") );
+}
+
+TEST(DateUtilsTest, TestParseFallback)
+{
+	time_t time;
+
+	// asctime() format isn't handled by the fast parser
+	EXPECT_FALSE( DateUtils::ParseCommonDate("Tue Jun  4 12:34:56 2013", time) );
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("Tue Jun  4 12:34:56 2013") );
+
+	// Unusual zone name
+	EXPECT_FALSE( DateUtils::ParseCommonDate("Tue, 4 Jun 2013 14:34:56 CEST", time) );
+	EXPECT_EQ( SAMPLE_TIME, DateUtils::ParseRfc822Date("Tue, 4 Jun 2013 14:34:56 CEST") );
+
+	EXPECT_EQ( -1, DateUtils::ParseRfc822Date("") );
+	EXPECT_EQ( -1, DateUtils::ParseRfc822Date("not a date") );
+	EXPECT_EQ( -1, DateUtils::ParseRfc822Date("32 Jun 2013 12:34:56 +0000") );
+	EXPECT_EQ( -1, DateUtils::ParseRfc822Date("4 Jun 2013 25:34:56 +0000") );
+}
+
+TEST(DateUtilsTest, TestMonthLength)
+{
+	time_t time;
+
+	EXPECT_TRUE( DateUtils::ParseCommonDate("31 Jan 2013 00:00:00 +0000", time) );
+	EXPECT_TRUE( DateUtils::ParseCommonDate("30 Apr 2013 00:00:00 +0000", time) );
+	EXPECT_TRUE( DateUtils::ParseCommonDate("28 Feb 2013 00:00:00 +0000", time) );
+
+	// Not rolled over into the next month
+	EXPECT_FALSE( DateUtils::ParseCommonDate("31 Feb 2013 00:00:00 +0000", time) );
+	EXPECT_FALSE( DateUtils::ParseCommonDate("31 Apr 2013 00:00:00 +0000", time) );
+	EXPECT_FALSE( DateUtils::ParseCommonDate("31-Jun-2013 00:00:00 +0000", time) );
+
+	// Leap years
+	EXPECT_TRUE( DateUtils::ParseCommonDate("29 Feb 2012 00:00:00 +0000", time) );
+	EXPECT_EQ( 1330473600, time );
+	EXPECT_TRUE( DateUtils::ParseCommonDate("29 Feb 2000 00:00:00 +0000", time) );
+	EXPECT_FALSE( DateUtils::ParseCommonDate("29 Feb 2013 00:00:00 +0000", time) );
+	EXPECT_FALSE( DateUtils::ParseCommonDate("29 Feb 2100 00:00:00 +0000", time) );
+}
+
+TEST(DateUtilsTest, TestFormatRfc3501Date)
+{
+	EXPECT_EQ( "04-Jun-2013", DateUtils::FormatRfc3501Date(SAMPLE_TIME) );
+	EXPECT_EQ( "31-Dec-1999", DateUtils::FormatRfc3501Date(946684799) );
+}
+
+static const char* s_monthNames[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+// Random well-formed dates should parse exactly like curl_getdate() does
+TEST(DateUtilsTest, TestFuzzWellFormed)
+{
+	srand(1);
+
+	for(int i = 0; i < 20000; i++) {
+		struct tm tm = {};
+		tm.tm_year = 70 + rand() % 60;
+		tm.tm_mon = rand() % 12;
+		tm.tm_mday = 1 + rand() % 28;
+		tm.tm_hour = rand() % 24;
+		tm.tm_min = rand() % 60;
+		tm.tm_sec = rand() % 60;
+
+		int offset = (rand() % 27 - 13) * 60 + (rand() % 2) * 30;
+		char sign = offset < 0 ? '-' : '+';
+		int absOffset = abs(offset);
+
+		char buf[64];
+		if(i % 2 == 0) {
+			snprintf(buf, sizeof(buf), "Mon, %d %s %04d %02d:%02d:%02d %c%02d%02d", tm.tm_mday, s_monthNames[tm.tm_mon],
+					tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec, sign, absOffset / 60, absOffset % 60);
+		} else {
+			snprintf(buf, sizeof(buf), "%2d-%s-%04d %02d:%02d:%02d %c%02d%02d", tm.tm_mday, s_monthNames[tm.tm_mon],
+					tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec, sign, absOffset / 60, absOffset % 60);
+		}
+
+		time_t expected = timegm(&tm) - offset * 60;
+		time_t time = 0;
+
+		ASSERT_TRUE( DateUtils::ParseCommonDate(buf, time) ) << buf;
+		ASSERT_EQ( expected, time ) << buf;
+		ASSERT_EQ( curl_getdate(buf, NULL), time ) << buf;
+	}
+}
+
+// Random corruptions of valid dates must not crash, and whatever the fast
+// parser accepts has to be a sensible date.
+TEST(DateUtilsTest, TestFuzzCorrupted)
+{
+	static const char* samples[] = {
+		"Tue, 4 Jun 2013 12:34:56 +0000",
+		"04-Jun-2013 08:34:56 -0400",
+		"Tue, 04 Jun 13 05:34:56 PDT (Pacific Daylight Time)"
+	};
+	static const char noise[] = "0123456789 :-+,()abcdefJUNZ\t\r\n\xff";
+
+	srand(2);
+
+	for(int i = 0; i < 100000; i++) {
+		string s = samples[rand() % 3];
+
+		int numEdits = 1 + rand() % 4;
+		for(int edit = 0; edit < numEdits; edit++) {
+			size_t pos = rand() % (s.length() + 1);
+			char ch = noise[rand() % (sizeof(noise) - 1)];
+
+			switch(rand() % 3) {
+			case 0: s.insert(pos, 1, ch); break;
+			case 1: if(pos < s.length()) s.erase(pos, 1); break;
+			case 2: if(pos < s.length()) s[pos] = ch; break;
+			}
+		}
+
+		time_t time;
+		if(DateUtils::ParseCommonDate(s.c_str(), time)) {
+			ASSERT_GT( time, 0 ) << s;
+			ASSERT_EQ( time, DateUtils::ParseRfc822Date(s.c_str()) ) << s;
+		} else {
+			DateUtils::ParseRfc822Date(s.c_str());
+		}
+	}
+}
@@ -0,0 +1,176 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+/**
+ * Entity lookup speed on entity-dense HTML, compared with the previous
+ * implementation (a std::map of the HTML 4 entities keyed by std::string).
+ */
+
+#include "email/HtmlEntities.h"
+#include "BenchmarkUtils.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <sstream>
+#include <string>
+#include <stdlib.h>
+
+using namespace std;
+
+static const size_t DATA_SIZE = 4 * 1024 * 1024;
+static const int ITERATIONS = 4;
+
+// HTML 4 entity names supported by the old implementation
+static const char* s_html4Names =
+	"quot amp lt gt nbsp iexcl cent pound curren yen brvbar sect uml copy ordf laquo not shy reg macr "
+	"deg plusmn sup2 sup3 acute micro para middot cedil sup1 ordm raquo frac14 frac12 frac34 iquest "
+	"Agrave Aacute Acirc Atilde Auml Aring AElig Ccedil Egrave Eacute Ecirc Euml Igrave Iacute Icirc "
+	"Iuml ETH Ntilde Ograve Oacute Ocirc Otilde Ouml times Oslash Ugrave Uacute Ucirc Uuml Yacute "
+	"THORN szlig agrave aacute acirc atilde auml aring aelig ccedil egrave eacute ecirc euml igrave "
+	"iacute icirc iuml eth ntilde ograve oacute ocirc otilde ouml divide oslash ugrave uacute ucirc "
+	"uuml yacute thorn yuml OElig oelig Scaron scaron Yuml fnof circ tilde Alpha Beta Gamma Delta "
+	"Epsilon Zeta Eta Theta Iota Kappa Lambda Mu Nu Xi Omicron Pi Rho Sigma Tau Upsilon Phi Chi Psi "
+	"Omega alpha beta gamma delta epsilon zeta eta theta iota kappa lambda mu nu xi omicron pi rho "
+	"sigmaf sigma tau upsilon phi chi psi omega thetasym upsih piv ensp emsp thinsp zwnj zwj lrm rlm "
+	"ndash mdash lsquo rsquo sbquo ldquo rdquo bdquo dagger Dagger bull hellip permil prime Prime "
+	"lsaquo rsaquo oline frasl euro image weierp real trade alefsym larr uarr rarr darr harr crarr "
+	"lArr uArr rArr dArr hArr forall part exist empty nabla isin notin ni prod sum minus lowast radic "
+	"prop infin ang and or cap cup int there4 sim cong asymp ne equiv le ge sub sup nsub sube supe "
+	"oplus otimes perp sdot lceil rceil lfloor rfloor lang rang loz spades clubs hearts diams";
+
+// Previous implementation: std::map lookup using a temporary std::string
+class LegacyEntityMap
+{
+public:
+	LegacyEntityMap()
+	{
+		istringstream ss(s_html4Names);
+		string name;
+
+		while(ss >> name) {
+			m_map[name] = HtmlEntities::LookupEntity(name.data(), name.length());
+		}
+	}
+
+	gunichar LookupEntity(const string& name) const
+	{
+		map<const string, gunichar>::const_iterator it = m_map.find(name);
+
+		if(it != m_map.end())
+			return it->second;
+		else
+			return 0;
+	}
+
+protected:
+	map<const string, gunichar> m_map;
+};
+
+// Build something that looks like a marketing newsletter: short runs of
+// text and markup with typographic entities sprinkled throughout.
+static string MakeNewsletter(size_t length)
+{
+	static const char* fragments[] = {
+		"<td style=\"padding:0\">&nbsp;</td>",
+		"Don&rsquo;t miss out &mdash; ",
+		"Save 20&percnt; &ndash; today only&hellip; ",
+		"&ldquo;Best deal of the year&rdquo; ",
+		"Caf&eacute; &amp; Cr&egrave;me Br&ucirc;l&eacute;e ",
+		"&copy; 2013 Example&trade; Inc. &reg; ",
+		"&lt;unsubscribe&gt; &bull; &middot; ",
+		"&euro;9&period;99 &pound;8 &yen;1200 ",
+		"&#8217;&#x2014;&bogus;&NotEqualTilde; ",
+		"<a href=\"http://example.com/?a=1&amp;b=2\">Shop&nbsp;now&nbsp;&raquo;</a>\r\n"
+	};
+	const size_t numFragments = sizeof(fragments) / sizeof(fragments[0]);
+
+	string data;
+	data.reserve(length + 256);
+	srand(1);
+
+	while(data.length() < length) {
+		data.append(fragments[rand() % numFragments]);
+	}
+
+	return data;
+}
+
+TEST(HtmlEntitiesBenchmark, DISABLED_TestLookup)
+{
+	string data = MakeNewsletter(DATA_SIZE);
+	LegacyEntityMap legacy;
+
+	size_t legacyLookups = 0, lookups = 0;
+	gunichar legacySum = 0, sum = 0;
+
+	// Old: copy each name into a std::string and look it up in the map
+	double start = GetTimeSeconds();
+	for(int iter = 0; iter < ITERATIONS; iter++) {
+		size_t pos = 0;
+		while((pos = data.find('&', pos)) != string::npos) {
+			size_t end = data.find(';', pos);
+			if(end == string::npos)
+				break;
+
+			legacySum += legacy.LookupEntity(string(data, pos + 1, end - pos - 1));
+			legacyLookups++;
+			pos = end + 1;
+		}
+	}
+	double legacyTime = GetTimeSeconds() - start;
+
+	// New: look up the name in place
+	start = GetTimeSeconds();
+	for(int iter = 0; iter < ITERATIONS; iter++) {
+		size_t pos = 0;
+		while((pos = data.find('&', pos)) != string::npos) {
+			size_t end = data.find(';', pos);
+			if(end == string::npos)
+				break;
+
+			sum += HtmlEntities::LookupEntity(data.data() + pos + 1, end - pos - 1);
+			lookups++;
+			pos = end + 1;
+		}
+	}
+	double newTime = GetTimeSeconds() - start;
+
+	PrintThroughput("std::map lookup", data.length() * ITERATIONS, legacyTime);
+	PrintRate("std::map lookup", legacyLookups, "lookup", legacyTime);
+	PrintThroughput("perfect hash lookup", data.length() * ITERATIONS, newTime);
+	PrintRate("perfect hash lookup", lookups, "lookup", newTime);
+
+	EXPECT_EQ( legacyLookups, lookups );
+
+	// The newsletter uses a few HTML5-only entities, so the sums will differ
+	EXPECT_GT( sum, legacySum );
+}
+
+TEST(HtmlEntitiesBenchmark, TestHtml4Compatible)
+{
+	istringstream ss(s_html4Names);
+	string name;
+	int count = 0;
+
+	// Every entity the old table knew about should still be found
+	while(ss >> name) {
+		EXPECT_GT( HtmlEntities::LookupEntity(name.data(), name.length()), (gunichar) 0 ) << name;
+		count++;
+	}
+
+	EXPECT_EQ( 252, count );
+}
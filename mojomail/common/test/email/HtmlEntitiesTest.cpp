@@ -0,0 +1,72 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "email/HtmlEntities.h"
+#include <gtest/gtest.h>
+#include <cstring>
+
+using namespace std;
+
+static gunichar Lookup(const char* name, gunichar* secondChar = NULL)
+{
+	return HtmlEntities::LookupEntity(name, strlen(name), secondChar);
+}
+
+TEST(HtmlEntitiesTest, TestLookup)
+{
+	EXPECT_EQ( (gunichar) 38, Lookup("amp") );
+	EXPECT_EQ( (gunichar) 38, Lookup("AMP") );
+	EXPECT_EQ( (gunichar) 169, Lookup("copy") );
+	EXPECT_EQ( (gunichar) 160, Lookup("nbsp") );
+	EXPECT_EQ( (gunichar) 0x2019, Lookup("rsquo") );
+	EXPECT_EQ( (gunichar) 0x1D4C5, Lookup("pscr") );
+	EXPECT_EQ( (gunichar) 0x2233, Lookup("CounterClockwiseContourIntegral") );
+
+	EXPECT_EQ( (gunichar) 169, HtmlEntities::LookupEntity(string("copy")) );
+
+	// Lookup shouldn't read past the given length
+	EXPECT_EQ( (gunichar) 38, HtmlEntities::LookupEntity("amp;xyz", 3) );
+}
+
+TEST(HtmlEntitiesTest, TestTwoCharacters)
+{
+	gunichar secondChar = 1;
+
+	EXPECT_EQ( (gunichar) 0x2242, Lookup("NotEqualTilde", &secondChar) );
+	EXPECT_EQ( (gunichar) 0x338, secondChar );
+
+	EXPECT_EQ( (gunichar) 'f', Lookup("fjlig", &secondChar) );
+	EXPECT_EQ( (gunichar) 'j', secondChar );
+
+	EXPECT_EQ( (gunichar) 38, Lookup("amp", &secondChar) );
+	EXPECT_EQ( (gunichar) 0, secondChar );
+}
+
+TEST(HtmlEntitiesTest, TestUnknown)
+{
+	gunichar secondChar = 1;
+
+	EXPECT_EQ( (gunichar) 0, Lookup("", &secondChar) );
+	EXPECT_EQ( (gunichar) 0, secondChar );
+
+	EXPECT_EQ( (gunichar) 0, Lookup("am") );
+	EXPECT_EQ( (gunichar) 0, Lookup("ampx") );
+	EXPECT_EQ( (gunichar) 0, Lookup("Amp") );
+	EXPECT_EQ( (gunichar) 0, Lookup("bogus") );
+	EXPECT_EQ( (gunichar) 0, Lookup("CounterClockwiseContourIntegralX") );
+}
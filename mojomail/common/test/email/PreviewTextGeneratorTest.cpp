@@ -17,6 +17,7 @@
 // LICENSE@@@
 
 #include "email/PreviewTextGenerator.h"
+#include "email/PreviewTextExtractor.h"
 #include <gtest/gtest.h>
 
 using namespace std;
@@ -40,6 +41,73 @@ TEST(PreviewTextGeneratorTest, TestStrip)
 
 	out = PreviewTextGenerator::GeneratePreviewText("A <b>B</b> C", 100, true);
 	EXPECT_EQ( "A B C", out );
+
+	out = PreviewTextGenerator::GeneratePreviewText("<HEAD><TITLE>T</TITLE></HEAD>A<!-- <b>x</b> -->B", 100, true);
+	EXPECT_EQ( "A B", out );
+
+	out = PreviewTextGenerator::GeneratePreviewText("<script>if(a<b) x = '</div>';</script >A", 100, true);
+	EXPECT_EQ( "A", out );
+
+	out = PreviewTextGenerator::GeneratePreviewText("<script src=\"x.js\"/>A", 100, true);
+	EXPECT_EQ( "A", out );
+
+	out = PreviewTextGenerator::GeneratePreviewText("1 < 2 &amp;&nbsp;AT&T", 100, true);
+	EXPECT_EQ( "1 < 2 & AT&T", out );
+
+	// Entities shouldn't get unescaped twice
+	out = PreviewTextGenerator::GeneratePreviewText("&amp;lt;", 100, true);
+	EXPECT_EQ( "&lt;", out );
+
+	// Plain text only has its whitespace cleaned up
+	out = PreviewTextGenerator::GeneratePreviewText("  <b>A</b>\r\n\t&amp;  ", 100, false);
+	EXPECT_EQ( "<b>A</b> &amp;", out );
+}
+
+// Feed text one byte at a time to check that state is kept across calls
+static string ExtractInChunks(const string& text, size_t maxLength)
+{
+	PreviewTextExtractor extractor(maxLength, true);
+
+	for(size_t i = 0; i < text.length(); i++)
+		extractor.Append(text.data() + i, 1);
+
+	return extractor.GetPreviewText();
+}
+
+TEST(PreviewTextGeneratorTest, TestExtractorChunks)
+{
+	const char* inputs[] = {
+		"A <style type=\"text/css\">p { color: red; }</style> B",
+		"<html><head><title>Title</title></head><body><p>Hello&nbsp;<b>world</b>&#33;</p></body></html>",
+		"Copyright &#xA9; 2010 &copy; &bogus; &#foo;",
+		"A <!-- comment --> B <!----> C",
+		"A <a href",
+		"AT&T"
+	};
+
+	for(size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+		string text = inputs[i];
+		EXPECT_EQ( PreviewTextGenerator::GeneratePreviewText(text, 100, true), ExtractInChunks(text, 100) ) << text;
+	}
+}
+
+TEST(PreviewTextGeneratorTest, TestExtractorStopsEarly)
+{
+	PreviewTextExtractor extractor(8, true);
+
+	extractor.Append("<p>abc def ghi</p>", 18);
+	EXPECT_TRUE( extractor.IsFull() );
+
+	// Anything after this should be ignored
+	extractor.Append("<style>", 7);
+	extractor.Append("xyz", 3);
+	EXPECT_EQ( "abc def", extractor.GetPreviewText() );
+
+	// Not enough text yet
+	PreviewTextExtractor extractor2(8, true);
+	extractor2.Append("<p>abc</p>  ", 12);
+	EXPECT_FALSE( extractor2.IsFull() );
+	EXPECT_EQ( "abc", extractor2.GetPreviewText() );
 }
 
 TEST(PreviewTextGeneratorTest, TestReplaceEntities)
@@ -62,6 +130,13 @@ TEST(PreviewTextGeneratorTest, TestReplaceEntities)
 	// Bad entity: foo is not a number
 	out = PreviewTextGenerator::ReplaceEntities("Bad entity &#foo; and &#xfoo;");
 	EXPECT_EQ( "Bad entity &#foo; and &#xfoo;", out );
+
+	// Bad entity: out of range
+	out = PreviewTextGenerator::ReplaceEntities("Bad entity &#x110000; &#99999999999;");
+	EXPECT_EQ( "Bad entity &#x110000; &#99999999999;", out );
+
+	out = PreviewTextGenerator::ReplaceEntities("&&amp;&lt;;");
+	EXPECT_EQ( "&&<;", out );
 }
 
 TEST(PreviewTextGeneratorTest, TestTruncateUTF8)
@@ -144,3 +144,64 @@ TEST(Rfc2047DecoderTest, TestEmpty)
 
 	EXPECT_EQ(output, "xy");
 }
+
+TEST(Rfc2047DecoderTest, TestSplitMultibyte)
+{
+	// UTF-8 sequence split between two words
+	if(true) {
+		string input = "=?UTF-8?Q?caf=C3?= =?UTF-8?Q?=A9?=";
+		string output;
+		Rfc2047Decoder::DecodeText(input, output);
+
+		EXPECT_EQ(output, "caf\xC3\xA9");
+	}
+
+	// Shift_JIS character split between two base64 words
+	if(true) {
+		string input = "=?Shift_JIS?B?gg==?=\r\n =?shift_jis?B?oA==?=";
+		string output;
+		Rfc2047Decoder::DecodeText(input, output);
+
+		EXPECT_EQ(output, "\xE3\x81\x82"); // HIRAGANA LETTER A
+	}
+
+	// different charsets aren't merged
+	if(true) {
+		string input = "=?ISO-8859-1?Q?=E9?= =?UTF-8?Q?=C3=A9?=";
+		string output;
+		Rfc2047Decoder::DecodeText(input, output);
+
+		EXPECT_EQ(output, "\xC3\xA9\xC3\xA9");
+	}
+}
+
+TEST(Rfc2047DecoderTest, TestAppendDecodedText)
+{
+	string output = "Re: ";
+
+	// no encoded-words
+	string input = "plain \xFF\xFEtext";
+	Rfc2047Decoder::AppendDecodedText(input.data(), input.length(), output);
+	EXPECT_EQ(output, "Re: plain \xEF\xBF\xBDtext");
+
+	// only the given length is decoded
+	output.clear();
+	input = "=?UTF-8?B?SGVsbG8=?= world";
+	Rfc2047Decoder::AppendDecodedText(input.data(), 20, output);
+	EXPECT_EQ(output, "Hello");
+
+	// RFC 2231 language suffix
+	output.clear();
+	input = "=?US-ASCII*EN?Q?Keith_Moore?=";
+	Rfc2047Decoder::AppendDecodedText(input.data(), input.length(), output);
+	EXPECT_EQ(output, "Keith Moore");
+}
+
+TEST(Rfc2047DecoderTest, TestInvalidUTF8)
+{
+	string input = "=?UTF-8?Q?abc=FF?= xyz";
+	string output;
+	Rfc2047Decoder::DecodeText(input, output);
+
+	EXPECT_EQ(output, "=?UTF-8?Q?abc=FF?= xyz");
+}
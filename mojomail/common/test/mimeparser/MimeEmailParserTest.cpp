@@ -258,3 +258,85 @@ TEST (MimeEmailParserTest, TestNoEndingNewline)
 
 	handler.CheckCounts();
 }
+
+class HeaderFieldTestHandler : public TestParseEventHandler
+{
+public:
+	virtual void HandleHeaderField(HeaderFieldNames::FieldId fieldId, const char* name, size_t nameLength, const std::string& value)
+	{
+		fieldIds.push_back(fieldId);
+		fields.push_back(string(name, nameLength) + "=" + value);
+	}
+
+	virtual void HandleBodyData(const char* data, size_t length) { body.append(data, length); }
+
+	vector<HeaderFieldNames::FieldId> fieldIds;
+	vector<string> fields;
+	string body;
+};
+
+TEST (MimeEmailParserTest, TestHeaderFields)
+{
+	HeaderFieldTestHandler handler;
+	MimeEmailParser parser(handler);
+
+	parser.BeginEmail();
+	parser.ParseLine("Subject: Hello\r\n");
+	parser.ParseLine("\t World \r\n");
+	parser.ParseLine("CONTENT-type :  text/plain\r\n");
+	parser.ParseLine("X-Mailer: test\r\n");
+	parser.ParseLine("Reply-To:\r\n");
+	parser.ParseLine("\r\n");
+	parser.ParseLine("BODY\r\n");
+	parser.EndEmail();
+
+	handler.CheckCounts();
+
+	ASSERT_EQ( (size_t) 4, handler.fields.size() );
+	EXPECT_EQ( "Subject=Hello\t World", handler.fields[0] );
+	EXPECT_EQ( HeaderFieldNames::Field_Subject, handler.fieldIds[0] );
+	EXPECT_EQ( "CONTENT-type=text/plain", handler.fields[1] );
+	EXPECT_EQ( HeaderFieldNames::Field_ContentType, handler.fieldIds[1] );
+	EXPECT_EQ( "X-Mailer=test", handler.fields[2] );
+	EXPECT_EQ( HeaderFieldNames::Field_Other, handler.fieldIds[2] );
+	EXPECT_EQ( "Reply-To=", handler.fields[3] );
+	EXPECT_EQ( HeaderFieldNames::Field_ReplyTo, handler.fieldIds[3] );
+}
+
+TEST (MimeEmailParserTest, TestFieldNameLookup)
+{
+	EXPECT_EQ( HeaderFieldNames::Field_To, HeaderFieldNames::Lookup("TO", 2) );
+	EXPECT_EQ( HeaderFieldNames::Field_ContentTransferEncoding, HeaderFieldNames::Lookup("Content-Transfer-Encoding", 25) );
+	EXPECT_EQ( HeaderFieldNames::Field_InReplyTo, HeaderFieldNames::Lookup("in-reply-to", 11) );
+	EXPECT_EQ( HeaderFieldNames::Field_Other, HeaderFieldNames::Lookup("Content-Typo", 12) );
+	EXPECT_EQ( HeaderFieldNames::Field_Other, HeaderFieldNames::Lookup("Dates", 5) );
+	EXPECT_EQ( HeaderFieldNames::Field_Other, HeaderFieldNames::Lookup("", 0) );
+}
+
+TEST (MimeEmailParserTest, TestBoundaryFilter)
+{
+	string data =
+			"Content-Type: multipart/mixed; boundary=BOUNDARY\r\n"
+			"\r\n"
+			"--BOUNDARY\r\n"
+			"Content-Type: text/plain\r\n"
+			"\r\n"
+			"--\r\n"
+			"--B\r\n"
+			"--OTHER\r\n"
+			"-- \r\n"
+			"--BOUNDARY--\r\n";
+
+	for (unsigned int stride = 1; stride <= data.length(); stride++) {
+		HeaderFieldTestHandler handler;
+		MimeEmailParser parser(handler);
+
+		parser.BeginEmail();
+		FeedChopped(parser, data, stride);
+		parser.EndEmail();
+
+		handler.CheckCounts();
+		EXPECT_EQ( 2, handler.beginPartCount );
+		EXPECT_EQ( "--\r\n--B\r\n--OTHER\r\n-- \r\n", handler.body );
+	}
+}
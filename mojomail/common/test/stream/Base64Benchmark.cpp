@@ -0,0 +1,133 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+/**
+ * Throughput of the base64 encoder and decoder streams, compared with GLib's
+ * g_base64_encode_step/g_base64_decode_step on the same data.
+ */
+
+#include "stream/Base64DecoderOutputStream.h"
+#include "stream/Base64OutputStream.h"
+#include "stream/ByteBufferOutputStream.h"
+#include "stream/CounterOutputStream.h"
+#include <glib.h>
+#include "BenchmarkUtils.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+
+using namespace std;
+
+static const size_t DATA_SIZE = 8 * 1024 * 1024;
+static const size_t CHUNK_SIZE = 8192; // typical socket read
+
+static string RandomData(size_t length)
+{
+	string data;
+	data.reserve(length);
+	srand(1);
+
+	for(size_t i = 0; i < length; ++i) {
+		data.push_back((char) (rand() & 0xFF));
+	}
+
+	return data;
+}
+
+// Encoded with CRLF line endings, as it arrives from the server
+static string EncodeData(const string& data)
+{
+	MojRefCountedPtr<ByteBufferOutputStream> bbos( new ByteBufferOutputStream() );
+	MojRefCountedPtr<Base64EncoderOutputStream> encoder( new Base64EncoderOutputStream(bbos) );
+
+	encoder->Write(data.data(), data.size());
+	encoder->Flush();
+
+	return bbos->GetBuffer();
+}
+
+TEST(Base64Benchmark, DISABLED_Encode)
+{
+	string data = RandomData(DATA_SIZE);
+
+	MojRefCountedPtr<CounterOutputStream> counter( new CounterOutputStream() );
+	MojRefCountedPtr<Base64EncoderOutputStream> encoder( new Base64EncoderOutputStream(counter) );
+
+	double start = GetTimeSeconds();
+	for(size_t offset = 0; offset < data.size(); offset += CHUNK_SIZE) {
+		encoder->Write(data.data() + offset, min(CHUNK_SIZE, data.size() - offset));
+	}
+	encoder->Flush();
+	PrintThroughput("Base64EncoderOutputStream", data.size(), GetTimeSeconds() - start);
+
+	// GLib, converting to CRLF afterwards like the old encoder stream did
+	vector<char> outbuf((CHUNK_SIZE / 3 + 1) * 4 * 2 + 16);
+	string crlf;
+	size_t total = 0;
+	gint state = 0, save = 0;
+
+	start = GetTimeSeconds();
+	for(size_t offset = 0; offset < data.size(); offset += CHUNK_SIZE) {
+		size_t length = min(CHUNK_SIZE, data.size() - offset);
+		gsize numBytesOut = g_base64_encode_step((const guchar*) data.data() + offset, length, true, &outbuf[0], &state, &save);
+
+		crlf.clear();
+		for(gsize i = 0; i < numBytesOut; ++i) {
+			if(outbuf[i] == '\n')
+				crlf.push_back('\r');
+			crlf.push_back(outbuf[i]);
+		}
+		total += crlf.size();
+	}
+	gsize numBytesOut = g_base64_encode_close(true, &outbuf[0], &state, &save);
+	total += numBytesOut + 1; // ends with \n
+	PrintThroughput("g_base64_encode_step", data.size(), GetTimeSeconds() - start);
+
+	EXPECT_EQ( total, counter->GetBytesWritten() );
+}
+
+TEST(Base64Benchmark, DISABLED_Decode)
+{
+	string data = RandomData(DATA_SIZE);
+	string text = EncodeData(data);
+
+	MojRefCountedPtr<CounterOutputStream> counter( new CounterOutputStream() );
+	MojRefCountedPtr<Base64DecoderOutputStream> decoder( new Base64DecoderOutputStream(counter) );
+
+	double start = GetTimeSeconds();
+	for(size_t offset = 0; offset < text.size(); offset += CHUNK_SIZE) {
+		decoder->Write(text.data() + offset, min(CHUNK_SIZE, text.size() - offset));
+	}
+	PrintThroughput("Base64DecoderOutputStream", text.size(), GetTimeSeconds() - start);
+
+	EXPECT_EQ( data.size(), counter->GetBytesWritten() );
+
+	vector<guchar> outbuf(CHUNK_SIZE);
+	size_t total = 0;
+	gint state = 0;
+	guint save = 0;
+
+	start = GetTimeSeconds();
+	for(size_t offset = 0; offset < text.size(); offset += CHUNK_SIZE) {
+		total += g_base64_decode_step(text.data() + offset, min(CHUNK_SIZE, text.size() - offset), &outbuf[0], &state, &save);
+	}
+	PrintThroughput("g_base64_decode_step", text.size(), GetTimeSeconds() - start);
+
+	EXPECT_EQ( data.size(), total );
+}
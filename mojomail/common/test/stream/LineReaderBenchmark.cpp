@@ -0,0 +1,106 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+/**
+ * Throughput of LineReader when lines arrive in network-sized chunks.
+ *
+ * Prints MB/s for long lines (base64 bodies without line breaks) fed in
+ * small chunks, and for many short lines fed in large chunks.
+ */
+
+#include "stream/MockStreams.h"
+#include "stream/LineReader.h"
+#include "MockDoneSlot.h"
+#include "BenchmarkUtils.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+
+class CountLinesSlot : public MockDoneSlot
+{
+public:
+	CountLinesSlot(const LineReaderPtr& lineReader) : m_lineReader(lineReader), m_numLines(0), m_numBytes(0) {}
+
+	void Done()
+	{
+		while(m_lineReader->MoreLinesInBuffer()) {
+			m_numBytes += m_lineReader->ReadLine(true).size();
+			++m_numLines;
+		}
+
+		m_lineReader->WaitForLine(GetSlot());
+	}
+
+	LineReaderPtr	m_lineReader;
+	size_t			m_numLines;
+	size_t			m_numBytes;
+};
+
+static void FeedChunks(MockInputStream* in, const string& data, size_t chunkSize)
+{
+	for(size_t i = 0; i < data.size(); i += chunkSize) {
+		in->Feed(data.substr(i, chunkSize));
+	}
+}
+
+TEST(LineReaderBenchmark, DISABLED_LongLines)
+{
+	// 900KB lines (just under the maximum line length) in 1500 byte chunks
+	string line(900 * 1024, 'A');
+	line.append("\r\n");
+
+	string data;
+	for(int i = 0; i < 4; ++i) {
+		data.append(line);
+	}
+
+	MojRefCountedPtr<MockInputStream> in(new MockInputStream());
+	LineReaderPtr lineReader(new LineReader(in));
+	CountLinesSlot slot(lineReader);
+	lineReader->WaitForLine(slot.GetSlot());
+
+	double start = GetTimeSeconds();
+	FeedChunks(in.get(), data, 1500);
+	double seconds = GetTimeSeconds() - start;
+
+	EXPECT_EQ( (size_t) 4, slot.m_numLines );
+	EXPECT_EQ( data.size(), slot.m_numBytes );
+
+	PrintThroughput("LongLines", data.size(), seconds);
+}
+
+TEST(LineReaderBenchmark, DISABLED_ShortLines)
+{
+	string data;
+	while(data.size() < 8 * 1024 * 1024) {
+		data.append("* 12345 FETCH (UID 67890 FLAGS (\\Seen \\Flagged))\r\n");
+	}
+
+	MojRefCountedPtr<MockInputStream> in(new MockInputStream());
+	LineReaderPtr lineReader(new LineReader(in));
+	CountLinesSlot slot(lineReader);
+	lineReader->WaitForLine(slot.GetSlot());
+
+	double start = GetTimeSeconds();
+	FeedChunks(in.get(), data, 16 * 1024);
+	double seconds = GetTimeSeconds() - start;
+
+	EXPECT_EQ( data.size(), slot.m_numBytes );
+
+	PrintThroughput("ShortLines", data.size(), seconds);
+}
@@ -99,3 +99,115 @@ TEST(LineReaderTest, TestNewlineAuto)
 
 	in->Feed("Hello world\nTest 1\r\n\rTest 2\r\n");
 }
+
+TEST(LineReaderTest, TestAppendData)
+{
+	MojRefCountedPtr<MockInputStream> in(new MockInputStream());
+	LineReaderPtr lineReader(new LineReader(in));
+
+	class AppendDataSlot : public LineReaderDoneSlot
+	{
+	public:
+		AppendDataSlot(const LineReaderPtr& lineReader) : LineReaderDoneSlot(lineReader) {}
+
+		void Done()
+		{
+			string buffer = "* LIST () \"/\" {5}";
+
+			ASSERT_EQ( (size_t) 5, m_lineReader->AppendData(buffer, 5) );
+			ASSERT_EQ( "* LIST () \"/\" {5}Inbox", buffer );
+
+			// Only copies what's available
+			ASSERT_EQ( (size_t) 2, m_lineReader->AppendData(buffer, 10) );
+			ASSERT_EQ( "* LIST () \"/\" {5}Inbox\r\n", buffer );
+		}
+	};
+
+	AppendDataSlot testSlot(lineReader);
+
+	lineReader->WaitForData(testSlot.GetSlot(), 5);
+
+	in->Feed("Inbox\r\n");
+}
+
+TEST(LineReaderTest, TestIncrementalFeed)
+{
+	MojRefCountedPtr<MockInputStream> in(new MockInputStream());
+	LineReaderPtr lineReader(new LineReader(in));
+
+	class ReadLinesSlot : public LineReaderDoneSlot
+	{
+	public:
+		ReadLinesSlot(const LineReaderPtr& lineReader) : LineReaderDoneSlot(lineReader) {}
+
+		void Done()
+		{
+			while(m_lineReader->MoreLinesInBuffer()) {
+				m_lines.push_back(m_lineReader->ReadLine(false));
+			}
+
+			m_lineReader->WaitForLine(GetSlot());
+		}
+
+		vector<string>	m_lines;
+	};
+
+	ReadLinesSlot slot(lineReader);
+	lineReader->WaitForLine(slot.GetSlot());
+
+	// Lone \r and \n in the middle of a line, and a \r\n split across chunks
+	in->Feed("Hello");
+	in->Feed(" wor\rld\n");
+	in->Feed("!\r");
+	ASSERT_EQ( (size_t) 0, slot.m_lines.size() );
+
+	in->Feed("\nSecond line\r\n");
+	ASSERT_EQ( (size_t) 2, slot.m_lines.size() );
+	EXPECT_EQ( "Hello wor\rld\n!", slot.m_lines[0] );
+	EXPECT_EQ( "Second line", slot.m_lines[1] );
+
+	// Long line delivered a few bytes at a time
+	string longLine;
+	for(int i = 0; i < 1000; ++i) {
+		longLine.append("0123456789abcdefghijklmnopqrstuvwxyz");
+	}
+
+	for(size_t i = 0; i < longLine.size(); i += 7) {
+		in->Feed(longLine.substr(i, 7));
+	}
+	in->Feed("\r\n");
+
+	ASSERT_EQ( (size_t) 3, slot.m_lines.size() );
+	EXPECT_EQ( longLine, slot.m_lines[2] );
+}
+
+TEST(LineReaderTest, TestNewlineAutoIncremental)
+{
+	MojRefCountedPtr<MockInputStream> in(new MockInputStream());
+	LineReaderPtr lineReader(new LineReader(in));
+
+	class ReadLineSlot : public LineReaderDoneSlot
+	{
+	public:
+		ReadLineSlot(const LineReaderPtr& lineReader) : LineReaderDoneSlot(lineReader) {}
+
+		void Done()
+		{
+			m_line = m_lineReader->ReadLine(false);
+		}
+
+		string	m_line;
+	};
+
+	ReadLineSlot slot(lineReader);
+
+	lineReader->SetNewlineMode(LineReader::NewlineMode_Auto);
+	lineReader->WaitForLine(slot.GetSlot());
+
+	in->Feed("0123456789012345678901234567890123456789");
+	in->Feed("0123456789012345678901234567890123456789");
+	ASSERT_EQ( "", slot.m_line );
+
+	in->Feed("end\nnext");
+	EXPECT_EQ( "01234567890123456789012345678901234567890123456789012345678901234567890123456789end", slot.m_line );
+}
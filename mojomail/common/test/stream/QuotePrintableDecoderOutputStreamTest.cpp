@@ -34,3 +34,38 @@ TEST(QuotePrintableDecoderOutputStreamTest, TestQuotePrintableDecoder)
 	ASSERT_EQ(101, (int) nread);
 	ASSERT_EQ("If you believe that truth=beauty, then surely mathematics is the most beautiful branch of philosophy.", std::string(buf, 101));
 }
+
+static std::string Decode(const std::string& input, size_t chunkSize)
+{
+	MojRefCountedPtr<ByteBufferOutputStream> bbos( new ByteBufferOutputStream() );
+	QuotePrintableDecoderOutputStream qpdos(bbos);
+
+	for(size_t offset = 0; offset < input.size(); offset += chunkSize) {
+		qpdos.Write(input.data() + offset, std::min(chunkSize, input.size() - offset));
+	}
+
+	return bbos->GetBuffer();
+}
+
+TEST(QuotePrintableDecoderOutputStreamTest, TestChunks)
+{
+	std::string input = "caf=C3=A9 au lait=\r\n, cr=E8me br=FBl=\r\n=E9e\r\nno escapes here\r\n=3D=3d";
+	std::string expected = "caf\xC3\xA9 au lait, cr\xE8me br\xFBl\xE9" "e\r\nno escapes here\r\n==";
+
+	for(size_t chunkSize = 1; chunkSize <= input.size(); ++chunkSize) {
+		ASSERT_EQ( expected, Decode(input, chunkSize) ) << "chunk size " << chunkSize;
+	}
+}
+
+TEST(QuotePrintableDecoderOutputStreamTest, TestInvalidEscapes)
+{
+	// Lowercase hex
+	ASSERT_EQ( "\xE9\xE9", Decode("=e9=E9", 100) );
+
+	// Soft line break with a bare LF
+	ASSERT_EQ( "ab", Decode("a=\nb", 100) );
+
+	// Not hex; left as is
+	ASSERT_EQ( "1=XY+=G1", Decode("1=XY+=G1", 100) );
+	ASSERT_EQ( "1=XY+=G1", Decode("1=XY+=G1", 1) );
+}
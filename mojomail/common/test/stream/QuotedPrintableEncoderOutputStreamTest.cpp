@@ -19,6 +19,7 @@
 #include "stream/QuotedPrintableEncoderOutputStream.h"
 #include "stream/QuotePrintableDecoderOutputStream.h"
 #include "stream/ByteBufferOutputStream.h"
+#include <string>
 #include <gtest/gtest.h>
 
 /* Compare an input string filtered through the QP encoder to the expected output.
@@ -196,3 +197,42 @@ TEST(QuotedPrintableEncoderOutputStreamTest, TestQuotedPrintableEncoder)
 	MATCH(" \r", "=20=0D");
 	MATCH("\t\r", "=09=0D");
 }
+
+// Plain runs are copied in bulk; make sure they stop at the same places the
+// per-character encoder would (line limit, '=', whitespace, line endings)
+TEST(QuotedPrintableEncoderOutputStreamTest, TestPlainRuns)
+{
+	using std::string;
+
+	string words;
+	for (int i = 0; i < 40; i++)
+		words += "word ";
+
+	// Soft line breaks in the middle of a long run with spaces; trailing space encoded at the end
+	MATCH(words.c_str(),
+	      ("word word word word word word word word word word word word word word word =\r\n"
+	       "word word word word word word word word word word word word word word word =\r\n"
+	       "word word word word word word word word word word=20"));
+
+	// Run ends at column 74, then whitespace before a line ending after the soft break
+	MATCH((string(74, 'a') + " \r\n" + string(10, 'b')).c_str(),
+	      (string(74, 'a') + "=\r\n=20\r\n" + string(10, 'b')).c_str());
+	MATCH((string(75, 'a') + " \r\n").c_str(),
+	      (string(75, 'a') + "=\r\n=20\r\n").c_str());
+
+	// Dot right after a soft line break
+	MATCH((string(75, 'a') + ".b\r\n").c_str(),
+	      (string(75, 'a') + "=\r\n=2Eb\r\n").c_str());
+
+	// Several soft breaks, then trailing tab and spaces
+	MATCH((string(150, 'x') + "\t\r\nEnd.  \r\n").c_str(),
+	      (string(75, 'x') + "=\r\n" + string(75, 'x') + "=\r\n=09\r\nEnd. =20\r\n").c_str());
+
+	// '=' ends a run
+	MATCH(("key=value " + string(80, 'k') + "=\r\n").c_str(),
+	      ("key=3Dvalue " + string(63, 'k') + "=\r\n" + string(17, 'k') + "=3D\r\n").c_str());
+
+	// Trailing mixed whitespace on a long line, dot at the start of the next one
+	MATCH(("Subject line\r\n" + string(70, 'a') + "\t\t \r\n.leading dot\r\n").c_str(),
+	      ("Subject line\r\n" + string(70, 'a') + "\t\t=20\r\n=2Eleading dot\r\n").c_str());
+}
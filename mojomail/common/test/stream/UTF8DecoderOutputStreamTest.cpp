@@ -18,7 +18,11 @@
 
 #include "stream/UTF8DecoderOutputStream.h"
 #include "stream/ByteBufferOutputStream.h"
+#include "email/CharsetConverterPool.h"
 #include <gtest/gtest.h>
+#include <string>
+
+using namespace std;
 
 TEST(UTF8DecoderOutputStreamTest, TestUTF8Decoder)
 {
@@ -42,3 +46,74 @@ TEST(UTF8DecoderOutputStreamTest, TestUTF8Decoder)
 
 	ASSERT_STREQ(control, std::string(buf, 11).c_str());
 }
+
+// Write the text one byte at a time, then close the stream
+static string DecodeBytewise(const char* charset, const string& text)
+{
+	MojRefCountedPtr<ByteBufferOutputStream> bbos( new ByteBufferOutputStream() );
+	UTF8DecoderOutputStream utf8dos(bbos, charset);
+
+	for(size_t i = 0; i < text.length(); i++) {
+		utf8dos.Write(text.data() + i, 1);
+	}
+	utf8dos.Close();
+
+	return bbos->GetBuffer();
+}
+
+TEST(UTF8DecoderOutputStreamTest, TestPassthrough)
+{
+	string text = "caf\xc3\xa9 \xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e \xf0\x9f\x98\x80";
+
+	MojRefCountedPtr<ByteBufferOutputStream> bbos( new ByteBufferOutputStream() );
+	UTF8DecoderOutputStream utf8dos(bbos, "utf-8");
+	EXPECT_TRUE( utf8dos.IsPassthrough() );
+
+	utf8dos.Write(text.data(), text.length());
+	utf8dos.Close();
+	EXPECT_TRUE( utf8dos.IsPassthrough() );
+	EXPECT_EQ( text, bbos->GetBuffer() );
+
+	// Sequences split across writes
+	EXPECT_EQ( text, DecodeBytewise("UTF8", text) );
+	EXPECT_EQ( "plain text", DecodeBytewise("US-ASCII", "plain text") );
+}
+
+TEST(UTF8DecoderOutputStreamTest, TestPassthroughInvalid)
+{
+	// Invalid bytes are replaced by ICU
+	EXPECT_EQ( "Te\xef\xbf\xbdst", DecodeBytewise("utf-8", "Te\x96st") );
+	EXPECT_EQ( "\xe6\x97\xa5\xef\xbf\xbdx", DecodeBytewise("utf-8", "\xe6\x97\xa5\xe6\x97x") );
+
+	// Incomplete sequence at the end
+	EXPECT_EQ( "Test\xef\xbf\xbd", DecodeBytewise("utf-8", "Test\xe6\x97") );
+
+	MojRefCountedPtr<ByteBufferOutputStream> bbos( new ByteBufferOutputStream() );
+	UTF8DecoderOutputStream utf8dos(bbos, "us-ascii");
+
+	utf8dos.Write("A\x80", 2);
+	EXPECT_FALSE( utf8dos.IsPassthrough() );
+}
+
+TEST(UTF8DecoderOutputStreamTest, TestConverterPool)
+{
+	UErrorCode err = U_ZERO_ERROR;
+	UConverter* converter = CharsetConverterPool::Acquire("ISO-8859-1", &err);
+	ASSERT_TRUE( U_SUCCESS(err) );
+	ASSERT_TRUE( converter != NULL );
+
+	CharsetConverterPool::Release(converter);
+
+	// Should get the same converter back
+	EXPECT_EQ( converter, CharsetConverterPool::Acquire("ISO-8859-1", &err) );
+	CharsetConverterPool::Release(converter);
+
+	EXPECT_EQ( "\xc3\xa0\xc3\xa8", DecodeBytewise("ISO-8859-1", "\xe0\xe8") );
+	EXPECT_EQ( "\xc3\xa0\xc3\xa8", DecodeBytewise("iso-8859-1", "\xe0\xe8") );
+
+	err = U_ZERO_ERROR;
+	EXPECT_TRUE( CharsetConverterPool::Acquire("no-such-charset", &err) == NULL );
+	EXPECT_TRUE( U_FAILURE(err) );
+
+	CharsetConverterPool::Clear();
+}
@@ -0,0 +1,158 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "util/Base64.h"
+#include <glib.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+
+using namespace std;
+
+static string Encode(const string& data, size_t chunkSize, size_t lineLength = Base64Encoder::MIME_LINE_LENGTH)
+{
+	Base64Encoder encoder(lineLength);
+	string result;
+
+	for(size_t offset = 0; offset < data.size() || offset == 0; offset += chunkSize) {
+		size_t length = min(chunkSize, data.size() - offset);
+		vector<char> buf(encoder.MaxEncodedSize(length));
+
+		size_t bytesOut = encoder.Encode(data.data() + offset, length, &buf[0]);
+		result.append(&buf[0], bytesOut);
+
+		if(data.empty())
+			break;
+	}
+
+	char buf[Base64Encoder::MAX_FINISH_SIZE];
+	result.append(buf, encoder.Finish(buf));
+
+	return result;
+}
+
+static string Decode(const string& text, size_t chunkSize)
+{
+	Base64Decoder decoder;
+	string result;
+
+	for(size_t offset = 0; offset < text.size(); offset += chunkSize) {
+		size_t length = min(chunkSize, text.size() - offset);
+		vector<char> buf(Base64Decoder::MaxDecodedSize(length));
+
+		result.append(&buf[0], decoder.Decode(text.data() + offset, length, &buf[0]));
+	}
+
+	return result;
+}
+
+// Reference encoding from GLib, with CRLF line endings
+static string GLibEncode(const string& data)
+{
+	gchar* encoded = g_base64_encode(reinterpret_cast<const guchar*>(data.data()), data.size());
+	string text(encoded);
+	g_free(encoded);
+
+	string result;
+	for(size_t i = 0; i < text.size(); i += 76) {
+		result.append(text, i, 76);
+		result.append("\r\n");
+	}
+
+	if(result.empty())
+		result = "\r\n";
+
+	return result;
+}
+
+static string RandomData(size_t length, unsigned int seed)
+{
+	string data;
+	srand(seed);
+
+	for(size_t i = 0; i < length; ++i) {
+		data.push_back((char) (rand() & 0xFF));
+	}
+
+	return data;
+}
+
+TEST(Base64Test, TestEncode)
+{
+	EXPECT_EQ( "\r\n", Encode("", 1) );
+	EXPECT_EQ( "TQ==\r\n", Encode("M", 1) );
+	EXPECT_EQ( "TWE=\r\n", Encode("Ma", 1) );
+	EXPECT_EQ( "TWFu\r\n", Encode("Man", 1) );
+	EXPECT_EQ( "TWFu", Encode("Man", 1, 0) );
+
+	// Exactly one line; no blank line before the final CRLF
+	string data(57, 'x');
+	EXPECT_EQ( string(76, 'e').size() + 2, Encode(data, 100).size() );
+	EXPECT_EQ( GLibEncode(data), Encode(data, 100) );
+}
+
+TEST(Base64Test, TestEncodeChunks)
+{
+	const size_t lengths[] = { 1, 2, 3, 56, 57, 58, 100, 114, 1000, 4096, 10000 };
+	const size_t chunkSizes[] = { 1, 2, 3, 5, 16, 17, 57, 4096, 100000 };
+
+	for(size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i) {
+		string data = RandomData(lengths[i], i);
+		string expected = GLibEncode(data);
+
+		for(size_t j = 0; j < sizeof(chunkSizes) / sizeof(chunkSizes[0]); ++j) {
+			ASSERT_EQ( expected, Encode(data, chunkSizes[j]) ) << "length " << lengths[i] << " chunk size " << chunkSizes[j];
+		}
+	}
+}
+
+TEST(Base64Test, TestDecode)
+{
+	EXPECT_EQ( "", Decode("", 1) );
+	EXPECT_EQ( "M", Decode("TQ==", 1) );
+	EXPECT_EQ( "Ma", Decode("TWE=", 3) );
+	EXPECT_EQ( "Man", Decode("TWFu\r\n", 4) );
+
+	// Skips line breaks, whitespace and junk
+	EXPECT_EQ( "Man is", Decode("TW Fu\r\nIG\t!lz", 100) );
+
+	// Concatenated encodings with padding in the middle
+	EXPECT_EQ( "MMa", Decode("TQ==TWE=", 100) );
+
+	// Non-ASCII bytes are ignored
+	EXPECT_EQ( "Man", Decode("T\x80W\xff" "Fu", 2) );
+}
+
+TEST(Base64Test, TestDecodeChunks)
+{
+	const size_t lengths[] = { 1, 2, 3, 56, 57, 58, 100, 1000, 10000 };
+	const size_t chunkSizes[] = { 1, 2, 3, 4, 5, 15, 16, 17, 78, 4096, 100000 };
+
+	for(size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i) {
+		string data = RandomData(lengths[i], 100 + i);
+		string text = GLibEncode(data);
+
+		for(size_t j = 0; j < sizeof(chunkSizes) / sizeof(chunkSizes[0]); ++j) {
+			ASSERT_EQ( data, Decode(text, chunkSizes[j]) ) << "length " << lengths[i] << " chunk size " << chunkSizes[j];
+		}
+
+		// Unwrapped text
+		ASSERT_EQ( data, Decode(Encode(data, 1000, 0), 1000) );
+	}
+}
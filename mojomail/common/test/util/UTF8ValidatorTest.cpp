@@ -0,0 +1,87 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "util/UTF8Validator.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <string.h>
+
+using namespace std;
+
+static size_t ValidLength(const string& text)
+{
+	return UTF8Validator::ValidLength(text.data(), text.length());
+}
+
+TEST(UTF8ValidatorTest, TestValid)
+{
+	EXPECT_EQ( 0u, ValidLength("") );
+	EXPECT_EQ( 5u, ValidLength(string("Te\0st", 5)) );
+
+	// 2, 3 and 4 byte sequences, including the highest code point
+	string text = "caf\xc3\xa9 \xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e \xf0\x9f\x98\x80 \xf4\x8f\xbf\xbf";
+	EXPECT_EQ( text.length(), ValidLength(text) );
+
+	// Long enough to cross several 16-byte blocks at different offsets
+	for (size_t offset = 0; offset < 16; offset++) {
+		string longText = string(offset, 'x');
+		for (int i = 0; i < 8; i++) longText.append(text);
+
+		EXPECT_EQ( longText.length(), ValidLength(longText) ) << offset;
+	}
+}
+
+TEST(UTF8ValidatorTest, TestInvalid)
+{
+	const char* invalid[] = {
+		"\x80",				// stray continuation byte
+		"\xc0\xaf",			// overlong 2 byte
+		"\xe0\x80\xaf",		// overlong 3 byte
+		"\xf0\x80\x80\xaf",	// overlong 4 byte
+		"\xed\xa0\x80",		// surrogate
+		"\xf4\x90\x80\x80",	// above U+10FFFF
+		"\xf8\x88\x80\x80\x80",
+		"\xff",
+		"\xc3\x28",			// missing continuation
+		"\xe6\x97\x28"
+	};
+
+	for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+		// Check at different positions in a block, with valid text around it
+		for (size_t offset = 0; offset < 40; offset += 7) {
+			string text = string(offset, 'a') + invalid[i] + string(32, 'b');
+
+			EXPECT_EQ( offset, ValidLength(text) ) << i << " " << offset;
+			EXPECT_FALSE( UTF8Validator::IsIncompleteSequence(invalid[i], strlen(invalid[i])) );
+		}
+	}
+}
+
+TEST(UTF8ValidatorTest, TestIncomplete)
+{
+	EXPECT_EQ( 4u, ValidLength("Test\xe6\x97") );
+	EXPECT_TRUE( UTF8Validator::IsIncompleteSequence("\xe6\x97", 2) );
+	EXPECT_TRUE( UTF8Validator::IsIncompleteSequence("\xf0\x9f\x98", 3) );
+	EXPECT_FALSE( UTF8Validator::IsIncompleteSequence("\xe6\x97\xa5", 3) );
+	EXPECT_FALSE( UTF8Validator::IsIncompleteSequence("a", 1) );
+	EXPECT_FALSE( UTF8Validator::IsIncompleteSequence("\xed\xa0", 2) );
+
+	// Incomplete sequence at the end of a block, followed by ASCII
+	string text = string(14, 'a') + "\xe6\x97" + string(16, 'b');
+	EXPECT_EQ( 14u, ValidLength(text) );
+}
@@ -52,6 +52,7 @@ class ImapSyncSessionCommand;
 class PowerManager;
 class ImapBusDispatcher;
 class NetworkStatusMonitor;
+class ImapConnectionPool;
 
 class ImapClient : public MojSignalHandler, public BusClient, public Command::Listener
 {
@@ -231,6 +232,9 @@ public:
 
 	NetworkStatusMonitor& GetNetworkStatusMonitor() const;
 
+	// Connections shared between the folder sessions
+	ImapConnectionPool& GetConnectionPool() { return *m_connectionPool.get(); }
+
 protected:
 	typedef enum {
 		State_None,
@@ -280,6 +284,7 @@ protected:
 	MojRefCountedPtr<MojServiceMessage>		m_deleteAccountMsg;
 	std::map< const MojObject, MojRefCountedPtr<ImapSession> > m_folderSessionMap;
 	std::vector< MojRefCountedPtr<ImapSession> > m_pendingDeletefolderSessions;
+	boost::shared_ptr<ImapConnectionPool>	m_connectionPool;
 
 	NetworkStatus							m_networkStatus;
 
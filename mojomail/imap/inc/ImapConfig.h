@@ -43,6 +43,15 @@ public:
 	int GetHeaderBatchSize() const { return m_headerBatchSize; }
 	void SetHeaderBatchSize(int size) { m_headerBatchSize = size; }
 
+	int GetMaxHeaderBatchSize() const { return m_maxHeaderBatchSize; }
+	void SetMaxHeaderBatchSize(int size) { m_maxHeaderBatchSize = size; }
+
+	bool GetAdaptiveHeaderBatch() const { return m_adaptiveHeaderBatch; }
+	void SetAdaptiveHeaderBatch(bool adaptive) { m_adaptiveHeaderBatch = adaptive; }
+
+	bool GetPipelineHeaderFetch() const { return m_pipelineHeaderFetch; }
+	void SetPipelineHeaderFetch(bool pipeline) { m_pipelineHeaderFetch = pipeline; }
+
 	int GetMaxEmails() const { return m_maxEmails; }
 	void SetMaxEmails(int maxEmails) { m_maxEmails = maxEmails; }
 
@@ -70,12 +79,30 @@ public:
 	int GetNumAutoDownloadBodies() const { return m_numAutoDownloadBodies; }
 	void SetNumAutoDownloadBodies(int num) { m_numAutoDownloadBodies = num; }
 
+	bool GetFlushSyncChangesPerPage() const { return m_flushSyncChangesPerPage; }
+	void SetFlushSyncChangesPerPage(bool flush) { m_flushSyncChangesPerPage = flush; }
+
+	bool GetPipelineSearches() const { return m_pipelineSearches; }
+	void SetPipelineSearches(bool pipeline) { m_pipelineSearches = pipeline; }
+
+	int GetMaxConnections() const { return m_maxConnections; }
+	void SetMaxConnections(int maxConnections) { m_maxConnections = maxConnections; }
+
+	int GetPooledConnectionTimeout() const { return m_pooledConnectionTimeout; }
+	void SetPooledConnectionTimeout(int timeout) { m_pooledConnectionTimeout = timeout; }
+
+	bool GetPreconnect() const { return m_preconnect; }
+	void SetPreconnect(bool preconnect) { m_preconnect = preconnect; }
+
 	static const int DEFAULT_INACTIVITY_TIMEOUT;
 	static const int DEFAULT_HEADER_BATCH_SIZE;
+	static const int DEFAULT_MAX_HEADER_BATCH_SIZE;
 	static const int DEFAULT_MAX_EMAILS;
 	static const int DEFAULT_CONNECT_TIMEOUT;
 	static const int DEFAULT_SESSION_KEEPALIVE;
 	static const int DEFAULT_NUM_AUTODOWNLOAD_BODIES;
+	static const int DEFAULT_MAX_CONNECTIONS;
+	static const int DEFAULT_POOLED_CONNECTION_TIMEOUT;
 
 protected:
 	void GetOptionalInt(const MojObject& obj, const char* prop, int& value, int min, int max);
@@ -88,6 +115,15 @@ protected:
 	// Max headers to download in one request
 	int m_headerBatchSize;
 
+	// Upper limit on the header batch size when adapting it to the connection speed
+	int m_maxHeaderBatchSize;
+
+	// Whether to adjust the header batch size based on how long each batch takes
+	bool m_adaptiveHeaderBatch;
+
+	// Whether to fetch the next batch of headers while the previous batch is being saved
+	bool m_pipelineHeaderFetch;
+
 	// Max emails to keep locally on the device per folder
 	int m_maxEmails;
 
@@ -116,6 +152,25 @@ protected:
 	// How many bodies to automatically download per folder
 	int m_numAutoDownloadBodies;
 
+	// Whether to save deleted emails and flag changes after diffing each page of local emails,
+	// instead of after the whole folder. This only bounds the deleted ids and flag changes;
+	// the server UIDs and flags, the new UIDs and the UID map still cover the whole folder.
+	// Off by default, since deletes and flag changes are then saved before new emails are fetched.
+	bool m_flushSyncChangesPerPage;
+
+	// Whether to send all of the sync searches at once instead of waiting for each one
+	bool m_pipelineSearches;
+
+	// Max connections to the server per account, shared by all folders
+	int m_maxConnections;
+
+	// How long to keep an idle logged-in connection around for another folder to reuse, in seconds
+	// Zero to log out right away
+	int m_pooledConnectionTimeout;
+
+	// Whether to start connecting to the server while still waiting for the network status
+	bool m_preconnect;
+
 	static ImapConfig s_instance;
 };
 
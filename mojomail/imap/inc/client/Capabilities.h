@@ -37,6 +37,10 @@ public:
 	static const std::string STARTTLS;
 	static const std::string LOGINDISABLED;
 	static const std::string COMPRESS_DEFLATE;
+	static const std::string ENABLE;
+	static const std::string CONDSTORE;
+	static const std::string QRESYNC;
+	static const std::string ESEARCH;
 
 	void SetCapability(const std::string& cap);
 	void RemoveCapability(const std::string& cap);
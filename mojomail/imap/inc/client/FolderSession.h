@@ -44,6 +44,13 @@ public:
 	void	SetUIDMap(const boost::shared_ptr<UIDMap>& uidMap) { m_uidMap = uidMap; }
 	void	SetMessageCount(unsigned int count) { m_count = count; }
 
+	// Highest mod sequence reported by the server since the folder was selected, or 0 if not supported
+	MojUInt64	GetHighestModSeq() const { return m_highestModSeq; }
+	void		SetHighestModSeq(MojUInt64 modSeq) { m_highestModSeq = modSeq; }
+
+	// Called for HIGHESTMODSEQ and MODSEQ values received while the folder is selected
+	void		UpdateHighestModSeq(MojUInt64 modSeq) { if(modSeq > m_highestModSeq) m_highestModSeq = modSeq; }
+
 protected:
 	// Database folder currently selected
 	ImapFolderPtr				m_folder;
@@ -51,6 +58,9 @@ protected:
 	// Number of messages when we selected the folder
 	int							m_count;
 
+	// Server HIGHESTMODSEQ when we selected the folder, updated by later responses
+	MojUInt64					m_highestModSeq;
+
 	// UIDMap for associating message sequence numbers with UIDs
 	boost::shared_ptr<UIDMap>	m_uidMap;
 };
@@ -0,0 +1,183 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#ifndef IMAPCONNECTIONPOOL_H_
+#define IMAPCONNECTIONPOOL_H_
+
+#include "core/MojSignal.h"
+#include "core/MojObject.h"
+#include "network/SocketConnection.h"
+#include "stream/LineReader.h"
+#include "client/Capabilities.h"
+#include "util/Timer.h"
+#include <list>
+#include <string>
+
+class ImapSession;
+class ImapConnectionPool;
+
+/**
+ * An authenticated connection that isn't currently being used by a session,
+ * along with the protocol state that goes with it.
+ */
+struct ImapConnectionState
+{
+	ImapConnectionState() : compressionActive(false), qresyncEnabled(false) {}
+
+	MojRefCountedPtr<SocketConnection>	connection;
+	InputStreamPtr						inputStream;
+	OutputStreamPtr						outputStream;
+	LineReaderPtr						lineReader;
+	Capabilities						capabilities;
+	bool								compressionActive;
+	bool								qresyncEnabled;
+};
+
+/**
+ * Idle connection waiting in the pool. Watches for the server closing the
+ * connection, and closes it after it has been idle for too long.
+ */
+class PooledConnection : public MojSignalHandler
+{
+public:
+	PooledConnection(ImapConnectionPool& pool, const ImapConnectionState& state, int idleTimeoutSeconds);
+	virtual ~PooledConnection();
+
+	const ImapConnectionState& GetState() const { return m_state; }
+
+	// Stops watching the connection so it can be handed to a session
+	void Detach();
+
+	// Closes the connection
+	void Shutdown();
+
+protected:
+	MojErr ConnectionClosed();
+	void IdleTimeout();
+
+	ImapConnectionPool&			m_pool;
+	ImapConnectionState			m_state;
+
+	MojSignal<>::Slot<PooledConnection>		m_closedSlot;
+	Timer<PooledConnection>					m_idleTimer;
+};
+
+/**
+ * Shares a limited number of server connections between the folder sessions of an account.
+ *
+ * Each session takes a connection slot before connecting, and gives it back when its
+ * connection is closed. Instead of logging out when it runs out of work, a session can
+ * return its connection to the pool, where the next session that needs to connect can
+ * pick it up and just SELECT its own folder, skipping the TCP/TLS/LOGIN handshake.
+ *
+ * Once all slots are in use, sessions wait for a slot or a pooled connection.
+ */
+class ImapConnectionPool
+{
+public:
+	enum Result
+	{
+		Result_Reused,		// got a pooled connection
+		Result_NewSlot,		// go ahead and open a new connection
+		Result_Wait			// wait for ConnectionSlotAvailable or PooledConnectionAvailable
+	};
+
+	ImapConnectionPool(MojLogger& log);
+	virtual ~ImapConnectionPool();
+
+	/**
+	 * Request a connection for a session.
+	 *
+	 * @param session		session to notify if it needs to wait
+	 * @param bindAddress	only reuse connections bound to this address (empty for default interface)
+	 * @param state			filled in with the pooled connection, if Result_Reused is returned
+	 */
+	Result RequestConnection(const MojRefCountedPtr<ImapSession>& session, const std::string& bindAddress, ImapConnectionState& state);
+
+	/**
+	 * Give an authenticated, idle connection back to the pool.
+	 * The session's connection slot is transferred along with it.
+	 */
+	void ReturnConnection(const ImapConnectionState& state);
+
+	/**
+	 * Called when a session's connection has been closed, freeing up its slot.
+	 */
+	void ReleaseSlot();
+
+	/**
+	 * Record how long it took to connect and log in to the server.
+	 */
+	void AddHandshakeTime(MojInt64 millis);
+
+	/**
+	 * Close all pooled connections.
+	 * Used when the account is being disabled or its settings changed.
+	 */
+	void Clear();
+
+	bool IsEnabled() const;
+
+	void Status(MojObject& status) const;
+
+	// Called by PooledConnection
+	void PooledConnectionClosed(PooledConnection* pooled);
+
+	static const int WAIT_TIMEOUT;
+
+protected:
+	typedef MojRefCountedPtr<PooledConnection>	PooledConnectionPtr;
+
+	struct Waiter
+	{
+		Waiter(const MojRefCountedPtr<ImapSession>& session, const std::string& bindAddress, time_t startTime)
+		: session(session), bindAddress(bindAddress), startTime(startTime) {}
+
+		MojRefCountedPtr<ImapSession>	session;
+		std::string						bindAddress;
+		time_t							startTime;
+	};
+
+	int GetMaxConnections() const;
+
+	// Give a free slot to the session that has been waiting the longest
+	void GrantSlotToWaiter();
+
+	void UpdateWaitTimer();
+	void WaitTimeout();
+
+	MojLogger&					m_log;
+
+	// Number of connections open, including pooled connections
+	int							m_openCount;
+
+	std::list<PooledConnectionPtr>	m_pooled;
+	std::list<Waiter>				m_waiters;
+
+	Timer<ImapConnectionPool>	m_waitTimer;
+
+	// Stats
+	MojInt64					m_hits;
+	MojInt64					m_misses;
+	MojInt64					m_overflows;
+	MojInt64					m_handshakeCount;
+	MojInt64					m_handshakeMillis;
+	MojInt64					m_maxHandshakeMillis;
+};
+
+#endif /* IMAPCONNECTIONPOOL_H_ */
@@ -39,6 +39,7 @@
 
 class ImapClient;
 class ImapResponseParser;
+struct ImapConnectionState;
 class DatabaseInterface;
 class FolderSession;
 
@@ -48,6 +49,7 @@ class DownloadListener;
 
 class BaseIdleCommand;
 class ScheduleRetryCommand;
+class PrefetchPartsCommand;
 
 class ImapLoginSettings;
 
@@ -149,6 +151,10 @@ public:
 			const MojRefCountedPtr<DownloadListener>& listener, Command::Priority priority);
 	virtual void SearchFolder(const MojObject& folderId, const MojRefCountedPtr<SearchRequest>& searchRequest);
 	virtual void FetchNewHeaders(const MojObject& folderId);
+	virtual void PrefetchParts(const MojRefCountedPtr<PrefetchPartsCommand>& command);
+
+	// Called from PrefetchPartsCommand to record download throughput
+	void PrefetchComplete(size_t numParts, MojInt64 numBytes, MojInt64 elapsedMillis);
 
 	virtual void Status(MojObject& status);
 
@@ -174,12 +180,17 @@ public:
 	virtual MojErr NetworkStatusAvailable();
 	virtual void QueryNetworkStatusDone();
 
+	virtual void RequestConnection();
 	virtual void Connect();
 	virtual void ConnectSuccess();
 	virtual void ConnectFailure(const std::exception& e);
 
 	virtual void Connected(const MojRefCountedPtr<SocketConnection>& connection);
 
+	// Called by ImapConnectionPool when this session was waiting for a connection
+	virtual void ConnectionSlotAvailable();
+	virtual void PooledConnectionAvailable(const ImapConnectionState& state);
+
 	virtual void CheckLoginCapabilities();
 	virtual void LoginCapabilityComplete();
 
@@ -292,6 +303,10 @@ public:
 	bool IsSafeMode() const { return m_safeMode; }
 	void SetSafeMode(bool enabled) { m_safeMode = enabled; }
 
+	// Whether QRESYNC (RFC 7162) has been enabled on this connection
+	bool IsQResyncEnabled() const { return m_qresyncEnabled; }
+	void SetQResyncEnabled(bool enabled) { m_qresyncEnabled = enabled; }
+
 	void ForceReconnect(const std::string& reason);
 
 	virtual bool IsValidator() const { return false; }
@@ -325,6 +340,21 @@ protected:
 
 	virtual void ResetConnection();
 
+	// Take over a logged-in connection from the pool
+	void ReuseConnection(const ImapConnectionState& state);
+
+	// Whether to start connecting before the network status is known
+	bool ShouldPreconnect();
+
+	// Called if the network status comes back with no connection after pre-connecting
+	void AbandonPreconnect();
+
+	// Whether the connection can be handed to the pool instead of logging out
+	bool CanPoolConnection() const;
+
+	// Give the connection to the pool and clean up as if disconnected
+	void ReturnConnectionToPool();
+
 	virtual void CleanupAfterDisconnect();
 
 	// This gets called when the sync session is done cleaning up
@@ -361,6 +391,9 @@ protected:
 	MojRefCountedPtr<ImapCommand> FindActiveCommand(const MojRefCountedPtr<ImapCommand>& command);
 	MojRefCountedPtr<ImapCommand> FindPendingCommand(const MojRefCountedPtr<ImapCommand>& command);
 
+	// Removes a part from any prefetch batches, so it isn't downloaded twice
+	void RemoveFromPrefetch(const MojObject& emailId, const MojObject& partId);
+
 	void CancelPendingCommands(ImapCommand::CancelType cancelType);
 
 	struct CompressionStats
@@ -375,6 +408,14 @@ protected:
 			return *this;
 		}
 
+		CompressionStats& operator -=(const CompressionStats& other) {
+			totalBytesIn -= other.totalBytesIn;
+			totalBytesOut -= other.totalBytesOut;
+			compressedBytesIn -= other.compressedBytesIn;
+			compressedBytesOut -= other.compressedBytesOut;
+			return *this;
+		}
+
 		MojInt64	totalBytesIn;
 		MojInt64	totalBytesOut;
 		MojInt64	compressedBytesIn;
@@ -383,11 +424,15 @@ protected:
 
 	struct Stats
 	{
-		Stats() : connectAttemptCount(0), loginSuccessCount(0) {}
+		Stats() : connectAttemptCount(0), loginSuccessCount(0), prefetchPartCount(0), prefetchBytes(0), prefetchMillis(0) {}
 
 		int					connectAttemptCount;
 		int					loginSuccessCount;
 
+		MojInt64			prefetchPartCount;
+		MojInt64			prefetchBytes;
+		MojInt64			prefetchMillis;
+
 		CompressionStats	compressionStats;
 	};
 
@@ -458,6 +503,9 @@ protected:
 	// Whether compression is currently enabled
 	bool									m_compressionActive;
 
+	// Whether the server has confirmed ENABLE QRESYNC on this connection
+	bool									m_qresyncEnabled;
+
 	// Whether we want to push
 	bool									m_shouldPush;
 
@@ -485,6 +533,22 @@ protected:
 	// (Otherwise, an invalid bind address could get this stuck in a bad state.)
 	std::string								m_connectBindAddress;
 
+	// Whether this session is using one of the client's connection slots
+	bool									m_hasConnectionSlot;
+
+	// When we started connecting, for measuring how long it takes to log in
+	MojInt64								m_connectStartTime;
+
+	// Compression counters of a pooled connection at the time this session took it over,
+	// which were already added to the stats of the sessions that used it before
+	CompressionStats						m_compressionStatsBaseline;
+
+	// Whether we started connecting without waiting for the network status
+	bool									m_preconnecting;
+
+	// Set if the network went away while the pre-connect was still connecting
+	bool									m_abandonConnect;
+
 	MojSignal<>::Slot<ImapSession>			m_networkStatusSlot;
 	MojSignal<>::Slot<ImapSession>			m_closedSlot;
 	MojSignal<>::Slot<ImapSession>			m_syncSessionDoneSlot;
@@ -22,9 +22,11 @@
 #include "commands/ImapSessionCommand.h"
 #include "db/MojDbClient.h"
 
+class PrefetchPartsCommand;
+
 /**
  * Command that searches for local emails with the autoDownload flag set
- * and queues fetch requests for them.
+ * and queues batched fetch requests for them.
  */
 class AutoDownloadCommand : public ImapSessionCommand
 {
@@ -38,6 +40,8 @@ public:
 	MojErr GetAutoDownloadsResponse(MojObject& response, MojErr err);
 
 protected:
+	void QueuePrefetch();
+
 	static const size_t MAX_AUTODOWNLOAD_SIZE;
 
 	MojObject	m_folderId;
@@ -45,6 +49,9 @@ protected:
 
 	int			m_emailsExamined;
 
+	// Batch of parts being collected for the next prefetch
+	MojRefCountedPtr<PrefetchPartsCommand>	m_prefetchCommand;
+
 	MojDbClient::Signal::Slot<AutoDownloadCommand>	m_getAutoDownloadsSlot;
 };
 
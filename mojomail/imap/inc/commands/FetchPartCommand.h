@@ -75,6 +75,9 @@ public:
 	// Implements CancelDownloadListener::CancelDownload
 	void CancelDownload();
 
+	// Wraps the sink with the content-encoding and charset decoders needed for the part
+	static OutputStreamPtr WrapDecoders(const OutputStreamPtr& sink, const EmailPart& part, MojLogger& log);
+
 protected:
 	void GetEmail();
 	MojErr GetEmailResponse(MojObject& response, MojErr err);
@@ -109,7 +112,6 @@ protected:
 	void ReportComplete();
 	void Done();
 
-	static const size_t PREVIEW_BUFFER_SIZE;
 	static const size_t PREVIEW_TEXT_LENGTH;
 
 	MojObject	m_folderId;
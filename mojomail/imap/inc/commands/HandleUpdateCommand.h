@@ -22,20 +22,41 @@
 #include "commands/ImapSyncSessionCommand.h"
 #include "db/MojDbClient.h"
 #include "ImapCoreDefs.h"
+#include <map>
+#include <vector>
 
+/**
+ * Applies flag changes and deletions reported by the server to the local emails.
+ *
+ * Updates are handled in batches: one query looks up the emails for a batch
+ * of UIDs, followed by one merge for the deletions and one for the flags.
+ */
 class HandleUpdateCommand : public ImapSyncSessionCommand
 {
 public:
-	HandleUpdateCommand(ImapSession& session, const MojObject& folderId, UID uid, bool deleted, const MojObject& newFlags);
+	struct Update
+	{
+		Update() : deleted(false), newFlags(MojObject::Undefined) {}
+
+		bool		deleted;
+		MojObject	newFlags;
+	};
+
+	typedef std::map<UID, Update> UpdateMap;
+
+	// Maximum number of emails to look up and write per database request
+	static const size_t BATCH_SIZE = 200;
+
+	HandleUpdateCommand(ImapSession& session, const MojObject& folderId, const UpdateMap& updates);
 	virtual ~HandleUpdateCommand();
 
 protected:
 	void RunImpl();
 
-	void GetEmail();
-	MojErr GetEmailResponse(MojObject& response, MojErr err);
+	void GetEmails();
+	MojErr GetEmailsResponse(MojObject& response, MojErr err);
 
-	void DeleteEmail();
+	void DeleteEmails();
 	MojErr DeleteResponse(MojObject& response, MojErr err);
 
 	void UpdateFlags();
@@ -43,13 +64,14 @@ protected:
 
 	void Done();
 
-	UID			m_uid;
-	bool		m_deleted;
-	MojObject	m_newFlags;
+	UpdateMap				m_updates;
+	UpdateMap::const_iterator	m_nextUpdate;
 
-	MojObject	m_emailId;
+	// Changes for the current batch
+	MojObject::ObjectVec	m_deleteIds;
+	MojObject::ObjectVec	m_flagChanges;
 
-	MojDbClient::Signal::Slot<HandleUpdateCommand>	m_getEmailSlot;
+	MojDbClient::Signal::Slot<HandleUpdateCommand>	m_getEmailsSlot;
 	MojDbClient::Signal::Slot<HandleUpdateCommand>	m_deleteSlot;
 	MojDbClient::Signal::Slot<HandleUpdateCommand>	m_updateFlagsSlot;
 };
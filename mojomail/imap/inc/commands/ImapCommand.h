@@ -40,7 +40,8 @@ public:
 	enum CommandType {
 		CommandType_Unknown,
 		CommandType_Sync,
-		CommandType_DownloadPart
+		CommandType_DownloadPart,
+		CommandType_PrefetchParts
 	};
 
 	enum CancelType {
@@ -24,6 +24,7 @@
 #include <sstream>
 #include "exceptions/MailException.h"
 #include "activity/Activity.h"
+#include "sync/UIDRangeSet.h"
 
 class ActivitySet;
 
@@ -44,16 +45,12 @@ public:
 
 protected:
 
+	// Appends the UIDs as a sequence set, with consecutive UIDs combined into ranges
 	template<class InputIterator>
 	static void AppendUIDs(std::stringstream& ss, const InputIterator& begin, const InputIterator& end)
 	{
 		if(begin != end) {
-			for(InputIterator it = begin; it != end; ++it) {
-				if(it != begin) {
-					ss << ",";
-				}
-				ss << *it;
-			}
+			ss << UIDRangeSet(begin, end).ToString();
 		} else {
 			throw MailException("empty UID list", __FILE__, __LINE__);
 		}
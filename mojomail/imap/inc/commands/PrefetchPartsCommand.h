@@ -0,0 +1,212 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+#ifndef PREFETCHPARTSCOMMAND_H_
+#define PREFETCHPARTSCOMMAND_H_
+
+#include "commands/ImapSessionCommand.h"
+#include "core/MojObject.h"
+#include "db/MojDbClient.h"
+#include "ImapCoreDefs.h"
+#include "protocol/ImapResponseParser.h"
+#include "parser/SemanticActions.h"
+#include "data/CommonData.h"
+#include "client/FileCacheClient.h"
+#include "stream/BaseOutputStream.h"
+#include "util/Timer.h"
+#include <map>
+#include <string>
+#include <vector>
+
+class FetchResponseParser;
+class AsyncIOChannel;
+class PrefetchPartsCommand;
+class PreviewTextExtractorOutputStream;
+
+/**
+ * A single part being downloaded by PrefetchPartsCommand.
+ * Each part needs its own file cache subscription and file channel,
+ * since many of them are in flight at the same time.
+ */
+class PrefetchPart : public MojSignalHandler
+{
+public:
+	PrefetchPart(PrefetchPartsCommand& command, size_t emailIndex, UID uid, const EmailPartPtr& part, bool isFirstBodyPart);
+	virtual ~PrefetchPart();
+
+	void InsertFileCache(FileCacheClient& fileCacheClient);
+
+	// Opens the file cache entry and returns the stream to write the encoded part to
+	OutputStreamPtr OpenOutputStream(FileCacheClient& fileCacheClient, MojLogger& log);
+
+	void Cleanup();
+
+	size_t GetEmailIndex() const { return m_emailIndex; }
+	UID GetUID() const { return m_uid; }
+	const EmailPartPtr& GetPart() const { return m_part; }
+	const std::string& GetPath() const { return m_path; }
+	bool IsFirstBodyPart() const { return m_isFirstBodyPart; }
+
+	bool IsOpened() const { return m_opened; }
+	bool IsWritten() const { return m_written; }
+
+	// Set when the part has been handed off to a FetchPartCommand; the part is still
+	// read from the server if it was already requested, but isn't saved to the database.
+	void SetRemoved() { m_removed = true; }
+	bool IsRemoved() const { return m_removed; }
+
+	// Set when the part is included in a fetch request
+	void SetRequested() { m_requested = true; }
+	bool IsRequested() const { return m_requested; }
+	bool HasPreviewText() const { return m_previewTextExtractor.get() != NULL; }
+	std::string GetPreviewText() const;
+
+protected:
+	MojErr InsertFileCacheResponse(MojObject& response, MojErr err);
+	MojErr FileChannelClosed();
+
+	PrefetchPartsCommand&	m_command;
+
+	size_t			m_emailIndex;
+	UID				m_uid;
+	EmailPartPtr	m_part;
+	bool			m_isFirstBodyPart;
+
+	std::string		m_path;
+	bool			m_opened;
+	bool			m_written;
+	bool			m_removed;
+	bool			m_requested;
+
+	MojRefCountedPtr<AsyncIOChannel>					m_fileChannel;
+	MojRefCountedPtr<PreviewTextExtractorOutputStream>	m_previewTextExtractor;
+
+	FileCacheClient::ReplySignal::Slot<PrefetchPart>	m_fileCacheSubscriptionSlot;
+	MojSignal<>::Slot<PrefetchPart>						m_fileChannelClosedSlot;
+};
+
+/**
+ * Downloads a batch of parts from several emails with as few round trips as possible.
+ *
+ * Emails that need the same set of sections are fetched with a single
+ * "UID FETCH uid,uid,... (UID BODY.PEEK[section] ...)" request, and each
+ * literal in the response is streamed into its own file cache entry.
+ * The new part paths are written to the database in one batch at the end,
+ * merged into the parts arrays as they are in the database at that point.
+ */
+class PrefetchPartsCommand : public ImapSessionCommand, public PartOutputStreamFactory
+{
+public:
+	PrefetchPartsCommand(ImapSession& session, const MojObject& folderId);
+	virtual ~PrefetchPartsCommand();
+
+	// Adds an email to download parts from
+	void AddEmail(const MojObject& emailId, UID uid);
+
+	// Adds a part to download from the most recently added email
+	void AddPart(const EmailPartPtr& part, bool isFirstBodyPart);
+
+	size_t GetNumParts() const { return m_parts.size(); }
+
+	/**
+	 * Removes a part from the batch so it can be downloaded by a FetchPartCommand instead.
+	 * If partId is null, the first body part of the email is removed.
+	 * Returns false if the part isn't in the batch or has already been downloaded.
+	 */
+	bool RemovePart(const MojObject& emailId, const MojObject& partId);
+
+	CommandType GetType() const { return CommandType_PrefetchParts; }
+
+	void RunImpl();
+
+	// Called by PrefetchPart
+	void FileCacheInserted(PrefetchPart* part, bool success);
+	void PartWritten(PrefetchPart* part);
+	void Progress(size_t bytes);
+
+	// Implements PartOutputStreamFactory
+	OutputStreamPtr GetPartOutputStream(UID uid, const std::string& section);
+
+	void Status(MojObject& status) const;
+
+	static const size_t MAX_BATCH_PARTS;
+
+protected:
+	struct PrefetchEmail
+	{
+		PrefetchEmail(const MojObject& emailId, UID uid)
+		: emailId(emailId), uid(uid), numRequested(0), numWritten(0) {}
+
+		MojObject	emailId;
+		UID			uid;
+		MojObject	partsArray; // read back from the database just before the update
+		int			numRequested;
+		int			numWritten;
+	};
+
+	typedef MojRefCountedPtr<PrefetchPart>				PrefetchPartPtr;
+	typedef std::pair<UID, std::string>					PartKey;
+
+	void InsertFileCache();
+
+	void SendNextFetchRequest();
+	MojErr FetchResponse();
+
+	void FetchTimeout();
+
+	void CheckDone();
+
+	void GetEmails();
+	MojErr GetEmailsResponse(MojObject& response, MojErr err);
+
+	void UpdateEmails();
+	MojErr UpdateEmailsResponse(MojObject& response, MojErr err);
+
+	void Failure(const std::exception& e);
+	void Cleanup();
+
+	static const int FETCH_PROGRESS_TIMEOUT;
+
+	MojObject	m_folderId;
+
+	std::vector<PrefetchEmail>				m_emails;
+	std::vector<PrefetchPartPtr>			m_parts;
+	std::map<PartKey, PrefetchPartPtr>		m_partsByKey;
+
+	// UIDs to fetch, grouped by the list of sections needed from each email
+	std::map< std::string, std::vector<UID> >	m_fetchGroups;
+
+	size_t		m_pendingInserts;
+	size_t		m_openChannels;
+	size_t		m_numWritten;
+	MojInt64	m_bytesRead;
+
+	MojInt64	m_startTime;
+
+	bool		m_fetchesDone;
+	bool		m_downloadInProgress;
+
+	Timer<PrefetchPartsCommand>		m_progressTimer;
+
+	MojRefCountedPtr<FetchResponseParser>	m_fetchResponseParser;
+
+	ImapResponseParser::DoneSignal::Slot<PrefetchPartsCommand>	m_fetchDoneSlot;
+	MojDbClient::Signal::Slot<PrefetchPartsCommand>				m_getEmailsSlot;
+	MojDbClient::Signal::Slot<PrefetchPartsCommand>				m_updateEmailsSlot;
+};
+
+#endif /* PREFETCHPARTSCOMMAND_H_ */
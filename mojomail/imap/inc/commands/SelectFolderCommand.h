@@ -56,6 +56,7 @@ protected:
 	MojObject 		m_selectFolderId;
 	bool			m_initialSync;
 
+	MojRefCountedPtr<ImapResponseParser>	m_enableParser;
 	MojRefCountedPtr<ExamineResponseParser>	m_responseParser;
 	MojRefCountedPtr<PurgeEmailsCommand>	m_purgeEmailsCommand;
 
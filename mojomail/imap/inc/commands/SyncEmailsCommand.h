@@ -30,10 +30,13 @@
 #include <utility>
 #include <boost/scoped_ptr.hpp>
 #include "client/SyncParams.h"
+#include "sync/BatchSizeTuner.h"
+#include "sync/UIDRangeSet.h"
 
 class ImapEmail;
 class UIDMap;
 class UidSearchResponseParser;
+class ChangedSinceResponseParser;
 class FetchResponseParser;
 class SyncLocalChangesCommand;
 class AutoDownloadCommand;
@@ -51,20 +54,35 @@ public:
 
 	void SyncServerChanges();
 
+	// Incremental sync using CONDSTORE/QRESYNC
+	bool CanSyncChangedSince();
+	void SyncChangedSince();
+	MojErr ChangedSinceResponse();
+
+	// Discard the incremental state and search the whole sync window instead
+	void FallBackToFullSync();
+	void ChangedSinceComplete();
+
+	void PipelineSearches();
 	void Search();
 	MojErr SearchResponse();
 	void SearchComplete();
 
 	void GetLocalEmails();
 	MojErr GetLocalEmailsResponse(MojObject& response, MojErr err);
+	void LocalEmailsPageDone();
 
 	// Fetch new emails, delete removed emails, update flags
 	void SyncUpdatesFromServer();
 
+	// Header fetches are pipelined with the database puts: the next batch
+	// is requested from the server while the previous one is being saved.
 	void FetchNewMessages();
 	void FetchOneBatch();
 	MojErr FetchResponse();
-	
+	void ContinueFetchingHeaders();
+
+	void PutEmails(const MojObject::ObjectVec& emails);
 	MojErr PutEmailsResponse(MojObject& response, MojErr err);
 
 	void DeleteLocalEmails();
@@ -72,6 +90,14 @@ public:
 
 	void MergeFlags();
 	MojErr MergeFlagsResponse(MojObject& response, MojErr err);
+	void MergeFlagsDone();
+
+	// Gets the server unread count without any UIDs, if the server supports ESEARCH
+	void GetUnreadCount();
+
+	// Save the server HIGHESTMODSEQ so the next sync can be incremental, and the unread count
+	void UpdateFolderState();
+	MojErr UpdateFolderStateResponse(MojObject& response, MojErr err);
 
 	void AutoDownload();
 	MojErr AutoDownloadDone();
@@ -85,6 +111,10 @@ public:
 
 protected:
 	int			m_daysBack;
+	std::string	m_sinceDate;	// empty if there's no sync window
+
+	// Number of times we had to wait for the server during this sync
+	int			m_roundTrips;
 
 	boost::shared_ptr<UIDMap>	m_uidMap;
 	
@@ -96,28 +126,64 @@ protected:
 	MojRefCountedPtr<SyncLocalChangesCommand> m_syncLocalChangesCommand;
 	MojRefCountedPtr<AutoDownloadCommand> m_autoDownloadCommand;
 
+	void SendSearch(SearchType searchType, bool notifyWhenDone);
+
+	void Cleanup();
+
 	std::queue<SearchType> m_pendingSearches;
 
 	MojDbQuery::Page	m_localEmailsPage;
+	bool				m_hasMoreLocalEmails;
+
+	// Whether the current page's deletes and flag changes are being saved
+	bool				m_flushingPage;
+
+	// Set if the incremental sync can't be used for this folder
+	bool				m_fullSyncRequired;
+
+	// HIGHESTMODSEQ to save once the sync is done; no higher than what the sync has seen
+	MojUInt64			m_syncModSeq;
 
 	boost::scoped_ptr<SyncEngine>	m_syncEngine;
 
-	MojRefCountedPtr<UidSearchResponseParser>	m_responseParser;
+	std::vector< MojRefCountedPtr<UidSearchResponseParser> >	m_searchParsers;
 	MojRefCountedPtr<FetchResponseParser>		m_fetchResponseParser;
+	MojRefCountedPtr<ChangedSinceResponseParser>	m_changedSinceParser;
+	MojRefCountedPtr<UidSearchResponseParser>		m_unreadCountParser;
 	
 	std::vector<UID>	m_allUIDs, m_deletedUIDs, m_unseenUIDs, m_answeredUIDs, m_flaggedUIDs;
 
+	// Changes since the last sync, for incremental sync
+	SyncEngine::ChangeList	m_remoteChanges;
+	UIDRangeSet				m_vanishedUIDs;
+
 	std::deque<UID>		m_pendingHeaders;
 
+	// Adjusts the header batch size based on fetch and put latency
+	boost::scoped_ptr<BatchSizeTuner>	m_batchSizeTuner;
+
+	// Headers fetched while the previous batch was still being saved
+	MojObject::ObjectVec	m_fetchedEmails;
+	bool				m_hasFetchedEmails;
+
+	bool				m_putInProgress;
+	int					m_putCount;
+
+	// Start times for the current fetch and put, in milliseconds
+	MojInt64			m_fetchStartTime;
+	MojInt64			m_putStartTime;
+
 	SyncParams			m_syncParams;
 
 	MojSignal<>::Slot<SyncEmailsCommand>		m_syncLocalChangesSlot;
 	ImapResponseParser::DoneSignal::Slot<SyncEmailsCommand>	m_searchResponseSlot;
+	ImapResponseParser::DoneSignal::Slot<SyncEmailsCommand>	m_changedSinceResponseSlot;
 	ImapResponseParser::DoneSignal::Slot<SyncEmailsCommand>	m_fetchResponseSlot;
 	MojDbClient::Signal::Slot<SyncEmailsCommand> m_getLocalEmailsResponseSlot;
 	MojDbClient::Signal::Slot<SyncEmailsCommand> m_putEmailsResponseSlot;
 	MojDbClient::Signal::Slot<SyncEmailsCommand> m_deleteLocalEmailsResponseSlot;
 	MojDbClient::Signal::Slot<SyncEmailsCommand> m_mergeFlagsResponseSlot;
+	MojDbClient::Signal::Slot<SyncEmailsCommand> m_updateFolderStateSlot;
 	MojSignal<>::Slot<SyncEmailsCommand>		m_autoDownloadSlot;
 };
 
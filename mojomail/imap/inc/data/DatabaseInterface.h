@@ -22,6 +22,7 @@
 #include "db/MojDbClient.h"
 #include "data/ImapAccountAdapter.h"
 #include "ImapCoreDefs.h"
+#include <vector>
 
 class DatabaseInterface
 {
@@ -36,6 +37,7 @@ public:
 	virtual void GetById(Signal::SlotRef slot, const MojObject& id) = 0;
 	virtual void GetByIds(Signal::SlotRef slot, const MojObject::ObjectVec& ids) = 0;
 	virtual void GetEmail(Signal::SlotRef slot, const MojObject& folderId, UID uid) = 0;
+	virtual void GetEmailsByUID(Signal::SlotRef slot, const MojObject& folderId, const std::vector<UID>& uids) = 0;
 
 	virtual void CreateFolders(Signal::SlotRef slot, const MojObject::ObjectVec& array) = 0;
 	virtual void ReserveIds(Signal::SlotRef slot, MojUInt32 num) = 0;
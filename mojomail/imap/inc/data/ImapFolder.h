@@ -37,6 +37,21 @@ public:
 	const std::string& GetDelimiter() const { return m_delimiter; }
 	UID GetUIDValidity() const { return m_uidValidity; }
 
+	// HIGHESTMODSEQ as of the last successful sync (RFC 7162); zero if unknown
+	void SetHighestModSeq(MojUInt64 modSeq) { m_highestModSeq = modSeq; }
+	MojUInt64 GetHighestModSeq() const { return m_highestModSeq; }
+
+	// Sync window (SINCE date and max emails) in effect when the HIGHESTMODSEQ was saved.
+	// The date is empty if there was no SINCE limit.
+	void SetModSeqSyncWindow(const std::string& sinceDate, int maxEmails) { m_modSeqSinceDate = sinceDate; m_modSeqMaxEmails = maxEmails; }
+	const std::string& GetModSeqSinceDate() const { return m_modSeqSinceDate; }
+	int GetModSeqMaxEmails() const { return m_modSeqMaxEmails; }
+
+	// Number of unread emails in the whole folder on the server, including emails outside the
+	// sync window, for the unread badge; -1 if unknown
+	void SetServerUnreadCount(int count) { m_serverUnreadCount = count; }
+	int GetServerUnreadCount() const { return m_serverUnreadCount; }
+
 	void SetSelectable(bool selectable) { m_selectable = selectable; }
 	bool IsSelectable() const { return m_selectable; }
 
@@ -57,6 +72,10 @@ protected:
 	std::string m_delimiter;
 	UID			m_uidValidity;
 	UID			m_uidNext;
+	MojUInt64	m_highestModSeq;
+	std::string	m_modSeqSinceDate;
+	int			m_modSeqMaxEmails;
+	int			m_serverUnreadCount;
 
 	bool		m_selectable;
 	std::string	m_xlistType;	// not persisted
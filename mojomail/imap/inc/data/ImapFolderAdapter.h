@@ -34,6 +34,10 @@ public:
 	static const char* const	SELECTABLE;
 	static const char* const	LAST_SYNC_REV;
 	static const char* const	UIDVALIDITY;
+	static const char* const	HIGHEST_MODSEQ;
+	static const char* const	MODSEQ_SINCE_DATE;
+	static const char* const	MODSEQ_MAX_EMAILS;
+	static const char* const	SERVER_UNREAD_COUNT;
 
 	// Get data from MojoDB and turn them into email Folder
 	static void		ParseDatabaseObject(const MojObject& obj, ImapFolder& folder);
@@ -31,6 +31,7 @@ public:
 	void GetById(Signal::SlotRef slot, const MojObject& id);
 	void GetByIds(Signal::SlotRef slot, const MojObject::ObjectVec& ids);
 	void GetEmail(Signal::SlotRef slot, const MojObject& folderId, UID uid);
+	void GetEmailsByUID(Signal::SlotRef slot, const MojObject& folderId, const std::vector<UID>& uids);
 
 	void CreateFolders(Signal::SlotRef slot, const MojObject::ObjectVec& array);
 	void ReserveIds(Signal::SlotRef slot, MojUInt32 num);
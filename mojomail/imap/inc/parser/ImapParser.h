@@ -27,7 +27,6 @@
 #include <vector>
 #include "core/MojRefCount.h"
 #include "parser/ParserTypes.h"
-#include <locale>
 
 class CallStackEntry;
 class Rfc3501Tokenizer;
@@ -57,7 +56,6 @@ protected:
 	TokenType GetTokenType() const;
 	
 	static void initialize();
-	static void BuildTokenTypeMap();
 	
 	Rfc3501Tokenizer*	m_tokenizer;
 	SemanticActions*	m_semantic;
@@ -65,11 +63,8 @@ protected:
 	std::stack<CallStackEntry> m_callStack;
 	
 	static bool s_initialized;
-	static const std::locale& s_classicLocale;
 	
 	static Symbol* symbols[];
-	static std::map<std::string, TokenType> s_tokenMap;
-	static std::vector< std::pair<std::string, TokenType> > s_tokenList;
 };
 
 class CallStackEntry {
@@ -38,6 +38,7 @@ enum TokenType {
 	, TK_HEADER_DOT_FIELDS_DOT_NOT
 	, TK_INTERNALDATE
 	, TK_MIME
+	, TK_MODSEQ
 	, TK_NIL
 	, TK_RFC822
 	, TK_RFC822_DOT_HEADER
@@ -0,0 +1,149 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#ifndef PARSERARENA_H_
+#define PARSERARENA_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+/**
+ * Bump allocator for the objects built while parsing a batch of FETCH responses
+ * (emails, parts, address lists).
+ *
+ * Objects are created with boost::allocate_shared and an ArenaAllocator. Each
+ * object's shared_ptr control block keeps a reference to the arena's memory,
+ * so individual frees are no-ops and the memory is released in one step once
+ * the parser and every object allocated from it are gone.
+ */
+class ParserArena
+{
+public:
+	// Size of each block requested from the heap
+	static const size_t BLOCK_SIZE = 16 * 1024;
+
+	// Allocations bigger than this get their own heap block
+	static const size_t MAX_SMALL_ALLOCATION = BLOCK_SIZE / 4;
+
+	struct Stats
+	{
+		Stats() : numAllocations(0), bytesAllocated(0), numBlocks(0), bytesReserved(0) {}
+
+		size_t	numAllocations;		// allocations served from the arena
+		size_t	bytesAllocated;		// bytes handed out, including alignment padding
+		size_t	numBlocks;			// heap allocations made by the arena
+		size_t	bytesReserved;		// bytes requested from the heap
+	};
+
+	ParserArena();
+	virtual ~ParserArena();
+
+	void* Allocate(size_t size);
+
+	// Starts over with an empty arena. If nothing allocated from the arena is
+	// still alive, the current block is kept and reused instead of freed.
+	void Reset();
+
+	const Stats& GetStats() const { return m_storage->m_stats; }
+
+protected:
+	template<typename T> friend class ArenaAllocator;
+
+	class Storage
+	{
+	public:
+		Storage();
+		~Storage();
+
+		void* Allocate(size_t size);
+
+		// Frees all blocks except the current one, which is rewound
+		void Reset();
+
+		Stats				m_stats;
+
+	protected:
+		std::vector<char*>	m_blocks;
+		char*				m_next;
+		size_t				m_remaining;
+
+	private:
+		Storage(const Storage&);
+		Storage& operator=(const Storage&);
+	};
+
+	boost::shared_ptr<Storage>	m_storage;
+};
+
+/**
+ * Standard allocator interface on top of a ParserArena, for use with boost::allocate_shared.
+ */
+template<typename T>
+class ArenaAllocator
+{
+public:
+	typedef T				value_type;
+	typedef T*				pointer;
+	typedef const T*		const_pointer;
+	typedef T&				reference;
+	typedef const T&		const_reference;
+	typedef size_t			size_type;
+	typedef ptrdiff_t		difference_type;
+
+	template<typename U>
+	struct rebind
+	{
+		typedef ArenaAllocator<U> other;
+	};
+
+	explicit ArenaAllocator(const ParserArena& arena) : m_storage(arena.m_storage) {}
+
+	template<typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) : m_storage(other.m_storage) {}
+
+	pointer allocate(size_type n, const void* hint = 0)
+	{
+		return static_cast<pointer>( m_storage->Allocate(n * sizeof(T)) );
+	}
+
+	// Memory is released along with the arena
+	void deallocate(pointer p, size_type n) {}
+
+	size_type max_size() const { return size_type(-1) / sizeof(T); }
+
+	void construct(pointer p, const T& value) { new(p) T(value); }
+	void destroy(pointer p) { p->~T(); }
+
+	pointer address(reference r) const { return &r; }
+	const_pointer address(const_reference r) const { return &r; }
+
+	template<typename U>
+	bool operator==(const ArenaAllocator<U>& other) const { return m_storage == other.m_storage; }
+
+	template<typename U>
+	bool operator!=(const ArenaAllocator<U>& other) const { return m_storage != other.m_storage; }
+
+protected:
+	template<typename U> friend class ArenaAllocator;
+
+	boost::shared_ptr<ParserArena::Storage>	m_storage;
+};
+
+#endif /* PARSERARENA_H_ */
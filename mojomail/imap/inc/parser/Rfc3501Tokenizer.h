@@ -25,6 +25,7 @@
 #define RFC3501TOKENIZER_H_
 
 #include <string.h>
+#include "core/MojCoreDefs.h"
 #include "core/MojRefCount.h"
 #include "parser/Parser.h"
 
@@ -41,6 +42,9 @@ public:
 
 /*
  * This is a tokenizer to be used when parsing responses as specified in rfc3501.
+ *
+ * Tokens are kept as offsets into the buffer; value() only copies the token
+ * into a string when someone actually needs one.
  */
 class Rfc3501Tokenizer : public MojRefCounted
 {
@@ -64,6 +68,7 @@ public:
 		bytesNeeded = -1;
 		chars.assign(str);
 		len = chars.size();
+		clearToken();
 	}
 
 	inline void append(const std::string& str) {
@@ -81,9 +86,20 @@ public:
 	}
 
 	inline const std::string& value() const {
+		if (!tokenValid)
+			materializeToken();
 		return token;
 	}
 
+	// Raw token text in the buffer. Quoted strings may still contain escapes.
+	inline const char* data() const {
+		return chars.data() + pos + tokenOffset;
+	}
+
+	inline size_t size() const {
+		return tokenLength;
+	}
+
 	// Get the text in the buffer
 	const std::string& getAllText() const {
 		return chars;
@@ -99,11 +115,26 @@ public:
 		return chars.substr(cp);
 	}
 
-	bool numberValue(long int& result);
+	bool numberValue(long int& result) const;
 
-	std::string valueUpper();
+	// Parse the token as an unsigned decimal number; fails on overflow
+	bool numberValue(MojUInt32& result) const;
 
-	bool match(const std::string& strchr);
+	// Parse the token as a 64-bit unsigned number, e.g. a MODSEQ value
+	bool numberValue(MojUInt64& result) const;
+
+	std::string valueUpper() const;
+
+	bool match(const std::string& str) const {
+		return tokenType == TK_TEXT && equalsIgnoreCase(str.data(), str.size());
+	}
+
+	bool match(const char* str) const {
+		return tokenType == TK_TEXT && equalsIgnoreCase(str, strlen(str));
+	}
+
+	// Case-insensitive (ASCII) comparison with the token, regardless of token type
+	bool equalsIgnoreCase(const char* str, size_t length) const;
 
 	TokenType next();
 
@@ -113,6 +144,25 @@ public:
 	bool needsLiteralBytes() { return bytesNeeded >= 0; }
 	int getBytesNeeded() { return bytesNeeded; }
 
+	// Character classes
+	enum {
+		CHAR_ATOM_SPECIAL	= 1 << 0,	// ends an atom
+		CHAR_DIGIT			= 1 << 1,
+		CHAR_QUOTED_SPECIAL	= 1 << 2	// needs handling inside a quoted string
+	};
+
+	static inline bool isAtomSpecial(char c) {
+		return s_charClass[(unsigned char) c] & CHAR_ATOM_SPECIAL;
+	}
+
+	static inline bool isDigit(char c) {
+		return s_charClass[(unsigned char) c] & CHAR_DIGIT;
+	}
+
+	static inline char toUpperAscii(char c) {
+		return (c >= 'a' && c <= 'z') ? (c - 'a' + 'A') : c;
+	}
+
 	static const std::string KEYWORD_BODYSTRUCTURE;
 	static const std::string KEYWORD_ENVELOPE;
 	static const std::string KEYWORD_EXISTS;
@@ -125,18 +175,45 @@ public:
 	static const std::string NAMESPACE_STRING;
 
 public:
-	std::string token;
 	TokenType tokenType;
 
 protected:
 	TokenType throwError(const char* msg);
-	static bool isAtomSpecial(char c);
+
+	inline TokenType setToken(TokenType type, int offset, int length, bool escaped = false) {
+		tokenType = type;
+		tokenOffset = offset;
+		tokenLength = length;
+		tokenEscaped = escaped;
+		tokenValid = false;
+		return type;
+	}
+
+	inline void clearToken() {
+		tokenOffset = 0;
+		tokenLength = 0;
+		tokenEscaped = false;
+		tokenValid = false;
+	}
+
+	void materializeToken() const;
+
+	static const unsigned char s_charClass[256];
 
 	std::string chars;
 	int pos;
 	int len;
 	int cp;
 
+	// Current token, relative to pos so it survives compact()
+	int tokenOffset;
+	int tokenLength;
+	bool tokenEscaped;
+
+	// Copy of the token made by value()
+	mutable std::string token;
+	mutable bool tokenValid;
+
 	std::string m_error;
 	bool brace_is_token;
 	int bytesNeeded;
@@ -19,20 +19,37 @@
 #ifndef SEMANTICACTIONS_H_
 #define SEMANTICACTIONS_H_
 
+#include "ImapCoreDefs.h"
 #include "data/CommonData.h"
 #include "data/Email.h"
 #include "stream/BaseOutputStream.h"
 #include "exceptions/Rfc3501ParseException.h"
+#include "parser/ParserArena.h"
 
 #include <vector>
 #include <string>
 #include <stack>
+#include <utility>
 #include <boost/scoped_ptr.hpp>
+#include <boost/make_shared.hpp>
 
 class ImapEmail;
 class Rfc3501Tokenizer;
 class ByteBufferOutputStream;
 
+/**
+ * Supplies a separate output stream for each BODY[section] literal in a fetch
+ * response, so that a single FETCH can download several parts of several emails.
+ */
+class PartOutputStreamFactory
+{
+public:
+	virtual ~PartOutputStreamFactory() {}
+
+	// Returns the stream for the given part, or NULL to discard the data
+	virtual OutputStreamPtr GetPartOutputStream(UID uid, const std::string& section) = 0;
+};
+
 enum StringType {
 	ST_Null,
 	ST_Quoted,
@@ -43,16 +60,21 @@ enum StringType {
 class SemanticActions {
 public:
 	SemanticActions(Rfc3501Tokenizer& tokenizer);
+
+	// Allocate emails, parts and addresses from the given arena
+	SemanticActions(Rfc3501Tokenizer& tokenizer, const ParserArena& arena);
 	virtual ~SemanticActions();
 	
 	unsigned int GetMsgNum() const { return m_msgNum; }
 	const boost::shared_ptr<ImapEmail> GetEmail() const { return m_emailStack.top().m_email; }
 	bool GetFlagsUpdated() const { return m_flagsUpdated; }
+	MojUInt64 GetModSeq() const { return m_modSeq; }
 
 	bool	ExpectingBinaryData() const { return m_expectBinaryData; }
 	size_t	ExpectedDataLength() const { return m_binaryDataLength; }
 
 	void SetBodyOutputStream(const OutputStreamPtr& os) { m_bodyOutputStream = os; }
+	void SetPartOutputStreamFactory(PartOutputStreamFactory* factory) { m_partStreamFactory = factory; }
 	const OutputStreamPtr&	GetCurrentOutputStream() const { return m_currentOutputStream; }
 
 	// These are the semantic actions that the parser calls
@@ -73,6 +95,7 @@ public:
 	void zeroPartWorkaround();
 
 	void setSection();
+	void appendSectionPart();
 	void setHeadersSection();
 
 	void beginNestedEmail(void);
@@ -96,6 +119,7 @@ public:
 	void setMimeSubtypeRfc822(void);
 
 	void beginFlags(void);
+	void saveModSeq(void);
 	void keywordFlagAtom(void);
 	void systemFlagAtom(void);
 
@@ -205,6 +229,8 @@ protected:
 		return m_currentPart;
 	}
 
+	void Init();
+
 	// Create a part and add it as a subpart of the current multipart container
 	void CreatePart();
 
@@ -220,6 +246,27 @@ protected:
 
 	Rfc3501Tokenizer& m_tokenizer;
 
+	// Create an object from the arena
+	template<typename T>
+	boost::shared_ptr<T> Create()
+	{
+		return boost::allocate_shared<T>(ArenaAllocator<T>(m_arena));
+	}
+
+	template<typename T, typename A1>
+	boost::shared_ptr<T> Create(const A1& a1)
+	{
+		return boost::allocate_shared<T>(ArenaAllocator<T>(m_arena), a1);
+	}
+
+	template<typename T, typename A1, typename A2>
+	boost::shared_ptr<T> Create(const A1& a1, const A2& a2)
+	{
+		return boost::allocate_shared<T>(ArenaAllocator<T>(m_arena), a1, a2);
+	}
+
+	ParserArena	m_arena;
+
 	// Temporary parser values
 	StringType	m_stringType;
 	std::string	m_stringValue;
@@ -239,6 +286,9 @@ protected:
 
 	bool m_flagsUpdated;
 
+	// MODSEQ from the FETCH response, or 0 if not present
+	MojUInt64 m_modSeq;
+
 	enum SectionType
 	{
 		Section_None,
@@ -248,9 +298,18 @@ protected:
 
 	SectionType m_sectionType;
 
+	// Section number of the current BODY[section], e.g. "1.2"
+	std::string m_sectionName;
+
 	OutputStreamPtr m_currentOutputStream;
 	OutputStreamPtr m_bodyOutputStream;
 	MojRefCountedPtr<ByteBufferOutputStream> m_bufferOutputStream;
+
+	PartOutputStreamFactory*	m_partStreamFactory;
+
+	// Parts received before the UID; written out once the whole response is parsed
+	bool m_deferBodyData;
+	std::vector< std::pair<std::string, std::string> > m_deferredBodies;
 };
 
 #endif /*SEMANTICACTIONS_H_*/
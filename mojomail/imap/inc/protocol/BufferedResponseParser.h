@@ -25,8 +25,11 @@ class TokenBuffer;
 
 class BufferedResponseParser : public ImapResponseParser
 {
-	static const unsigned int MAX_LITERAL_SIZE = 1024;
-	static const unsigned int MAX_LINE_LENGTH = 1024 * 1024; // 1 MB
+	// Upper bound on a complete response, including any literals
+	static const unsigned int MAX_RESPONSE_SIZE = 16 * 1024 * 1024; // 16 MB
+
+	// Buffers that grew beyond this are released after each response
+	static const unsigned int MAX_RETAINED_CAPACITY = 64 * 1024; // 64 KB
 
 public:
 	BufferedResponseParser(ImapSession& session, DoneSignal::SlotRef doneSlot);
@@ -0,0 +1,56 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#ifndef CHANGEDSINCERESPONSEPARSER_H_
+#define CHANGEDSINCERESPONSEPARSER_H_
+
+#include "ImapCoreDefs.h"
+#include "protocol/ImapResponseParser.h"
+#include "sync/SyncEngine.h"
+#include "sync/UIDRangeSet.h"
+#include <vector>
+
+class Rfc3501Tokenizer;
+
+/**
+ * Parses the response to "UID FETCH 1:* (FLAGS) (CHANGEDSINCE n VANISHED)" (RFC 7162).
+ *
+ * Collects the flags of every message that changed, and the UIDs reported by
+ * "* VANISHED (EARLIER) uid-set".
+ */
+class ChangedSinceResponseParser : public ImapResponseParser
+{
+public:
+	ChangedSinceResponseParser(ImapSession& session, DoneSignal::SlotRef doneSlot,
+			SyncEngine::ChangeList& changes, UIDRangeSet& vanishedUIDs);
+	virtual ~ChangedSinceResponseParser();
+
+	bool HandleUntaggedResponse(const std::string& line);
+
+	// Highest MODSEQ of the changed messages, or 0 if there weren't any
+	MojUInt64 GetHighestModSeq() const { return m_highestModSeq; }
+
+protected:
+	void ParseFlags(Rfc3501Tokenizer& t, SyncEngine::RemoteChange& change);
+
+	SyncEngine::ChangeList&	m_changes;
+	UIDRangeSet&			m_vanishedUIDs;
+	MojUInt64				m_highestModSeq;
+};
+
+#endif /* CHANGEDSINCERESPONSEPARSER_H_ */
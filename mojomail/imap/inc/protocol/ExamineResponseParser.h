@@ -35,9 +35,18 @@ public:
 	// Get the UIDVALIDITY for the folder
 	UID		GetUIDValidity() const { return m_uidValidity; }
 
+	// Get the HIGHESTMODSEQ for the folder, or 0 if the folder doesn't support mod sequences
+	MojUInt64	GetHighestModSeq() const { return m_highestModSeq; }
+
+	// Whether the server confirmed an ENABLE QRESYNC sent ahead of the select
+	bool	IsQResyncEnabled() const { return m_qresyncEnabled; }
+
 protected:
 	int		m_exists;
 	UID		m_uidValidity;
+
+	MojUInt64	m_highestModSeq;
+	bool		m_qresyncEnabled;
 };
 
 #endif /*EXAMINERESPONSEPARSER_H_*/
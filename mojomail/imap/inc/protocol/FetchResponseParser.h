@@ -24,22 +24,27 @@
 #include <vector>
 #include "data/CommonData.h"
 #include "stream/BaseOutputStream.h"
+#include "parser/ParserArena.h"
 
 class Rfc3501Tokenizer;
 class ImapParser;
 class SemanticActions;
 class ImapEmail;
+class PartOutputStreamFactory;
 
 // Represents a fetch response, possibly a new email or a flag update or body part
 struct FetchUpdate
 {
-	FetchUpdate(unsigned int msgNum, const boost::shared_ptr<ImapEmail> &email, bool flagsUpdated)
-	: msgNum(msgNum), email(email), flagsUpdated(flagsUpdated) {}
+	FetchUpdate(unsigned int msgNum, const boost::shared_ptr<ImapEmail> &email, bool flagsUpdated, MojUInt64 modSeq = 0)
+	: msgNum(msgNum), email(email), flagsUpdated(flagsUpdated), modSeq(modSeq) {}
 
 	unsigned int msgNum;
 	boost::shared_ptr<ImapEmail> email;
 
 	bool flagsUpdated;
+
+	// MODSEQ reported with the fetch (CONDSTORE), or 0 if not present
+	MojUInt64 modSeq;
 };
 
 class FetchResponseParser : public ImapResponseParser
@@ -52,27 +57,46 @@ public:
 	
 	void SetPartOutputStream(const OutputStreamPtr& outputStream);
 
+	// Use a separate stream for each part in the response; the factory must outlive the parser
+	// or be cleared with SetPartOutputStreamFactory(NULL)
+	void SetPartOutputStreamFactory(PartOutputStreamFactory* factory);
+
 	bool HandleUntaggedResponse(const std::string& line);
 	bool HandleAdditionalData();
 	
 	const std::vector<FetchUpdate>&	GetUpdates() const { return m_emails; }
 
+	// Discards the updates parsed so far so the parser can be reused for
+	// another response. Must not be called while reading a literal.
+	void Reset();
+
+	// Allocation counters for the objects parsed so far
+	const ParserArena::Stats& GetArenaStats() const { return m_arena.GetStats(); }
+	void Status(MojObject& status) const;
+
 protected:
 	// Parse the current token buffer. Returns true if it needs more data.
 	bool Parse();
 	void RequestMoreData();
 	bool SkipRestOfResponse();
 
+	static bool IsFetchResponse(const std::string& line);
+
 	boost::scoped_ptr<Rfc3501Tokenizer> m_tokenizer;
 	boost::scoped_ptr<SemanticActions>	m_semantic;
 	boost::scoped_ptr<ImapParser>		m_imapParser;
 
 	OutputStreamPtr						m_partOutputStream;
+	PartOutputStreamFactory*			m_partStreamFactory;
 	size_t								m_literalBytesRemaining;
 
 	std::vector<FetchUpdate>			m_emails;
 
 	bool								m_recoveringFromError;
+
+	// Emails, parts and addresses for all responses are allocated from here
+	ParserArena							m_arena;
+	int									m_numResponses;
 };
 
 #endif /*FETCHRESPONSEPARSER_H_*/
@@ -59,6 +59,10 @@ public:
 
 	virtual void HandleError(const std::exception& e);
 
+	// Tag of the request this parser is handling, e.g. "~A1"
+	void SetTag(const std::string& tag) { m_tag = tag; }
+	const std::string& GetTag() const { return m_tag; }
+
 	/**
 	 * Splits a string on the first space.
 	 */
@@ -84,6 +88,7 @@ protected:
 	
 	ImapStatusCode	m_status;
 	std::string		m_responseLine;
+	std::string		m_tag;
 	DoneSignal		m_doneSignal;
 	ContinuationSignal m_continuationSignal;
 };
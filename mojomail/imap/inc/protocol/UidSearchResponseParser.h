@@ -21,21 +21,74 @@
 
 #include "ImapCoreDefs.h"
 #include "protocol/ImapResponseParser.h"
+#include <string>
 #include <vector>
 
+class Capabilities;
+
+/**
+ * Parses the results of a UID SEARCH, either as a plain "* SEARCH 1 2 3" response
+ * or as an RFC 4731 "* ESEARCH (TAG "~A1") UID ALL 1:3" response.
+ *
+ * A search that only needs the number of results can be sent with RETURN (COUNT),
+ * in which case the server doesn't send the UIDs at all.
+ */
 class UidSearchResponseParser : public ImapResponseParser
 {
 public:
+	// Result options for SEARCH RETURN (...), used if the server supports ESEARCH
+	enum ReturnOption
+	{
+		RETURN_ALL,
+		RETURN_COUNT
+	};
+
+	UidSearchResponseParser(ImapSession& session, std::vector<UID>& uidList);
 	UidSearchResponseParser(ImapSession& session, DoneSignal::SlotRef doneSlot, std::vector<UID>& uidList);
+
+	// Only counts the results
+	UidSearchResponseParser(ImapSession& session);
 	virtual ~UidSearchResponseParser();
 	
 	bool HandleUntaggedResponse(const std::string& line);
 	void HandleResponse(ImapStatusCode status, const std::string& response);
+
+	// Number of results, or -1 if the results haven't been received yet
+	int GetCount() const { return m_count; }
 	
 	static bool ParseUids(const std::string& line, std::vector<UID>& uids);
+
+	/**
+	 * Gets the tag from the search correlator at the start of the data after "ESEARCH",
+	 * e.g. (TAG "~A1"). Returns false if the response doesn't have one.
+	 */
+	static bool ParseEsearchTag(const std::string& line, std::string& tag);
+
+	/**
+	 * Parses the data after "ESEARCH". UIDs from ALL are appended to uids.
+	 * If the response has a COUNT, it's stored in count; otherwise count isn't changed.
+	 * Returns false if the response isn't valid.
+	 */
+	static bool ParseEsearch(const std::string& line, std::vector<UID>& uids, int& count);
+
+	/**
+	 * Builds a UID SEARCH command for the given criteria.
+	 * On servers with ESEARCH, asks for the results as a sequence set with RETURN (ALL),
+	 * or just the number of results with RETURN (COUNT).
+	 * Otherwise, falls back to a plain UID SEARCH, which always returns every UID.
+	 */
+	static std::string BuildSearchCommand(const Capabilities& caps, const std::string& criteria, ReturnOption returnOption = RETURN_ALL);
 	
 protected:
-	std::vector<UID>&	m_uidList;
+	// NULL if only the count is needed
+	std::vector<UID>*	m_uidList;
+	int					m_count;
+
+	// Whether we've already received the untagged SEARCH response for this request.
+	// Plain SEARCH responses don't say which request they're for, so if multiple searches
+	// are pipelined, each parser claims the first result it sees. ESEARCH responses are
+	// matched by tag instead.
+	bool				m_gotResults;
 };
 
 #endif /*UIDSEARCHRESPONSEPARSER_H_*/
@@ -21,10 +21,20 @@
 
 #include "protocol/ImapResponseParser.h"
 #include "protocol/FetchResponseParser.h"
+#include "commands/HandleUpdateCommand.h"
+#include "util/Timer.h"
+#include <deque>
 
-class HandleUpdateCommand;
 class ImapCommandResult;
 
+/**
+ * Handles unsolicited EXISTS, EXPUNGE, FETCH and VANISHED responses.
+ *
+ * Flag changes and deletions are collected for a short time, or until the
+ * next tagged response, and then written to the database by a single
+ * HandleUpdateCommand. Bulk actions on the server, like marking a folder
+ * read, send one untagged response per message.
+ */
 class UntaggedUpdateParser : public ImapResponseParser
 {
 public:
@@ -33,9 +43,33 @@ public:
 
 	bool HandleUntaggedResponse(const std::string& line);
 
+	// Starts writing any collected updates to the database
+	void FlushUpdates();
+
+	// How long to wait for more updates before writing them
+	static const unsigned int UPDATE_WINDOW_MILLIS = 250;
+
+	// Write the updates right away once there's this many waiting
+	static const size_t MAX_PENDING_UPDATES = 1000;
+
 protected:
+	// Collected updates for one folder
+	struct PendingUpdates
+	{
+		MojObject						folderId;
+		HandleUpdateCommand::UpdateMap	updates;
+	};
+
+	void AddUpdate(const MojObject& folderId, UID uid, bool deleted, const MojObject& newFlags);
+	void UpdateWindowExpired();
+	void RunNextUpdateCommand();
+
 	MojErr UpdateCommandResponse();
 
+	std::deque<PendingUpdates>				m_pendingUpdates;
+	size_t									m_numPendingUpdates;
+	Timer<UntaggedUpdateParser>				m_updateWindowTimer;
+
 	MojRefCountedPtr<HandleUpdateCommand>	m_handleUpdateCommand;
 	MojRefCountedPtr<ImapCommandResult>		m_result;
 
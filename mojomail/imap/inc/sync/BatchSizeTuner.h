@@ -0,0 +1,65 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#ifndef BATCHSIZETUNER_H_
+#define BATCHSIZETUNER_H_
+
+#include "core/MojCoreDefs.h"
+
+/**
+ * Picks the number of headers to request per UID FETCH during a sync.
+ *
+ * Small batches waste most of their time waiting on the network round trip;
+ * large batches on a slow link (or a busy database) delay progress and make
+ * each db8 put block other clients for longer. The tuner starts from the
+ * configured batch size, doubles it while batches complete quickly, and
+ * halves it when either the fetch or the database put gets too slow.
+ */
+class BatchSizeTuner
+{
+public:
+	// Batches that complete faster than this are dominated by round trip latency
+	static const MojInt64 FAST_BATCH_MILLIS = 1000;
+
+	// Fetches or puts that take longer than this mean the batch is too big
+	static const MojInt64 SLOW_BATCH_MILLIS = 4000;
+
+	BatchSizeTuner(int initialSize, int minSize, int maxSize);
+	virtual ~BatchSizeTuner();
+
+	int GetBatchSize() const { return m_batchSize; }
+
+	// Report how long it took to fetch a batch of headers from the server
+	void FetchComplete(int numHeaders, MojInt64 millis);
+
+	// Report how long it took to write a batch of emails to the database
+	void PutComplete(int numEmails, MojInt64 millis);
+
+protected:
+	void Grow();
+	void Shrink();
+
+	int			m_batchSize;
+	int			m_minSize;
+	int			m_maxSize;
+
+	// Duration of the most recent database put, or -1 if none yet
+	MojInt64	m_lastPutMillis;
+};
+
+#endif /* BATCHSIZETUNER_H_ */
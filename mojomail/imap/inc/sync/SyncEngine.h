@@ -23,14 +23,40 @@
 #include <vector>
 #include "core/MojObject.h"
 #include "data/ImapEmail.h"
+#include "sync/UIDFlagTable.h"
+#include "sync/UIDRangeSet.h"
 
 class SyncEngine {
 	typedef std::vector<UID> UIDList;
 
 public:
+	// Server state of a message that changed since the last sync
+	struct RemoteChange
+	{
+		RemoteChange(UID uid) : uid(uid), deleted(false) {}
+
+		bool operator<(const RemoteChange& other) const { return uid < other.uid; }
+
+		UID uid;
+		EmailFlags flags;
+		bool deleted;
+	};
+
+	typedef std::vector<RemoteChange> ChangeList;
+
 	SyncEngine(const UIDList& sortedRemote, const UIDList& sortedDeleted,
 			const UIDList& sortedUnseen, const UIDList& sortedAnswered,
 			const UIDList& sortedFlagged);
+
+	/**
+	 * Incremental sync (RFC 7162 CONDSTORE/QRESYNC).
+	 * Only messages that changed or vanished since the last sync are known;
+	 * all other local emails are assumed to be unchanged.
+	 *
+	 * At most maxNewUIDs (newest first) are reported as new; zero means no limit.
+	 */
+	SyncEngine(const ChangeList& sortedChanges, const UIDRangeSet& vanished, unsigned int maxNewUIDs = 0);
+
 	virtual ~SyncEngine();
 
 	// Key info we need to sync in the email
@@ -44,17 +70,6 @@ public:
 		EmailFlags lastSyncFlags;
 	};
 
-	class UIDSet
-	{
-	public:
-		UIDSet(const UIDList& uidList);
-		inline bool Find(UID uid);
-
-	protected:
-		const UIDList& m_uidList;
-		UIDList::const_iterator m_it;
-	};
-
 	/**
 	 * Compares a batch of local email stubs with the remote UID lists.
 	 *
@@ -63,24 +78,47 @@ public:
 	 */
 	void Diff(const std::vector<EmailStub> &localBatch, bool hasMoreLocal);
 
+	bool IsIncremental() const { return m_incremental; }
+
+	// Incremental mode only: whether any local emails have been diffed so far
+	bool HasLocalEmails() const { return m_lastLocalUID > 0; }
+
 	/**
 	 * Clear the current list of new and deleted ids
 	 */
 	void Clear() { m_newUIDs.clear(); m_deletedIds.clear(); }
 
+	/**
+	 * Clear the deleted ids and modified flags once they've been saved,
+	 * keeping the new UIDs
+	 */
+	void ClearDeletedAndModified() { m_deletedIds.clear(); m_modifiedFlags.clear(); }
+
 	const std::vector<UID>&			GetNewUIDs() const		{ return m_newUIDs; }
 	const std::vector<MojObject>&	GetDeletedIds() const	{ return m_deletedIds; }
 	const std::vector< std::pair<EmailStub, EmailFlags> >&	GetModifiedFlags() const { return m_modifiedFlags; }
 
+	// Incremental mode only: UIDs of local emails still on the server, followed by new UIDs
+	const std::vector<UID>&			GetRemainingUIDs() const { return m_remainingUIDs; }
+
 protected:
-	// These must all be sorted
-	const UIDList&	m_remoteUIDs;
-	UIDSet			m_deletedUIDs;
-	UIDSet			m_unseenUIDs;
-	UIDSet			m_answeredUIDs;
-	UIDSet			m_flaggedUIDs;
-
-	UIDList::const_iterator m_remoteIt;
+	void DiffIncremental(const std::vector<EmailStub> &localBatch, bool hasMoreLocal);
+
+	static const ChangeList EMPTY_CHANGES;
+
+	bool			m_incremental;
+
+	// Remote UIDs and their flags. The caller doesn't need to keep the lists around.
+	UIDFlagTable			m_remoteTable;
+	UIDFlagTable::Iterator	m_remoteIt;
+
+	// Incremental mode
+	const ChangeList&			m_changes;
+	ChangeList::const_iterator	m_changeIt;
+	UIDRangeSet					m_vanishedUIDs;
+	UID							m_lastLocalUID;
+	unsigned int				m_maxNewUIDs;
+	std::vector<UID>			m_remainingUIDs;
 
 	std::vector<UID>		m_newUIDs;
 	std::vector<MojObject>	m_deletedIds;
@@ -0,0 +1,147 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#ifndef UIDFLAGTABLE_H_
+#define UIDFLAGTABLE_H_
+
+#include "ImapCoreDefs.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Compact table of server UIDs and their flags, used by the sync engine.
+ *
+ * UIDs are split into chunks by their upper 16 bits. A chunk with few UIDs
+ * stores a sorted array of the lower 16 bits plus a flag byte for each UID.
+ * Once a chunk fills up it switches to bitmaps: one for which UIDs exist
+ * and one per flag. Flags are applied to a bitmap chunk a word at a time.
+ *
+ * Iterating over the table returns UIDs in ascending order along with their
+ * flags, so the sync engine can diff against the local emails in one pass.
+ */
+class UIDFlagTable
+{
+public:
+	enum Flag
+	{
+		FLAG_DELETED	= 1 << 0,
+		FLAG_UNSEEN		= 1 << 1,
+		FLAG_ANSWERED	= 1 << 2,
+		FLAG_FLAGGED	= 1 << 3
+	};
+
+	static const unsigned int NUM_FLAGS = 4;
+
+	// Chunks with more UIDs than this are stored as bitmaps
+	static const unsigned int MAX_ARRAY_SIZE = 8192;
+
+	UIDFlagTable();
+	virtual ~UIDFlagTable();
+
+	// Add UIDs with no flags set. UIDs must be added in ascending order;
+	// anything lower than the last UID added is ignored.
+	void Add(UID uid);
+	void AddUIDs(const std::vector<UID>& sortedUIDs);
+
+	// Set a flag on each of the UIDs. UIDs that aren't in the table are ignored.
+	void SetFlag(const std::vector<UID>& sortedUIDs, Flag flag);
+
+	bool Contains(UID uid) const;
+
+	// Returns the flags for a UID, or 0 if it's not in the table
+	unsigned int GetFlags(UID uid) const;
+
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+
+	// Approximate number of bytes used to store the table
+	size_t GetMemoryUsage() const;
+
+	// All UIDs that share the same upper 16 bits
+	struct Chunk
+	{
+		Chunk(MojUInt32 key) : key(key), count(0) {}
+
+		bool IsBitmap() const { return !bitmaps.empty(); }
+
+		// Switch from an array to bitmaps
+		void ConvertToBitmap();
+
+		// Bitmap for presence (index 0) or a flag (index 1 + flag bit)
+		uint64_t* GetBitmap(unsigned int index) { return &bitmaps[index * BITMAP_WORDS]; }
+		const uint64_t* GetBitmap(unsigned int index) const { return &bitmaps[index * BITMAP_WORDS]; }
+
+		static const unsigned int BITMAP_WORDS = 65536 / 64;
+
+		MojUInt32	key;
+		size_t		count;
+
+		// Array storage: sorted lower 16 bits of each UID, and the flags for each
+		std::vector<uint16_t>	lows;
+		std::vector<uint8_t>	flags;
+
+		// Bitmap storage: presence bitmap followed by one bitmap per flag
+		std::vector<uint64_t>	bitmaps;
+	};
+
+	// Walks the table in ascending order by UID
+	class Iterator
+	{
+	public:
+		Iterator(const UIDFlagTable& table);
+
+		bool AtEnd() const { return m_chunkIndex >= m_table.m_chunks.size(); }
+
+		UID GetUID() const { return m_uid; }
+		unsigned int GetFlags() const;
+
+		void Next();
+
+		// Go back to the first UID
+		void Reset();
+
+	protected:
+		void Seek(unsigned int position);
+
+		const UIDFlagTable&	m_table;
+		size_t				m_chunkIndex;
+
+		// Index into the array, or bit number in the bitmap
+		unsigned int		m_position;
+
+		UID					m_uid;
+	};
+
+protected:
+	typedef std::vector<Chunk> ChunkList;
+
+	const Chunk* FindChunk(MojUInt32 key) const;
+
+	// Sets the flag on UIDs in [begin, end), which are all in the given chunk
+	void SetChunkFlag(Chunk& chunk, std::vector<UID>::const_iterator begin, std::vector<UID>::const_iterator end, Flag flag);
+
+	ChunkList	m_chunks;
+	size_t		m_size;
+
+private:
+	// not copyable
+	UIDFlagTable(const UIDFlagTable&);
+	UIDFlagTable& operator=(const UIDFlagTable&);
+};
+
+#endif /* UIDFLAGTABLE_H_ */
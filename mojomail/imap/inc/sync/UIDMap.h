@@ -22,6 +22,16 @@
 #include "ImapCoreDefs.h"
 #include <vector>
 
+class UIDRangeSet;
+
+/**
+ * Maps message sequence numbers to UIDs for the tail of a folder.
+ *
+ * Removing a message only marks its slot as removed. A Fenwick tree over the
+ * present slots finds the slot for a message number in O(log n), so a burst of
+ * EXPUNGE responses doesn't have to shift the whole list each time. Removed
+ * slots are compacted away once they outnumber the present ones.
+ */
 class UIDMap
 {
 public:
@@ -30,14 +40,13 @@ public:
 	virtual ~UIDMap();
 	
 	// Returns the UID for a given message sequence number
-	inline UID GetUID(unsigned int num) {
-		if(!WithinRange(num))
-			return 0;
-
-		return m_uids[num - m_firstMsgNum];
-	}
+	UID GetUID(unsigned int num) const;
 	
-	const std::vector<UID>& GetUIDs() const { return m_uids; }
+	// Returns the UIDs in the map, in order by message number
+	const std::vector<UID>& GetUIDs();
+
+	// Number of messages in the map
+	unsigned int GetSize() const { return m_size; }
 
 	void GetMissingMsgNums(std::vector<unsigned int>& msgNums) const;
 
@@ -49,16 +58,59 @@ public:
 	// Remove a message number from the map
 	UID Remove(unsigned int num);
 
+	// Remove a message by UID (e.g. from a VANISHED response).
+	// Returns the message number, or 0 if it wasn't in the map.
+	unsigned int RemoveUID(UID uid);
+
+	// Remove a set of messages by UID in one pass. The UIDs that were in the map are
+	// appended to removedUIDs. Returns the number of messages removed from the folder,
+	// including ones older than the map; UIDs not in the folder aren't counted.
+	unsigned int RemoveUIDs(const UIDRangeSet& uids, std::vector<UID>& removedUIDs);
+
 	// Remove oldest messages when there's too many in the map
 	void ShrinkToSize(unsigned int maxSize);
 
 protected:
-	inline bool WithinRange(unsigned int num) {
-		return (num >= m_firstMsgNum && num - m_firstMsgNum < m_uids.size());
+	static const size_t NOT_FOUND = (size_t) -1;
+
+	inline bool WithinRange(unsigned int num) const {
+		return (num >= m_firstMsgNum && num - m_firstMsgNum < m_size);
 	}
 
-	// List of known UIDs, in order by seq num, starting at m_firstMsgNum
+	// Returns the slot of the nth (starting from 0) message in the map
+	size_t GetSlot(unsigned int index) const;
+
+	// Returns the slot holding the UID, or NOT_FOUND
+	size_t FindSlot(UID uid) const;
+
+	// Marks a slot as removed
+	void RemoveSlot(size_t slot);
+
+	// Appends a slot for a message
+	void AppendSlot(UID uid);
+
+	// Number of present slots before the given slot
+	unsigned int CountBefore(size_t slot) const;
+
+	// Rebuilds the slot list with only the present messages
+	void Compact();
+
+	// Rebuilds the Fenwick tree, with all slots present
+	void RebuildTree();
+
+	// UIDs in order by seq num, including removed slots. The first present
+	// slot is message number m_firstMsgNum.
 	std::vector<UID>	m_uids;
+
+	// Whether each slot is still in the map
+	std::vector<bool>	m_present;
+
+	// Fenwick tree counting present slots; m_tree[i] covers the slots
+	// (i - (i & -i), i], counting from 1.
+	std::vector<unsigned int>	m_tree;
+
+	// Number of present slots
+	unsigned int		m_size;
 	
 	// Lowest message sequence num stored in the map
 	// If all messages are in the map, the first message number is 1
@@ -0,0 +1,111 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#ifndef UIDRANGESET_H_
+#define UIDRANGESET_H_
+
+#include "ImapCoreDefs.h"
+#include <string>
+#include <vector>
+
+/**
+ * A set of UIDs stored as sorted, non-overlapping ranges.
+ *
+ * Mailboxes tend to have long runs of consecutive UIDs, so this is usually
+ * much smaller than a list of every UID. It reads and writes RFC 3501
+ * sequence sets ("1:5,7,10:12"), which keeps command lines short.
+ *
+ * Union, intersection and difference are linear in the number of ranges.
+ */
+class UIDRangeSet
+{
+public:
+	// Inclusive range of UIDs
+	struct Range
+	{
+		Range(UID first, UID last) : first(first), last(last) {}
+
+		bool operator==(const Range& other) const { return first == other.first && last == other.last; }
+
+		UID first;
+		UID last;
+	};
+
+	typedef std::vector<Range> RangeList;
+
+	UIDRangeSet();
+
+	// Create a set from a list of UIDs in any order
+	explicit UIDRangeSet(const std::vector<UID>& uids);
+
+	template<class InputIterator>
+	UIDRangeSet(const InputIterator& begin, const InputIterator& end)
+	{
+		for(InputIterator it = begin; it != end; ++it) {
+			Add(*it);
+		}
+	}
+
+	virtual ~UIDRangeSet();
+
+	// Add a single UID. Adding UIDs in ascending order is fastest.
+	void Add(UID uid);
+
+	// Add all UIDs from first to last, inclusive
+	void AddRange(UID first, UID last);
+
+	void Remove(UID uid);
+
+	bool Contains(UID uid) const;
+
+	bool empty() const { return m_ranges.empty(); }
+	void clear() { m_ranges.clear(); }
+
+	// Number of UIDs in the set
+	size_t size() const;
+
+	const RangeList& GetRanges() const { return m_ranges; }
+
+	// Append all UIDs to the list, in ascending order
+	void GetUIDs(std::vector<UID>& uids) const;
+
+	UIDRangeSet Union(const UIDRangeSet& other) const;
+	UIDRangeSet Intersection(const UIDRangeSet& other) const;
+	UIDRangeSet Difference(const UIDRangeSet& other) const;
+
+	bool operator==(const UIDRangeSet& other) const { return m_ranges == other.m_ranges; }
+	bool operator!=(const UIDRangeSet& other) const { return !(m_ranges == other.m_ranges); }
+
+	// Returns the set as an IMAP sequence set, e.g. "1:5,7"
+	std::string ToString() const;
+
+	/**
+	 * Parses an IMAP sequence set like "1:3,7" and adds the UIDs to the set.
+	 * Reversed ranges like "7:5" are allowed. Returns false if the string isn't
+	 * a valid sequence set; "*" isn't supported since it depends on the mailbox.
+	 */
+	static bool Parse(const std::string& str, UIDRangeSet& set);
+
+protected:
+	// Append a range that starts after every existing range, merging with the last one if adjacent
+	void AppendRange(UID first, UID last);
+
+	RangeList	m_ranges;
+};
+
+#endif /* UIDRANGESET_H_ */
@@ -33,6 +33,7 @@
 #include "activity/ActivityParser.h"
 #include "data/DatabaseAdapter.h"
 #include "client/CommandManager.h"
+#include "network/SocketConnection.h"
 
 ImapBusDispatcher::ImapBusDispatcher(ImapServiceApp& app)
 : BusClient(&app.GetService(), "com.palm.imap"),
@@ -606,6 +607,11 @@ void ImapBusDispatcher::Status(MojObject& status) const
 		err = status.put("networkStatusMonitor", monitorStatus);
 		ErrorToException(err);
 	}
+
+	MojObject hostStatus;
+	SocketConnection::HostStatus(hostStatus);
+	err = status.put("hosts", hostStatus);
+	ErrorToException(err);
 }
 
 MojErr ImapBusDispatcher::StatusRequest(MojServiceMessage* msg, MojObject& payload)
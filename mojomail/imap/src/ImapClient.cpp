@@ -28,6 +28,7 @@
 #include "client/FileCacheClient.h"
 #include "client/SyncSession.h"
 #include "client/PowerManager.h"
+#include "client/ImapConnectionPool.h"
 
 #include "commands/DeleteAccountCommand.h"
 #include "commands/DisableAccountCommand.h"
@@ -59,6 +60,7 @@ ImapClient::ImapClient(MojLunaService* service, ImapBusDispatcher* dispatcher, c
   m_accountIdString(AsJsonString(accountId)),
   m_log(s_log),
   m_commandManager(new CommandManager(CommandManager::DEFAULT_MAX_CONCURRENT_COMMANDS, true)),
+  m_connectionPool(new ImapConnectionPool(s_log)),
   m_state(State_NeedsAccountInfo),
   m_retryInterval(0),
   m_cleanupSessionCallbackId(0),
@@ -308,6 +310,10 @@ void ImapClient::UpdateAccount(const MojObject& accountId, const ActivityPtr& ac
 	if(!DisableAccountInProgress())
 	{
 		fprintf(stderr, "Updating Account from ImapClient \n\n");
+
+		// Don't reuse connections that were set up with the old settings
+		m_connectionPool->Clear();
+
 		m_activity = activity;
 		MojRefCountedPtr<UpdateAccountCommand> command(new UpdateAccountCommand(*this, m_activity, credentialsChanged));
 		m_commandManager->QueueCommand(command, false);
@@ -330,6 +336,8 @@ void ImapClient::DisableAccount(MojServiceMessage* msg, MojObject& payload)
 	{
 		SetState(State_TerminatingSessions);
 
+		m_connectionPool->Clear();
+
 		if(m_folderSessionMap.empty())
 		{
 			SetState(State_DisableAccount);
@@ -357,6 +365,7 @@ void ImapClient::DeleteAccount(MojServiceMessage* msg, MojObject& payload)
 	m_deleteAccountMsg = msg;
 	m_payload = payload;
 	SetState(State_DeleteAccount);
+	m_connectionPool->Clear();
 	CheckQueue();
 }
 
@@ -583,6 +592,11 @@ void ImapClient::Status(MojObject& status)
 	err = status.putString("clientState", GetStateName(m_state));
 	ErrorToException(err);
 
+	MojObject connectionPoolStatus;
+	m_connectionPool->Status(connectionPoolStatus);
+	err = status.put("connectionPool", connectionPoolStatus);
+	ErrorToException(err);
+
 	if(m_account.get()) {
 		MojObject accountStatus;
 
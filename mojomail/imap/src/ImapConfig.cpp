@@ -23,16 +23,22 @@
 
 const int ImapConfig::DEFAULT_INACTIVITY_TIMEOUT = 30; // 30 minutes
 const int ImapConfig::DEFAULT_HEADER_BATCH_SIZE = 20; // 20 headers at a time
+const int ImapConfig::DEFAULT_MAX_HEADER_BATCH_SIZE = 200; // up to 200 headers when adapting
 const int ImapConfig::DEFAULT_MAX_EMAILS = 1000; // 1000 emails per folder max
 const int ImapConfig::DEFAULT_CONNECT_TIMEOUT = 20; // 20 seconds
 const int ImapConfig::DEFAULT_SESSION_KEEPALIVE = 50; // 50 seconds
 const int ImapConfig::DEFAULT_NUM_AUTODOWNLOAD_BODIES = 1000; // 1000 email bodies
+const int ImapConfig::DEFAULT_MAX_CONNECTIONS = 5; // 5 connections per account
+const int ImapConfig::DEFAULT_POOLED_CONNECTION_TIMEOUT = 60; // 60 seconds
 
 ImapConfig ImapConfig::s_instance;
 
 ImapConfig::ImapConfig()
 : m_inactivityTimeout(DEFAULT_INACTIVITY_TIMEOUT),
   m_headerBatchSize(DEFAULT_HEADER_BATCH_SIZE),
+  m_maxHeaderBatchSize(DEFAULT_MAX_HEADER_BATCH_SIZE),
+  m_adaptiveHeaderBatch(true),
+  m_pipelineHeaderFetch(true),
   m_maxEmails(DEFAULT_MAX_EMAILS),
   m_ignoreViewFolder(false),
   m_ignoreNetworkStatus(false),
@@ -41,7 +47,12 @@ ImapConfig::ImapConfig()
   m_enableCompress(true),
   m_sessionKeepAlive(DEFAULT_SESSION_KEEPALIVE),
   m_keepAliveForSync(false),
-  m_numAutoDownloadBodies(DEFAULT_NUM_AUTODOWNLOAD_BODIES)
+  m_numAutoDownloadBodies(DEFAULT_NUM_AUTODOWNLOAD_BODIES),
+  m_flushSyncChangesPerPage(false),
+  m_pipelineSearches(true),
+  m_maxConnections(DEFAULT_MAX_CONNECTIONS),
+  m_pooledConnectionTimeout(DEFAULT_POOLED_CONNECTION_TIMEOUT),
+  m_preconnect(false)
 {
 }
 
@@ -79,6 +90,9 @@ MojErr ImapConfig::ParseConfig(const MojObject& conf)
 {
 	GetOptionalInt(conf, "inactivityTimeoutSeconds", m_inactivityTimeout, 0, MojInt32Max);
 	GetOptionalInt(conf, "headerBatchSize", m_headerBatchSize, 1, 1000);
+	GetOptionalInt(conf, "maxHeaderBatchSize", m_maxHeaderBatchSize, 1, 1000);
+	GetOptionalBool(conf, "adaptiveHeaderBatch", m_adaptiveHeaderBatch);
+	GetOptionalBool(conf, "pipelineHeaderFetch", m_pipelineHeaderFetch);
 	GetOptionalInt(conf, "maxEmails", m_maxEmails, 100, 20000);
 	GetOptionalBool(conf, "ignoreViewFolder", m_ignoreViewFolder);
 	GetOptionalBool(conf, "ignoreNetworkStatus", m_ignoreNetworkStatus);
@@ -87,6 +101,11 @@ MojErr ImapConfig::ParseConfig(const MojObject& conf)
 	GetOptionalBool(conf, "keepAliveForSync", m_keepAliveForSync);
 	GetOptionalBool(conf, "cleanDisconnect", m_cleanDisconnect);
 	GetOptionalBool(conf, "enableCompress", m_enableCompress);
+	GetOptionalBool(conf, "flushSyncChangesPerPage", m_flushSyncChangesPerPage);
+	GetOptionalBool(conf, "pipelineSearches", m_pipelineSearches);
+	GetOptionalInt(conf, "maxConnections", m_maxConnections, 1, 20);
+	GetOptionalInt(conf, "pooledConnectionTimeout", m_pooledConnectionTimeout, 0, 10 * 60);
+	GetOptionalBool(conf, "preconnect", m_preconnect);
 
 	return MojErrNone;
 }
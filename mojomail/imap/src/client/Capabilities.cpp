@@ -28,6 +28,10 @@ const string Capabilities::NAMESPACE		= "NAMESPACE";
 const string Capabilities::STARTTLS			= "STARTTLS";
 const string Capabilities::LOGINDISABLED	= "LOGINDISABLED";
 const string Capabilities::COMPRESS_DEFLATE	= "COMPRESS=DEFLATE";
+const string Capabilities::ENABLE			= "ENABLE";
+const string Capabilities::CONDSTORE		= "CONDSTORE";
+const string Capabilities::QRESYNC			= "QRESYNC";
+const string Capabilities::ESEARCH			= "ESEARCH";
 
 Capabilities::Capabilities()
 : m_valid(false)
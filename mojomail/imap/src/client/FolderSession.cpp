@@ -20,7 +20,7 @@
 #include "data/ImapFolder.h"
 
 FolderSession::FolderSession(const ImapFolderPtr& folder)
-: m_folder(folder), m_count(0)
+: m_folder(folder), m_count(0), m_highestModSeq(0)
 {
 }
 
@@ -0,0 +1,300 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "client/ImapConnectionPool.h"
+#include "client/ImapSession.h"
+#include "ImapConfig.h"
+#include "ImapPrivate.h"
+#include <ctime>
+
+using namespace std;
+
+const int ImapConnectionPool::WAIT_TIMEOUT = 30; // 30 seconds
+
+PooledConnection::PooledConnection(ImapConnectionPool& pool, const ImapConnectionState& state, int idleTimeoutSeconds)
+: m_pool(pool),
+  m_state(state),
+  m_closedSlot(this, &PooledConnection::ConnectionClosed)
+{
+	m_state.connection->WatchClosed(m_closedSlot);
+	m_idleTimer.SetTimeout(idleTimeoutSeconds, this, &PooledConnection::IdleTimeout);
+}
+
+PooledConnection::~PooledConnection()
+{
+}
+
+void PooledConnection::Detach()
+{
+	m_closedSlot.cancel();
+	m_idleTimer.Cancel();
+}
+
+void PooledConnection::Shutdown()
+{
+	Detach();
+
+	// Keep a local reference so it doesn't get deleted while in Shutdown
+	MojRefCountedPtr<SocketConnection> connection = m_state.connection;
+	connection->Shutdown();
+}
+
+MojErr PooledConnection::ConnectionClosed()
+{
+	// Closed by the server while sitting in the pool
+	MojRefCountedPtr<PooledConnection> self(this);
+
+	Detach();
+	m_pool.PooledConnectionClosed(this);
+
+	return MojErrNone;
+}
+
+void PooledConnection::IdleTimeout()
+{
+	MojRefCountedPtr<PooledConnection> self(this);
+
+	Shutdown();
+	m_pool.PooledConnectionClosed(this);
+}
+
+ImapConnectionPool::ImapConnectionPool(MojLogger& log)
+: m_log(log),
+  m_openCount(0),
+  m_hits(0),
+  m_misses(0),
+  m_overflows(0),
+  m_handshakeCount(0),
+  m_handshakeMillis(0),
+  m_maxHandshakeMillis(0)
+{
+}
+
+ImapConnectionPool::~ImapConnectionPool()
+{
+	BOOST_FOREACH(const PooledConnectionPtr& pooled, m_pooled) {
+		pooled->Detach();
+	}
+}
+
+int ImapConnectionPool::GetMaxConnections() const
+{
+	return ImapConfig::GetConfig().GetMaxConnections();
+}
+
+bool ImapConnectionPool::IsEnabled() const
+{
+	return ImapConfig::GetConfig().GetPooledConnectionTimeout() > 0;
+}
+
+ImapConnectionPool::Result ImapConnectionPool::RequestConnection(const MojRefCountedPtr<ImapSession>& session, const string& bindAddress, ImapConnectionState& state)
+{
+	// Use the most recently pooled connection; older ones are more likely to have timed out on the server
+	list<PooledConnectionPtr>::reverse_iterator it;
+	for(it = m_pooled.rbegin(); it != m_pooled.rend(); ++it) {
+		const ImapConnectionState& pooledState = (*it)->GetState();
+
+		if(pooledState.connection->GetBindAddress() == bindAddress && !pooledState.connection->IsClosed()) {
+			PooledConnectionPtr pooled = *it;
+			m_pooled.erase(--it.base());
+
+			pooled->Detach();
+			state = pooled->GetState();
+
+			m_hits++;
+			return Result_Reused;
+		}
+	}
+
+	if(m_openCount < GetMaxConnections()) {
+		m_openCount++;
+		m_misses++;
+		return Result_NewSlot;
+	}
+
+	MojLogInfo(m_log, "all %d connections in use; session %p waiting", m_openCount, session.get());
+
+	m_waiters.push_back(Waiter(session, bindAddress, time(NULL)));
+	UpdateWaitTimer();
+
+	return Result_Wait;
+}
+
+void ImapConnectionPool::ReturnConnection(const ImapConnectionState& state)
+{
+	// Hand it straight to a waiting session, if one can use it
+	list<Waiter>::iterator it;
+	for(it = m_waiters.begin(); it != m_waiters.end(); ++it) {
+		if(it->bindAddress == state.connection->GetBindAddress()) {
+			MojRefCountedPtr<ImapSession> session = it->session;
+			m_waiters.erase(it);
+			UpdateWaitTimer();
+
+			m_hits++;
+			session->PooledConnectionAvailable(state);
+			return;
+		}
+	}
+
+	if(IsEnabled() && !state.connection->IsClosed()) {
+		PooledConnectionPtr pooled(new PooledConnection(*this, state, ImapConfig::GetConfig().GetPooledConnectionTimeout()));
+		m_pooled.push_back(pooled);
+	} else {
+		MojRefCountedPtr<SocketConnection> connection = state.connection;
+		connection->Shutdown();
+		ReleaseSlot();
+	}
+}
+
+void ImapConnectionPool::ReleaseSlot()
+{
+	if(m_openCount > 0) {
+		m_openCount--;
+	} else {
+		MojLogWarning(m_log, "connection slot released more than once");
+	}
+
+	if(!m_waiters.empty() && m_openCount < GetMaxConnections()) {
+		GrantSlotToWaiter();
+	}
+}
+
+void ImapConnectionPool::GrantSlotToWaiter()
+{
+	MojRefCountedPtr<ImapSession> session = m_waiters.front().session;
+	m_waiters.pop_front();
+	UpdateWaitTimer();
+
+	m_openCount++;
+	m_misses++;
+
+	session->ConnectionSlotAvailable();
+}
+
+void ImapConnectionPool::PooledConnectionClosed(PooledConnection* pooled)
+{
+	list<PooledConnectionPtr>::iterator it;
+	for(it = m_pooled.begin(); it != m_pooled.end(); ++it) {
+		if(it->get() == pooled) {
+			m_pooled.erase(it);
+			ReleaseSlot();
+			break;
+		}
+	}
+}
+
+void ImapConnectionPool::AddHandshakeTime(MojInt64 millis)
+{
+	m_handshakeCount++;
+	m_handshakeMillis += millis;
+
+	if(millis > m_maxHandshakeMillis)
+		m_maxHandshakeMillis = millis;
+}
+
+void ImapConnectionPool::Clear()
+{
+	if(!m_pooled.empty()) {
+		MojLogInfo(m_log, "closing %d pooled connections", (int) m_pooled.size());
+	}
+
+	// Detach everything first, since releasing slots can wake up waiting sessions
+	list<PooledConnectionPtr> pooled;
+	pooled.swap(m_pooled);
+
+	BOOST_FOREACH(const PooledConnectionPtr& connection, pooled) {
+		connection->Shutdown();
+	}
+
+	for(size_t i = 0; i < pooled.size(); i++) {
+		ReleaseSlot();
+	}
+}
+
+void ImapConnectionPool::UpdateWaitTimer()
+{
+	if(m_waiters.empty()) {
+		m_waitTimer.Cancel();
+	} else {
+		int remaining = int(m_waiters.front().startTime + WAIT_TIMEOUT - time(NULL));
+		m_waitTimer.SetTimeout(std::max(remaining, 1), this, &ImapConnectionPool::WaitTimeout);
+	}
+}
+
+void ImapConnectionPool::WaitTimeout()
+{
+	// Don't let a session that's holding on to a connection (e.g. for push) block the others forever;
+	// go over the limit instead.
+	time_t now = time(NULL);
+
+	while(!m_waiters.empty() && m_waiters.front().startTime + WAIT_TIMEOUT <= now) {
+		MojLogWarning(m_log, "timed out waiting for a free connection; opening an extra connection");
+
+		m_overflows++;
+		GrantSlotToWaiter();
+	}
+
+	UpdateWaitTimer();
+}
+
+void ImapConnectionPool::Status(MojObject& status) const
+{
+	MojErr err;
+
+	err = status.put("maxConnections", GetMaxConnections());
+	ErrorToException(err);
+
+	err = status.put("open", m_openCount);
+	ErrorToException(err);
+
+	err = status.put("pooled", (MojInt64) m_pooled.size());
+	ErrorToException(err);
+
+	err = status.put("waiting", (MojInt64) m_waiters.size());
+	ErrorToException(err);
+
+	err = status.put("hits", m_hits);
+	ErrorToException(err);
+
+	err = status.put("misses", m_misses);
+	ErrorToException(err);
+
+	if(m_overflows > 0) {
+		err = status.put("overflows", m_overflows);
+		ErrorToException(err);
+	}
+
+	if(m_handshakeCount > 0) {
+		MojObject handshakeStatus;
+
+		err = handshakeStatus.put("count", m_handshakeCount);
+		ErrorToException(err);
+
+		err = handshakeStatus.put("totalMillis", m_handshakeMillis);
+		ErrorToException(err);
+
+		err = handshakeStatus.put("averageMillis", m_handshakeMillis / m_handshakeCount);
+		ErrorToException(err);
+
+		err = handshakeStatus.put("maxMillis", m_maxHandshakeMillis);
+		ErrorToException(err);
+
+		err = status.put("handshake", handshakeStatus);
+		ErrorToException(err);
+	}
+}
@@ -74,6 +74,7 @@ void ImapRequestManager::SendRequest(const string& request, const MojRefCountedP
 	assert( responseParser.get() );
 
 	std::string tag = SendRequest(request, canLogRequest);
+	responseParser->SetTag(tag);
 	m_pendingRequests.push_back( PendingRequest(tag, responseParser, timeoutSeconds) );
 
 	// Don't call WaitForResponses if someone is already using the LineReader
@@ -273,6 +274,9 @@ void ImapRequestManager::HandleResponseLine(const string& line)
 				}
 			}
 			
+			// Write any updates collected while the command was running
+			m_untaggedUpdateParser->FlushUpdates();
+
 			// Check if we found a matching tag
 			if(parser.get()) {
 				parser->BaseHandleResponse(status, response);
@@ -28,11 +28,13 @@
 #include "ImapPrivate.h"
 #include "client/SyncSession.h"
 #include "client/PowerManager.h"
+#include "client/ImapConnectionPool.h"
 #include "exceptions/ExceptionUtils.h"
 #include "activity/ImapActivityFactory.h"
 #include "activity/ActivityBuilder.h"
 #include "network/NetworkStatus.h"
 #include "network/NetworkStatusMonitor.h"
+#include "email/DateUtils.h"
 #include "stream/InflaterInputStream.h"
 #include "stream/DeflaterOutputStream.h"
 
@@ -49,6 +51,7 @@
 #include "commands/LogoutCommand.h"
 #include "commands/AuthYahooCommand.h"
 #include "commands/NoopIdleCommand.h"
+#include "commands/PrefetchPartsCommand.h"
 #include "commands/SearchFolderCommand.h"
 #include "commands/SelectFolderCommand.h"
 #include "commands/ScheduleRetryCommand.h"
@@ -96,12 +99,17 @@ ImapSession::ImapSession(const MojRefCountedPtr<ImapClient>& client, MojLogger&
   m_reconnectRequested(false),
   m_safeMode(false),
   m_compressionActive(false),
+  m_qresyncEnabled(false),
   m_shouldPush(false),
   m_idleMode(IdleMode_None),
   m_pushRetryCount(0),
   m_enteredStateTime(0),
   m_idleStartTime(0),
   m_sessionPushDuration(0),
+  m_hasConnectionSlot(false),
+  m_connectStartTime(0),
+  m_preconnecting(false),
+  m_abandonConnect(false),
   m_networkStatusSlot(this, &ImapSession::NetworkStatusAvailable),
   m_closedSlot(this, &ImapSession::ConnectionClosed),
   m_syncSessionDoneSlot(this, &ImapSession::SyncSessionDone),
@@ -136,6 +144,14 @@ void ImapSession::SetPowerManager(const MojRefCountedPtr<PowerManager>& powerMan
 
 void ImapSession::Connected(const MojRefCountedPtr<SocketConnection>& connection)
 {
+	if(m_abandonConnect && connection.get()) {
+		// Network went away while we were connecting
+		m_abandonConnect = false;
+		connection->Shutdown();
+		Disconnected();
+		return;
+	}
+
 	m_connection = connection;
 	
 	if(connection.get()) {
@@ -496,7 +512,11 @@ void ImapSession::CommandComplete(Command* command)
 				MojLogInfo(m_log, "nothing left to do; disconnecting");
 			}
 
-			Logout();
+			if(CanPoolConnection()) {
+				ReturnConnectionToPool();
+			} else {
+				Logout();
+			}
 		}
 	} else if(m_state == State_Disconnecting && m_commandManager->GetActiveCommandCount() == 0) {
 		Disconnected();
@@ -837,6 +857,29 @@ MojRefCountedPtr<ImapCommand> ImapSession::FindPendingCommand(const MojRefCounte
 	return NULL;
 }
 
+void ImapSession::RemoveFromPrefetch(const MojObject& emailId, const MojObject& partId)
+{
+	BOOST_FOREACH(const MojRefCountedPtr<Command>& activeCommand, m_commandManager->GetActiveCommandIterators()) {
+		ImapCommand* imapCommand = static_cast<ImapCommand*>(activeCommand.get());
+
+		if(imapCommand->GetType() == ImapCommand::CommandType_PrefetchParts) {
+			if(static_cast<PrefetchPartsCommand*>(imapCommand)->RemovePart(emailId, partId)) {
+				MojLogDebug(m_log, "removed part from active prefetch command");
+			}
+		}
+	}
+
+	BOOST_FOREACH(const MojRefCountedPtr<Command>& pendingCommand, m_commandManager->GetPendingCommandIterators()) {
+		ImapCommand* imapCommand = static_cast<ImapCommand*>(pendingCommand.get());
+
+		if(imapCommand->GetType() == ImapCommand::CommandType_PrefetchParts) {
+			if(static_cast<PrefetchPartsCommand*>(imapCommand)->RemovePart(emailId, partId)) {
+				MojLogDebug(m_log, "removed part from pending prefetch command");
+			}
+		}
+	}
+}
+
 void ImapSession::DownloadPart(const MojObject& folderId, const MojObject& emailId, const MojObject& partId, const MojRefCountedPtr<DownloadListener>& listener, Command::Priority priority)
 {
 	MojRefCountedPtr<FetchPartCommand> command(new FetchPartCommand(*this, folderId, emailId, partId, priority));
@@ -870,6 +913,9 @@ void ImapSession::DownloadPart(const MojObject& folderId, const MojObject& email
 	if(listener.get())
 		command->AddDownloadListener(listener);
 
+	// Don't download the part again as part of an auto-download batch
+	RemoveFromPrefetch(emailId, partId);
+
 	// If this is a high priority request, set m_recentUserInteraction to true
 	if (priority >= Command::HighPriority) {
 		m_recentUserInteraction = true;
@@ -903,12 +949,27 @@ void ImapSession::FetchNewHeaders(const MojObject& folderId)
 	CheckQueue();
 }
 
+void ImapSession::PrefetchParts(const MojRefCountedPtr<PrefetchPartsCommand>& command)
+{
+	m_commandManager->QueueCommand(command, false);
+	CheckQueue();
+}
+
+void ImapSession::PrefetchComplete(size_t numParts, MojInt64 numBytes, MojInt64 elapsedMillis)
+{
+	m_stats.prefetchPartCount += numParts;
+	m_stats.prefetchBytes += numBytes;
+	m_stats.prefetchMillis += elapsedMillis;
+}
+
 void ImapSession::PrepareToConnect()
 {
 	SetState(State_QueryingNetworkStatus);
 
 	m_reconnectRequested = false;
 	m_sessionPushDuration = 0;
+	m_preconnecting = false;
+	m_abandonConnect = false;
 
 	if(m_client.get() && m_account.get())
 		m_shouldPush = IsPushRequested(m_folderId);
@@ -920,6 +981,16 @@ void ImapSession::QueryNetworkStatus()
 {
 	if(m_client.get() != NULL && !m_client->GetNetworkStatusMonitor().HasCurrentStatus()) {
 		m_client->GetNetworkStatusMonitor().WaitForStatus(m_networkStatusSlot);
+
+		if(ShouldPreconnect()) {
+			// Overlap the TCP/TLS setup with the connection manager query
+			MojLogInfo(m_log, "session %p connecting before network status is available", this);
+
+			m_preconnecting = true;
+
+			SetState(State_Connecting);
+			RequestConnection();
+		}
 	} else {
 		// If we already have the network status, or don't have a client, move on
 		QueryNetworkStatusDone();
@@ -928,6 +999,19 @@ void ImapSession::QueryNetworkStatus()
 
 MojErr ImapSession::NetworkStatusAvailable()
 {
+	if(m_preconnecting) {
+		// Already connecting (or connected), unless it turns out there's no network
+		m_preconnecting = false;
+
+		NetworkStatusMonitor& monitor = m_client->GetNetworkStatusMonitor();
+		if(monitor.HasCurrentStatus() && !monitor.GetCurrentStatus().IsConnected()) {
+			MojLogWarning(m_log, "session %p no network connection available; abandoning pre-connect", this);
+			AbandonPreconnect();
+		}
+
+		return MojErrNone;
+	}
+
 	QueryNetworkStatusDone();
 
 	return MojErrNone;
@@ -962,13 +1046,97 @@ void ImapSession::QueryNetworkStatusDone()
 	if(hasConnection) {
 		SetState(State_Connecting);
 
-		Connect();
+		RequestConnection();
 	} else {
 		MojLogWarning(m_log, "session %p no network connection available", this);
 		Disconnected();
 	}
 }
 
+// Get a connection slot from the client, or a logged-in connection if one is available
+void ImapSession::RequestConnection()
+{
+	if(m_client.get() == NULL) {
+		// Validator doesn't share connections
+		Connect();
+		return;
+	}
+
+	ImapConnectionState pooled;
+	MojRefCountedPtr<ImapSession> self(this);
+
+	switch(m_client->GetConnectionPool().RequestConnection(self, m_connectBindAddress, pooled)) {
+	case ImapConnectionPool::Result_Reused:
+		m_hasConnectionSlot = true;
+		ReuseConnection(pooled);
+		break;
+	case ImapConnectionPool::Result_NewSlot:
+		m_hasConnectionSlot = true;
+		Connect();
+		break;
+	case ImapConnectionPool::Result_Wait:
+		MojLogInfo(m_log, "session %p waiting for a free connection", this);
+		break;
+	}
+}
+
+void ImapSession::ConnectionSlotAvailable()
+{
+	if(m_state != State_Connecting) {
+		// Don't need it anymore; give it back
+		MojLogWarning(m_log, "session %p got a connection slot in state %s", this, GetStateName(m_state));
+		m_client->GetConnectionPool().ReleaseSlot();
+		return;
+	}
+
+	m_hasConnectionSlot = true;
+
+	if(m_client->DisableAccountInProgress()) {
+		Disconnected();
+	} else {
+		Connect();
+	}
+}
+
+void ImapSession::PooledConnectionAvailable(const ImapConnectionState& state)
+{
+	if(m_state == State_Connecting && !m_client->DisableAccountInProgress()) {
+		m_hasConnectionSlot = true;
+		ReuseConnection(state);
+	} else {
+		// Don't need it anymore; give it back
+		m_client->GetConnectionPool().ReturnConnection(state);
+	}
+}
+
+void ImapSession::ReuseConnection(const ImapConnectionState& state)
+{
+	MojLogInfo(m_log, "session %p reusing logged-in connection", this);
+
+	m_connection = state.connection;
+	m_inputStream = state.inputStream;
+	m_outputStream = state.outputStream;
+	m_lineReader = state.lineReader;
+	m_capabilities = state.capabilities;
+	m_compressionActive = state.compressionActive;
+	m_qresyncEnabled = state.qresyncEnabled;
+
+	// Only count the compression stats from here on
+	CompressionStats baseline;
+	m_compressionStatsBaseline = CompressionStats();
+	CollectConnectionStats(baseline);
+	m_compressionStatsBaseline = baseline;
+
+	m_connectBindAddress.clear();
+
+	m_closedSlot.cancel(); // make sure it's not connected to a slot
+	m_connection->WatchClosed(m_closedSlot);
+	m_connection->MarkReused();
+
+	// Already logged in; just need to switch folders
+	SelectFolder();
+}
+
 void ImapSession::Connect()
 {
 	MojRefCountedPtr<ConnectCommand> command(new ConnectCommand(*this, m_connectBindAddress));
@@ -978,6 +1146,7 @@ void ImapSession::Connect()
 	m_connectBindAddress.clear();
 
 	m_stats.connectAttemptCount++;
+	m_connectStartTime = DateUtils::GetMonotonicTimeMillis();
 
 	m_commandManager->RunCommand(command);
 }
@@ -1130,6 +1299,14 @@ void ImapSession::CompressComplete(bool success)
 
 void ImapSession::SelectFolder()
 {
+	if(m_connectStartTime > 0) {
+		if(m_client.get()) {
+			m_client->GetConnectionPool().AddHandshakeTime(DateUtils::GetMonotonicTimeMillis() - m_connectStartTime);
+		}
+
+		m_connectStartTime = 0;
+	}
+
 	// Only sync folder lists if we're syncing the inbox
 	if(m_account.get() == NULL || !IsValidId(m_folderId) || m_account->GetInboxFolderId() == m_folderId) {
 		MojRefCountedPtr<SyncFolderListCommand> command(new SyncFolderListCommand(*this));
@@ -1344,6 +1521,29 @@ void ImapSession::Status(MojObject& status)
 		err = stats.put("loginSuccessCount", m_stats.loginSuccessCount);
 		ErrorToException(err);
 
+		if(m_stats.prefetchPartCount > 0) {
+			MojObject prefetchStats;
+
+			err = prefetchStats.put("partCount", m_stats.prefetchPartCount);
+			ErrorToException(err);
+
+			err = prefetchStats.put("bytes", m_stats.prefetchBytes);
+			ErrorToException(err);
+
+			err = prefetchStats.put("millis", m_stats.prefetchMillis);
+			ErrorToException(err);
+
+			if(m_stats.prefetchMillis > 0) {
+				MojInt64 partsPerSecond = (m_stats.prefetchPartCount * 1000 + m_stats.prefetchMillis / 2) / m_stats.prefetchMillis;
+
+				err = prefetchStats.put("partsPerSecond", partsPerSecond);
+				ErrorToException(err);
+			}
+
+			err = stats.put("prefetch", prefetchStats);
+			ErrorToException(err);
+		}
+
 		err = status.put("stats", stats);
 		ErrorToException(err);
 	}
@@ -1436,14 +1636,16 @@ void ImapSession::CollectConnectionStats(CompressionStats& stats)
 {
 	// Collect stats
 	if(m_compressionActive) {
+		CompressionStats connectionStats;
+
 		InflaterInputStream* iis = dynamic_cast<InflaterInputStream*>(m_inputStream.get());
 
 		if(iis != NULL) {
 			InflaterInputStream::InflateStats inflateStats;
 			iis->GetInflateStats(inflateStats);
 
-			stats.totalBytesIn += inflateStats.bytesOut;
-			stats.compressedBytesIn += inflateStats.bytesIn;
+			connectionStats.totalBytesIn += inflateStats.bytesOut;
+			connectionStats.compressedBytesIn += inflateStats.bytesIn;
 		}
 
 		DeflaterOutputStream* dis = dynamic_cast<DeflaterOutputStream*>(m_outputStream.get());
@@ -1452,9 +1654,14 @@ void ImapSession::CollectConnectionStats(CompressionStats& stats)
 			DeflaterOutputStream::DeflateStats deflateStats;
 			dis->GetDeflateStats(deflateStats);
 
-			stats.totalBytesOut += deflateStats.bytesIn;
-			stats.compressedBytesOut += deflateStats.bytesOut;
+			connectionStats.totalBytesOut += deflateStats.bytesIn;
+			connectionStats.compressedBytesOut += deflateStats.bytesOut;
 		}
+
+		// The streams count from when compression was started, possibly by another session
+		connectionStats -= m_compressionStatsBaseline;
+
+		stats += connectionStats;
 	}
 }
 
@@ -1489,6 +1696,88 @@ void ImapSession::ResetConnection()
 	m_requestManager.reset(new ImapRequestManager(*this));
 
 	m_compressionActive = false;
+	m_qresyncEnabled = false;
+
+	m_compressionStatsBaseline = CompressionStats();
+
+	m_connectStartTime = 0;
+
+	if(m_hasConnectionSlot) {
+		m_hasConnectionSlot = false;
+
+		if(m_client.get()) {
+			m_client->GetConnectionPool().ReleaseSlot();
+		}
+	}
+}
+
+bool ImapSession::ShouldPreconnect()
+{
+	if(!ImapConfig::GetConfig().GetPreconnect() || ImapConfig::GetConfig().GetIgnoreNetworkStatus()) {
+		return false;
+	}
+
+	// Push needs the network status to pick the interface to bind to
+	return m_account.get() && !IsPushRequested(m_folderId);
+}
+
+void ImapSession::AbandonPreconnect()
+{
+	if(IsConnected()) {
+		// Connected (or reused a pooled connection) before the status came back
+		FatalError("no network connection");
+	} else if(m_state == State_Connecting) {
+		if(m_hasConnectionSlot) {
+			// ConnectCommand is running; the connection gets dropped in Connected
+			m_abandonConnect = true;
+		} else {
+			// Still waiting for a connection slot; the pool gets it back when it's handed out
+			Disconnected();
+		}
+	}
+}
+
+bool ImapSession::CanPoolConnection() const
+{
+	if(m_client.get() == NULL || !m_client->GetConnectionPool().IsEnabled() || m_client->DisableAccountInProgress()) {
+		return false;
+	}
+
+	if(m_connection.get() == NULL || m_connection->IsClosed() || m_reconnectRequested) {
+		return false;
+	}
+
+	// Yahoo push disconnects on its own; don't hold on to those connections
+	if(m_account.get() && m_account->IsYahoo()) {
+		return false;
+	}
+
+	// Only hand over the connection while nothing is reading from it
+	return m_lineReader.get() == NULL || !m_lineReader->Waiting();
+}
+
+void ImapSession::ReturnConnectionToPool()
+{
+	MojLogInfo(m_log, "session %p returning connection to the pool", this);
+
+	ImapConnectionState state;
+	state.connection = m_connection;
+	state.inputStream = m_inputStream;
+	state.outputStream = m_outputStream;
+	state.lineReader = m_lineReader;
+	state.capabilities = m_capabilities;
+	state.compressionActive = m_compressionActive;
+	state.qresyncEnabled = m_qresyncEnabled;
+
+	// The connection slot goes along with the connection
+	m_closedSlot.cancel();
+	m_hasConnectionSlot = false;
+
+	ResetConnection();
+	SetState(State_Cleanup);
+	CleanupAfterDisconnect();
+
+	m_client->GetConnectionPool().ReturnConnection(state);
 }
 
 // Cleanup sync sessions and activities
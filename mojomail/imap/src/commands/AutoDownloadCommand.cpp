@@ -17,6 +17,7 @@
 // LICENSE@@@
 
 #include "commands/AutoDownloadCommand.h"
+#include "commands/PrefetchPartsCommand.h"
 #include "client/ImapSession.h"
 #include "data/EmailPart.h"
 #include "data/DatabaseInterface.h"
@@ -25,7 +26,6 @@
 #include "data/EmailSchema.h"
 #include "data/ImapEmailAdapter.h"
 #include "ImapPrivate.h"
-#include "client/DownloadListener.h"
 #include "ImapConfig.h"
 
 const size_t AutoDownloadCommand::MAX_AUTODOWNLOAD_SIZE = 300 * 1024; // 300KB
@@ -71,6 +71,14 @@ MojErr AutoDownloadCommand::GetAutoDownloadsResponse(MojObject& response, MojErr
 				continue;
 			}
 
+			MojObject emailId;
+			err = emailObj.getRequired(DatabaseAdapter::ID, emailId);
+			ErrorToException(err);
+
+			UID uid;
+			err = emailObj.getRequired(ImapEmailAdapter::UID, uid);
+			ErrorToException(err);
+
 			MojObject partsArray;
 			err = emailObj.getRequired(EmailSchema::PARTS, partsArray);
 			ErrorToException(err);
@@ -78,7 +86,16 @@ MojErr AutoDownloadCommand::GetAutoDownloadsResponse(MojObject& response, MojErr
 			EmailPartList emailParts;
 			EmailAdapter::ParseParts(partsArray, emailParts);
 
+			bool addedEmail = false;
+			bool firstBodyPart = true;
+
 			BOOST_FOREACH(const EmailPartPtr& part, emailParts) {
+				bool isFirstBodyPart = part->IsBodyPart() && firstBodyPart;
+
+				if(part->IsBodyPart()) {
+					firstBodyPart = false;
+				}
+
 				if(part->GetLocalFilePath().empty()) {
 					bool fetch = false;
 
@@ -89,23 +106,42 @@ MojErr AutoDownloadCommand::GetAutoDownloadsResponse(MojObject& response, MojErr
 					}
 
 					if(fetch) {
-						MojObject emailId;
-						err = emailObj.getRequired(DatabaseAdapter::ID, emailId);
-						ErrorToException(err);
+						if(!addedEmail) {
+							if(m_prefetchCommand.get() == NULL) {
+								m_prefetchCommand.reset(new PrefetchPartsCommand(m_session, m_folderId));
+							}
 
-						MojRefCountedPtr<DownloadListener> listener(NULL);
-						m_session.DownloadPart(m_folderId, emailId, part->GetId(), listener, Command::LowPriority);
+							m_prefetchCommand->AddEmail(emailId, uid);
+							addedEmail = true;
+						}
+
+						m_prefetchCommand->AddPart(part, isFirstBodyPart);
 					}
 				}
 			}
+
+			// Queue a batch once it's big enough; an email's parts are never split across batches
+			if(m_prefetchCommand.get() && m_prefetchCommand->GetNumParts() >= PrefetchPartsCommand::MAX_BATCH_PARTS) {
+				QueuePrefetch();
+			}
 		}
 
 		if(m_emailsExamined < ImapConfig::GetConfig().GetNumAutoDownloadBodies() && DatabaseAdapter::GetNextPage(response, m_page)) {
 			GetAutoDownloads();
 		} else {
+			QueuePrefetch();
 			Complete();
 		}
 	} CATCH_AS_FAILURE
 
 	return MojErrNone;
 }
+
+void AutoDownloadCommand::QueuePrefetch()
+{
+	if(m_prefetchCommand.get() && m_prefetchCommand->GetNumParts() > 0) {
+		m_session.PrefetchParts(m_prefetchCommand);
+	}
+
+	m_prefetchCommand.reset();
+}
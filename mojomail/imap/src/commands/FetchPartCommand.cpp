@@ -35,11 +35,9 @@
 #include "stream/Base64DecoderOutputStream.h"
 #include "stream/QuotePrintableDecoderOutputStream.h"
 #include "stream/UTF8DecoderOutputStream.h"
-#include "email/PreviewTextGenerator.h"
 #include "exceptions/ExceptionUtils.h"
 #include "util/StringUtils.h"
 
-const size_t FetchPartCommand::PREVIEW_BUFFER_SIZE = 8192;
 const size_t FetchPartCommand::PREVIEW_TEXT_LENGTH = 128;
 
 const int FetchPartCommand::FETCH_PROGRESS_TIMEOUT = 120; // 2 minutes with no updates
@@ -243,13 +241,32 @@ void FetchPartCommand::SendFetchRequest()
 	// Extract preview text from decoded output
 	// Only do this for the first body part
 	if(m_part->IsBodyPart() && m_isFirstBodyPart) {
-		m_previewTextExtractor.reset(new PreviewTextExtractorOutputStream(os, PREVIEW_BUFFER_SIZE));
+		bool isHtml = boost::iequals(m_part->GetMimeType(), "text/html");
+
+		m_previewTextExtractor.reset(new PreviewTextExtractorOutputStream(os, PREVIEW_TEXT_LENGTH, isHtml));
 		os = m_previewTextExtractor;
 	}
 
-	if(m_part->IsBodyPart()) {
+	os = WrapDecoders(os, *m_part, m_log);
+
+	os.reset(new ProgressOutputStream(os, *this));
+
+	m_fetchResponseParser->SetPartOutputStream(os);
+
+	m_downloadInProgress = true;
+
+	m_progressTimer.SetTimeout(FETCH_PROGRESS_TIMEOUT, this, &FetchPartCommand::FetchTimeout);
+
+	m_session.SendRequest(ss.str(), m_fetchResponseParser);
+}
+
+OutputStreamPtr FetchPartCommand::WrapDecoders(const OutputStreamPtr& sink, const EmailPart& part, MojLogger& log)
+{
+	OutputStreamPtr os = sink;
+
+	if(part.IsBodyPart()) {
 		// Convert charset to UTF-8
-		string charset = m_part->GetCharset();
+		string charset = part.GetCharset();
 
 		if(charset.empty()) {
 			charset = "us-ascii";
@@ -258,7 +275,7 @@ void FetchPartCommand::SendFetchRequest()
 		try {
 			os.reset(new UTF8DecoderOutputStream(os, charset.c_str()));
 		} catch (const std::exception& e) {
-			MojLogError(m_log, "error creating charset decoder stream: %s", e.what());
+			MojLogError(log, "error creating charset decoder stream: %s", e.what());
 
 			// Fall back to ASCII
 			os.reset(new UTF8DecoderOutputStream(os, "us-ascii"));
@@ -266,7 +283,7 @@ void FetchPartCommand::SendFetchRequest()
 	}
 
 	// Decode content-encoding
-	const string& encoding = m_part->GetEncoding();
+	const string& encoding = part.GetEncoding();
 
 	if(encoding == "base64") {
 		os.reset(new Base64DecoderOutputStream(os));
@@ -274,15 +291,7 @@ void FetchPartCommand::SendFetchRequest()
 		os.reset(new QuotePrintableDecoderOutputStream(os));
 	}
 
-	os.reset(new ProgressOutputStream(os, *this));
-
-	m_fetchResponseParser->SetPartOutputStream(os);
-
-	m_downloadInProgress = true;
-
-	m_progressTimer.SetTimeout(FETCH_PROGRESS_TIMEOUT, this, &FetchPartCommand::FetchTimeout);
-
-	m_session.SendRequest(ss.str(), m_fetchResponseParser);
+	return os;
 }
 
 MojErr FetchPartCommand::FetchResponse()
@@ -406,11 +415,7 @@ void FetchPartCommand::UpdateEmail()
 
 	// Update preview text
 	if(m_previewTextExtractor.get()) {
-		const string& previewBuf = m_previewTextExtractor->GetPreviewText();
-
-		bool isHtml = boost::iequals(m_part->GetMimeType(), "text/html");
-
-		string previewText = PreviewTextGenerator::GeneratePreviewText(previewBuf, PREVIEW_TEXT_LENGTH, isHtml);
+		string previewText = m_previewTextExtractor->GetPreviewText();
 		emailObj.putString(EmailSchema::SUMMARY, previewText.c_str());
 	}
 
@@ -24,12 +24,10 @@
 #include "client/ImapSession.h"
 #include "client/SyncSession.h"
 
-HandleUpdateCommand::HandleUpdateCommand(ImapSession& session, const MojObject& folderId, UID uid, bool deleted, const MojObject& newFlags)
+HandleUpdateCommand::HandleUpdateCommand(ImapSession& session, const MojObject& folderId, const UpdateMap& updates)
 : ImapSyncSessionCommand(session, folderId),
-  m_uid(uid),
-  m_deleted(deleted),
-  m_newFlags(newFlags),
-  m_getEmailSlot(this, &HandleUpdateCommand::GetEmailResponse),
+  m_updates(updates),
+  m_getEmailsSlot(this, &HandleUpdateCommand::GetEmailsResponse),
   m_deleteSlot(this, &HandleUpdateCommand::DeleteResponse),
   m_updateFlagsSlot(this, &HandleUpdateCommand::UpdateFlagsResponse)
 {
@@ -43,17 +41,31 @@ void HandleUpdateCommand::RunImpl()
 {
 	CommandTraceFunction();
 
-	GetEmail();
+	m_nextUpdate = m_updates.begin();
+	GetEmails();
 }
 
-void HandleUpdateCommand::GetEmail()
+void HandleUpdateCommand::GetEmails()
 {
 	CommandTraceFunction();
 
-	m_session.GetDatabaseInterface().GetEmail(m_getEmailSlot, m_folderId, m_uid);
+	if(m_nextUpdate == m_updates.end()) {
+		Done();
+		return;
+	}
+
+	std::vector<UID> uids;
+	for(; m_nextUpdate != m_updates.end() && uids.size() < BATCH_SIZE; ++m_nextUpdate) {
+		uids.push_back(m_nextUpdate->first);
+	}
+
+	m_deleteIds.clear();
+	m_flagChanges.clear();
+
+	m_session.GetDatabaseInterface().GetEmailsByUID(m_getEmailsSlot, m_folderId, uids);
 }
 
-MojErr HandleUpdateCommand::GetEmailResponse(MojObject& response, MojErr err)
+MojErr HandleUpdateCommand::GetEmailsResponse(MojObject& response, MojErr err)
 {
 	CommandTraceFunction();
 
@@ -64,41 +76,62 @@ MojErr HandleUpdateCommand::GetEmailResponse(MojObject& response, MojErr err)
 		err = response.getRequired(DatabaseAdapter::RESULTS, results);
 		ErrorToException(err);
 
-		if(results.size() == 1) {
-			MojObject email;
-			if(!results.at(0, email)) {
-				throw MailException("Error getting email", __FILE__, __LINE__);
-			}
+		// If an email with this UID doesn't exist, that's OK.
+		// We may have already deleted it, or never downloaded it in the first place.
+		MojObject::ArrayIterator it;
+		err = results.arrayBegin(it);
+		ErrorToException(err);
+
+		for(; it != results.arrayEnd(); ++it) {
+			MojObject& email = *it;
 
-			err = email.getRequired(DatabaseAdapter::ID, m_emailId);
+			MojObject id;
+			err = email.getRequired(DatabaseAdapter::ID, id);
 			ErrorToException(err);
 
-			if(m_deleted) {
-				DeleteEmail();
+			UID uid;
+			err = email.getRequired(ImapEmailAdapter::UID, uid);
+			ErrorToException(err);
+
+			UpdateMap::const_iterator update = m_updates.find(uid);
+			if(update == m_updates.end()) {
+				continue;
+			}
+
+			if(update->second.deleted) {
+				err = m_deleteIds.push(id);
+				ErrorToException(err);
 			} else {
-				UpdateFlags();
+				// TODO don't overwrite user changes
+				MojObject toMerge;
+				err = toMerge.put(DatabaseAdapter::ID, id);
+				ErrorToException(err);
+				err = toMerge.put(EmailSchema::FLAGS, update->second.newFlags);
+				ErrorToException(err);
+				err = toMerge.put(ImapEmailAdapter::LAST_SYNC_FLAGS, update->second.newFlags);
+				ErrorToException(err);
+
+				err = m_flagChanges.push(toMerge);
+				ErrorToException(err);
 			}
-		} else {
-			// If an email with this UID doesn't exist, that's OK.
-			// We may have already deleted it, or never downloaded it in the first place.
-			Done();
 		}
+
+		DeleteEmails();
 	} CATCH_AS_FAILURE
 
 	return MojErrNone;
 }
 
-void HandleUpdateCommand::DeleteEmail()
+void HandleUpdateCommand::DeleteEmails()
 {
 	CommandTraceFunction();
 
-	MojErr err;
-	MojObject::ObjectVec ids;
-
-	err = ids.push(m_emailId);
-	ErrorToException(err);
+	if(m_deleteIds.empty()) {
+		UpdateFlags();
+		return;
+	}
 
-	m_session.GetDatabaseInterface().DeleteEmailIds(m_deleteSlot, ids);
+	m_session.GetDatabaseInterface().DeleteEmailIds(m_deleteSlot, m_deleteIds);
 }
 
 MojErr HandleUpdateCommand::DeleteResponse(MojObject& response, MojErr err)
@@ -110,7 +143,7 @@ MojErr HandleUpdateCommand::DeleteResponse(MojObject& response, MojErr err)
 
 		m_syncSession->AddPutResponseRevs(response);
 
-		Done();
+		UpdateFlags();
 	} CATCH_AS_FAILURE
 
 	return MojErrNone;
@@ -120,24 +153,12 @@ void HandleUpdateCommand::UpdateFlags()
 {
 	CommandTraceFunction();
 
-	MojErr err;
-
-	MojObject::ObjectVec objects;
+	if(m_flagChanges.empty()) {
+		GetEmails();
+		return;
+	}
 
-	// TODO don't overwrite user changes
-
-	MojObject toMerge;
-	err = toMerge.put(DatabaseAdapter::ID, m_emailId);
-	ErrorToException(err);
-	err = toMerge.put(EmailSchema::FLAGS, m_newFlags);
-	ErrorToException(err);
-	err = toMerge.put(ImapEmailAdapter::LAST_SYNC_FLAGS, m_newFlags);
-	ErrorToException(err);
-
-	err = objects.push(toMerge);
-	ErrorToException(err);
-
-	m_session.GetDatabaseInterface().MergeFlags(m_updateFlagsSlot, objects);
+	m_session.GetDatabaseInterface().MergeFlags(m_updateFlagsSlot, m_flagChanges);
 }
 
 MojErr HandleUpdateCommand::UpdateFlagsResponse(MojObject& response, MojErr err)
@@ -147,7 +168,8 @@ MojErr HandleUpdateCommand::UpdateFlagsResponse(MojObject& response, MojErr err)
 	try {
 		ErrorToException(err);
 
-		Done();
+		// Next batch
+		GetEmails();
 	} CATCH_AS_FAILURE
 
 	return MojErrNone;
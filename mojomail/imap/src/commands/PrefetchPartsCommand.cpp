@@ -0,0 +1,658 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+#include "commands/PrefetchPartsCommand.h"
+#include "commands/FetchPartCommand.h"
+#include "ImapPrivate.h"
+#include "client/ImapSession.h"
+#include "data/DatabaseAdapter.h"
+#include "data/DatabaseInterface.h"
+#include "data/EmailPart.h"
+#include "data/EmailSchema.h"
+#include "data/ImapEmailAdapter.h"
+#include "protocol/FetchResponseParser.h"
+#include "async/GIOChannelWrapper.h"
+#include "async/FileCacheResizerOutputStream.h"
+#include "stream/PreviewTextExtractorOutputStream.h"
+#include "util/StringUtils.h"
+#include <boost/algorithm/string/predicate.hpp>
+#include <sstream>
+#include "email/DateUtils.h"
+
+using namespace std;
+
+// Enough to keep the pipe busy, without holding too many file cache entries open
+const size_t PrefetchPartsCommand::MAX_BATCH_PARTS = 50;
+
+const int PrefetchPartsCommand::FETCH_PROGRESS_TIMEOUT = 120; // 2 minutes with no updates
+
+static const size_t PREVIEW_TEXT_LENGTH = 128;
+
+// Reports the number of encoded bytes received for a part
+class PrefetchProgressOutputStream : public ChainedOutputStream
+{
+public:
+	PrefetchProgressOutputStream(const OutputStreamPtr& sink, PrefetchPartsCommand& command)
+	: ChainedOutputStream(sink), m_command(command) {}
+
+	void Write(const char* src, size_t length)
+	{
+		ChainedOutputStream::Write(src, length);
+		m_command.Progress(length);
+	}
+
+protected:
+	PrefetchPartsCommand&	m_command;
+};
+
+PrefetchPart::PrefetchPart(PrefetchPartsCommand& command, size_t emailIndex, UID uid, const EmailPartPtr& part, bool isFirstBodyPart)
+: m_command(command),
+  m_emailIndex(emailIndex),
+  m_uid(uid),
+  m_part(part),
+  m_isFirstBodyPart(isFirstBodyPart),
+  m_opened(false),
+  m_written(false),
+  m_removed(false),
+  m_requested(false),
+  m_fileCacheSubscriptionSlot(this, &PrefetchPart::InsertFileCacheResponse),
+  m_fileChannelClosedSlot(this, &PrefetchPart::FileChannelClosed)
+{
+}
+
+PrefetchPart::~PrefetchPart()
+{
+}
+
+void PrefetchPart::InsertFileCache(FileCacheClient& fileCacheClient)
+{
+	MojInt64 lifetime = -1; // no lifetime
+	MojInt64 cost = -1; // default cost
+	MojInt64 size = m_part->EstimateMaxSize(); // needs to be >= actual size
+
+	string filename = m_part->GetDisplayName();
+
+	if(filename.empty()) {
+		string prefix = m_part->IsBodyPart() ? "body" : "attachment";
+
+		filename = prefix + m_part->GuessFileExtension();
+	} else {
+		StringUtils::SanitizeFileCacheName(filename);
+	}
+
+	const char* type = m_part->IsBodyPart() ? FileCacheClient::EMAIL : FileCacheClient::ATTACHMENT;
+
+	fileCacheClient.InsertCacheObject(m_fileCacheSubscriptionSlot, type, filename.c_str(), size, cost, lifetime);
+}
+
+MojErr PrefetchPart::InsertFileCacheResponse(MojObject& response, MojErr err)
+{
+	bool success = false;
+
+	try {
+		ResponseToException(response, err);
+
+		MojString pathName;
+		err = response.getRequired("pathName", pathName);
+		ErrorToException(err);
+
+		m_path.assign(pathName.data());
+		success = true;
+	} catch(const std::exception& e) {
+		// Leave this part for the next auto-download
+		m_fileCacheSubscriptionSlot.cancel();
+	}
+
+	m_command.FileCacheInserted(this, success);
+
+	return MojErrNone;
+}
+
+OutputStreamPtr PrefetchPart::OpenOutputStream(FileCacheClient& fileCacheClient, MojLogger& log)
+{
+	assert( !m_path.empty() );
+
+	MojLogInfo(log, "writing uid %d %s section %s to %s", m_uid, m_part->IsBodyPart() ? "body" : "attachment",
+			m_part->GetSection().c_str(), m_path.c_str());
+
+	GIOChannelWrapperFactory factory;
+	m_fileChannel = factory.OpenFile(m_path.c_str(), "w");
+	m_fileChannel->WatchClosed(m_fileChannelClosedSlot);
+
+	m_opened = true;
+
+	OutputStreamPtr os = m_fileChannel->GetOutputStream();
+
+	os.reset(new FileCacheResizerOutputStream(os, fileCacheClient, m_path, m_part->EstimateMaxSize()));
+
+	// Extract preview text from the first body part
+	if(m_part->IsBodyPart() && m_isFirstBodyPart) {
+		bool isHtml = boost::iequals(m_part->GetMimeType(), "text/html");
+
+		m_previewTextExtractor.reset(new PreviewTextExtractorOutputStream(os, PREVIEW_TEXT_LENGTH, isHtml));
+		os = m_previewTextExtractor;
+	}
+
+	return FetchPartCommand::WrapDecoders(os, *m_part, log);
+}
+
+MojErr PrefetchPart::FileChannelClosed()
+{
+	// Done writing; release the file cache subscription
+	m_fileCacheSubscriptionSlot.cancel();
+
+	m_written = true;
+	m_fileChannel.reset();
+
+	m_command.PartWritten(this);
+
+	return MojErrNone;
+}
+
+string PrefetchPart::GetPreviewText() const
+{
+	return m_previewTextExtractor.get() ? m_previewTextExtractor->GetPreviewText() : "";
+}
+
+void PrefetchPart::Cleanup()
+{
+	m_fileCacheSubscriptionSlot.cancel();
+	m_fileChannelClosedSlot.cancel();
+	m_fileChannel.reset();
+}
+
+PrefetchPartsCommand::PrefetchPartsCommand(ImapSession& session, const MojObject& folderId)
+: ImapSessionCommand(session, Command::LowPriority),
+  m_folderId(folderId),
+  m_pendingInserts(0),
+  m_openChannels(0),
+  m_numWritten(0),
+  m_bytesRead(0),
+  m_startTime(0),
+  m_fetchesDone(false),
+  m_downloadInProgress(false),
+  m_fetchDoneSlot(this, &PrefetchPartsCommand::FetchResponse),
+  m_getEmailsSlot(this, &PrefetchPartsCommand::GetEmailsResponse),
+  m_updateEmailsSlot(this, &PrefetchPartsCommand::UpdateEmailsResponse)
+{
+}
+
+PrefetchPartsCommand::~PrefetchPartsCommand()
+{
+}
+
+void PrefetchPartsCommand::AddEmail(const MojObject& emailId, UID uid)
+{
+	m_emails.push_back( PrefetchEmail(emailId, uid) );
+}
+
+void PrefetchPartsCommand::AddPart(const EmailPartPtr& part, bool isFirstBodyPart)
+{
+	assert( !m_emails.empty() );
+
+	size_t emailIndex = m_emails.size() - 1;
+	UID uid = m_emails.back().uid;
+
+	PartKey key(uid, part->GetSection());
+
+	if(part->GetSection().empty() || m_partsByKey.find(key) != m_partsByKey.end()) {
+		// Can't request this part, or it's already in the batch
+		return;
+	}
+
+	PrefetchPartPtr prefetchPart(new PrefetchPart(*this, emailIndex, uid, part, isFirstBodyPart));
+
+	m_parts.push_back(prefetchPart);
+	m_partsByKey[key] = prefetchPart;
+}
+
+bool PrefetchPartsCommand::RemovePart(const MojObject& emailId, const MojObject& partId)
+{
+	bool wantBodyPart = partId.undefined() || partId.null();
+
+	BOOST_FOREACH(const PrefetchPartPtr& part, m_parts) {
+		PrefetchEmail& email = m_emails.at(part->GetEmailIndex());
+
+		if(!(email.emailId == emailId) || part->IsRemoved()) {
+			continue;
+		}
+
+		bool matches = wantBodyPart ? part->IsFirstBodyPart() : part->GetPart()->GetId() == partId;
+
+		if(!matches) {
+			continue;
+		}
+
+		if(part->IsWritten()) {
+			// Already downloaded; the path will be saved shortly
+			return false;
+		}
+
+		part->SetRemoved();
+
+		if(part->IsRequested()) {
+			email.numRequested--;
+		}
+
+		// Release the file cache entry unless the file cache request is still pending
+		// or the part is being written; those are cleaned up when they complete.
+		if(!part->IsOpened() && !part->GetPath().empty()) {
+			part->Cleanup();
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+void PrefetchPartsCommand::RunImpl()
+{
+	CommandTraceFunction();
+
+	m_startTime = DateUtils::GetMonotonicTimeMillis();
+
+	if(m_parts.empty()) {
+		Complete();
+		return;
+	}
+
+	InsertFileCache();
+}
+
+void PrefetchPartsCommand::InsertFileCache()
+{
+	CommandTraceFunction();
+
+	m_pendingInserts = m_parts.size();
+
+	// The file cache requests are independent, so send them all at once
+	BOOST_FOREACH(const PrefetchPartPtr& part, m_parts) {
+		part->InsertFileCache(m_session.GetFileCacheClient());
+	}
+}
+
+void PrefetchPartsCommand::FileCacheInserted(PrefetchPart* part, bool success)
+{
+	CommandTraceFunction();
+
+	try {
+		if(!success) {
+			MojLogWarning(m_log, "couldn't create file cache entry for uid %d section %s",
+					part->GetUID(), part->GetPart()->GetSection().c_str());
+		}
+
+		assert( m_pendingInserts > 0 );
+		if(--m_pendingInserts > 0) {
+			return;
+		}
+
+		// Group the emails by the sections needed from each, so each group can be
+		// downloaded with one request
+		for(size_t i = 0; i < m_emails.size(); i++) {
+			stringstream sections;
+
+			BOOST_FOREACH(const PrefetchPartPtr& prefetchPart, m_parts) {
+				if(prefetchPart->GetEmailIndex() != i) {
+					continue;
+				}
+
+				if(prefetchPart->IsRemoved()) {
+					prefetchPart->Cleanup();
+				} else if(!prefetchPart->GetPath().empty()) {
+					sections << " BODY.PEEK[" << prefetchPart->GetPart()->GetSection() << "]";
+					prefetchPart->SetRequested();
+					m_emails[i].numRequested++;
+				}
+			}
+
+			if(!sections.str().empty()) {
+				m_fetchGroups[sections.str()].push_back(m_emails[i].uid);
+			}
+		}
+
+		SendNextFetchRequest();
+	} CATCH_AS_FAILURE
+}
+
+void PrefetchPartsCommand::SendNextFetchRequest()
+{
+	CommandTraceFunction();
+
+	if(m_fetchGroups.empty()) {
+		m_fetchesDone = true;
+		CheckDone();
+		return;
+	}
+
+	map< string, vector<UID> >::iterator group = m_fetchGroups.begin();
+
+	stringstream ss;
+	ss << "UID FETCH ";
+	AppendUIDs(ss, group->second.begin(), group->second.end());
+	ss << " (UID" << group->first << ")";
+
+	m_fetchGroups.erase(group);
+
+	m_fetchResponseParser.reset(new FetchResponseParser(m_session, m_fetchDoneSlot));
+	m_fetchResponseParser->SetPartOutputStreamFactory(this);
+
+	m_downloadInProgress = true;
+
+	m_progressTimer.SetTimeout(FETCH_PROGRESS_TIMEOUT, this, &PrefetchPartsCommand::FetchTimeout);
+
+	m_session.SendRequest(ss.str(), m_fetchResponseParser);
+}
+
+OutputStreamPtr PrefetchPartsCommand::GetPartOutputStream(UID uid, const string& section)
+{
+	map<PartKey, PrefetchPartPtr>::iterator it = m_partsByKey.find( PartKey(uid, section) );
+
+	if(it != m_partsByKey.end() && it->second->IsRemoved()) {
+		MojLogDebug(m_log, "discarding uid %d section %s; downloaded separately", uid, section.c_str());
+		return OutputStreamPtr();
+	}
+
+	if(it == m_partsByKey.end() || it->second->IsOpened() || it->second->GetPath().empty()) {
+		MojLogWarning(m_log, "discarding unexpected part uid %d section %s", uid, section.c_str());
+		return OutputStreamPtr();
+	}
+
+	OutputStreamPtr os = it->second->OpenOutputStream(m_session.GetFileCacheClient(), m_log);
+	m_openChannels++;
+
+	return OutputStreamPtr(new PrefetchProgressOutputStream(os, *this));
+}
+
+void PrefetchPartsCommand::Progress(size_t bytes)
+{
+	m_bytesRead += bytes;
+
+	m_progressTimer.SetTimeout(FETCH_PROGRESS_TIMEOUT, this, &PrefetchPartsCommand::FetchTimeout);
+}
+
+MojErr PrefetchPartsCommand::FetchResponse()
+{
+	CommandTraceFunction();
+
+	try {
+		ImapStatusCode status = m_fetchResponseParser->GetStatus();
+
+		m_fetchResponseParser->SetPartOutputStreamFactory(NULL);
+
+		if(status == NO) {
+			// Some of the emails may have been deleted; keep whatever was returned
+			MojLogWarning(m_log, "server returned NO for part prefetch");
+		} else {
+			m_fetchResponseParser->CheckStatus();
+		}
+
+		m_downloadInProgress = false;
+
+		SendNextFetchRequest();
+	} CATCH_AS_FAILURE
+
+	return MojErrNone;
+}
+
+void PrefetchPartsCommand::PartWritten(PrefetchPart* part)
+{
+	CommandTraceFunction();
+
+	try {
+		assert( m_openChannels > 0 );
+		m_openChannels--;
+
+		if(!part->IsRemoved()) {
+			m_numWritten++;
+			m_emails.at(part->GetEmailIndex()).numWritten++;
+		}
+
+		CheckDone();
+	} CATCH_AS_FAILURE
+}
+
+void PrefetchPartsCommand::CheckDone()
+{
+	// The fetch responses and file channel closures are asynchronous;
+	// wait until all of them are done before writing to the database.
+	if(m_fetchesDone && m_openChannels == 0) {
+		m_progressTimer.Cancel();
+
+		GetEmails();
+	}
+}
+
+void PrefetchPartsCommand::FetchTimeout()
+{
+	MojLogError(m_log, "prefetch timed out after %d seconds with no updates", FETCH_PROGRESS_TIMEOUT);
+
+	m_fetchDoneSlot.cancel();
+
+	MailException exc("prefetch timed out", __FILE__, __LINE__);
+	Failure(exc);
+}
+
+void PrefetchPartsCommand::GetEmails()
+{
+	CommandTraceFunction();
+
+	MojErr err;
+	MojObject::ObjectVec emailIds;
+
+	BOOST_FOREACH(const PrefetchEmail& email, m_emails) {
+		if(email.numWritten > 0) {
+			err = emailIds.push(email.emailId);
+			ErrorToException(err);
+		}
+	}
+
+	if(emailIds.empty()) {
+		UpdateEmails();
+		return;
+	}
+
+	// The parts may have changed since the batch was built (e.g. a part downloaded
+	// by FetchPartCommand in the meantime), so get the current parts arrays to merge into.
+	m_session.GetDatabaseInterface().GetByIds(m_getEmailsSlot, emailIds);
+}
+
+MojErr PrefetchPartsCommand::GetEmailsResponse(MojObject& response, MojErr err)
+{
+	CommandTraceFunction();
+
+	try {
+		ResponseToException(response, err);
+
+		BOOST_FOREACH(const MojObject& emailObj, DatabaseAdapter::GetResultsIterators(response)) {
+			MojObject emailId;
+			err = emailObj.getRequired(DatabaseAdapter::ID, emailId);
+			ErrorToException(err);
+
+			bool deleted = false, found = false;
+			err = emailObj.get(DatabaseAdapter::DEL, deleted, found);
+			ErrorToException(err);
+
+			if(deleted) {
+				continue;
+			}
+
+			BOOST_FOREACH(PrefetchEmail& email, m_emails) {
+				if(email.emailId == emailId) {
+					err = emailObj.getRequired(EmailSchema::PARTS, email.partsArray);
+					ErrorToException(err);
+					break;
+				}
+			}
+		}
+
+		UpdateEmails();
+	} CATCH_AS_FAILURE
+
+	return MojErrNone;
+}
+
+void PrefetchPartsCommand::UpdateEmails()
+{
+	CommandTraceFunction();
+
+	MojErr err;
+	MojObject::ObjectVec emailObjs;
+
+	for(size_t i = 0; i < m_emails.size(); i++) {
+		PrefetchEmail& email = m_emails[i];
+
+		if(email.numRequested == 0) {
+			continue;
+		}
+
+		MojObject emailObj;
+		err = emailObj.put(DatabaseAdapter::ID, email.emailId);
+		ErrorToException(err);
+
+		if(email.numWritten == 0) {
+			// Server didn't return anything; don't keep trying to download it
+			err = emailObj.put(ImapEmailAdapter::AUTO_DOWNLOAD, false);
+			ErrorToException(err);
+
+			err = emailObjs.push(emailObj);
+			ErrorToException(err);
+			continue;
+		}
+
+		if(email.partsArray.undefined()) {
+			// Email was deleted while its parts were being downloaded
+			continue;
+		}
+
+		// Only patch the paths of the parts downloaded here; the rest of the array is left as is
+		BOOST_FOREACH(const PrefetchPartPtr& part, m_parts) {
+			if(part->GetEmailIndex() != i || !part->IsWritten() || part->IsRemoved()) {
+				continue;
+			}
+
+			MojObject::ArrayIterator it;
+			err = email.partsArray.arrayBegin(it);
+			ErrorToException(err);
+
+			for(; it != email.partsArray.arrayEnd(); ++it) {
+				MojObject& partObj = *it;
+
+				MojObject partId;
+				err = partObj.getRequired(DatabaseAdapter::ID, partId);
+				ErrorToException(err);
+
+				if(partId == part->GetPart()->GetId()) {
+					err = partObj.putString(EmailSchema::Part::PATH, part->GetPath().c_str());
+					ErrorToException(err);
+				}
+			}
+
+			if(part->HasPreviewText()) {
+				err = emailObj.putString(EmailSchema::SUMMARY, part->GetPreviewText().c_str());
+				ErrorToException(err);
+			}
+		}
+
+		err = emailObj.put(EmailSchema::PARTS, email.partsArray);
+		ErrorToException(err);
+
+		err = emailObjs.push(emailObj);
+		ErrorToException(err);
+	}
+
+	if(emailObjs.empty()) {
+		Complete();
+		return;
+	}
+
+	m_session.GetDatabaseInterface().UpdateEmails(m_updateEmailsSlot, emailObjs);
+}
+
+MojErr PrefetchPartsCommand::UpdateEmailsResponse(MojObject& response, MojErr err)
+{
+	CommandTraceFunction();
+
+	try {
+		ResponseToException(response, err);
+
+		MojInt64 elapsed = DateUtils::GetMonotonicTimeMillis() - m_startTime;
+
+		MojLogInfo(m_log, "prefetched %d/%d parts (%lld bytes) from %d emails in %lld ms",
+				(int) m_numWritten, (int) m_parts.size(), m_bytesRead, (int) m_emails.size(), elapsed);
+
+		m_session.PrefetchComplete(m_numWritten, m_bytesRead, elapsed);
+
+		Complete();
+	} CATCH_AS_FAILURE
+
+	return MojErrNone;
+}
+
+void PrefetchPartsCommand::Failure(const exception& e)
+{
+	m_fetchDoneSlot.cancel();
+
+	BOOST_FOREACH(const PrefetchPartPtr& part, m_parts) {
+		part->Cleanup();
+	}
+
+	if(m_downloadInProgress) {
+		m_downloadInProgress = false;
+
+		// Fatal because the parser may not be able to recover
+		m_session.FatalError("failure while prefetching parts");
+	}
+
+	ImapSessionCommand::Failure(e);
+}
+
+void PrefetchPartsCommand::Cleanup()
+{
+	if(m_fetchResponseParser.get()) {
+		m_fetchResponseParser->SetPartOutputStreamFactory(NULL);
+	}
+
+	BOOST_FOREACH(const PrefetchPartPtr& part, m_parts) {
+		part->Cleanup();
+	}
+
+	m_progressTimer.Cancel();
+
+	ImapSessionCommand::Cleanup();
+}
+
+void PrefetchPartsCommand::Status(MojObject& status) const
+{
+	MojErr err;
+	ImapSessionCommand::Status(status);
+
+	err = status.put("folderId", m_folderId);
+	ErrorToException(err);
+
+	err = status.put("numEmails", (MojInt64) m_emails.size());
+	ErrorToException(err);
+
+	err = status.put("numParts", (MojInt64) m_parts.size());
+	ErrorToException(err);
+
+	err = status.put("partsWritten", (MojInt64) m_numWritten);
+	ErrorToException(err);
+
+	err = status.put("bytesRead", m_bytesRead);
+	ErrorToException(err);
+}
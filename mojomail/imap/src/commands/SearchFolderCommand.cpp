@@ -50,7 +50,7 @@ void SearchFolderCommand::RunImpl()
 
 	stringstream ss;
 
-	ss << "UID SEARCH CHARSET UTF-8 NOT DELETED TEXT {" << m_searchRequest->GetSearchText().length();
+	ss << "CHARSET UTF-8 NOT DELETED TEXT {" << m_searchRequest->GetSearchText().length();
 
 	if (m_session.GetCapabilities().HasCapability("LITERAL+")) {
 		ss << "+";
@@ -59,8 +59,10 @@ void SearchFolderCommand::RunImpl()
 
 	ss << "}";
 
+	string command = UidSearchResponseParser::BuildSearchCommand(m_session.GetCapabilities(), ss.str());
+
 	m_searchResponseParser.reset(new UidSearchResponseParser(m_session, m_searchResponseSlot, m_matchingUIDs));
-	m_session.SendRequest(ss.str(), m_searchResponseParser);
+	m_session.SendRequest(command, m_searchResponseParser);
 
 	if (sendLiteralNow) {
 		HandleContinuation();
@@ -91,8 +91,23 @@ void SelectFolderCommand::SelectFolder()
 {
 	CommandTraceFunction();
 
+	string selectCommand = "SELECT " + QuoteString(m_folder->GetFolderName());
+
+	Capabilities& capabilities = m_session.GetCapabilities();
+
+	if(capabilities.HasCapability(Capabilities::QRESYNC) && capabilities.HasCapability(Capabilities::ENABLE)) {
+		if(!m_session.IsQResyncEnabled()) {
+			// Sent along with the SELECT; the ENABLED response is picked up by the select parser.
+			// QRESYNC implies CONDSTORE, so the SELECT will report HIGHESTMODSEQ.
+			m_enableParser.reset(new ImapResponseParser(m_session));
+			m_session.SendRequest("ENABLE " + Capabilities::QRESYNC, m_enableParser);
+		}
+	} else if(capabilities.HasCapability(Capabilities::CONDSTORE)) {
+		selectCommand += " (CONDSTORE)";
+	}
+
 	m_responseParser.reset(new ExamineResponseParser(m_session, m_selectFolderResponseSlot));
-	m_session.SendRequest("SELECT " + QuoteString(m_folder->GetFolderName()), m_responseParser);
+	m_session.SendRequest(selectCommand, m_responseParser);
 }
 
 MojErr SelectFolderCommand::SelectResponse()
@@ -100,6 +115,10 @@ MojErr SelectFolderCommand::SelectResponse()
 	CommandTraceFunction();
 
 	try {
+		if(m_responseParser->IsQResyncEnabled()) {
+			m_session.SetQResyncEnabled(true);
+		}
+
 		ImapStatusCode status = m_responseParser->GetStatus();
 		if(status == OK) {
 			UID serverUIDValidity = m_responseParser->GetUIDValidity();
@@ -163,6 +182,11 @@ void SelectFolderCommand::UpdateFolder()
 	err = updatedFolder.put(ImapFolderAdapter::UIDVALIDITY, (MojInt64) m_folder->GetUIDValidity());
 	ErrorToException(err);
 
+	// Mod sequences from the old UIDVALIDITY are meaningless; force a full sync
+	m_folder->SetHighestModSeq(0);
+	err = updatedFolder.put(ImapFolderAdapter::HIGHEST_MODSEQ, (MojInt64) 0);
+	ErrorToException(err);
+
 	m_session.GetDatabaseInterface().UpdateFolder(m_updateFolderSlot, updatedFolder);
 }
 
@@ -188,6 +212,8 @@ void SelectFolderCommand::SelectDone()
 	if(m_responseParser->GetExistsCount() > 0) // -1 means unknown
 		folderSession->SetMessageCount( m_responseParser->GetExistsCount() );
 
+	folderSession->SetHighestModSeq( m_responseParser->GetHighestModSeq() );
+
 	m_session.SetFolderSession(folderSession);
 	m_session.FolderSelected();
 	Complete();
@@ -17,8 +17,6 @@
 // LICENSE@@@
 
 #include "commands/SyncEmailsCommand.h"
-#include <boost/date_time/posix_time/posix_time.hpp>
-#include <boost/date_time/gregorian/gregorian_types.hpp>
 #include <sstream>
 #include "client/ImapSession.h"
 #include "commands/AutoDownloadCommand.h"
@@ -26,11 +24,15 @@
 #include "data/DatabaseInterface.h"
 #include "data/ImapEmailAdapter.h"
 #include "data/ImapEmail.h"
+#include "data/ImapFolder.h"
+#include "data/ImapFolderAdapter.h"
 #include "data/EmailSchema.h"
 #include "ImapPrivate.h"
 #include "sync/UIDMap.h"
 #include "protocol/UidSearchResponseParser.h"
+#include "protocol/ChangedSinceResponseParser.h"
 #include "protocol/FetchResponseParser.h"
+#include "client/Capabilities.h"
 #include "client/FolderSession.h"
 #include <algorithm>
 #include "sync/SyncEngine.h"
@@ -40,19 +42,37 @@
 #include "client/SyncSession.h"
 #include "ImapConfig.h"
 #include "commands/FetchNewHeadersCommand.h"
+#include "email/DateUtils.h"
 
-using namespace boost::gregorian;
+// Date for SEARCH SINCE, e.g. "04-Jun-2013"
+string SinceDateString(int daysBack)
+{
+	return DateUtils::FormatRfc3501Date(time(NULL) - time_t(daysBack) * 24 * 60 * 60);
+}
 
 SyncEmailsCommand::SyncEmailsCommand(ImapSession& session, const MojObject& folderId, SyncParams syncParams)
 : ImapSyncSessionCommand(session, folderId),
+  m_daysBack(0),
+  m_roundTrips(0),
+  m_hasMoreLocalEmails(false),
+  m_flushingPage(false),
+  m_fullSyncRequired(false),
+  m_syncModSeq(0),
+  m_hasFetchedEmails(false),
+  m_putInProgress(false),
+  m_putCount(0),
+  m_fetchStartTime(0),
+  m_putStartTime(0),
   m_syncParams(syncParams),
   m_syncLocalChangesSlot(this, &SyncEmailsCommand::SyncLocalChangesDone),
   m_searchResponseSlot(this, &SyncEmailsCommand::SearchResponse),
+  m_changedSinceResponseSlot(this, &SyncEmailsCommand::ChangedSinceResponse),
   m_fetchResponseSlot(this, &SyncEmailsCommand::FetchResponse),
   m_getLocalEmailsResponseSlot(this, &SyncEmailsCommand::GetLocalEmailsResponse),
   m_putEmailsResponseSlot(this, &SyncEmailsCommand::PutEmailsResponse),
   m_deleteLocalEmailsResponseSlot(this, &SyncEmailsCommand::DeleteLocalEmailsResponse),
   m_mergeFlagsResponseSlot(this, &SyncEmailsCommand::MergeFlagsResponse),
+  m_updateFolderStateSlot(this, &SyncEmailsCommand::UpdateFolderStateResponse),
   m_autoDownloadSlot(this, &SyncEmailsCommand::AutoDownloadDone)
 {
 	assert(!folderId.undefined() && !folderId.null());
@@ -68,6 +88,12 @@ void SyncEmailsCommand::RunImpl()
 	// Get sync window from preferences.
 	assert( m_session.GetAccount().get() != NULL );
 	m_daysBack = m_session.GetAccount()->GetSyncWindowDays();
+
+	// If daysBack is 0, get all emails, otherwise limit the sync to emails SINCE this date
+	if(m_daysBack > 0) {
+		m_sinceDate = SinceDateString(m_daysBack);
+	}
+
 	SyncLocalChanges();
 }
 
@@ -97,39 +123,193 @@ void SyncEmailsCommand::SyncServerChanges()
 	CommandTraceFunction();
 
 	try {
+		// Anything that changes after this point will show up as changed in the next sync
+		m_syncModSeq = m_session.GetFolderSession()->GetHighestModSeq();
+
+		if(m_unreadCountParser.get() == NULL) {
+			GetUnreadCount();
+		}
+
+		if(CanSyncChangedSince()) {
+			SyncChangedSince();
+			return;
+		}
+
 		m_pendingSearches.push(ALL); // this one is essential
 		m_pendingSearches.push(DELETED);
 		m_pendingSearches.push(UNSEEN);
 		m_pendingSearches.push(ANSWERED);
 		m_pendingSearches.push(FLAGGED);
 
-		Search();
+		if(ImapConfig::GetConfig().GetPipelineSearches() && !m_session.IsSafeMode()) {
+			PipelineSearches();
+		} else {
+			Search();
+		}
 	} CATCH_AS_FAILURE
 }
 
-// TODO move this to another class
-string SinceDateString(int daysBack)
+/**
+ * Sent along with the sync requests; nothing waits for the result, which
+ * arrives before the responses to the requests sent after it.
+ */
+void SyncEmailsCommand::GetUnreadCount()
+{
+	CommandTraceFunction();
+
+	// Without ESEARCH, the server would send every matching UID, which is what this avoids
+	if(!m_session.GetCapabilities().HasCapability(Capabilities::ESEARCH) || m_session.IsSafeMode()) {
+		return;
+	}
+
+	string command = UidSearchResponseParser::BuildSearchCommand(m_session.GetCapabilities(), "UNSEEN NOT DELETED",
+			UidSearchResponseParser::RETURN_COUNT);
+
+	m_unreadCountParser.reset(new UidSearchResponseParser(m_session));
+	m_session.SendRequest(command, m_unreadCountParser);
+}
+
+bool SyncEmailsCommand::CanSyncChangedSince()
+{
+	boost::shared_ptr<FolderSession> folderSession = m_session.GetFolderSession();
+	assert( folderSession.get() );
+
+	// QRESYNC is needed to find out about expunged messages
+	if(!m_session.IsQResyncEnabled() || m_session.IsSafeMode() || m_fullSyncRequired) {
+		return false;
+	}
+
+	// Need the mod sequence from the last successful sync
+	const ImapFolderPtr& folder = folderSession->GetFolder();
+	if(folderSession->GetHighestModSeq() == 0 || folder->GetHighestModSeq() == 0) {
+		return false;
+	}
+
+	// Messages that enter or leave the window because it moved (once a day) or changed size
+	// don't show up as changed, so the window has to be synced from scratch.
+	if(folder->GetModSeqSinceDate() != m_sinceDate || folder->GetModSeqMaxEmails() != ImapConfig::GetConfig().GetMaxEmails()) {
+		MojLogInfo(m_log, "sync window for folder %s changed; doing a full sync", AsJsonString(m_folderId).c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Only get the messages that changed since the last sync, instead of searching the entire folder.
+ *
+ * Unlike the QRESYNC parameter to SELECT (RFC 7162 3.2.5), this is a separate request after
+ * a plain SELECT, so selecting the folder works the same way for every kind of sync.
+ *
+ * The request is always sent, even if the HIGHESTMODSEQ we know about matches the saved one;
+ * on a connection that's been kept open, it may not have been updated since the folder was selected.
+ */
+void SyncEmailsCommand::SyncChangedSince()
 {
-	date d = day_clock::universal_day() - days(daysBack);
+	CommandTraceFunction();
+
+	boost::shared_ptr<FolderSession> folderSession = m_session.GetFolderSession();
+
+	MojUInt64 localModSeq = folderSession->GetFolder()->GetHighestModSeq();
+
+	m_roundTrips++;
 
 	stringstream ss;
-	date_facet *df = new date_facet("%d-%b-%Y"); // will be freed by locale
-	locale loc = locale(locale("C"), df);
-	ss.imbue(loc);
-	ss << d;
-	
-	return ss.str();
+	ss << "UID FETCH 1:* (FLAGS) (CHANGEDSINCE " << localModSeq << " VANISHED)";
+
+	m_changedSinceParser.reset(new ChangedSinceResponseParser(m_session, m_changedSinceResponseSlot, m_remoteChanges, m_vanishedUIDs));
+	m_session.SendRequest(ss.str(), m_changedSinceParser);
+}
+
+MojErr SyncEmailsCommand::ChangedSinceResponse()
+{
+	CommandTraceFunction();
+
+	try {
+		m_changedSinceParser->CheckStatus();
+
+		// The server has at least this mod sequence now
+		MojUInt64 modSeq = m_changedSinceParser->GetHighestModSeq();
+		if(modSeq > m_syncModSeq) {
+			m_syncModSeq = modSeq;
+		}
+
+		m_session.GetFolderSession()->UpdateHighestModSeq(modSeq);
+
+		ChangedSinceComplete();
+	} CATCH_AS_FAILURE
+
+	return MojErrNone;
+}
+
+void SyncEmailsCommand::ChangedSinceComplete()
+{
+	CommandTraceFunction();
+
+	MojLogInfo(m_log, "%d changed and %d vanished messages since last sync", (int) m_remoteChanges.size(), (int) m_vanishedUIDs.size());
+
+	sort(m_remoteChanges.begin(), m_remoteChanges.end());
+
+	// The UID map gets created after the local emails have been diff'd
+	m_syncEngine.reset(new SyncEngine(m_remoteChanges, m_vanishedUIDs, ImapConfig::GetConfig().GetMaxEmails()));
+
+	GetLocalEmails();
+}
+
+void SyncEmailsCommand::FallBackToFullSync()
+{
+	CommandTraceFunction();
+
+	m_fullSyncRequired = true;
+
+	m_syncEngine.reset();
+	m_changedSinceParser.reset();
+	m_remoteChanges.clear();
+	m_vanishedUIDs.clear();
+	m_localEmailsPage.clear();
+
+	SyncServerChanges();
+}
+
+/**
+ * Sends all pending searches without waiting for the previous one to complete,
+ * so the whole set only costs a single round trip.
+ *
+ * ESEARCH results are matched to their parser by tag. Plain SEARCH results aren't
+ * tagged, so each parser claims the first one that hasn't already been claimed; this
+ * relies on the server answering in the order the searches were sent. Only the last
+ * parser reports completion.
+ */
+void SyncEmailsCommand::PipelineSearches()
+{
+	CommandTraceFunction();
+
+	m_roundTrips++;
+
+	while(!m_pendingSearches.empty()) {
+		SearchType searchType = m_pendingSearches.front();
+		m_pendingSearches.pop();
+
+		SendSearch(searchType, m_pendingSearches.empty());
+	}
 }
 
 void SyncEmailsCommand::Search()
 {
 	CommandTraceFunction();
 
-	string currentSearch;
+	m_roundTrips++;
 
 	SearchType searchType = m_pendingSearches.front();
 	m_pendingSearches.pop();
 
+	SendSearch(searchType, true);
+}
+
+void SyncEmailsCommand::SendSearch(SearchType searchType, bool notifyWhenDone)
+{
+	string currentSearch;
+
 	std::vector<UID>* targetList;
 
 	switch(searchType) {
@@ -159,15 +339,25 @@ void SyncEmailsCommand::Search()
 	}
 
 	stringstream ss;
-	ss << "UID SEARCH " << currentSearch;
+	ss << currentSearch;
 
-	if(m_daysBack > 0) {
-		// If daysBack is 0, get all emails, otherwise add the SINCE parameter
-		ss << " SINCE " << SinceDateString(m_daysBack);
+	if(!m_sinceDate.empty()) {
+		ss << " SINCE " << m_sinceDate;
+	}
+
+	// With ESEARCH, the results come back as a compact sequence set instead of one UID per word
+	string command = UidSearchResponseParser::BuildSearchCommand(m_session.GetCapabilities(), ss.str());
+
+	MojRefCountedPtr<UidSearchResponseParser> parser;
+
+	if(notifyWhenDone) {
+		parser.reset(new UidSearchResponseParser(m_session, m_searchResponseSlot, *targetList));
+	} else {
+		parser.reset(new UidSearchResponseParser(m_session, *targetList));
 	}
 
-	m_responseParser.reset(new UidSearchResponseParser(m_session, m_searchResponseSlot, *targetList));
-	m_session.SendRequest(ss.str(), m_responseParser);
+	m_searchParsers.push_back(parser);
+	m_session.SendRequest(command, parser);
 }
 
 MojErr SyncEmailsCommand::SearchResponse()
@@ -175,8 +365,19 @@ MojErr SyncEmailsCommand::SearchResponse()
 	CommandTraceFunction();
 
 	try {
-		// Check error
-		m_responseParser->CheckStatus();
+		// Check errors for every search sent so far
+		BOOST_FOREACH(const MojRefCountedPtr<UidSearchResponseParser>& parser, m_searchParsers) {
+			if(parser->GetStatus() == STATUS_UNKNOWN) {
+				// The server didn't complete the pipelined searches in order.
+				// Use safe mode so the next sync sends them one at a time.
+				m_session.SetSafeMode(true);
+				throw MailException("pipelined search completed out of order", __FILE__, __LINE__);
+			}
+
+			parser->CheckStatus();
+		}
+
+		m_searchParsers.clear();
 
 		// Run next search, or finish searches
 		if(!m_pendingSearches.empty()) {
@@ -213,6 +414,13 @@ void SyncEmailsCommand::SearchComplete()
 	// Initialize sync engine with sorted lists
 	m_syncEngine.reset(new SyncEngine(m_uidMap->GetUIDs(), m_deletedUIDs, m_unseenUIDs, m_answeredUIDs, m_flaggedUIDs));
 
+	// The sync engine keeps its own compressed copy of the flag lists
+	vector<UID>().swap(m_allUIDs);
+	vector<UID>().swap(m_deletedUIDs);
+	vector<UID>().swap(m_unseenUIDs);
+	vector<UID>().swap(m_answeredUIDs);
+	vector<UID>().swap(m_flaggedUIDs);
+
 	GetLocalEmails();
 }
 
@@ -272,15 +480,29 @@ MojErr SyncEmailsCommand::GetLocalEmailsResponse(MojObject& response, MojErr err
 		bool hasMore = DatabaseAdapter::GetNextPage(response, m_localEmailsPage);
 
 		assert( m_syncEngine.get() != NULL );
+
+		if(m_syncEngine->IsIncremental() && !m_syncEngine->HasLocalEmails() && localEmails.empty() && !hasMore) {
+			// Nothing to apply the changes to; get the whole sync window instead
+			MojLogInfo(m_log, "no local emails in folder %s; doing a full sync", AsJsonString(m_folderId).c_str());
+			FallBackToFullSync();
+			return MojErrNone;
+		}
+
 		m_syncEngine->Diff(localEmails, hasMore);
 
-		if(hasMore) {
-			// Get next batch of emails
-			MojLogDebug(m_log, "getting another batch of local emails");
-			GetLocalEmails();
+		m_hasMoreLocalEmails = hasMore;
+
+		if(ImapConfig::GetConfig().GetFlushSyncChangesPerPage()) {
+			// Save this page's deletes and flag changes before getting the next page,
+			// so they don't pile up in memory for the whole folder. Note that this
+			// means they're saved before any new emails are fetched.
+			MojLogDebug(m_log, "%d deleted emails, %d changed emails in page",
+					(int) m_syncEngine->GetDeletedIds().size(), (int) m_syncEngine->GetModifiedFlags().size());
+
+			m_flushingPage = true;
+			DeleteLocalEmails();
 		} else {
-			// After all changes are accounted for, handle fetching new messages and updating/deleting existing messages
-			SyncUpdatesFromServer();
+			LocalEmailsPageDone();
 		}
 
 	} CATCH_AS_FAILURE
@@ -288,6 +510,36 @@ MojErr SyncEmailsCommand::GetLocalEmailsResponse(MojObject& response, MojErr err
 	return MojErrNone;
 }
 
+void SyncEmailsCommand::LocalEmailsPageDone()
+{
+	CommandTraceFunction();
+
+	if(m_hasMoreLocalEmails) {
+		// Get next batch of emails
+		MojLogDebug(m_log, "getting another batch of local emails");
+		GetLocalEmails();
+	} else {
+		if(m_syncEngine->IsIncremental()) {
+			// Create UID map from the local emails that are still on the server, plus new emails
+			boost::shared_ptr<FolderSession> folderSession = m_session.GetFolderSession();
+			unsigned int maxSize = ImapConfig::GetConfig().GetMaxEmails();
+
+			// The oldest emails need to be removed to stay under the limit, which only a full sync does
+			if(maxSize > 0 && m_syncEngine->GetRemainingUIDs().size() > maxSize) {
+				MojLogInfo(m_log, "folder %s has more than %u emails; doing a full sync", AsJsonString(m_folderId).c_str(), maxSize);
+				FallBackToFullSync();
+				return;
+			}
+
+			m_uidMap = make_shared<UIDMap>(m_syncEngine->GetRemainingUIDs(), folderSession->GetMessageCount(), maxSize);
+			folderSession->SetUIDMap(m_uidMap);
+		}
+
+		// After all changes are accounted for, handle fetching new messages and updating/deleting existing messages
+		SyncUpdatesFromServer();
+	}
+}
+
 void SyncEmailsCommand::SyncUpdatesFromServer()
 {
 	CommandTraceFunction();
@@ -295,7 +547,8 @@ void SyncEmailsCommand::SyncUpdatesFromServer()
 	MojLogInfo(m_log, "%d new emails, %d deleted emails, %d changed emails on server",
 			m_syncEngine->GetNewUIDs().size(), m_syncEngine->GetDeletedIds().size(), m_syncEngine->GetModifiedFlags().size());
 
-	// Order is important here!
+	// Order is important here! New emails are fetched first so they show up as soon as possible.
+	// If the deletes and flag changes were saved after each page, only the new emails are left.
 	if(!m_syncEngine->GetNewUIDs().empty())
 		FetchNewMessages();
 	else if(!m_syncEngine->GetDeletedIds().empty())
@@ -303,7 +556,7 @@ void SyncEmailsCommand::SyncUpdatesFromServer()
 	else if(!m_syncEngine->GetModifiedFlags().empty())
 		MergeFlags();
 	else
-		AutoDownload();
+		UpdateFolderState();
 }
 
 void SyncEmailsCommand::FetchNewMessages()
@@ -313,6 +566,15 @@ void SyncEmailsCommand::FetchNewMessages()
 	// Copy to queue
 	m_pendingHeaders.insert(m_pendingHeaders.begin(), m_syncEngine->GetNewUIDs().begin(), m_syncEngine->GetNewUIDs().end());
 
+	const ImapConfig& config = ImapConfig::GetConfig();
+	int batchSize = config.GetHeaderBatchSize();
+
+	if(config.GetAdaptiveHeaderBatch()) {
+		m_batchSizeTuner.reset(new BatchSizeTuner(batchSize, batchSize, config.GetMaxHeaderBatchSize()));
+	} else {
+		m_batchSizeTuner.reset(new BatchSizeTuner(batchSize, batchSize, batchSize));
+	}
+
 	FetchOneBatch();
 }
 
@@ -320,28 +582,27 @@ void SyncEmailsCommand::FetchOneBatch()
 {
 	CommandTraceFunction();
 
-	stringstream ss;
-	ss << "UID FETCH ";
+	int batchSize = m_session.IsSafeMode() ? 1 : m_batchSizeTuner->GetBatchSize();
 
-	int batchSize = m_session.IsSafeMode() ? 1 : ImapConfig::GetConfig().GetHeaderBatchSize();
-
-	int count = 0;
-	while(!m_pendingHeaders.empty() && count < batchSize) {
-		UID uid = m_pendingHeaders.back();
+	// Each batch takes the newest UIDs left, so new mail shows up first.
+	// Within a batch the UIDs are sent as a sorted range set, so the server
+	// will usually return them oldest first.
+	vector<UID> batch;
+	while(!m_pendingHeaders.empty() && (int) batch.size() < batchSize) {
+		batch.push_back(m_pendingHeaders.back());
 		m_pendingHeaders.pop_back();
-
-		if(count > 0) { // first item in set
-			ss << ",";
-		}
-
-		ss << uid;
-		count++;
 	}
 
+	stringstream ss;
+	ss << "UID FETCH ";
+	AppendUIDs(ss, batch.begin(), batch.end());
 	ss << " (" << FetchNewHeadersCommand::FETCH_ITEMS << ")";
 
 	string command = ss.str();
 
+	m_roundTrips++;
+	m_fetchStartTime = DateUtils::GetMonotonicTimeMillis();
+
 	m_fetchResponseParser.reset(new FetchResponseParser(m_session, m_fetchResponseSlot));
 	m_session.SendRequest(command, m_fetchResponseParser);
 }
@@ -361,6 +622,8 @@ MojErr SyncEmailsCommand::FetchResponse()
 			throw; // rethrow exception
 		}
 
+		m_batchSizeTuner->FetchComplete(m_fetchResponseParser->GetUpdates().size(), DateUtils::GetMonotonicTimeMillis() - m_fetchStartTime);
+
 		BOOST_FOREACH(const FetchUpdate& update, m_fetchResponseParser->GetUpdates()) {
 			const boost::shared_ptr<ImapEmail>& email = update.email;
 
@@ -384,18 +647,68 @@ MojErr SyncEmailsCommand::FetchResponse()
 			err = array.push(emailObj);
 			ErrorToException(err);
 		}
-		m_session.GetDatabaseInterface().PutEmails(m_putEmailsResponseSlot, array);
 
+		const ParserArena::Stats& stats = m_fetchResponseParser->GetArenaStats();
+		MojLogInfo(m_log, "parsed %d headers with %d allocations (%d bytes) from %d heap blocks",
+				(int) m_fetchResponseParser->GetUpdates().size(), (int) stats.numAllocations, (int) stats.bytesAllocated, (int) stats.numBlocks);
+
+		// Releases the parser's arena once the emails are serialized
+		m_fetchResponseParser.reset();
+
+		if(!m_putInProgress) {
+			PutEmails(array);
+		} else {
+			// Hold on to these until the current put finishes
+			assert( !m_hasFetchedEmails );
+			m_fetchedEmails = array;
+			m_hasFetchedEmails = true;
+		}
+
+		ContinueFetchingHeaders();
 	} CATCH_AS_FAILURE
 
 	return MojErrNone;
 }
 
+void SyncEmailsCommand::ContinueFetchingHeaders()
+{
+	CommandTraceFunction();
+
+	bool fetchInProgress = m_fetchResponseParser.get() != NULL;
+
+	if(!m_pendingHeaders.empty()) {
+		// Only fetch ahead if the fetched headers have somewhere to go. In safe mode,
+		// wait for each batch to be saved before fetching the next.
+		bool canPipeline = ImapConfig::GetConfig().GetPipelineHeaderFetch() && !m_session.IsSafeMode();
+
+		if(!fetchInProgress && !m_hasFetchedEmails && (canPipeline || !m_putInProgress)) {
+			FetchOneBatch();
+		}
+	} else if(!fetchInProgress && !m_putInProgress && !m_hasFetchedEmails) {
+		MojLogInfo(m_log, "finished fetching headers; final batch size %d", m_batchSizeTuner->GetBatchSize());
+
+		DeleteLocalEmails();
+	}
+}
+
+void SyncEmailsCommand::PutEmails(const MojObject::ObjectVec& emails)
+{
+	CommandTraceFunction();
+
+	m_putInProgress = true;
+	m_putCount = emails.size();
+	m_putStartTime = DateUtils::GetMonotonicTimeMillis();
+
+	m_session.GetDatabaseInterface().PutEmails(m_putEmailsResponseSlot, emails);
+}
+
 MojErr SyncEmailsCommand::PutEmailsResponse(MojObject& response, MojErr err)
 {
 	CommandTraceFunction();
 
 	try {
+		m_putInProgress = false;
+
 		if(err != MojErrNone) {
 			// Possible UTF-8 error
 			m_session.SetSafeMode(true);
@@ -405,11 +718,17 @@ MojErr SyncEmailsCommand::PutEmailsResponse(MojObject& response, MojErr err)
 
 		m_syncSession->AddPutResponseRevs(response);
 
-		if(!m_pendingHeaders.empty()) {
-			FetchOneBatch();
-		} else {
-			DeleteLocalEmails();
+		m_batchSizeTuner->PutComplete(m_putCount, DateUtils::GetMonotonicTimeMillis() - m_putStartTime);
+
+		if(m_hasFetchedEmails) {
+			MojObject::ObjectVec emails = m_fetchedEmails;
+			m_fetchedEmails.clear();
+			m_hasFetchedEmails = false;
+
+			PutEmails(emails);
 		}
+
+		ContinueFetchingHeaders();
 	} CATCH_AS_FAILURE
 
 	return MojErrNone;
@@ -488,7 +807,10 @@ void SyncEmailsCommand::MergeFlags()
 		modified.push(obj);
 	}
 
-	m_session.GetDatabaseInterface().MergeFlags(m_mergeFlagsResponseSlot, modified);
+	if(!modified.empty())
+		m_session.GetDatabaseInterface().MergeFlags(m_mergeFlagsResponseSlot, modified);
+	else
+		MergeFlagsDone();
 }
 
 MojErr SyncEmailsCommand::MergeFlagsResponse(MojObject& response, MojErr err)
@@ -500,6 +822,92 @@ MojErr SyncEmailsCommand::MergeFlagsResponse(MojObject& response, MojErr err)
 
 		m_syncSession->AddPutResponseRevs(response);
 
+		MergeFlagsDone();
+	} CATCH_AS_FAILURE
+
+	return MojErrNone;
+}
+
+void SyncEmailsCommand::MergeFlagsDone()
+{
+	CommandTraceFunction();
+
+	if(m_flushingPage) {
+		// Done with this page of local emails
+		m_flushingPage = false;
+		m_syncEngine->ClearDeletedAndModified();
+
+		LocalEmailsPageDone();
+	} else {
+		UpdateFolderState();
+	}
+}
+
+void SyncEmailsCommand::UpdateFolderState()
+{
+	CommandTraceFunction();
+
+	boost::shared_ptr<FolderSession> folderSession = m_session.GetFolderSession();
+	assert( folderSession.get() );
+
+	const ImapFolderPtr& folder = folderSession->GetFolder();
+	MojUInt64 serverModSeq = m_syncModSeq;
+	int maxEmails = ImapConfig::GetConfig().GetMaxEmails();
+
+	bool windowChanged = folder->GetModSeqSinceDate() != m_sinceDate || folder->GetModSeqMaxEmails() != maxEmails;
+	bool modSeqChanged = serverModSeq > 0 && (serverModSeq != folder->GetHighestModSeq() || windowChanged);
+
+	int unreadCount = -1;
+	if(m_unreadCountParser.get() && m_unreadCountParser->GetStatus() == OK) {
+		unreadCount = m_unreadCountParser->GetCount();
+	}
+
+	bool unreadCountChanged = unreadCount >= 0 && unreadCount != folder->GetServerUnreadCount();
+
+	if(modSeqChanged || unreadCountChanged) {
+		MojErr err;
+		MojObject updatedFolder;
+
+		err = updatedFolder.put(DatabaseAdapter::ID, m_folderId);
+		ErrorToException(err);
+
+		if(modSeqChanged) {
+			err = updatedFolder.put(ImapFolderAdapter::HIGHEST_MODSEQ, (MojInt64) serverModSeq);
+			ErrorToException(err);
+
+			// The mod sequence is only valid for the window it was synced with
+			err = updatedFolder.putString(ImapFolderAdapter::MODSEQ_SINCE_DATE, m_sinceDate.c_str());
+			ErrorToException(err);
+
+			err = updatedFolder.put(ImapFolderAdapter::MODSEQ_MAX_EMAILS, (MojInt64) maxEmails);
+			ErrorToException(err);
+
+			folder->SetHighestModSeq(serverModSeq);
+			folder->SetModSeqSyncWindow(m_sinceDate, maxEmails);
+		}
+
+		if(unreadCountChanged) {
+			MojLogInfo(m_log, "%d unread emails in folder %s on server", unreadCount, AsJsonString(m_folderId).c_str());
+
+			err = updatedFolder.put(ImapFolderAdapter::SERVER_UNREAD_COUNT, (MojInt64) unreadCount);
+			ErrorToException(err);
+
+			folder->SetServerUnreadCount(unreadCount);
+		}
+
+		m_session.GetDatabaseInterface().UpdateFolder(m_updateFolderStateSlot, updatedFolder);
+	} else {
+		AutoDownload();
+	}
+}
+
+MojErr SyncEmailsCommand::UpdateFolderStateResponse(MojObject& response, MojErr err)
+{
+	CommandTraceFunction();
+
+	try {
+		ErrorToException(err);
+
 		AutoDownload();
 	} CATCH_AS_FAILURE
 
@@ -510,6 +918,8 @@ void SyncEmailsCommand::AutoDownload()
 {
 	CommandTraceFunction();
 
+	MojLogInfo(m_log, "sync of folder %s took %d round trips", AsJsonString(m_folderId).c_str(), m_roundTrips);
+
 	// Check for bodies to download
 	m_autoDownloadCommand.reset(new AutoDownloadCommand(m_session, m_folderId));
 	m_autoDownloadCommand->Run(m_autoDownloadSlot);
@@ -550,12 +960,36 @@ std::string SyncEmailsCommand::Describe() const
 	return GetClassName() + " [folderId=" + AsJsonString(m_folderId) + "]";
 }
 
+void SyncEmailsCommand::Cleanup()
+{
+	// A header fetch and a database put may both be in flight if the other one failed
+	m_fetchResponseSlot.cancel();
+	m_putEmailsResponseSlot.cancel();
+
+	ImapSyncSessionCommand::Cleanup();
+}
+
 void SyncEmailsCommand::Status(MojObject& status) const
 {
 	MojErr err;
 
 	ImapSyncSessionCommand::Status(status);
 
+	err = status.put("roundTrips", m_roundTrips);
+	ErrorToException(err);
+
+	if(m_batchSizeTuner.get()) {
+		err = status.put("headerBatchSize", m_batchSizeTuner->GetBatchSize());
+		ErrorToException(err);
+	}
+
+	if(m_fetchResponseParser.get()) {
+		MojObject parserStatus;
+		m_fetchResponseParser->Status(parserStatus);
+		err = status.put("fetchResponseParser", parserStatus);
+		ErrorToException(err);
+	}
+
 	MojObject syncParamsStatus;
 	m_syncParams.Status(syncParamsStatus);
 	err = status.put("syncParams", syncParamsStatus);
@@ -30,7 +30,7 @@ const char* const ImapFolder::XLIST_TRASH = "TRASH";
 
 
 ImapFolder::ImapFolder()
-: m_uidValidity(0), m_uidNext(0), m_selectable(true)
+: m_uidValidity(0), m_uidNext(0), m_highestModSeq(0), m_modSeqMaxEmails(0), m_serverUnreadCount(-1), m_selectable(true)
 {
 }
 
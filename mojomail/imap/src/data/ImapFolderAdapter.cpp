@@ -37,6 +37,10 @@ const char* const ImapFolderAdapter::DELIMITER			 	= "delimiter";
 const char* const ImapFolderAdapter::SELECTABLE			 	= "selectable";
 const char* const ImapFolderAdapter::LAST_SYNC_REV			= "lastSyncRev";
 const char* const ImapFolderAdapter::UIDVALIDITY			= "uidValidity";
+const char* const ImapFolderAdapter::HIGHEST_MODSEQ		= "highestModSeq";
+const char* const ImapFolderAdapter::MODSEQ_SINCE_DATE		= "modSeqSinceDate";
+const char* const ImapFolderAdapter::MODSEQ_MAX_EMAILS		= "modSeqMaxEmails";
+const char* const ImapFolderAdapter::SERVER_UNREAD_COUNT	= "serverUnreadCount";
 
 void ImapFolderAdapter::ParseDatabaseObject(const MojObject& obj, ImapFolder& folder)
 {
@@ -62,6 +66,30 @@ void ImapFolderAdapter::ParseDatabaseObject(const MojObject& obj, ImapFolder& fo
 		folder.SetUIDValidity(uidValidity);
 	}
 
+	bool hasModSeq;
+	MojInt64 modSeq = 0;
+	err = obj.get(HIGHEST_MODSEQ, modSeq, hasModSeq);
+	ErrorToException(err);
+	if(hasModSeq && modSeq > 0) {
+		folder.SetHighestModSeq(modSeq);
+
+		bool hasMaxEmails;
+		MojInt64 maxEmails = 0;
+		err = obj.get(MODSEQ_MAX_EMAILS, maxEmails, hasMaxEmails);
+		ErrorToException(err);
+
+		// If these are missing, the max emails won't match the config and the next sync will be a full sync
+		folder.SetModSeqSyncWindow(DatabaseAdapter::GetOptionalString(obj, MODSEQ_SINCE_DATE), maxEmails);
+	}
+
+	bool hasUnreadCount;
+	MojInt64 unreadCount = 0;
+	err = obj.get(SERVER_UNREAD_COUNT, unreadCount, hasUnreadCount);
+	ErrorToException(err);
+	if(hasUnreadCount) {
+		folder.SetServerUnreadCount(unreadCount);
+	}
+
 	bool selectable = DatabaseAdapter::GetOptionalBool(obj, SELECTABLE, true);
 	folder.SetSelectable(selectable);
 }
@@ -95,4 +123,22 @@ void ImapFolderAdapter::SerializeToDatabaseObject(const ImapFolder& folder, MojO
 		err = obj.put(UIDVALIDITY, (MojInt64) folder.GetUIDValidity());
 		ErrorToException(err);
 	}
+
+	// Highest mod sequence
+	if(folder.GetHighestModSeq() > 0) {
+		err = obj.put(HIGHEST_MODSEQ, (MojInt64) folder.GetHighestModSeq());
+		ErrorToException(err);
+
+		err = obj.putString(MODSEQ_SINCE_DATE, folder.GetModSeqSinceDate().c_str());
+		ErrorToException(err);
+
+		err = obj.put(MODSEQ_MAX_EMAILS, (MojInt64) folder.GetModSeqMaxEmails());
+		ErrorToException(err);
+	}
+
+	// Unread count on the server
+	if(folder.GetServerUnreadCount() >= 0) {
+		err = obj.put(SERVER_UNREAD_COUNT, (MojInt64) folder.GetServerUnreadCount());
+		ErrorToException(err);
+	}
 }
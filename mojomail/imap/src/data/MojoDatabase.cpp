@@ -70,6 +70,38 @@ void MojoDatabase::GetEmail(Signal::SlotRef slot, const MojObject& folderId, UID
 	ErrorToException(err);
 }
 
+// Gets the id and UID of each email with one of the given UIDs
+void MojoDatabase::GetEmailsByUID(Signal::SlotRef slot, const MojObject& folderId, const std::vector<UID>& uids)
+{
+	MojErr err;
+
+	MojObject uidArray(MojObject::TypeArray);
+	for(std::vector<UID>::const_iterator it = uids.begin(); it != uids.end(); ++it) {
+		err = uidArray.push((MojInt64) *it);
+		ErrorToException(err);
+	}
+
+	MojDbQuery query;
+	err = query.from(ImapEmailAdapter::IMAP_EMAIL_KIND);
+	ErrorToException(err);
+	err = query.where(EmailSchema::FOLDER_ID, MojDbQuery::OpEq, folderId);
+	ErrorToException(err);
+
+	// An array matches any of its values
+	err = query.where(ImapEmailAdapter::UID, MojDbQuery::OpEq, uidArray);
+	ErrorToException(err);
+
+	err = query.select(DatabaseAdapter::ID);
+	ErrorToException(err);
+	err = query.select(ImapEmailAdapter::UID);
+	ErrorToException(err);
+
+	query.limit(uids.size());
+
+	err = m_dbClient.find(slot, query);
+	ErrorToException(err);
+}
+
 void MojoDatabase::CreateFolders(Signal::SlotRef slot, const MojObject::ObjectVec& array)
 {
 	MojErr err = m_dbClient.put(slot, array.begin(), array.end());
@@ -161,6 +193,9 @@ void MojoDatabase::GetAutoDownloads(Signal::SlotRef slot, const MojObject& folde
 	err = query.select(ImapEmailAdapter::AUTO_DOWNLOAD);
 	ErrorToException(err);
 
+	err = query.select(ImapEmailAdapter::UID);
+	ErrorToException(err);
+
 	// Set limit
 	if(limit > 0) {
 		query.limit(limit);
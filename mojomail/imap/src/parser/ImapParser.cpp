@@ -22,24 +22,68 @@
 #include "parser/Rfc3501Tokenizer.h"
 #include "exceptions/Rfc3501ParseException.h"
 #include <sstream>
-#include <cctype>
-#include <boost/algorithm/string/predicate.hpp>
 
 using namespace std;
 
-map<string, TokenType> ImapParser::s_tokenMap;
-vector< std::pair<string, TokenType> > ImapParser::s_tokenList;
-
 bool ImapParser::s_initialized = false;
 
-const std::locale& ImapParser::s_classicLocale = std::locale::classic();
+struct KeywordToken
+{
+	const char*	keyword;
+	size_t		length;
+	TokenType	type;
+};
+
+#define KEYWORD_TOKEN(keyword, type) { keyword, sizeof(keyword) - 1, type }
+
+// Atoms that are promoted to tokens
+static const KeywordToken s_keywordTokens[] = {
+	KEYWORD_TOKEN("BODY", TK_BODY),
+	KEYWORD_TOKEN("BODYSTRUCTURE", TK_BODYSTRUCTURE),
+	KEYWORD_TOKEN("ENVELOPE", TK_ENVELOPE),
+	KEYWORD_TOKEN("EXPUNGE", TK_EXPUNGE),
+	KEYWORD_TOKEN("FETCH", TK_FETCH),
+	KEYWORD_TOKEN("FLAGS", TK_FLAGS),
+	KEYWORD_TOKEN("HEADER", TK_HEADER),
+	KEYWORD_TOKEN("HEADER.FIELDS", TK_HEADER_DOT_FIELDS),
+	KEYWORD_TOKEN("HEADER.FIELDS.NOT", TK_HEADER_DOT_FIELDS_DOT_NOT),
+	KEYWORD_TOKEN("INTERNALDATE", TK_INTERNALDATE),
+	KEYWORD_TOKEN("MIME", TK_MIME),
+	KEYWORD_TOKEN("MODSEQ", TK_MODSEQ),
+	KEYWORD_TOKEN("NIL", TK_NIL),
+	KEYWORD_TOKEN("RFC822.HEADER", TK_RFC822_DOT_HEADER),
+	KEYWORD_TOKEN("RFC822.SIZE", TK_RFC822_DOT_SIZE),
+	KEYWORD_TOKEN("RFC822.TEXT", TK_RFC822_DOT_TEXT),
+	KEYWORD_TOKEN("UID", TK_UID)
+};
+
+// "TEXT", "RFC822", and "MESSAGE" are handled in GetTokenType since they're quoted strings
+static const KeywordToken s_quotedKeywordTokens[] = {
+	KEYWORD_TOKEN("TEXT", TK_TEXT_IN_QUOTES),
+	KEYWORD_TOKEN("RFC822", TK_RFC822_IN_QUOTES),
+	KEYWORD_TOKEN("MESSAGE", TK_MESSAGE_IN_QUOTES)
+};
+
+#undef KEYWORD_TOKEN
+
+template<size_t N>
+static inline TokenType LookupKeyword(const Rfc3501Tokenizer& t, const KeywordToken (&keywords)[N], TokenType defaultType)
+{
+	size_t length = t.size();
+
+	for(size_t i = 0; i < N; ++i) {
+		if(keywords[i].length == length && t.equalsIgnoreCase(keywords[i].keyword, length))
+			return keywords[i].type;
+	}
+
+	return defaultType;
+}
 
 ImapParser::ImapParser(Rfc3501Tokenizer* tokenizer, SemanticActions* semantic)
 : m_tokenizer(tokenizer), m_semantic(semantic)
 {
 	if(!s_initialized) {
 		initialize();
-		BuildTokenTypeMap();
 		s_initialized = true;
 	}
 	
@@ -84,86 +128,30 @@ ImapParser::ParseResult ImapParser::Parse()
 	return ParseStep();
 }
 
-void ImapParser::BuildTokenTypeMap()
-{
-	s_tokenMap["FETCH"] = TK_FETCH;
-	s_tokenMap["FLAGS"] = TK_FLAGS;
-	s_tokenMap["INTERNALDATE"] = TK_INTERNALDATE;
-	s_tokenMap["UID"] = TK_UID;
-	s_tokenMap["NIL"] = TK_NIL;
-	s_tokenMap["BODY"] = TK_BODY;
-	s_tokenMap["BODYSTRUCTURE"] = TK_BODYSTRUCTURE;
-	s_tokenMap["ENVELOPE"] = TK_ENVELOPE;
-	s_tokenMap["HEADER"] = TK_HEADER;
-	s_tokenMap["HEADER.FIELDS"] = TK_HEADER_DOT_FIELDS;
-	s_tokenMap["HEADER.FIELDS.NOT"] = TK_HEADER_DOT_FIELDS_DOT_NOT;
-	s_tokenMap["RFC822.HEADER"] = TK_RFC822_DOT_HEADER;
-	s_tokenMap["RFC822.SIZE"] = TK_RFC822_DOT_SIZE;
-	s_tokenMap["RFC822.TEXT"] = TK_RFC822_DOT_TEXT;
-	s_tokenMap["MIME"] = TK_MIME;
-	s_tokenMap["EXPUNGE"] = TK_EXPUNGE;
-
-	// FIXME use a hashmap
-	s_tokenList.assign(s_tokenMap.begin(), s_tokenMap.end());
-
-	// "TEXT", "RFC822", and "MESSAGE" are handled in GetTokenType since they're quoted strings
-}
-
 TokenType ImapParser::GetTokenType() const
 {
 	// FIXME: eventually remove this double layer or translation
-	Rfc3501Tokenizer& t(*m_tokenizer);
+	const Rfc3501Tokenizer& t(*m_tokenizer);
 
 	switch (t.tokenType) {
 	case TK_LITERAL_BYTES:
 		return TK_LITERAL_BYTES;
 	case TK_TEXT:
 	{
-		// FIXME: replace Tokenizer
 		// The exact mechanism for promoting these to tokens needs further thought.
 		// We either need to change the grammar, or we need to add some semantic
 		// actions to trigger the promotion.
 
-		const std::string& token = t.value();
-
-		if (token[0] >= '0' && token[0]<='9')
+		if (t.size() > 0 && Rfc3501Tokenizer::isDigit(t.data()[0]))
 			return TK_NUMBER;
 
-		if(true) {
-			vector< std::pair<string, TokenType> >::iterator it;
-			for(it = s_tokenList.begin(); it != s_tokenList.end(); ++it) {
-				if( it->first.length() == token.length() && boost::iequals(it->first, token, s_classicLocale) )
-					return it->second;
-			}
-		}
-
-		//if (s_tokenMap[t.valueUpper()])
-		//	return s_tokenMap[t.valueUpper()];
-		return TK_ATOM;
+		return LookupKeyword(t, s_keywordTokens, TK_ATOM);
 	}
 	case TK_QUOTED_STRING:
-	{
-		if ( boost::iequals(t.value(), "TEXT", s_classicLocale) )
-			return TK_TEXT_IN_QUOTES;
-		if ( boost::iequals(t.value(), "RFC822", s_classicLocale) )
-			return TK_RFC822_IN_QUOTES;
-		if ( boost::iequals(t.value(), "MESSAGE", s_classicLocale) )
-			return TK_MESSAGE_IN_QUOTES;
-		return TK_QUOTED_STRING;
-	}
+		return LookupKeyword(t, s_quotedKeywordTokens, TK_QUOTED_STRING);
 	default:
 		return t.tokenType;
 	}
-	/* TODO
-			, &TT_RFC822_DOT_TEXT
-			, &TT_RFC822_DOT_SIZE
-			, &TT_RFC822_DOT_HEADER
-			, &TT_RFC822
-			, &TT_MIME
-			, &TT_HEADER_DOT_FIELDS_DOT_NOT
-			, &TT_HEADER_DOT_FIELDS
-			, &TT_EXPUNGE
-	 */
 }
 
 ImapParser::ParseResult ImapParser::ParseStep()
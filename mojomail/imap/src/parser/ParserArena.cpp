@@ -0,0 +1,129 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "parser/ParserArena.h"
+#include <cstdlib>
+
+// Alignment for every allocation; enough for any of the parser's objects
+static const size_t ARENA_ALIGNMENT = sizeof(double) > sizeof(void*) ? sizeof(double) : sizeof(void*);
+
+static inline size_t AlignSize(size_t size)
+{
+	return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+ParserArena::ParserArena()
+: m_storage(new Storage())
+{
+}
+
+ParserArena::~ParserArena()
+{
+}
+
+void* ParserArena::Allocate(size_t size)
+{
+	return m_storage->Allocate(size);
+}
+
+void ParserArena::Reset()
+{
+	if(m_storage.unique()) {
+		m_storage->Reset();
+	} else {
+		// Objects from the arena are still in use; leave the memory to them
+		m_storage.reset(new Storage());
+	}
+}
+
+ParserArena::Storage::Storage()
+: m_next(NULL),
+  m_remaining(0)
+{
+}
+
+ParserArena::Storage::~Storage()
+{
+	for(std::vector<char*>::iterator it = m_blocks.begin(); it != m_blocks.end(); ++it) {
+		free(*it);
+	}
+}
+
+void* ParserArena::Storage::Allocate(size_t size)
+{
+	size = AlignSize(size > 0 ? size : 1);
+
+	m_stats.numAllocations++;
+	m_stats.bytesAllocated += size;
+
+	if(size > MAX_SMALL_ALLOCATION) {
+		// Large allocation; give it its own block and keep using the current one
+		m_blocks.reserve(m_blocks.size() + 1);
+
+		char* block = static_cast<char*>( malloc(size) );
+		if(block == NULL)
+			throw std::bad_alloc();
+
+		m_blocks.push_back(block);
+		m_stats.numBlocks++;
+		m_stats.bytesReserved += size;
+		return block;
+	}
+
+	if(size > m_remaining) {
+		m_blocks.reserve(m_blocks.size() + 1);
+
+		char* block = static_cast<char*>( malloc(BLOCK_SIZE) );
+		if(block == NULL)
+			throw std::bad_alloc();
+
+		m_blocks.push_back(block);
+		m_stats.numBlocks++;
+		m_stats.bytesReserved += BLOCK_SIZE;
+
+		m_next = block;
+		m_remaining = BLOCK_SIZE;
+	}
+
+	void* p = m_next;
+	m_next += size;
+	m_remaining -= size;
+
+	return p;
+}
+
+void ParserArena::Storage::Reset()
+{
+	// Large allocations never become the current block
+	char* current = m_next != NULL ? m_next + m_remaining - BLOCK_SIZE : NULL;
+
+	for(std::vector<char*>::iterator it = m_blocks.begin(); it != m_blocks.end(); ++it) {
+		if(*it != current) {
+			free(*it);
+		}
+	}
+
+	m_blocks.clear();
+	m_stats = Stats();
+
+	if(current != NULL) {
+		m_blocks.push_back(current);
+		m_next = current;
+		m_remaining = BLOCK_SIZE;
+	}
+}
@@ -22,10 +22,8 @@
 
 #include <string>
 #include <algorithm>
-#include <boost/algorithm/string/case_conv.hpp>
-#include <boost/algorithm/string/predicate.hpp>
+#include <climits>
 #include "parser/Rfc3501Tokenizer.h"
-#include "parser/Util.h"
 
 using namespace std;
 
@@ -40,195 +38,267 @@ const string Rfc3501Tokenizer::KEYWORD_UID 				= "UID";
 const string Rfc3501Tokenizer::NIL_STRING 				= "NIL";
 const string Rfc3501Tokenizer::NAMESPACE_STRING 		= "NAMESPACE";
 
+#define AS CHAR_ATOM_SPECIAL
+#define DG CHAR_DIGIT
+#define QS CHAR_QUOTED_SPECIAL
+
+// Controls and ( ) [ ] { } % * \ " SP end an atom.
+// Bytes >= 0x80 are treated as atom characters.
+const unsigned char Rfc3501Tokenizer::s_charClass[256] = {
+	AS, AS, AS, AS, AS, AS, AS, AS, AS, AS, AS, AS, AS, AS, AS, AS,
+	AS, AS, AS, AS, AS, AS, AS, AS, AS, AS, AS, AS, AS, AS, AS, AS,
+	AS, 0, AS|QS, 0, 0, AS, 0, 0, AS, AS, AS, 0, 0, 0, 0, 0,
+	DG, DG, DG, DG, DG, DG, DG, DG, DG, DG, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, AS, AS|QS, AS, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, AS, 0, AS, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+#undef AS
+#undef DG
+#undef QS
 
 TokenType Rfc3501Tokenizer::throwError(const char* msg) {
 	m_error = msg;
 	return TK_ERROR;
 }
 
-string Rfc3501Tokenizer::valueUpper() {
-	return boost::to_upper_copy(token);
+void Rfc3501Tokenizer::materializeToken() const {
+	const char* p = data();
+
+	if (!tokenEscaped) {
+		token.assign(p, tokenLength);
+	} else {
+		token.clear();
+		token.reserve(tokenLength);
+
+		for (int i = 0; i < tokenLength; i++) {
+			if (p[i] == '\\' && i + 1 < tokenLength)
+				i++;
+			token.push_back(p[i]);
+		}
+	}
+
+	tokenValid = true;
+}
+
+string Rfc3501Tokenizer::valueUpper() const {
+	string upper = value();
+
+	for (size_t i = 0; i < upper.size(); i++)
+		upper[i] = toUpperAscii(upper[i]);
+
+	return upper;
+}
+
+bool Rfc3501Tokenizer::numberValue(long int& result) const {
+	const char* p = data();
+	const char* end = p + tokenLength;
+
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+')) {
+		negative = (*p == '-');
+		++p;
+	}
+
+	if (p == end || !isDigit(*p))
+		return false;
+
+	unsigned long n = 0;
+	for (; p < end && isDigit(*p); ++p) {
+		unsigned long digit = *p - '0';
+		if (n > (LONG_MAX - digit) / 10)
+			return false;
+		n = n * 10 + digit;
+	}
+
+	result = negative ? -(long int) n : (long int) n;
+	return true;
+}
+
+bool Rfc3501Tokenizer::numberValue(MojUInt32& result) const {
+	const char* p = data();
+	const char* end = p + tokenLength;
+
+	if (p == end || !isDigit(*p))
+		return false;
+
+	MojUInt32 n = 0;
+	for (; p < end && isDigit(*p); ++p) {
+		MojUInt32 digit = *p - '0';
+		if (n > (0xFFFFFFFFU - digit) / 10)
+			return false;
+		n = n * 10 + digit;
+	}
+
+	result = n;
+	return true;
 }
 
+bool Rfc3501Tokenizer::numberValue(MojUInt64& result) const {
+	const char* p = data();
+	const char* end = p + tokenLength;
+
+	if (p == end || !isDigit(*p))
+		return false;
+
+	MojUInt64 n = 0;
+	for (; p < end && isDigit(*p); ++p) {
+		MojUInt64 digit = *p - '0';
+		if (n > (0xFFFFFFFFFFFFFFFFULL - digit) / 10)
+			return false;
+		n = n * 10 + digit;
+	}
 
-bool Rfc3501Tokenizer::numberValue(long int& result) {
-	return Util::from_string(result, token, std::dec);
+	result = n;
+	return true;
 }
 
-bool Rfc3501Tokenizer::match(const string& strchr) {
-	if (tokenType != TK_TEXT)
+bool Rfc3501Tokenizer::equalsIgnoreCase(const char* str, size_t length) const {
+	if (tokenEscaped) {
+		const string& v = value();
+		if (v.size() != length)
+			return false;
+
+		for (size_t i = 0; i < length; i++) {
+			if (toUpperAscii(v[i]) != toUpperAscii(str[i]))
+				return false;
+		}
+		return true;
+	}
+
+	if (length != (size_t) tokenLength)
 		return false;
-	
-	return boost::iequals(token, strchr);
+
+	const char* p = data();
+	for (size_t i = 0; i < length; i++) {
+		if (toUpperAscii(p[i]) != toUpperAscii(str[i]))
+			return false;
+	}
+	return true;
 }
 
 TokenType Rfc3501Tokenizer::next() {
-	token.clear();
+	clearToken();
 
 	tokenType = TK_ERROR;
 	if (cp>=len) {
 		return tokenType;
 	}
 	pos = cp;
-	char c = chars[cp++];
+
+	const char* buf = chars.data();
+	char c = buf[cp++];
 	switch (c) {
 		case '\r':
-			token.push_back(c);
-			tokenType = TK_CR;
-			return tokenType;
+			return setToken(TK_CR, 0, 1);
 		case '\n':
-			token.push_back(c);
-			tokenType = TK_LF;
-			return tokenType;
+			return setToken(TK_LF, 0, 1);
 		case '(':
-			token.push_back(c);
-			tokenType = TK_LPAREN;
-			return tokenType;
+			return setToken(TK_LPAREN, 0, 1);
 		case ')':
-			token.push_back(c);
-			tokenType = TK_RPAREN;
-			return tokenType;
+			return setToken(TK_RPAREN, 0, 1);
 		case '[':
-			token.push_back(c);
-			tokenType = TK_LBRACKET;
-			return tokenType;
+			return setToken(TK_LBRACKET, 0, 1);
 		case ']':
-			token.push_back(c);
-			tokenType = TK_RBRACKET;
-			return tokenType;
+			return setToken(TK_RBRACKET, 0, 1);
 		case '}':
-			token.push_back(c);
-			tokenType = TK_RBRACE;
-			return tokenType;
+			return setToken(TK_RBRACE, 0, 1);
 		case '%':
-			token.push_back(c);
-			tokenType = TK_TEXT;
-			return tokenType;
 		case '*':
-			token.push_back(c);
-			tokenType = TK_TEXT;
-			return tokenType;
+			return setToken(TK_TEXT, 0, 1);
 		case '\\':
-			token.push_back(c);
-			tokenType = TK_BACKSLASH;
-			return tokenType;
-		case ' ': {
-			token.push_back(c);
-			tokenType = TK_SP;
-			return tokenType;
-		}
+			return setToken(TK_BACKSLASH, 0, 1);
+		case ' ':
+			return setToken(TK_SP, 0, 1);
 
 		case '{': {
 			if (brace_is_token) {
-				token.push_back(c);
-				tokenType = TK_LBRACE;
-				return tokenType;
+				return setToken(TK_LBRACE, 0, 1);
 			}
 			int size = 0;
-			c = chars[cp++];
+			c = (cp < len) ? buf[cp++] : '\0';
 
-			// FIXME this could overflow size
-			while (c>='0'&&c<='9') {
+			while (isDigit(c)) {
+				if (size > (INT_MAX - 9) / 10)
+					return throwError("literal size too large");
 				size = size*10+(c-'0');
-				c = chars[cp++];
+				c = (cp < len) ? buf[cp++] : '\0';
 			}
 			if (c != '}')
 				return throwError("right brace expected");
 			if (len < cp+2)
 				return throwError("two chars after brace expected");
-			c = chars[cp++];
+			c = buf[cp++];
 			if (c != '\r')
 				return throwError("cr after brace expected");
-			c = chars[cp++];
+			c = buf[cp++];
 			if (c != '\n')
 				return throwError("crlf after brace expected");
-			token.clear();
 
-			if (cp + size <= len) {
-				//fprintf(stderr, "got enough bytes: %d < %d", cp+size, len);
-				for (int i=0;i<size;i++)
-					token.push_back(chars[cp++]);
-				tokenType = TK_QUOTED_STRING;
+			if (size <= len - cp) {
+				int start = cp;
+				cp += size;
+				return setToken(TK_QUOTED_STRING, start - pos, size);
 			} else {
-				//fprintf(stderr, "need more bytes: %d\n", size);
 				bytesNeeded = size;
 				return throwError("missing literal data");
 			}
-			return tokenType;
 		}
 		case '\"': {
-			if (cp>=len) {
-				tokenType = TK_QUOTED_STRING_WITHOUT_TERMINATION;
-				return tokenType;
- 			}
-			token.clear();
-			c = chars[cp++];
+			int start = cp;
+			int end = start;
+			bool escaped = false;
+
 			for (;;) {
-				if (c=='\"') {
-					tokenType = TK_QUOTED_STRING;
-					return tokenType;
+				// Skip to the next quote or backslash
+				while (cp < len && !(s_charClass[(unsigned char) buf[cp]] & CHAR_QUOTED_SPECIAL))
+					cp++;
+
+				if (cp >= len) {
+					// The last character isn't part of the partial string
+					end = std::max(start, len - 1);
+					break;
 				}
-				if (c=='\\') {
-					if (cp>=len) {
-						tokenType = TK_QUOTED_STRING_WITHOUT_TERMINATION;
-						return tokenType;
-					}
-					c = chars[cp++];
+
+				if (buf[cp] == '\"') {
+					cp++;
+					return setToken(TK_QUOTED_STRING, start - pos, cp - 1 - start, escaped);
 				}
-				if (cp>=len) {
-					tokenType = TK_QUOTED_STRING_WITHOUT_TERMINATION;
-					return tokenType;
+
+				// Backslash; the next character is taken literally
+				if (cp + 2 >= len) {
+					end = cp;
+					break;
 				}
-				token.push_back(c);
-				c = chars[cp++];
+
+				escaped = true;
+				cp += 2;
 			}
+
+			cp = len;
+			return setToken(TK_QUOTED_STRING_WITHOUT_TERMINATION, start - pos, end - start, escaped);
 		}
 
 		default: {
 			// Assume this is an atom
-			token.push_back(c);
-			if (cp<len) {
-				c = chars[cp++];
-				for (;;) {
-					if (isAtomSpecial(c)) {
-						cp--;
-						tokenType = TK_TEXT;
-						return tokenType;
-					}
-					token.push_back(c);
-					if (cp>=len)
-						break;
-					c = chars[cp++];
-				}
-			}
-			tokenType = TK_TEXT;
-			return tokenType;
-		}
-	}
-}
+			while (cp < len && !isAtomSpecial(buf[cp]))
+				cp++;
 
-bool Rfc3501Tokenizer::isAtomSpecial(char c) {
-	if (c<' ')
-		return true;
-	switch(c) {
-	case '(':
-	case ')':
-	case '[':
-	case ']':
-	case '{':
-	case '}':
-	case '%':
-	case '*':
-	case '\\':
-	case '"':
-	case ' ':
-		return true;
-	default:
-		return false;
+			return setToken(TK_TEXT, 0, cp - pos);
+		}
 	}
 }
 
-
 bool Rfc3501Tokenizer::startAt(string key) {
 	for (;;) {
 		char tokenType = next();
@@ -258,9 +328,9 @@ std::string Rfc3501Tokenizer::produceDebugText()
 				|| tokenType == (TK_QUOTED_STRING_WITHOUT_TERMINATION);
 
 		if (isString) {
-			debugText.append(!token.empty() ? "\"[STRING]\"" : "\"\"");
+			debugText.append(tokenLength > 0 ? "\"[STRING]\"" : "\"\"");
 		} else {
-			debugText.append(token);
+			debugText.append(data(), size());
 		}
 	}
 
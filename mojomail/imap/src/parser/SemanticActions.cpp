@@ -41,12 +41,37 @@ SemanticActions::SemanticActions(Rfc3501Tokenizer& tokenizer)
   m_expectBinaryData(false),
   m_binaryDataLength(0),
   m_flagsUpdated(false),
-  m_sectionType(Section_None)
+  m_modSeq(0),
+  m_sectionType(Section_None),
+  m_partStreamFactory(NULL),
+  m_deferBodyData(false)
+{
+	Init();
+}
+
+SemanticActions::SemanticActions(Rfc3501Tokenizer& tokenizer, const ParserArena& arena)
+: m_tokenizer(tokenizer),
+  m_arena(arena),
+  m_stringType(ST_Null),
+  m_nzNumber(0),
+  m_msgNum(0),
+  m_expectBinaryData(false),
+  m_binaryDataLength(0),
+  m_flagsUpdated(false),
+  m_modSeq(0),
+  m_sectionType(Section_None),
+  m_partStreamFactory(NULL),
+  m_deferBodyData(false)
+{
+	Init();
+}
+
+void SemanticActions::Init()
 {
 	m_bufferOutputStream.reset(new ByteBufferOutputStream());
 
 	m_emailStack.push(NestedEmail());
-	m_emailStack.top().m_email.reset(new ImapEmail());
+	m_emailStack.top().m_email = Create<ImapEmail>();
 }
 
 SemanticActions::~SemanticActions()
@@ -54,8 +79,8 @@ SemanticActions::~SemanticActions()
 }
 
 void SemanticActions::readAheadLiteral(void) {
-	int n = 0;
-	bool ok = Util::from_string(n, m_tokenizer.value(), std::dec);
+	MojUInt32 n = 0;
+	bool ok = m_tokenizer.numberValue(n);
 	if (ok) {
 		m_expectBinaryData = true;
 		m_binaryDataLength = n;
@@ -123,7 +148,7 @@ void SemanticActions::saveInternalDate(void) {
 
 void SemanticActions::saveUID(void) {
 	UID uid;
-	if(Util::from_string(uid, m_tokenizer.value(), std::dec))
+	if(m_tokenizer.numberValue(uid))
 		GetCurrentEmail().SetUID(uid);
 	// FIXME handle error
 }
@@ -131,7 +156,7 @@ void SemanticActions::saveUID(void) {
 void SemanticActions::saveNonZeroNumber(void)
 {
 	MojUInt32 number;
-	if(Util::from_string(number, m_tokenizer.value(), std::dec))
+	if(m_tokenizer.numberValue(number))
 		m_nzNumber = number;
 	else
 		throw Rfc3501ParseException("not a valid non-zero number", __FILE__, __LINE__);
@@ -189,6 +214,17 @@ string SemanticActions::GetCurrentString(bool lowercase) const
 
 void SemanticActions::setSection()
 {
+	m_sectionName.clear();
+}
+
+void SemanticActions::appendSectionPart()
+{
+	if(!m_sectionName.empty()) {
+		m_sectionName += '.';
+	}
+
+	// The tokenizer returns a dotted part number like "1.2" as a single number token
+	m_sectionName += m_tokenizer.value();
 }
 
 void SemanticActions::setHeadersSection()
@@ -197,6 +233,17 @@ void SemanticActions::setHeadersSection()
 }
 
 void SemanticActions::expectBodyData(void) {
+	if(m_partStreamFactory && m_sectionType != Section_Headers) {
+		UID uid = GetCurrentEmail().GetUID();
+
+		if(uid > 0) {
+			m_bodyOutputStream = m_partStreamFactory->GetPartOutputStream(uid, m_sectionName);
+		} else {
+			// The UID hasn't been parsed yet; hold on to the data until the end of the response
+			m_deferBodyData = true;
+		}
+	}
+
 	fprintf(stderr, "Setting output stream to body output stream %p\n", m_bodyOutputStream.get());
 	m_currentOutputStream = m_bodyOutputStream;
 	m_stringValue.clear();
@@ -205,7 +252,10 @@ void SemanticActions::expectBodyData(void) {
 void SemanticActions::handleBodyData(void) {
 	fprintf(stderr, "Closing body output stream\n");
 
-	if(m_currentOutputStream.get()) {
+	if(m_deferBodyData) {
+		m_deferredBodies.push_back( make_pair(m_sectionName, m_stringValue) );
+		m_deferBodyData = false;
+	} else if(m_currentOutputStream.get()) {
 		// If the body was an inline string rather than a literal, we'll append it now
 		if(!m_stringValue.empty()) {
 			m_currentOutputStream->Write(m_stringValue);
@@ -215,6 +265,9 @@ void SemanticActions::handleBodyData(void) {
 		m_currentOutputStream->Close();
 	}
 
+	// Don't let a literal that went to the buffer leak into the next part
+	m_bufferOutputStream->Clear();
+
 	if(m_sectionType == Section_Headers) {
 		// Parse headers
 		ParseExtraHeaders(m_stringValue);
@@ -284,7 +337,7 @@ void SemanticActions::beginNestedEmail()
 
 	// Push new email
 	m_emailStack.push(NestedEmail());
-	m_emailStack.top().m_email.reset(new ImapEmail());
+	m_emailStack.top().m_email = Create<ImapEmail>();
 }
 
 void SemanticActions::endNestedEmail()
@@ -361,7 +414,7 @@ void SemanticActions::endPartList(void) {
 void SemanticActions::CreatePart()
 {
 	// Add part
-	m_currentPart.reset(new ImapStructurePart());
+	m_currentPart = Create<ImapStructurePart>();
 
 	if(!GetNestedEmail().m_multipartStack.empty()) {
 		ImapStructurePart& parent = *(GetNestedEmail().m_multipartStack.top());
@@ -443,7 +496,7 @@ void SemanticActions::SerializeParts(EmailPartList& emailParts, const boost::sha
 			}
 		}
 
-		EmailPartPtr emailPart(new EmailPart(type));
+		EmailPartPtr emailPart = Create<EmailPart>(type);
 		emailPart->SetMimeType(imapPart->mimeType + "/" + imapPart->mimeSubtype);
 
 		emailPart->SetContentId(imapPart->contentId);
@@ -546,27 +599,35 @@ void SemanticActions::beginFlags(void) {
 	m_flagsUpdated = true;
 }
 
+void SemanticActions::saveModSeq(void) {
+	MojUInt64 modSeq = 0;
+	if(m_tokenizer.numberValue(modSeq))
+		m_modSeq = modSeq;
+	else
+		throw Rfc3501ParseException("not a valid mod-sequence value", __FILE__, __LINE__);
+}
+
 void SemanticActions::keywordFlagAtom(void) {
 	//string flag = m_tokenizer.value();
 }
 
 void SemanticActions::systemFlagAtom(void) {
-	string flag = m_tokenizer.valueUpper();
+	const Rfc3501Tokenizer& t = m_tokenizer;
 
-	if(boost::iequals(flag, "Seen")) {
+	if(t.equalsIgnoreCase("Seen", 4)) {
 		GetCurrentEmail().SetRead(true);
-	} else if(boost::iequals(flag, "Deleted")) {
+	} else if(t.equalsIgnoreCase("Deleted", 7)) {
 		GetCurrentEmail().SetDeleted(true);
-	} else if(boost::iequals(flag, "Answered")) {
+	} else if(t.equalsIgnoreCase("Answered", 8)) {
 		GetCurrentEmail().SetReplied(true);
-	} else if(boost::iequals(flag, "Flagged")) {
+	} else if(t.equalsIgnoreCase("Flagged", 7)) {
 		GetCurrentEmail().SetFlagged(true);
 	}
 }
 
 void SemanticActions::setPartSize(void) {
-	size_t n = 0;
-	bool ok = Util::from_string(n, m_tokenizer.value(), std::dec);
+	MojUInt32 n = 0;
+	bool ok = m_tokenizer.numberValue(n);
 	if (ok) {
 		GetCurrentPart()->size = n;
 	}
@@ -576,6 +637,23 @@ void SemanticActions::setPartSize(void) {
 }
 
 void SemanticActions::endFetch(void) {
+	UID uid = GetCurrentEmail().GetUID();
+
+	for(size_t i = 0; i < m_deferredBodies.size(); i++) {
+		OutputStreamPtr os;
+
+		if(m_partStreamFactory && uid > 0) {
+			os = m_partStreamFactory->GetPartOutputStream(uid, m_deferredBodies[i].first);
+		}
+
+		if(os.get()) {
+			os->Write(m_deferredBodies[i].second);
+			os->Flush();
+			os->Close();
+		}
+	}
+
+	m_deferredBodies.clear();
 }
 
 void SemanticActions::envSubject() {
@@ -614,7 +692,7 @@ void SemanticActions::envCcAddressList() {
 
 void SemanticActions::envBeginAddressList() {
 	// Allocate a new list
-	m_envelope.m_addressList.reset(new EmailAddressList());
+	m_envelope.m_addressList = Create<EmailAddressList>();
 }
 
 void SemanticActions::envDate() {
@@ -629,7 +707,7 @@ void SemanticActions::envMessageId() {
 }
 
 void SemanticActions::envEndAddress() {
-	EmailAddressPtr address = make_shared<EmailAddress>(m_envelope.m_addressDisplayName, m_envelope.m_addressEmail);
+	EmailAddressPtr address = Create<EmailAddress>(m_envelope.m_addressDisplayName, m_envelope.m_addressEmail);
 	m_envelope.GetCurrentAddressList()->push_back(address);
 }
 
@@ -52,10 +52,14 @@ bool BufferedResponseParser::CheckResponseReady()
 
 	if (needsLiteral) {
 		// Check if the size is sane
-		if (bytesNeeded > MAX_LITERAL_SIZE || m_buffer.size() + bytesNeeded > MAX_LINE_LENGTH) {
+		if (bytesNeeded > MAX_RESPONSE_SIZE || m_buffer.size() + bytesNeeded > MAX_RESPONSE_SIZE) {
 			throw MailException("literal size exceeds maximum", __FILE__, __LINE__);
 		}
 
+		// Make room for the CRLF, the literal and a typical remainder of the line
+		// so the literal can be appended without reallocating.
+		m_buffer.reserve(m_buffer.size() + 2 + bytesNeeded + 128);
+
 		MojRefCountedPtr<ImapResponseParser> ref(this);
 
 		m_bytesNeeded = bytesNeeded;
@@ -71,7 +75,12 @@ bool BufferedResponseParser::CheckResponseReady()
 
 		ResponseLineReady();
 
-		m_buffer.clear();
+		if (m_buffer.capacity() > MAX_RETAINED_CAPACITY) {
+			// Don't hold on to the memory from a large literal
+			string().swap(m_buffer);
+		} else {
+			m_buffer.clear();
+		}
 
 		return true; // done
 	}
@@ -85,21 +94,16 @@ bool BufferedResponseParser::HandleAdditionalData()
 		// Read raw bytes
 		size_t bytesAvailable = lineReader->NumBytesAvailable();
 
-		char buf[MAX_LITERAL_SIZE + 10];
-
-		if ( (size_t) m_bytesNeeded > bytesAvailable || m_bytesNeeded > MAX_LITERAL_SIZE) {
-			MojLogError(m_log, "need %d but only %d available", (size_t) m_bytesNeeded, bytesAvailable);
+		if ( (size_t) m_bytesNeeded > bytesAvailable) {
+			MojLogError(m_log, "need %d but only %d available", (int) m_bytesNeeded, (int) bytesAvailable);
 			throw MailException("refusing to parse literal", __FILE__, __LINE__);
 		}
 
-		// FIXME copy string directly
-		lineReader->ReadData(buf, m_bytesNeeded);
-
 		// Append newline to buffer
 		m_buffer.append("\r\n");
 
-		// Add byte data to buffer
-		m_buffer.append(buf, m_bytesNeeded);
+		// Add byte data straight from the line reader into the buffer
+		lineReader->AppendData(m_buffer, m_bytesNeeded);
 
 		// Done getting this literal
 		m_needsLiteral = false;
@@ -0,0 +1,103 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "protocol/ChangedSinceResponseParser.h"
+#include "parser/Rfc3501Tokenizer.h"
+#include "parser/Util.h"
+
+using namespace std;
+
+ChangedSinceResponseParser::ChangedSinceResponseParser(ImapSession& session, DoneSignal::SlotRef doneSlot,
+		SyncEngine::ChangeList& changes, UIDRangeSet& vanishedUIDs)
+: ImapResponseParser(session, doneSlot),
+  m_changes(changes),
+  m_vanishedUIDs(vanishedUIDs),
+  m_highestModSeq(0)
+{
+}
+
+ChangedSinceResponseParser::~ChangedSinceResponseParser()
+{
+}
+
+bool ChangedSinceResponseParser::HandleUntaggedResponse(const string& line)
+{
+	Rfc3501Tokenizer t(line);
+
+	if(t.next() != TK_TEXT)
+		return false;
+
+	if(t.match("VANISHED")) {
+		// Only VANISHED (EARLIER) is part of the response; a plain VANISHED is a live expunge
+		// and is left for the UntaggedUpdateParser, which removes it from the UID map.
+		if(t.next() != TK_SP || t.next() != TK_LPAREN)
+			return false;
+
+		if(t.next() != TK_TEXT || !t.match("EARLIER") || t.next() != TK_RPAREN || t.next() != TK_SP)
+			ThrowParseException("expected (EARLIER)");
+
+		if(t.next() != TK_TEXT || !UIDRangeSet::Parse(t.value(), m_vanishedUIDs))
+			ThrowParseException("invalid VANISHED uid set");
+
+		return true;
+	}
+
+	// n FETCH (UID uid FLAGS (flags) MODSEQ (modseq))
+	long msgNum;
+	if(!t.numberValue(msgNum) || t.next() != TK_SP || t.next() != TK_TEXT || !t.match("FETCH"))
+		return false;
+
+	if(t.next() != TK_SP || t.next() != TK_LPAREN)
+		ThrowParseException("expected fetch attribute list");
+
+	SyncEngine::RemoteChange change(0);
+
+	TokenType tk = t.next();
+	while(tk == TK_TEXT) {
+		if(t.match("UID")) {
+			if(t.next() != TK_SP || t.next() != TK_TEXT || !Util::from_string(change.uid, t.value(), std::dec))
+				ThrowParseException("expected UID number");
+		} else if(t.match("FLAGS")) {
+			ParseFlags(t, change);
+		} else if(t.match("MODSEQ")) {
+			MojUInt64 modSeq = 0;
+			if(t.next() != TK_SP || t.next() != TK_LPAREN || t.next() != TK_TEXT || !Util::from_string(modSeq, t.value(), std::dec) || t.next() != TK_RPAREN)
+				ThrowParseException("expected MODSEQ value");
+
+			if(modSeq > m_highestModSeq)
+				m_highestModSeq = modSeq;
+		} else {
+			ThrowParseException("unexpected fetch attribute");
+		}
+
+		tk = t.next();
+		if(tk == TK_SP)
+			tk = t.next();
+	}
+
+	if(tk != TK_RPAREN)
+		ThrowParseException("expected end of fetch attribute list");
+
+	if(change.uid > 0) {
+		m_changes.push_back(change);
+	} else {
+		MojLogWarning(m_log, "ignoring FETCH response for msg %ld without UID", msgNum);
+	}
+
+	return true;
+}
@@ -24,7 +24,8 @@ using namespace std;
 
 ExamineResponseParser::ExamineResponseParser(ImapSession& session, DoneSignal::SlotRef doneSlot)
 : ImapResponseParser(session, doneSlot),
-  m_exists(-1), m_uidValidity(0)
+  m_exists(-1), m_uidValidity(0),
+  m_highestModSeq(0), m_qresyncEnabled(false)
 {
 }
 
@@ -42,6 +43,14 @@ bool ExamineResponseParser::HandleUntaggedResponse(const string& line)
 
 	if(t.value() == "FLAGS") {
 		// TODO
+		return true;
+	} else if(t.match("ENABLED")) {
+		// Response to ENABLE sent before the SELECT
+		while(t.next() == TK_SP) {
+			if(t.next() == TK_TEXT && t.match("QRESYNC"))
+				m_qresyncEnabled = true;
+		}
+
 		return true;
 	} else if(t.value() == "OK") {
 		if(t.next() != TK_SP)
@@ -65,6 +74,22 @@ bool ExamineResponseParser::HandleUntaggedResponse(const string& line)
 
 			m_uidValidity = (UID) uidValidity; // force cast to 32-bit (hack)
 
+			return true;
+		} else if(t.match("HIGHESTMODSEQ")) {
+			if(t.next() != TK_SP)
+				ThrowParseException("expected space after HIGHESTMODSEQ");
+
+			MojUInt64 modSeq = 0;
+			if(t.next() != TK_TEXT || !Util::from_string(modSeq, t.value(), std::dec))
+				ThrowParseException("expected number");
+
+			m_highestModSeq = modSeq;
+
+			return true;
+		} else if(t.match("NOMODSEQ")) {
+			// Folder doesn't support persistent mod sequences
+			m_highestModSeq = 0;
+
 			return true;
 		}
 	} else {
@@ -73,7 +98,7 @@ bool ExamineResponseParser::HandleUntaggedResponse(const string& line)
 			if(t.next() != TK_SP)
 				return false;
 
-			if(t.next() == TK_TEXT && t.valueUpper() == "EXISTS") {
+			if(t.next() == TK_TEXT && t.match("EXISTS")) {
 				m_exists = number;
 				return true;
 			}
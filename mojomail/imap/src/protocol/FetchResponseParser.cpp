@@ -17,13 +17,13 @@
 // LICENSE@@@
 
 #include "protocol/FetchResponseParser.h"
-#include <boost/regex.hpp>
 #include "parser/ImapParser.h"
 #include "parser/Rfc3501Tokenizer.h"
 #include "parser/SemanticActions.h"
 #include "data/ImapEmail.h"
 #include "client/ImapSession.h"
 #include <algorithm>
+#include <strings.h>
 #include "stream/ByteBufferOutputStream.h"
 #include "stream/CounterOutputStream.h"
 
@@ -35,15 +35,19 @@ const int READ_TIMEOUT = 90; // 90 seconds to read 8K = 0.1 KB/second
 
 FetchResponseParser::FetchResponseParser(ImapSession& session)
 : ImapResponseParser(session),
+  m_partStreamFactory(NULL),
   m_literalBytesRemaining(0),
-  m_recoveringFromError(false)
+  m_recoveringFromError(false),
+  m_numResponses(0)
 {
 }
 
 FetchResponseParser::FetchResponseParser(ImapSession& session, DoneSignal::SlotRef doneSlot)
 : ImapResponseParser(session, doneSlot),
+  m_partStreamFactory(NULL),
   m_literalBytesRemaining(0),
-  m_recoveringFromError(false)
+  m_recoveringFromError(false),
+  m_numResponses(0)
 {
 }
 
@@ -56,22 +60,81 @@ void FetchResponseParser::SetPartOutputStream(const OutputStreamPtr& outputStrea
 	m_partOutputStream = outputStream;
 }
 
+void FetchResponseParser::SetPartOutputStreamFactory(PartOutputStreamFactory* factory)
+{
+	m_partStreamFactory = factory;
+
+	if(m_semantic.get()) {
+		m_semantic->SetPartOutputStreamFactory(factory);
+	}
+}
+
+void FetchResponseParser::Reset()
+{
+	m_imapParser.reset();
+	m_semantic.reset();
+	m_emails.clear();
+
+	m_literalBytesRemaining = 0;
+	m_recoveringFromError = false;
+
+	// The emails are gone, so the arena's block can usually be reused
+	m_arena.Reset();
+}
+
+void FetchResponseParser::Status(MojObject& status) const
+{
+	MojErr err;
+	const ParserArena::Stats& stats = m_arena.GetStats();
+
+	err = status.put("numResponses", (MojInt64) m_numResponses);
+	ErrorToException(err);
+
+	err = status.put("arenaAllocations", (MojInt64) stats.numAllocations);
+	ErrorToException(err);
+
+	err = status.put("arenaBytes", (MojInt64) stats.bytesAllocated);
+	ErrorToException(err);
+
+	err = status.put("heapBlocks", (MojInt64) stats.numBlocks);
+	ErrorToException(err);
+
+	err = status.put("heapBytes", (MojInt64) stats.bytesReserved);
+	ErrorToException(err);
+}
+
+// Matches "[0-9]+ FETCH" (case insensitive) at the start of the line
+bool FetchResponseParser::IsFetchResponse(const string& line)
+{
+	size_t i = 0;
+	while(i < line.size() && line[i] >= '0' && line[i] <= '9')
+		i++;
+
+	return i > 0 && line.size() >= i + 6 && line[i] == ' ' && strncasecmp(line.data() + i + 1, "FETCH", 5) == 0;
+}
+
 bool FetchResponseParser::HandleUntaggedResponse(const string& line)
 {
-	boost::regex fetchRe("[0-9]+ FETCH", boost::regex::icase);
-	if(boost::regex_search(line, fetchRe, boost:: match_continuous)) {
-		m_tokenizer.reset(new Rfc3501Tokenizer(line, true));
+	if(IsFetchResponse(line)) {
+		// Reuse the tokenizer buffer between responses
+		if(m_tokenizer.get())
+			m_tokenizer->reset(line);
+		else
+			m_tokenizer.reset(new Rfc3501Tokenizer(line, true));
 		
 		// Add newline
 		m_tokenizer->append("\r\n");
 		
-		m_semantic.reset(new SemanticActions(*m_tokenizer.get()));
+		m_numResponses++;
+		m_semantic.reset(new SemanticActions(*m_tokenizer.get(), m_arena));
 		m_imapParser.reset(new ImapParser(m_tokenizer.get(), m_semantic.get()));
 		
 		if(m_partOutputStream.get()) {
 			m_semantic->SetBodyOutputStream(m_partOutputStream);
 		}
 
+		m_semantic->SetPartOutputStreamFactory(m_partStreamFactory);
+
 		try {
 			Parse();
 		} catch(const std::exception& e) {
@@ -181,7 +244,7 @@ bool FetchResponseParser::HandleAdditionalData()
 				m_tokenizer->compact();
 
 				// Check for obvious abuse (trying to get around line reader max line length)
-				if(m_tokenizer->token.size() > MAX_INCOMPLETE_STRING_SIZE) {
+				if(m_tokenizer->size() > MAX_INCOMPLETE_STRING_SIZE) {
 					throw Rfc3501ParseException("excessively long string", __FILE__, __LINE__);
 				}
 
@@ -214,8 +277,16 @@ void FetchResponseParser::RequestMoreData()
 	MojRefCountedPtr<FetchResponseParser> ref(this);
 
 	if(m_semantic->ExpectingBinaryData()) {
-		// Read a buffer-full of data
-		size_t bytesRequested = min<size_t>(m_literalBytesRemaining, READ_BUFFER_SIZE);
+		size_t bytesRequested;
+
+		if(m_partOutputStream.get() || m_partStreamFactory) {
+			// Streaming a part body; take whatever has arrived so it goes straight from
+			// the socket read buffer to the part stream, instead of piling up in the input buffer
+			bytesRequested = min<size_t>(m_literalBytesRemaining, 1);
+		} else {
+			// Read a buffer-full of data
+			bytesRequested = min<size_t>(m_literalBytesRemaining, READ_BUFFER_SIZE);
+		}
 
 		MojLogDebug(m_log, "requesting another %d bytes of binary data", bytesRequested);
 		m_session.RequestData(ref, bytesRequested, READ_TIMEOUT);
@@ -256,7 +327,7 @@ bool FetchResponseParser::Parse()
 		assert( email.get() );
 		MojLogInfo(m_log, "parsed email uid=%d msg=%d", email->GetUID(), msgNum);
 
-		m_emails.push_back( FetchUpdate(msgNum, email, m_semantic->GetFlagsUpdated()) );
+		m_emails.push_back( FetchUpdate(msgNum, email, m_semantic->GetFlagsUpdated(), m_semantic->GetModSeq()) );
 	}
 	
 	// Return true if we need more data
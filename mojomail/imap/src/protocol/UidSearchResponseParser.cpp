@@ -17,13 +17,36 @@
 // LICENSE@@@
 
 #include "protocol/UidSearchResponseParser.h"
+#include "client/Capabilities.h"
+#include "parser/Util.h"
+#include "sync/UIDRangeSet.h"
 #include <boost/algorithm/string/predicate.hpp>
+#include <cctype>
 #include <sstream>
 
 using namespace std;
 
+UidSearchResponseParser::UidSearchResponseParser(ImapSession& session, vector<UID>& uidList)
+: ImapResponseParser(session),
+  m_uidList(&uidList),
+  m_count(-1),
+  m_gotResults(false)
+{
+}
+
 UidSearchResponseParser::UidSearchResponseParser(ImapSession& session, DoneSignal::SlotRef doneSlot, vector<UID>& uidList)
-: ImapResponseParser(session, doneSlot), m_uidList(uidList)
+: ImapResponseParser(session, doneSlot),
+  m_uidList(&uidList),
+  m_count(-1),
+  m_gotResults(false)
+{
+}
+
+UidSearchResponseParser::UidSearchResponseParser(ImapSession& session)
+: ImapResponseParser(session),
+  m_uidList(NULL),
+  m_count(-1),
+  m_gotResults(false)
 {
 }
 
@@ -68,15 +91,160 @@ bool UidSearchResponseParser::ParseUids(const std::string& line, std::vector<UID
 	return true;
 }
 
+string UidSearchResponseParser::BuildSearchCommand(const Capabilities& caps, const string& criteria, ReturnOption returnOption)
+{
+	stringstream ss;
+	ss << "UID SEARCH ";
+
+	if(caps.HasCapability(Capabilities::ESEARCH)) {
+		ss << (returnOption == RETURN_COUNT ? "RETURN (COUNT) " : "RETURN (ALL) ");
+	}
+
+	ss << criteria;
+	return ss.str();
+}
+
+// Get the next space-delimited word, or a parenthesized list
+static bool NextWord(const string& line, size_t& pos, string& word)
+{
+	while(pos < line.size() && line[pos] == ' ')
+		pos++;
+
+	if(pos >= line.size())
+		return false;
+
+	size_t start = pos;
+
+	if(line[pos] == '(') {
+		int depth = 0;
+		for(; pos < line.size(); pos++) {
+			if(line[pos] == '(') {
+				depth++;
+			} else if(line[pos] == ')' && --depth == 0) {
+				pos++;
+				break;
+			}
+		}
+	} else {
+		pos = line.find(' ', pos);
+		if(pos == string::npos)
+			pos = line.size();
+	}
+
+	word.assign(line, start, pos - start);
+	return true;
+}
+
+/**
+ * Format (RFC 4466): "(" "TAG" SP tag-string ")"
+ */
+bool UidSearchResponseParser::ParseEsearchTag(const string& line, string& tag)
+{
+	size_t pos = 0;
+	string word;
+
+	if(!NextWord(line, pos, word) || word.size() < 2 || word[0] != '(' || word[word.size() - 1] != ')')
+		return false;
+
+	// Contents of the parentheses
+	string correlator(word, 1, word.size() - 2);
+
+	string name;
+	SplitOnce(correlator, name, tag);
+
+	if(!boost::iequals(name, "TAG"))
+		return false;
+
+	// Tags we send never need escaping
+	if(tag.size() >= 2 && tag[0] == '"' && tag[tag.size() - 1] == '"')
+		tag = tag.substr(1, tag.size() - 2);
+
+	return !tag.empty();
+}
+
+/**
+ * Format (RFC 4731): [(TAG "tag")] [UID] *(SP name SP value)
+ *
+ * Result data other than ALL and COUNT (e.g. MIN) is skipped.
+ */
+bool UidSearchResponseParser::ParseEsearch(const string& line, vector<UID>& uids, int& count)
+{
+	size_t pos = 0;
+	string word, value;
+
+	bool hasWord = NextWord(line, pos, word);
+
+	// Search correlator
+	if(hasWord && word[0] == '(') {
+		hasWord = NextWord(line, pos, word);
+	}
+
+	if(hasWord && boost::iequals(word, "UID")) {
+		hasWord = NextWord(line, pos, word);
+	}
+
+	for(; hasWord; hasWord = NextWord(line, pos, word)) {
+		if(!NextWord(line, pos, value))
+			return false;
+
+		if(boost::iequals(word, "ALL")) {
+			UIDRangeSet set;
+			if(!UIDRangeSet::Parse(value, set))
+				return false;
+
+			set.GetUIDs(uids);
+		} else if(boost::iequals(word, "COUNT")) {
+			if(!isdigit(value[0]) || !Util::from_string(count, value, std::dec))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 bool UidSearchResponseParser::HandleUntaggedResponse(const string& line)
 {
+	if(m_gotResults)
+		return false;
+
+	// If we only need the count, the UIDs are thrown away
+	vector<UID> discardedUIDs;
+	vector<UID>& uids = m_uidList ? *m_uidList : discardedUIDs;
+	size_t oldSize = uids.size();
+
 	if(boost::istarts_with(line, "SEARCH")) {
 		string word; // should be search
 		string rest;
 		
 		SplitOnce(line, word, rest);
-		
-		ParseUids(rest, m_uidList);
+
+		ParseUids(rest, uids);
+
+		m_count = uids.size() - oldSize;
+		m_gotResults = true;
+
+		// Claim the response so the next pipelined search doesn't also get it
+		return true;
+	} else if(boost::istarts_with(line, "ESEARCH")) {
+		string word; // should be esearch
+		string rest;
+
+		SplitOnce(line, word, rest);
+
+		// Leave results for other pipelined searches to their own parsers
+		string tag;
+		if(ParseEsearchTag(rest, tag) && !m_tag.empty() && tag != m_tag) {
+			return false;
+		}
+
+		int count = -1;
+		if(!ParseEsearch(rest, uids, count)) {
+			ThrowParseException("invalid ESEARCH response");
+		}
+
+		m_count = count >= 0 ? count : uids.size() - oldSize;
+		m_gotResults = true;
+		return true;
 	}
 	return false;
 }
@@ -24,11 +24,14 @@
 #include "data/EmailAdapter.h"
 #include "data/ImapEmail.h"
 #include "parser/Rfc3501Tokenizer.h"
+#include "parser/Util.h"
 #include "sync/UIDMap.h"
+#include "sync/UIDRangeSet.h"
 #include "ImapPrivate.h"
 
 UntaggedUpdateParser::UntaggedUpdateParser(ImapSession& session)
 : ImapResponseParser(session),
+  m_numPendingUpdates(0),
   m_updateCommandSlot(this, &UntaggedUpdateParser::UpdateCommandResponse)
 {
 }
@@ -88,48 +91,88 @@ bool UntaggedUpdateParser::HandleUntaggedResponse(const string& line)
 					UID uid = uidMap->Remove(number);
 					MojLogInfo(m_log, "UID %d (msg %ld) expunged from server", uid, number);
 
-					MojObject newFlags(MojObject::Undefined);
-					m_handleUpdateCommand.reset(new HandleUpdateCommand(m_session, folderSession->GetFolderId(), uid, true, newFlags));
-
-					// Set up result so we get notified when it's done
-					m_result = m_handleUpdateCommand->GetResult();
-					m_result->ConnectDoneSlot(m_updateCommandSlot);
-
-					m_handleUpdateCommand->Run();
+					if(uid > 0) {
+						AddUpdate(folderSession->GetFolderId(), uid, true, MojObject(MojObject::Undefined));
+					}
 				}
 			} else if(key == "FETCH") {
-				m_fetchParser.reset(new FetchResponseParser(m_session));
+				// Reuse the parser and its arena block for each update
+				if(m_fetchParser.get()) {
+					m_fetchParser->Reset();
+				} else {
+					m_fetchParser.reset(new FetchResponseParser(m_session));
+				}
 
 				// TODO handle multi-line fetch responses
 				bool done = m_fetchParser->HandleUntaggedResponse(line);
 
 				if(done) {
 					BOOST_FOREACH(const FetchUpdate& update, m_fetchParser->GetUpdates()) {
+						if(update.modSeq > 0) {
+							folderSession->UpdateHighestModSeq(update.modSeq);
+						}
+
 						if(folderSession->HasUIDMap()) {
 							const boost::shared_ptr<UIDMap>& uidMap = folderSession->GetUIDMap();
 							UID uid = uidMap->GetUID(update.msgNum);
 							if(uid > 0 && update.flagsUpdated) {
-								MojLogInfo(m_log, "UID %d (msg %ld) flags updated", uid, number);
+								MojLogInfo(m_log, "UID %d (msg %d) flags updated", uid, update.msgNum);
 
 								MojObject newFlags;
 								EmailAdapter::SerializeFlags(*update.email, newFlags);
 
-								m_handleUpdateCommand.reset(new HandleUpdateCommand(m_session, folderSession->GetFolderId(), uid, update.email->IsDeleted(), newFlags));
-
-								// Set up result so we get notified when it's done
-								m_result = m_handleUpdateCommand->GetResult();
-								m_result->ConnectDoneSlot(m_updateCommandSlot);
-
-								m_handleUpdateCommand->Run();
-
-								// only handle one update
-								break;
+								AddUpdate(folderSession->GetFolderId(), uid, update.email->IsDeleted(), newFlags);
 							}
 						}
 					}
 				}
 			}
 		}
+	} else if(t.match("VANISHED")) {
+		// With QRESYNC enabled, the server sends VANISHED instead of EXPUNGE (RFC 7162)
+		const boost::shared_ptr<FolderSession>& folderSession = m_session.GetFolderSession();
+
+		// VANISHED (EARLIER) is only sent in response to our own requests
+		if(folderSession.get() && t.next() == TK_SP && t.next() == TK_TEXT) {
+			UIDRangeSet vanished;
+
+			if(!UIDRangeSet::Parse(t.value(), vanished)) {
+				ThrowParseException("invalid VANISHED uid set");
+			}
+
+			// The set comes from the server and may be huge (e.g. "1:4294967295"), so it's never
+			// expanded; only the UIDs we actually have in the UID map are handled.
+			unsigned int oldCount = folderSession->GetMessageCount();
+			unsigned int numRemoved;
+			vector<UID> uids;
+
+			if(folderSession->HasUIDMap()) {
+				numRemoved = folderSession->GetUIDMap()->RemoveUIDs(vanished, uids);
+			} else {
+				// Don't know which messages are local yet; the next sync will pick up the expunges
+				numRemoved = std::min((size_t) oldCount, vanished.size());
+			}
+
+			folderSession->SetMessageCount(oldCount - std::min(oldCount, numRemoved));
+
+			MojLogInfo(m_log, "%u messages vanished from server, %d of them in the UID map", numRemoved, (int) uids.size());
+
+			BOOST_FOREACH(UID uid, uids) {
+				AddUpdate(folderSession->GetFolderId(), uid, true, MojObject(MojObject::Undefined));
+			}
+		}
+	} else if(t.match("OK")) {
+		// OK [HIGHESTMODSEQ n] may be sent at any time while the folder is selected (RFC 7162)
+		const boost::shared_ptr<FolderSession>& folderSession = m_session.GetFolderSession();
+
+		if(folderSession.get() && t.next() == TK_SP && t.next() == TK_LBRACKET && t.next() == TK_TEXT && t.match("HIGHESTMODSEQ")) {
+			MojUInt64 modSeq = 0;
+			if(t.next() != TK_SP || t.next() != TK_TEXT || !Util::from_string(modSeq, t.value(), std::dec)) {
+				ThrowParseException("expected HIGHESTMODSEQ number");
+			}
+
+			folderSession->UpdateHighestModSeq(modSeq);
+		}
 	} else if(boost::iequals(t.value(), "BYE")) {
 		MojLogInfo(m_log, "received BYE from server: %s", line.c_str());
 	}
@@ -137,12 +180,86 @@ bool UntaggedUpdateParser::HandleUntaggedResponse(const string& line)
 	return true;
 }
 
+void UntaggedUpdateParser::AddUpdate(const MojObject& folderId, UID uid, bool deleted, const MojObject& newFlags)
+{
+	if(m_pendingUpdates.empty() || m_pendingUpdates.back().folderId != folderId) {
+		m_pendingUpdates.push_back(PendingUpdates());
+		m_pendingUpdates.back().folderId = folderId;
+	}
+
+	HandleUpdateCommand::UpdateMap& updates = m_pendingUpdates.back().updates;
+	HandleUpdateCommand::UpdateMap::iterator it = updates.find(uid);
+
+	if(it == updates.end()) {
+		it = updates.insert(make_pair(uid, HandleUpdateCommand::Update())).first;
+		m_numPendingUpdates++;
+	}
+
+	// A deletion can't be undone by a later flag change
+	if(deleted) {
+		it->second.deleted = true;
+	} else if(!it->second.deleted) {
+		it->second.newFlags = newFlags;
+	}
+
+	if(m_numPendingUpdates >= MAX_PENDING_UPDATES) {
+		FlushUpdates();
+	} else if(!m_updateWindowTimer.IsActive()) {
+		m_updateWindowTimer.SetTimeoutMillis(UPDATE_WINDOW_MILLIS, this, &UntaggedUpdateParser::UpdateWindowExpired);
+	}
+}
+
+void UntaggedUpdateParser::UpdateWindowExpired()
+{
+	FlushUpdates();
+}
+
+void UntaggedUpdateParser::FlushUpdates()
+{
+	m_updateWindowTimer.Cancel();
+
+	// Only one update command runs at a time; the rest will be written when it's done
+	if(m_handleUpdateCommand.get() == NULL) {
+		RunNextUpdateCommand();
+	}
+}
+
+void UntaggedUpdateParser::RunNextUpdateCommand()
+{
+	if(m_pendingUpdates.empty()) {
+		return;
+	}
+
+	PendingUpdates& pending = m_pendingUpdates.front();
+
+	MojLogInfo(m_log, "writing %d updates from server", (int) pending.updates.size());
+
+	m_handleUpdateCommand.reset(new HandleUpdateCommand(m_session, pending.folderId, pending.updates));
+
+	m_numPendingUpdates -= pending.updates.size();
+	m_pendingUpdates.pop_front();
+
+	// Set up result so we get notified when it's done
+	m_result = m_handleUpdateCommand->GetResult();
+	m_result->ConnectDoneSlot(m_updateCommandSlot);
+
+	m_handleUpdateCommand->Run();
+}
+
 MojErr UntaggedUpdateParser::UpdateCommandResponse()
 {
 	try {
 		m_result->CheckException();
 	} catch(const exception& e) {
-		// FIXME
+		MojLogError(m_log, "error writing updates from server: %s", e.what());
+	}
+
+	m_handleUpdateCommand.reset();
+
+	// Write anything that came in while the command was running, unless
+	// we're still waiting for more
+	if(!m_updateWindowTimer.IsActive()) {
+		RunNextUpdateCommand();
 	}
 
 	m_session.ParserFinished(this);
@@ -0,0 +1,65 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "sync/BatchSizeTuner.h"
+#include <algorithm>
+
+BatchSizeTuner::BatchSizeTuner(int initialSize, int minSize, int maxSize)
+: m_minSize(std::max(1, minSize)),
+  m_maxSize(std::max(m_minSize, maxSize)),
+  m_lastPutMillis(-1)
+{
+	m_batchSize = std::max(m_minSize, std::min(initialSize, m_maxSize));
+}
+
+BatchSizeTuner::~BatchSizeTuner()
+{
+}
+
+void BatchSizeTuner::FetchComplete(int numHeaders, MojInt64 millis)
+{
+	if(millis > SLOW_BATCH_MILLIS) {
+		Shrink();
+	} else if(millis < FAST_BATCH_MILLIS && numHeaders >= m_batchSize) {
+		// Only grow if the batch was full; a short final batch says nothing
+		// about how long a bigger one would take. Also don't grow past what
+		// the database is keeping up with.
+		if(m_lastPutMillis < FAST_BATCH_MILLIS) {
+			Grow();
+		}
+	}
+}
+
+void BatchSizeTuner::PutComplete(int numEmails, MojInt64 millis)
+{
+	m_lastPutMillis = millis;
+
+	if(millis > SLOW_BATCH_MILLIS && numEmails > m_minSize) {
+		Shrink();
+	}
+}
+
+void BatchSizeTuner::Grow()
+{
+	m_batchSize = std::min(m_batchSize * 2, m_maxSize);
+}
+
+void BatchSizeTuner::Shrink()
+{
+	m_batchSize = std::max(m_batchSize / 2, m_minSize);
+}
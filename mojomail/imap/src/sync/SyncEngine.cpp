@@ -20,15 +20,36 @@
 #include "ImapPrivate.h"
 #include <utility>
 
+const SyncEngine::ChangeList SyncEngine::EMPTY_CHANGES;
+
 SyncEngine::SyncEngine(const UIDList& sortedRemote, const UIDList& sortedDeleted,
 		const UIDList& sortedUnseen, const UIDList& sortedAnswered,
 		const UIDList& sortedFlagged)
-: m_remoteUIDs(sortedRemote),
-  m_deletedUIDs(sortedDeleted),
-  m_unseenUIDs(sortedUnseen),
-  m_answeredUIDs(sortedAnswered),
-  m_flaggedUIDs(sortedFlagged),
-  m_remoteIt(sortedRemote.begin())
+: m_incremental(false),
+  m_remoteIt(m_remoteTable),
+  m_changes(EMPTY_CHANGES),
+  m_changeIt(EMPTY_CHANGES.begin()),
+  m_lastLocalUID(0),
+  m_maxNewUIDs(0)
+{
+	m_remoteTable.AddUIDs(sortedRemote);
+	m_remoteTable.SetFlag(sortedDeleted, UIDFlagTable::FLAG_DELETED);
+	m_remoteTable.SetFlag(sortedUnseen, UIDFlagTable::FLAG_UNSEEN);
+	m_remoteTable.SetFlag(sortedAnswered, UIDFlagTable::FLAG_ANSWERED);
+	m_remoteTable.SetFlag(sortedFlagged, UIDFlagTable::FLAG_FLAGGED);
+
+	// Start iterating now that the table is filled in
+	m_remoteIt.Reset();
+}
+
+SyncEngine::SyncEngine(const ChangeList& sortedChanges, const UIDRangeSet& vanished, unsigned int maxNewUIDs)
+: m_incremental(true),
+  m_remoteIt(m_remoteTable),
+  m_changes(sortedChanges),
+  m_changeIt(sortedChanges.begin()),
+  m_vanishedUIDs(vanished),
+  m_lastLocalUID(0),
+  m_maxNewUIDs(maxNewUIDs)
 {
 }
 
@@ -42,39 +63,45 @@ SyncEngine::~SyncEngine()
  */
 void SyncEngine::Diff(const vector<EmailStub> &localBatch, bool hasMoreLocal)
 {
+	if(m_incremental) {
+		DiffIncremental(localBatch, hasMoreLocal);
+		return;
+	}
+
 	vector<EmailStub>::const_iterator localIt = localBatch.begin();
 
-	while(localIt != localBatch.end() && m_remoteIt != m_remoteUIDs.end()) {
+	while(localIt != localBatch.end() && !m_remoteIt.AtEnd()) {
 		UID localUID = localIt->uid;
-		UID remoteUID = *m_remoteIt;
+		UID remoteUID = m_remoteIt.GetUID();
+		unsigned int remoteFlags = m_remoteIt.GetFlags();
 
 		if(localUID == remoteUID) {
 			// In both the local and remote lists
 
 			// Check deleted
-			if(m_deletedUIDs.Find(localUID)) {
+			if(remoteFlags & UIDFlagTable::FLAG_DELETED) {
 				m_deletedIds.push_back(localIt->id);
 			} else {
 				// Check flags
 				EmailFlags serverFlags;
-				serverFlags.read = (m_unseenUIDs.Find(localUID) == false);
-				serverFlags.replied = m_answeredUIDs.Find(localUID);
-				serverFlags.flagged = m_flaggedUIDs.Find(localUID);
+				serverFlags.read = !(remoteFlags & UIDFlagTable::FLAG_UNSEEN);
+				serverFlags.replied = remoteFlags & UIDFlagTable::FLAG_ANSWERED;
+				serverFlags.flagged = remoteFlags & UIDFlagTable::FLAG_FLAGGED;
 
 				if(serverFlags != localIt->lastSyncFlags) {
 					m_modifiedFlags.push_back( make_pair(*localIt, serverFlags) );
 				}
 			}
 
-			++m_remoteIt;
+			m_remoteIt.Next();
 			++localIt;
 		} else if(remoteUID < localUID) {
 			// Only in the remote list, and not deleted
-			if(!m_deletedUIDs.Find(remoteUID)) {
+			if(!(remoteFlags & UIDFlagTable::FLAG_DELETED)) {
 				m_newUIDs.push_back(remoteUID);
 			}
 
-			++m_remoteIt;
+			m_remoteIt.Next();
 		} else if(remoteUID > localUID) {
 			// Only in the local list
 			m_deletedIds.push_back(localIt->id);
@@ -93,30 +120,69 @@ void SyncEngine::Diff(const vector<EmailStub> &localBatch, bool hasMoreLocal)
 
 	if(!hasMoreLocal) {
 		// Any remaining remote UIDs are considered new
-		while(m_remoteIt != m_remoteUIDs.end()) {
+		for(; !m_remoteIt.AtEnd(); m_remoteIt.Next()) {
 			// Only if not deleted
-			if(!m_deletedUIDs.Find(*m_remoteIt)) {
-				m_newUIDs.push_back(*m_remoteIt);
+			if(!(m_remoteIt.GetFlags() & UIDFlagTable::FLAG_DELETED)) {
+				m_newUIDs.push_back(m_remoteIt.GetUID());
 			}
-			++m_remoteIt;
 		}
 	}
 }
 
-SyncEngine::UIDSet::UIDSet(const UIDList& uidList)
-: m_uidList(uidList), m_it(uidList.begin())
+/**
+ * Apply the server changes to a batch of local emails. The local emails must be in ascending
+ * order by UID. Local emails which aren't in the change list are unchanged on the server.
+ *
+ * Changed UIDs that are higher than any local UID are new messages. Changes to other messages
+ * we don't have locally (e.g. outside the sync window) are ignored.
+ */
+void SyncEngine::DiffIncremental(const vector<EmailStub> &localBatch, bool hasMoreLocal)
 {
-}
+	vector<EmailStub>::const_iterator localIt;
 
-bool SyncEngine::UIDSet::Find(UID uid)
-{
-	// Skip over any lower UIDs
-	while(m_it != m_uidList.end() && *m_it < uid) {
-		++m_it;
+	for(localIt = localBatch.begin(); localIt != localBatch.end(); ++localIt) {
+		UID localUID = localIt->uid;
+
+		// Skip over changes to messages we don't have
+		while(m_changeIt != m_changes.end() && m_changeIt->uid < localUID) {
+			++m_changeIt;
+		}
+
+		bool changed = m_changeIt != m_changes.end() && m_changeIt->uid == localUID;
+
+		if(m_vanishedUIDs.Contains(localUID) || (changed && m_changeIt->deleted)) {
+			m_deletedIds.push_back(localIt->id);
+		} else {
+			if(changed) {
+				EmailFlags serverFlags = m_changeIt->flags;
+
+				if(serverFlags != localIt->lastSyncFlags) {
+					m_modifiedFlags.push_back( make_pair(*localIt, serverFlags) );
+				}
+			}
+
+			m_remainingUIDs.push_back(localUID);
+		}
+
+		m_lastLocalUID = localUID;
 	}
 
-	if(m_it != m_uidList.end() && *m_it == uid)
-		return true;
+	if(!hasMoreLocal) {
+		// Anything newer than the last local email is new, unless it's already deleted
+		for(; m_changeIt != m_changes.end(); ++m_changeIt) {
+			if(m_changeIt->uid > m_lastLocalUID && !m_changeIt->deleted) {
+				m_newUIDs.push_back(m_changeIt->uid);
+				m_remainingUIDs.push_back(m_changeIt->uid);
+			}
+		}
 
-	return false;
+		// Keep only the newest messages, same as the UID map does for a full sync
+		if(m_maxNewUIDs > 0 && m_newUIDs.size() > m_maxNewUIDs) {
+			size_t excess = m_newUIDs.size() - m_maxNewUIDs;
+			vector<UID>::iterator firstNew = m_remainingUIDs.end() - m_newUIDs.size();
+
+			m_remainingUIDs.erase(firstNew, firstNew + excess);
+			m_newUIDs.erase(m_newUIDs.begin(), m_newUIDs.begin() + excess);
+		}
+	}
 }
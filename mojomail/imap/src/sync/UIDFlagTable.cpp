@@ -0,0 +1,328 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "sync/UIDFlagTable.h"
+#include <algorithm>
+
+using namespace std;
+
+static inline MojUInt32 ChunkKey(UID uid)
+{
+	return uid >> 16;
+}
+
+static inline uint16_t LowBits(UID uid)
+{
+	return uid & 0xFFFF;
+}
+
+static inline bool TestBit(const uint64_t* bitmap, unsigned int bit)
+{
+	return (bitmap[bit / 64] >> (bit % 64)) & 1;
+}
+
+static inline void SetBit(uint64_t* bitmap, unsigned int bit)
+{
+	bitmap[bit / 64] |= (uint64_t) 1 << (bit % 64);
+}
+
+// Returns the index of the flag's bitmap
+static inline unsigned int FlagBitmapIndex(UIDFlagTable::Flag flag)
+{
+	return 1 + __builtin_ctz(flag);
+}
+
+// Orders chunks by key
+struct ChunkBefore
+{
+	bool operator()(const UIDFlagTable::Chunk& chunk, MojUInt32 key) const
+	{
+		return chunk.key < key;
+	}
+};
+
+void UIDFlagTable::Chunk::ConvertToBitmap()
+{
+	bitmaps.assign((1 + NUM_FLAGS) * BITMAP_WORDS, 0);
+
+	for(size_t i = 0; i < lows.size(); ++i) {
+		SetBit(GetBitmap(0), lows[i]);
+
+		for(unsigned int f = 0; f < NUM_FLAGS; ++f) {
+			if(flags[i] & (1 << f)) {
+				SetBit(GetBitmap(1 + f), lows[i]);
+			}
+		}
+	}
+
+	// Free the array storage
+	vector<uint16_t>().swap(lows);
+	vector<uint8_t>().swap(flags);
+}
+
+UIDFlagTable::UIDFlagTable()
+: m_size(0)
+{
+}
+
+UIDFlagTable::~UIDFlagTable()
+{
+}
+
+void UIDFlagTable::Add(UID uid)
+{
+	MojUInt32 key = ChunkKey(uid);
+
+	if(m_chunks.empty() || m_chunks.back().key < key) {
+		m_chunks.push_back(Chunk(key));
+	} else if(m_chunks.back().key > key) {
+		return; // out of order
+	}
+
+	Chunk& chunk = m_chunks.back();
+	uint16_t low = LowBits(uid);
+
+	if(chunk.IsBitmap()) {
+		uint64_t* present = chunk.GetBitmap(0);
+
+		// Bitmaps only need to be in order to catch duplicates
+		if(TestBit(present, low)) {
+			return;
+		}
+
+		SetBit(present, low);
+	} else {
+		if(!chunk.lows.empty() && chunk.lows.back() >= low) {
+			return; // out of order or duplicate
+		}
+
+		chunk.lows.push_back(low);
+		chunk.flags.push_back(0);
+
+		if(chunk.lows.size() > MAX_ARRAY_SIZE) {
+			chunk.ConvertToBitmap();
+		}
+	}
+
+	chunk.count++;
+	m_size++;
+}
+
+void UIDFlagTable::AddUIDs(const vector<UID>& sortedUIDs)
+{
+	for(vector<UID>::const_iterator it = sortedUIDs.begin(); it != sortedUIDs.end(); ++it) {
+		Add(*it);
+	}
+}
+
+void UIDFlagTable::SetFlag(const vector<UID>& sortedUIDs, Flag flag)
+{
+	vector<UID>::const_iterator it = sortedUIDs.begin();
+	ChunkList::iterator chunkIt = m_chunks.begin();
+
+	while(it != sortedUIDs.end() && chunkIt != m_chunks.end()) {
+		MojUInt32 key = ChunkKey(*it);
+
+		// Find the UIDs in the same chunk
+		vector<UID>::const_iterator runEnd = it;
+		while(runEnd != sortedUIDs.end() && ChunkKey(*runEnd) == key) {
+			++runEnd;
+		}
+
+		chunkIt = lower_bound(chunkIt, m_chunks.end(), key, ChunkBefore());
+
+		if(chunkIt != m_chunks.end() && chunkIt->key == key) {
+			SetChunkFlag(*chunkIt, it, runEnd, flag);
+		}
+
+		it = runEnd;
+	}
+}
+
+void UIDFlagTable::SetChunkFlag(Chunk& chunk, vector<UID>::const_iterator begin, vector<UID>::const_iterator end, Flag flag)
+{
+	if(chunk.IsBitmap()) {
+		// Build a bitmap of the UIDs, then combine it with the presence bitmap
+		// one word at a time, so UIDs that aren't in the table aren't flagged
+		vector<uint64_t> temp(Chunk::BITMAP_WORDS, 0);
+
+		for(vector<UID>::const_iterator it = begin; it != end; ++it) {
+			SetBit(&temp[0], LowBits(*it));
+		}
+
+		const uint64_t* present = chunk.GetBitmap(0);
+		uint64_t* flagBitmap = chunk.GetBitmap(FlagBitmapIndex(flag));
+
+		for(unsigned int i = 0; i < Chunk::BITMAP_WORDS; ++i) {
+			flagBitmap[i] |= temp[i] & present[i];
+		}
+	} else {
+		// Merge the two sorted lists
+		vector<uint16_t>::iterator lowIt = chunk.lows.begin();
+
+		for(vector<UID>::const_iterator it = begin; it != end && lowIt != chunk.lows.end(); ++it) {
+			uint16_t low = LowBits(*it);
+
+			lowIt = lower_bound(lowIt, chunk.lows.end(), low);
+
+			if(lowIt != chunk.lows.end() && *lowIt == low) {
+				chunk.flags[lowIt - chunk.lows.begin()] |= flag;
+			}
+		}
+	}
+}
+
+const UIDFlagTable::Chunk* UIDFlagTable::FindChunk(MojUInt32 key) const
+{
+	ChunkList::const_iterator it = lower_bound(m_chunks.begin(), m_chunks.end(), key, ChunkBefore());
+
+	if(it != m_chunks.end() && it->key == key) {
+		return &(*it);
+	}
+
+	return NULL;
+}
+
+bool UIDFlagTable::Contains(UID uid) const
+{
+	const Chunk* chunk = FindChunk(ChunkKey(uid));
+
+	if(chunk == NULL) {
+		return false;
+	} else if(chunk->IsBitmap()) {
+		return TestBit(chunk->GetBitmap(0), LowBits(uid));
+	} else {
+		return binary_search(chunk->lows.begin(), chunk->lows.end(), LowBits(uid));
+	}
+}
+
+unsigned int UIDFlagTable::GetFlags(UID uid) const
+{
+	const Chunk* chunk = FindChunk(ChunkKey(uid));
+	uint16_t low = LowBits(uid);
+
+	if(chunk == NULL) {
+		return 0;
+	} else if(chunk->IsBitmap()) {
+		unsigned int flags = 0;
+
+		for(unsigned int f = 0; f < NUM_FLAGS; ++f) {
+			if(TestBit(chunk->GetBitmap(1 + f), low)) {
+				flags |= 1 << f;
+			}
+		}
+
+		return flags;
+	} else {
+		vector<uint16_t>::const_iterator it = lower_bound(chunk->lows.begin(), chunk->lows.end(), low);
+
+		if(it != chunk->lows.end() && *it == low) {
+			return chunk->flags[it - chunk->lows.begin()];
+		}
+
+		return 0;
+	}
+}
+
+size_t UIDFlagTable::GetMemoryUsage() const
+{
+	size_t bytes = sizeof(*this) + m_chunks.capacity() * sizeof(Chunk);
+
+	for(ChunkList::const_iterator it = m_chunks.begin(); it != m_chunks.end(); ++it) {
+		bytes += it->lows.capacity() * sizeof(uint16_t);
+		bytes += it->flags.capacity() * sizeof(uint8_t);
+		bytes += it->bitmaps.capacity() * sizeof(uint64_t);
+	}
+
+	return bytes;
+}
+
+UIDFlagTable::Iterator::Iterator(const UIDFlagTable& table)
+: m_table(table),
+  m_chunkIndex(0),
+  m_position(0),
+  m_uid(0)
+{
+	Seek(0);
+}
+
+void UIDFlagTable::Iterator::Seek(unsigned int position)
+{
+	// Find the next UID at or after the position, moving on to later chunks as needed
+	while(m_chunkIndex < m_table.m_chunks.size()) {
+		const Chunk& chunk = m_table.m_chunks[m_chunkIndex];
+
+		if(chunk.IsBitmap()) {
+			const uint64_t* present = chunk.GetBitmap(0);
+
+			for(unsigned int word = position / 64; word < Chunk::BITMAP_WORDS; ++word) {
+				// Mask off bits before the position in the first word
+				uint64_t bits = present[word];
+				if(word == position / 64) {
+					bits &= ~(uint64_t) 0 << (position % 64);
+				}
+
+				if(bits) {
+					m_position = word * 64 + __builtin_ctzll(bits);
+					m_uid = (chunk.key << 16) | m_position;
+					return;
+				}
+			}
+		} else if(position < chunk.lows.size()) {
+			m_position = position;
+			m_uid = (chunk.key << 16) | chunk.lows[position];
+			return;
+		}
+
+		// Nothing left in this chunk
+		++m_chunkIndex;
+		position = 0;
+	}
+}
+
+void UIDFlagTable::Iterator::Reset()
+{
+	m_chunkIndex = 0;
+	Seek(0);
+}
+
+void UIDFlagTable::Iterator::Next()
+{
+	if(!AtEnd()) {
+		Seek(m_position + 1);
+	}
+}
+
+unsigned int UIDFlagTable::Iterator::GetFlags() const
+{
+	const Chunk& chunk = m_table.m_chunks[m_chunkIndex];
+
+	if(chunk.IsBitmap()) {
+		unsigned int flags = 0;
+
+		for(unsigned int f = 0; f < NUM_FLAGS; ++f) {
+			if(TestBit(chunk.GetBitmap(1 + f), m_position)) {
+				flags |= 1 << f;
+			}
+		}
+
+		return flags;
+	} else {
+		return chunk.flags[m_position];
+	}
+}
@@ -17,32 +17,45 @@
 // LICENSE@@@
 
 #include "sync/UIDMap.h"
+#include "sync/UIDRangeSet.h"
 #include <algorithm>
 
 using namespace std;
 
+// Don't bother compacting small maps
+static const size_t MIN_COMPACT_SLOTS = 64;
+
+static inline size_t LowBit(size_t i)
+{
+	return i & (~i + 1);
+}
+
 UIDMap::UIDMap(const vector<UID>& initialUidList, unsigned int msgCount, unsigned int maxSize)
 {
 	// Copy the uids (must already be sorted)
-	unsigned int listSize = maxSize > 0 ? std::min(maxSize, initialUidList.size()) : initialUidList.size();
+	unsigned int listSize = maxSize > 0 ? std::min((size_t) maxSize, initialUidList.size()) : initialUidList.size();
 
 	m_uids.insert(m_uids.begin(), initialUidList.end() - listSize, initialUidList.end());
 
 	// Make sure there's no duplicates
-	std::unique(m_uids.begin(), m_uids.end());
+	m_uids.erase(std::unique(m_uids.begin(), m_uids.end()), m_uids.end());
+
+	m_size = m_uids.size();
+	m_present.assign(m_size, true);
+	RebuildTree();
 
 	// If we get back more results than expected, increase the message count
 	// It might just indicate that we haven't gotten an EXISTS response yet
 	// FIXME make sure this is safe / latest count
-	if(m_uids.size() > msgCount) {
-		msgCount = m_uids.size();
+	if(m_size > msgCount) {
+		msgCount = m_size;
 	}
 
 	m_msgCount = msgCount;
 
 	// Calculate the first message number.
 	// If we have the entire folder in the map, then the first message should be number 1.
-	m_firstMsgNum = msgCount + 1 - m_uids.size();
+	m_firstMsgNum = msgCount + 1 - m_size;
 
 	//printf("msgCount = %d, initial = %d, first = %d\n", msgCount, initialUidList.size(), m_firstMsgNum);
 }
@@ -51,21 +64,163 @@ UIDMap::~UIDMap()
 {
 }
 
+void UIDMap::RebuildTree()
+{
+	size_t numSlots = m_uids.size();
+	m_tree.assign(numSlots + 1, 1);
+	m_tree[0] = 0;
+
+	for(size_t i = 1; i <= numSlots; i++) {
+		size_t parent = i + LowBit(i);
+
+		if(parent <= numSlots) {
+			m_tree[parent] += m_tree[i];
+		}
+	}
+}
+
+void UIDMap::Compact()
+{
+	if(m_size == m_uids.size()) {
+		return;
+	}
+
+	size_t out = 0;
+	for(size_t slot = 0; slot < m_uids.size(); slot++) {
+		if(m_present[slot]) {
+			m_uids[out++] = m_uids[slot];
+		}
+	}
+
+	m_uids.resize(out);
+	m_present.assign(out, true);
+	RebuildTree();
+}
+
+unsigned int UIDMap::CountBefore(size_t slot) const
+{
+	unsigned int count = 0;
+
+	for(size_t i = slot; i > 0; i -= LowBit(i)) {
+		count += m_tree[i];
+	}
+
+	return count;
+}
+
+size_t UIDMap::GetSlot(unsigned int index) const
+{
+	size_t step = 1;
+	while(step * 2 < m_tree.size()) {
+		step *= 2;
+	}
+
+	// Find the last tree position with no more than index present slots before it
+	size_t pos = 0;
+	unsigned int remaining = index;
+
+	for(; step > 0; step /= 2) {
+		if(pos + step < m_tree.size() && m_tree[pos + step] <= remaining) {
+			pos += step;
+			remaining -= m_tree[pos];
+		}
+	}
+
+	return pos;
+}
+
+void UIDMap::RemoveSlot(size_t slot)
+{
+	m_present[slot] = false;
+	m_size--;
+
+	for(size_t i = slot + 1; i < m_tree.size(); i += LowBit(i)) {
+		m_tree[i]--;
+	}
+}
+
+void UIDMap::AppendSlot(UID uid)
+{
+	size_t i = m_tree.size();
+
+	m_uids.push_back(uid);
+	m_present.push_back(true);
+	m_tree.push_back(1 + CountBefore(i - 1) - CountBefore(i - LowBit(i)));
+	m_size++;
+}
+
+size_t UIDMap::FindSlot(UID uid) const
+{
+	// Known UIDs are in ascending order, but new messages may not have a UID yet
+	size_t low = 0, high = m_uids.size();
+
+	while(low < high) {
+		size_t mid = low + (high - low) / 2;
+
+		size_t probe = mid;
+		while(probe > low && m_uids[probe] == 0) {
+			--probe;
+		}
+
+		if(m_uids[probe] == 0 || m_uids[probe] < uid) {
+			low = mid + 1;
+		} else if(m_uids[probe] > uid) {
+			high = probe;
+		} else {
+			return m_present[probe] ? probe : NOT_FOUND;
+		}
+	}
+
+	return NOT_FOUND;
+}
+
+UID UIDMap::GetUID(unsigned int num) const
+{
+	if(!WithinRange(num))
+		return 0;
+
+	return m_uids[GetSlot(num - m_firstMsgNum)];
+}
+
+const vector<UID>& UIDMap::GetUIDs()
+{
+	Compact();
+	return m_uids;
+}
+
 void UIDMap::UpdateMsgCount(unsigned int newCount)
 {
 	m_msgCount = newCount;
 
 	// Resize the UID list. Message numbers with an unknown UID will be zero'd out.
-	m_uids.resize(m_msgCount + 1 - m_firstMsgNum);
+	unsigned int newSize = newCount + 1 >= m_firstMsgNum ? newCount + 1 - m_firstMsgNum : 0;
+
+	if(newSize < m_size) {
+		// Drop the newest messages, including any removed slots after them
+		size_t slot = newSize > 0 ? GetSlot(newSize - 1) + 1 : 0;
+
+		m_uids.resize(slot);
+		m_present.resize(slot);
+		m_tree.resize(slot + 1);
+		m_size = newSize;
+	}
+
+	while(m_size < newSize) {
+		AppendSlot(0);
+	}
 }
 
 void UIDMap::GetMissingMsgNums(std::vector<unsigned int>& msgNums) const
 {
-	vector<UID>::const_iterator it;
+	unsigned int msgNum = m_firstMsgNum;
+
+	for(size_t slot = 0; slot < m_uids.size(); slot++) {
+		if(m_present[slot]) {
+			if(m_uids[slot] == 0) {
+				msgNums.push_back(msgNum);
+			}
 
-	for(unsigned int i = 0; i < m_uids.size(); i++) {
-		if(m_uids[i] == 0) {
-			msgNums.push_back(m_firstMsgNum + i);
+			msgNum++;
 		}
 	}
 }
@@ -73,7 +228,7 @@ void UIDMap::GetMissingMsgNums(std::vector<unsigned int>& msgNums) const
 void UIDMap::SetMsgUID(unsigned int msgNum, UID uid)
 {
 	if(WithinRange(msgNum)) {
-		m_uids[msgNum - m_firstMsgNum] = uid;
+		m_uids[GetSlot(msgNum - m_firstMsgNum)] = uid;
 	}
 }
 
@@ -83,14 +238,16 @@ UID UIDMap::Remove(unsigned int num)
 
 	if(WithinRange(num)) {
 		// If the message is within our map range, delete it
-		size_t offset = num - m_firstMsgNum;
+		size_t slot = GetSlot(num - m_firstMsgNum);
 
-		uid = m_uids[offset];
-		m_uids.erase(m_uids.begin() + offset);
-	}
+		uid = m_uids[slot];
+		RemoveSlot(slot);
 
-	if(num <= m_firstMsgNum) {
-		// If the deleted message is before our map range, or the first message
+		if(m_uids.size() >= MIN_COMPACT_SLOTS && m_uids.size() > 2 * m_size) {
+			Compact();
+		}
+	} else if(num <= m_firstMsgNum) {
+		// If the deleted message is before our map range, everything shifts down
 		--m_firstMsgNum;
 	}
 
@@ -99,3 +256,68 @@ UID UIDMap::Remove(unsigned int num)
 	return uid;
 }
 
+unsigned int UIDMap::RemoveUID(UID uid)
+{
+	size_t slot = FindSlot(uid);
+
+	if(slot != NOT_FOUND) {
+		unsigned int num = m_firstMsgNum + CountBefore(slot);
+		Remove(num);
+		return num;
+	} else if(m_size > 0 && uid < m_uids[GetSlot(0)] && m_firstMsgNum > 1) {
+		// Older than anything in the map; just shift the message numbers
+		Remove(m_firstMsgNum - 1);
+	}
+
+	return 0;
+}
+
+unsigned int UIDMap::RemoveUIDs(const UIDRangeSet& uids, vector<UID>& removedUIDs)
+{
+	if(uids.empty()) {
+		return 0;
+	}
+
+	Compact();
+
+	// Messages older than anything in the map shift the whole map down
+	unsigned int numOlder = 0;
+	if(!m_uids.empty() && m_uids.front() > 1 && m_firstMsgNum > 1) {
+		UIDRangeSet older;
+		older.AddRange(1, m_uids.front() - 1);
+		numOlder = std::min((unsigned int) older.Intersection(uids).size(), m_firstMsgNum - 1);
+	}
+
+	unsigned int numRemoved = 0;
+	for(size_t slot = 0; slot < m_uids.size(); slot++) {
+		if(m_uids[slot] != 0 && uids.Contains(m_uids[slot])) {
+			removedUIDs.push_back(m_uids[slot]);
+			RemoveSlot(slot);
+			numRemoved++;
+		}
+	}
+
+	Compact();
+
+	m_firstMsgNum -= numOlder;
+	m_msgCount -= std::min(m_msgCount, numRemoved + numOlder);
+
+	return numRemoved + numOlder;
+}
+
+void UIDMap::ShrinkToSize(unsigned int maxSize)
+{
+	if(m_size <= maxSize) {
+		return;
+	}
+
+	Compact();
+
+	unsigned int numDropped = m_size - maxSize;
+	m_uids.erase(m_uids.begin(), m_uids.begin() + numDropped);
+	m_present.assign(m_uids.size(), true);
+	m_size = m_uids.size();
+	RebuildTree();
+
+	m_firstMsgNum += numDropped;
+}
@@ -0,0 +1,313 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "sync/UIDRangeSet.h"
+#include <algorithm>
+#include <sstream>
+
+using namespace std;
+
+// Orders ranges that end before a UID, not counting a range that ends right before it
+struct RangeEndsBefore
+{
+	bool operator()(const UIDRangeSet::Range& range, UID uid) const
+	{
+		return range.last < uid && uid - range.last > 1;
+	}
+};
+
+// Orders ranges that end before a UID
+struct RangeBefore
+{
+	bool operator()(const UIDRangeSet::Range& range, UID uid) const
+	{
+		return range.last < uid;
+	}
+};
+
+UIDRangeSet::UIDRangeSet()
+{
+}
+
+UIDRangeSet::UIDRangeSet(const vector<UID>& uids)
+{
+	for(vector<UID>::const_iterator it = uids.begin(); it != uids.end(); ++it) {
+		Add(*it);
+	}
+}
+
+UIDRangeSet::~UIDRangeSet()
+{
+}
+
+void UIDRangeSet::Add(UID uid)
+{
+	AddRange(uid, uid);
+}
+
+void UIDRangeSet::AppendRange(UID first, UID last)
+{
+	if(!m_ranges.empty() && (first <= m_ranges.back().last || first - m_ranges.back().last == 1)) {
+		m_ranges.back().last = std::max(m_ranges.back().last, last);
+	} else {
+		m_ranges.push_back(Range(first, last));
+	}
+}
+
+void UIDRangeSet::AddRange(UID first, UID last)
+{
+	if(first > last) {
+		std::swap(first, last);
+	}
+
+	// Fast path for adding in ascending order
+	if(m_ranges.empty() || first > m_ranges.back().last) {
+		AppendRange(first, last);
+		return;
+	}
+
+	// Find the first range that overlaps or touches the new range
+	RangeList::iterator start = lower_bound(m_ranges.begin(), m_ranges.end(), first, RangeEndsBefore());
+
+	// Find the end of the ranges that overlap or touch it
+	RangeList::iterator end = start;
+	while(end != m_ranges.end() && (end->first <= last || end->first - last == 1)) {
+		first = std::min(first, end->first);
+		last = std::max(last, end->last);
+		++end;
+	}
+
+	if(start == end) {
+		m_ranges.insert(start, Range(first, last));
+	} else {
+		*start = Range(first, last);
+		m_ranges.erase(start + 1, end);
+	}
+}
+
+void UIDRangeSet::Remove(UID uid)
+{
+	RangeList::iterator it = lower_bound(m_ranges.begin(), m_ranges.end(), uid, RangeBefore());
+
+	if(it == m_ranges.end() || it->first > uid) {
+		return; // not in set
+	}
+
+	if(it->first == it->last) {
+		m_ranges.erase(it);
+	} else if(it->first == uid) {
+		it->first++;
+	} else if(it->last == uid) {
+		it->last--;
+	} else {
+		// Split the range
+		Range upper(uid + 1, it->last);
+		it->last = uid - 1;
+		m_ranges.insert(it + 1, upper);
+	}
+}
+
+bool UIDRangeSet::Contains(UID uid) const
+{
+	RangeList::const_iterator it = lower_bound(m_ranges.begin(), m_ranges.end(), uid, RangeBefore());
+
+	return it != m_ranges.end() && it->first <= uid;
+}
+
+size_t UIDRangeSet::size() const
+{
+	size_t count = 0;
+
+	for(RangeList::const_iterator it = m_ranges.begin(); it != m_ranges.end(); ++it) {
+		count += (it->last - it->first) + 1;
+	}
+
+	return count;
+}
+
+void UIDRangeSet::GetUIDs(vector<UID>& uids) const
+{
+	uids.reserve(uids.size() + size());
+
+	for(RangeList::const_iterator it = m_ranges.begin(); it != m_ranges.end(); ++it) {
+		for(UID uid = it->first; ; ++uid) {
+			uids.push_back(uid);
+
+			if(uid == it->last)
+				break;
+		}
+	}
+}
+
+UIDRangeSet UIDRangeSet::Union(const UIDRangeSet& other) const
+{
+	UIDRangeSet result;
+
+	RangeList::const_iterator a = m_ranges.begin();
+	RangeList::const_iterator b = other.m_ranges.begin();
+
+	// Merge the two lists in order of the start of each range
+	while(a != m_ranges.end() || b != other.m_ranges.end()) {
+		if(b == other.m_ranges.end() || (a != m_ranges.end() && a->first <= b->first)) {
+			result.AppendRange(a->first, a->last);
+			++a;
+		} else {
+			result.AppendRange(b->first, b->last);
+			++b;
+		}
+	}
+
+	return result;
+}
+
+UIDRangeSet UIDRangeSet::Intersection(const UIDRangeSet& other) const
+{
+	UIDRangeSet result;
+
+	RangeList::const_iterator a = m_ranges.begin();
+	RangeList::const_iterator b = other.m_ranges.begin();
+
+	while(a != m_ranges.end() && b != other.m_ranges.end()) {
+		UID first = std::max(a->first, b->first);
+		UID last = std::min(a->last, b->last);
+
+		if(first <= last) {
+			result.m_ranges.push_back(Range(first, last));
+		}
+
+		// Advance whichever range ends first
+		if(a->last < b->last) {
+			++a;
+		} else {
+			++b;
+		}
+	}
+
+	return result;
+}
+
+UIDRangeSet UIDRangeSet::Difference(const UIDRangeSet& other) const
+{
+	UIDRangeSet result;
+
+	RangeList::const_iterator b = other.m_ranges.begin();
+
+	for(RangeList::const_iterator a = m_ranges.begin(); a != m_ranges.end(); ++a) {
+		UID first = a->first;
+		bool remaining = true;
+
+		// Skip ranges that end before this one starts
+		while(b != other.m_ranges.end() && b->last < first) {
+			++b;
+		}
+
+		// Cut out each range that overlaps
+		RangeList::const_iterator it = b;
+		while(it != other.m_ranges.end() && it->first <= a->last) {
+			if(it->first > first) {
+				result.m_ranges.push_back(Range(first, it->first - 1));
+			}
+
+			if(it->last >= a->last) {
+				remaining = false;
+				break;
+			}
+
+			first = it->last + 1;
+			++it;
+		}
+
+		if(remaining) {
+			result.m_ranges.push_back(Range(first, a->last));
+		}
+	}
+
+	return result;
+}
+
+string UIDRangeSet::ToString() const
+{
+	stringstream ss;
+
+	for(RangeList::const_iterator it = m_ranges.begin(); it != m_ranges.end(); ++it) {
+		if(it != m_ranges.begin()) {
+			ss << ",";
+		}
+
+		ss << it->first;
+
+		if(it->last != it->first) {
+			ss << ":" << it->last;
+		}
+	}
+
+	return ss.str();
+}
+
+// Parses a non-zero 32-bit number, advancing pos
+static bool ParseUID(const string& str, size_t& pos, UID& uid)
+{
+	MojUInt64 value = 0;
+	size_t start = pos;
+
+	while(pos < str.length() && str[pos] >= '0' && str[pos] <= '9') {
+		value = value * 10 + (str[pos] - '0');
+
+		if(value > MojUInt32Max) {
+			return false;
+		}
+
+		++pos;
+	}
+
+	uid = (UID) value;
+	return pos > start && uid > 0;
+}
+
+bool UIDRangeSet::Parse(const string& str, UIDRangeSet& set)
+{
+	size_t pos = 0;
+
+	while(true) {
+		UID first, last;
+
+		if(!ParseUID(str, pos, first)) {
+			return false;
+		}
+
+		last = first;
+
+		if(pos < str.length() && str[pos] == ':') {
+			++pos;
+
+			if(!ParseUID(str, pos, last)) {
+				return false;
+			}
+		}
+
+		set.AddRange(first, last);
+
+		if(pos == str.length()) {
+			return true;
+		} else if(str[pos] == ',') {
+			++pos;
+		} else {
+			return false;
+		}
+	}
+}
@@ -0,0 +1,275 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "client/ImapConnectionPool.h"
+#include "client/MockImapSession.h"
+#include "client/MockImapClient.h"
+#include "network/SocketConnection.h"
+#include "ImapConfig.h"
+#include "MockTestSetup.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+
+// Socket that never touches the network; Shutdown just reports it as closed
+class MockSocketConnection : public SocketConnection
+{
+public:
+	MockSocketConnection(const string& bindAddress = "")
+	: SocketConnection(NULL, false)
+	{
+		m_bindAddress = bindAddress;
+	}
+
+	void Shutdown()
+	{
+		if(!AsyncIOChannel::m_closed) {
+			AsyncIOChannel::m_closed = true;
+			m_closedSignal.fire();
+		}
+	}
+};
+
+// Records the pool's callbacks. If passThrough is set, they're handled by ImapSession as usual.
+class PoolTestSession : public MockImapSession
+{
+public:
+	PoolTestSession(const MojRefCountedPtr<MockImapClient>& client, bool passThrough = false)
+	: MockImapSession(client), m_passThrough(passThrough), m_slotsGranted(0) {}
+
+	void ConnectionSlotAvailable()
+	{
+		m_slotsGranted++;
+
+		if(m_passThrough)
+			MockImapSession::ConnectionSlotAvailable();
+	}
+
+	void PooledConnectionAvailable(const ImapConnectionState& state)
+	{
+		m_pooledConnection = state.connection;
+
+		if(m_passThrough)
+			MockImapSession::PooledConnectionAvailable(state);
+	}
+
+	bool								m_passThrough;
+	int									m_slotsGranted;
+	MojRefCountedPtr<SocketConnection>	m_pooledConnection;
+};
+
+// Sets the pool config for a test and restores it afterwards
+class PoolConfig
+{
+public:
+	PoolConfig(int maxConnections, int pooledConnectionTimeout = 60)
+	: m_maxConnections(ImapConfig::GetConfig().GetMaxConnections()),
+	  m_pooledConnectionTimeout(ImapConfig::GetConfig().GetPooledConnectionTimeout())
+	{
+		ImapConfig::GetConfig().SetMaxConnections(maxConnections);
+		ImapConfig::GetConfig().SetPooledConnectionTimeout(pooledConnectionTimeout);
+	}
+
+	~PoolConfig()
+	{
+		ImapConfig::GetConfig().SetMaxConnections(m_maxConnections);
+		ImapConfig::GetConfig().SetPooledConnectionTimeout(m_pooledConnectionTimeout);
+	}
+
+protected:
+	int		m_maxConnections;
+	int		m_pooledConnectionTimeout;
+};
+
+static ImapConnectionPool::Result Request(ImapConnectionPool& pool, PoolTestSession* session, const string& bindAddress, ImapConnectionState& state)
+{
+	return pool.RequestConnection(MojRefCountedPtr<ImapSession>(session), bindAddress, state);
+}
+
+static ImapConnectionState CreateState(const MojRefCountedPtr<SocketConnection>& connection)
+{
+	ImapConnectionState state;
+	state.connection = connection;
+	return state;
+}
+
+static MojInt64 GetStatus(const ImapConnectionPool& pool, const char* key)
+{
+	MojObject status;
+	pool.Status(status);
+
+	MojInt64 value = -1;
+	MojErr err = status.getRequired(key, value);
+	ErrorToException(err);
+
+	return value;
+}
+
+TEST(ImapConnectionPoolTest, TestReuse)
+{
+	PoolConfig config(2);
+	MockTestSetup setup;
+	ImapConnectionPool& pool = setup.GetClient().GetConnectionPool();
+
+	MojRefCountedPtr<PoolTestSession> session1(new PoolTestSession(setup.GetClientPtr()));
+	MojRefCountedPtr<PoolTestSession> session2(new PoolTestSession(setup.GetClientPtr()));
+	MojRefCountedPtr<PoolTestSession> session3(new PoolTestSession(setup.GetClientPtr()));
+
+	ImapConnectionState state;
+	ASSERT_EQ( ImapConnectionPool::Result_NewSlot, Request(pool, session1.get(), "", state) );
+
+	MojRefCountedPtr<SocketConnection> connection(new MockSocketConnection());
+	pool.ReturnConnection(CreateState(connection));
+
+	EXPECT_EQ( 1, GetStatus(pool, "open") );
+	EXPECT_EQ( 1, GetStatus(pool, "pooled") );
+
+	// Bound to a different interface; can't use the pooled connection
+	ASSERT_EQ( ImapConnectionPool::Result_NewSlot, Request(pool, session2.get(), "10.0.0.1", state) );
+	EXPECT_EQ( 2, GetStatus(pool, "open") );
+
+	ASSERT_EQ( ImapConnectionPool::Result_Reused, Request(pool, session3.get(), "", state) );
+	EXPECT_TRUE( state.connection.get() == connection.get() );
+	EXPECT_FALSE( connection->IsClosed() );
+
+	EXPECT_EQ( 2, GetStatus(pool, "open") );
+	EXPECT_EQ( 0, GetStatus(pool, "pooled") );
+	EXPECT_EQ( 1, GetStatus(pool, "hits") );
+	EXPECT_EQ( 2, GetStatus(pool, "misses") );
+}
+
+TEST(ImapConnectionPoolTest, TestWaitForSlot)
+{
+	PoolConfig config(1);
+	MockTestSetup setup;
+	ImapConnectionPool& pool = setup.GetClient().GetConnectionPool();
+
+	MojRefCountedPtr<PoolTestSession> session1(new PoolTestSession(setup.GetClientPtr()));
+	MojRefCountedPtr<PoolTestSession> session2(new PoolTestSession(setup.GetClientPtr()));
+
+	ImapConnectionState state;
+	ASSERT_EQ( ImapConnectionPool::Result_NewSlot, Request(pool, session1.get(), "", state) );
+	ASSERT_EQ( ImapConnectionPool::Result_Wait, Request(pool, session2.get(), "", state) );
+
+	EXPECT_EQ( 1, GetStatus(pool, "waiting") );
+	EXPECT_EQ( 0, session2->m_slotsGranted );
+
+	// session1 disconnected
+	pool.ReleaseSlot();
+
+	EXPECT_EQ( 1, session2->m_slotsGranted );
+	EXPECT_EQ( 1, GetStatus(pool, "open") );
+	EXPECT_EQ( 0, GetStatus(pool, "waiting") );
+}
+
+TEST(ImapConnectionPoolTest, TestReturnToWaiter)
+{
+	PoolConfig config(1);
+	MockTestSetup setup;
+	ImapConnectionPool& pool = setup.GetClient().GetConnectionPool();
+
+	MojRefCountedPtr<PoolTestSession> session1(new PoolTestSession(setup.GetClientPtr()));
+	MojRefCountedPtr<PoolTestSession> session2(new PoolTestSession(setup.GetClientPtr()));
+
+	ImapConnectionState state;
+	ASSERT_EQ( ImapConnectionPool::Result_NewSlot, Request(pool, session1.get(), "", state) );
+	ASSERT_EQ( ImapConnectionPool::Result_Wait, Request(pool, session2.get(), "", state) );
+
+	// Handed straight to the waiting session instead of going into the pool
+	MojRefCountedPtr<SocketConnection> connection(new MockSocketConnection());
+	pool.ReturnConnection(CreateState(connection));
+
+	EXPECT_TRUE( session2->m_pooledConnection.get() == connection.get() );
+	EXPECT_EQ( 0, session2->m_slotsGranted );
+
+	EXPECT_EQ( 1, GetStatus(pool, "open") );
+	EXPECT_EQ( 0, GetStatus(pool, "pooled") );
+	EXPECT_EQ( 0, GetStatus(pool, "waiting") );
+	EXPECT_EQ( 1, GetStatus(pool, "hits") );
+}
+
+TEST(ImapConnectionPoolTest, TestWaiterNoLongerConnecting)
+{
+	PoolConfig config(1);
+	MockTestSetup setup;
+	ImapConnectionPool& pool = setup.GetClient().GetConnectionPool();
+
+	// These sessions aren't in State_Connecting, so they give back whatever they get
+	MojRefCountedPtr<PoolTestSession> session1(new PoolTestSession(setup.GetClientPtr()));
+	MojRefCountedPtr<PoolTestSession> session2(new PoolTestSession(setup.GetClientPtr(), true));
+	MojRefCountedPtr<PoolTestSession> session3(new PoolTestSession(setup.GetClientPtr(), true));
+
+	ImapConnectionState state;
+	ASSERT_EQ( ImapConnectionPool::Result_NewSlot, Request(pool, session1.get(), "", state) );
+	ASSERT_EQ( ImapConnectionPool::Result_Wait, Request(pool, session2.get(), "", state) );
+
+	// The slot goes back to the pool
+	pool.ReleaseSlot();
+
+	EXPECT_EQ( 1, session2->m_slotsGranted );
+	EXPECT_EQ( 0, GetStatus(pool, "open") );
+	EXPECT_EQ( 0, GetStatus(pool, "waiting") );
+
+	ASSERT_EQ( ImapConnectionPool::Result_NewSlot, Request(pool, session1.get(), "", state) );
+	ASSERT_EQ( ImapConnectionPool::Result_Wait, Request(pool, session3.get(), "", state) );
+
+	// The connection goes back to the pool, along with its slot
+	MojRefCountedPtr<SocketConnection> connection(new MockSocketConnection());
+	pool.ReturnConnection(CreateState(connection));
+
+	EXPECT_TRUE( session3->m_pooledConnection.get() == connection.get() );
+	EXPECT_FALSE( connection->IsClosed() );
+
+	EXPECT_EQ( 1, GetStatus(pool, "open") );
+	EXPECT_EQ( 1, GetStatus(pool, "pooled") );
+	EXPECT_EQ( 0, GetStatus(pool, "waiting") );
+
+	pool.Clear();
+}
+
+TEST(ImapConnectionPoolTest, TestClearWithWaiters)
+{
+	PoolConfig config(2);
+	MockTestSetup setup;
+	ImapConnectionPool& pool = setup.GetClient().GetConnectionPool();
+
+	MojRefCountedPtr<PoolTestSession> session1(new PoolTestSession(setup.GetClientPtr()));
+	MojRefCountedPtr<PoolTestSession> session2(new PoolTestSession(setup.GetClientPtr()));
+	MojRefCountedPtr<PoolTestSession> session3(new PoolTestSession(setup.GetClientPtr()));
+
+	ImapConnectionState state;
+	ASSERT_EQ( ImapConnectionPool::Result_NewSlot, Request(pool, session1.get(), "", state) );
+	ASSERT_EQ( ImapConnectionPool::Result_NewSlot, Request(pool, session2.get(), "", state) );
+
+	MojRefCountedPtr<SocketConnection> connection(new MockSocketConnection());
+	pool.ReturnConnection(CreateState(connection));
+
+	// Can't use the pooled connection, and all the slots are taken
+	ASSERT_EQ( ImapConnectionPool::Result_Wait, Request(pool, session3.get(), "10.0.0.1", state) );
+
+	// Closing the pooled connection frees up a slot for the waiting session
+	pool.Clear();
+
+	EXPECT_TRUE( connection->IsClosed() );
+	EXPECT_EQ( 1, session3->m_slotsGranted );
+	EXPECT_TRUE( session3->m_pooledConnection.get() == NULL );
+
+	EXPECT_EQ( 2, GetStatus(pool, "open") );
+	EXPECT_EQ( 0, GetStatus(pool, "pooled") );
+	EXPECT_EQ( 0, GetStatus(pool, "waiting") );
+}
@@ -0,0 +1,114 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "client/MockImapSession.h"
+#include "client/MockImapClient.h"
+#include "commands/HandleUpdateCommand.h"
+#include "TestUtils.h"
+#include "MockTestSetup.h"
+#include <gtest/gtest.h>
+
+class UpdateMockDatabase : public MockDatabase
+{
+public:
+	UpdateMockDatabase() : m_numLookups(0) {}
+
+	virtual void GetEmailsByUID(Signal::SlotRef slot, const MojObject& folderId, const std::vector<UID>& uids)
+	{
+		m_numLookups++;
+		m_lastUIDs = uids;
+		Default(__func__, slot);
+	}
+
+	virtual void DeleteEmailIds(Signal::SlotRef slot, const MojObject::ObjectVec& ids)
+	{
+		m_lastDeleted = ids;
+		Default(__func__, slot);
+	}
+
+	virtual void MergeFlags(Signal::SlotRef slot, const MojObject::ObjectVec& array)
+	{
+		m_lastMerged = array;
+		Default(__func__, slot);
+	}
+
+	int						m_numLookups;
+	std::vector<UID>		m_lastUIDs;
+	MojObject::ObjectVec	m_lastDeleted;
+	MojObject::ObjectVec	m_lastMerged;
+};
+
+TEST(HandleUpdateCommandTest, TestBatchedUpdates)
+{
+	MockTestSetup setup;
+	UpdateMockDatabase& db = setup.GetTestDatabase<UpdateMockDatabase>();
+	MockImapSession& session = setup.GetSession();
+
+	boost::shared_ptr<ImapAccount> account(new ImapAccount());
+	setup.GetClient().SetAccount(account);
+
+	MojString folderId;
+	folderId.assign("TEST+FOLDERID");
+
+	HandleUpdateCommand::UpdateMap updates;
+	updates[10].deleted = true;
+	updates[20].newFlags = QUOTE_JSON_OBJ(( {"read": true} ));
+	updates[30].newFlags = QUOTE_JSON_OBJ(( {"read": false} ));
+	updates[40].deleted = true; // not in the database
+
+	MojRefCountedPtr<HandleUpdateCommand> command(new HandleUpdateCommand(session, folderId, updates));
+
+	MojObject response;
+
+	response = QUOTE_JSON_OBJ((
+		{"results":
+		[
+		 {"_id": "id1", "uid": 10},
+		 {"_id": "id2", "uid": 20},
+		 {"_id": "id3", "uid": 30},
+		]}
+	));
+	db.SetResponse("GetEmailsByUID", response);
+
+	response = QUOTE_JSON_OBJ(( {"results":[{"id": "id1", "rev": 100}]} ));
+	db.SetResponse("DeleteEmailIds", response);
+
+	response = QUOTE_JSON_OBJ(( {"results":[{"id": "id2", "rev": 200}, {"id": "id3", "rev": 300}]} ));
+	db.SetResponse("MergeFlags", response);
+
+	command->Run();
+
+	// One lookup, one delete and one merge for all the updates
+	EXPECT_EQ( 1, db.m_numLookups );
+	ASSERT_EQ( (size_t) 4, db.m_lastUIDs.size() );
+	EXPECT_EQ( UID(10), db.m_lastUIDs[0] );
+	EXPECT_EQ( UID(40), db.m_lastUIDs[3] );
+
+	ASSERT_EQ( (MojSize) 1, db.m_lastDeleted.size() );
+	EXPECT_TRUE( db.m_lastDeleted[0] == StringAsMojObject("id1") );
+
+	ASSERT_EQ( (MojSize) 2, db.m_lastMerged.size() );
+
+	MojObject id, flags;
+	ASSERT_TRUE( db.m_lastMerged[0].get("_id", id) );
+	EXPECT_TRUE( id == StringAsMojObject("id2") );
+	ASSERT_TRUE( db.m_lastMerged[0].get("flags", flags) );
+	EXPECT_TRUE( flags == updates[20].newFlags );
+
+	EXPECT_NO_THROW( command->GetResult()->CheckException() );
+}
@@ -0,0 +1,279 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "client/MockImapSession.h"
+#include "client/MockImapClient.h"
+#include "client/FileCacheClient.h"
+#include "commands/PrefetchPartsCommand.h"
+#include "data/DatabaseAdapter.h"
+#include "data/EmailPart.h"
+#include "data/EmailSchema.h"
+#include "data/ImapEmailAdapter.h"
+#include "protocol/MockDoneSlot.h"
+#include "TestUtils.h"
+#include "MockTestSetup.h"
+#include <boost/foreach.hpp>
+#include <glib.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace std;
+
+class PrefetchMockDatabase : public MockDatabase
+{
+public:
+	PrefetchMockDatabase() : m_numUpdates(0) {}
+
+	virtual void GetByIds(Signal::SlotRef slot, const MojObject::ObjectVec& ids)
+	{
+		m_lastIds = ids;
+		Default(__func__, slot);
+	}
+
+	virtual void UpdateEmails(Signal::SlotRef slot, const MojObject::ObjectVec& objects)
+	{
+		m_numUpdates++;
+		m_lastUpdated = objects;
+		Default(__func__, slot);
+	}
+
+	int						m_numUpdates;
+	MojObject::ObjectVec	m_lastIds;
+	MojObject::ObjectVec	m_lastUpdated;
+};
+
+// Hands out file cache entries in a temporary directory once ReplyAll is called
+class MockFileCacheClient : public FileCacheClient
+{
+public:
+	MockFileCacheClient(BusClient& busClient) : FileCacheClient(busClient)
+	{
+		char dirTemplate[] = "/tmp/PrefetchPartsCommandTest.XXXXXX";
+		m_dir = mkdtemp(dirTemplate);
+	}
+
+	virtual ~MockFileCacheClient()
+	{
+		BOOST_FOREACH(const string& path, m_paths) {
+			unlink(path.c_str());
+		}
+
+		rmdir(m_dir.c_str());
+	}
+
+	void InsertCacheObject(ReplySignal::SlotRef slot, const char* typeName, const char* fileName, MojInt64 size, MojInt64 cost, MojInt64 lifetime)
+	{
+		MojRefCountedPtr<PendingInsert> insert(new PendingInsert());
+		insert->m_signal.connect(slot);
+		m_pendingInserts.push_back(insert);
+	}
+
+	void ResizeCacheObject(ReplySignal::SlotRef slot, const char* pathName, MojInt64 newSize)
+	{
+	}
+
+	void ReplyAll()
+	{
+		vector< MojRefCountedPtr<PendingInsert> > inserts;
+		inserts.swap(m_pendingInserts);
+
+		BOOST_FOREACH(const MojRefCountedPtr<PendingInsert>& insert, inserts) {
+			stringstream path;
+			path << m_dir << "/part" << m_paths.size();
+			m_paths.push_back(path.str());
+
+			MojObject response;
+			response.putString("pathName", path.str().c_str());
+			insert->m_signal.fire(response, MojErrNone);
+		}
+	}
+
+	const string& GetPath(size_t i) const { return m_paths.at(i); }
+
+protected:
+	class PendingInsert : public MojSignalHandler
+	{
+	public:
+		PendingInsert() : m_signal(this) {}
+
+		ReplySignal m_signal;
+	};
+
+	string									m_dir;
+	vector<string>							m_paths;
+	vector< MojRefCountedPtr<PendingInsert> >	m_pendingInserts;
+};
+
+static EmailPartPtr CreatePart(EmailPart::PartType type, const char* id, const char* section, const char* mimeType)
+{
+	EmailPartPtr part(new EmailPart(type));
+	part->SetId(StringAsMojObject(id));
+	part->SetSection(section);
+	part->SetMimeType(mimeType);
+	part->SetEncodedSize(100);
+
+	return part;
+}
+
+// Lets the file channels flush and close
+static void RunMainLoop()
+{
+	while(g_main_context_iteration(NULL, FALSE)) {
+	}
+}
+
+static string GetPartPath(const MojObject& emailObj, const char* partId)
+{
+	MojObject partsArray;
+	MojErr err = emailObj.getRequired(EmailSchema::PARTS, partsArray);
+	ErrorToException(err);
+
+	BOOST_FOREACH(const MojObject& partObj, DatabaseAdapter::GetArrayIterators(partsArray)) {
+		if(DatabaseAdapter::GetOptionalString(partObj, DatabaseAdapter::ID) == partId) {
+			return DatabaseAdapter::GetOptionalString(partObj, EmailSchema::Part::PATH);
+		}
+	}
+
+	return "(missing)";
+}
+
+TEST(PrefetchPartsCommandTest, TestPrefetch)
+{
+	MockTestSetup setup;
+	PrefetchMockDatabase& db = setup.GetTestDatabase<PrefetchMockDatabase>();
+	MockImapSession& session = setup.GetSession();
+
+	const MockInputStreamPtr& is = session.GetMockInputStream();
+	const MockOutputStreamPtr& os = session.GetMockOutputStream();
+
+	MockFileCacheClient fileCacheClient(setup.GetClient());
+	session.SetFileCacheClient(fileCacheClient);
+
+	MojRefCountedPtr<PrefetchPartsCommand> command(new PrefetchPartsCommand(session, StringAsMojObject("folder")));
+
+	command->AddEmail(StringAsMojObject("email1"), 10);
+	command->AddPart(CreatePart(EmailPart::BODY, "part1", "1", "text/plain"), true);
+
+	command->AddEmail(StringAsMojObject("email2"), 11);
+	command->AddPart(CreatePart(EmailPart::BODY, "part2", "1", "text/plain"), true);
+
+	command->AddEmail(StringAsMojObject("email3"), 20);
+	command->AddPart(CreatePart(EmailPart::BODY, "part3", "1", "text/plain"), true);
+	command->AddPart(CreatePart(EmailPart::INLINE, "part3b", "2", "image/png"), false);
+
+	ASSERT_EQ( (size_t) 4, command->GetNumParts() );
+
+	// email1 has a second part whose path was written by someone else during the prefetch
+	db.SetResponse("GetByIds", QUOTE_JSON_OBJ((
+		{"results":
+		[
+		 {"_id": "email1", "parts": [{"_id": "part1"}, {"_id": "part1b", "path": "/other/path"}]},
+		 {"_id": "email2", "parts": [{"_id": "part2"}]}
+		]}
+	)));
+	db.SetResponse("UpdateEmails", QUOTE_JSON_OBJ(( {"results":[]} )));
+
+	MockDoneSlot doneSlot;
+	command->Run(doneSlot.GetSlot());
+
+	fileCacheClient.ReplyAll();
+
+	// Emails needing the same sections are fetched together
+	ASSERT_EQ( "~A1 UID FETCH 10:11 (UID BODY.PEEK[1])", os->GetLine() );
+
+	// UID after the body; the literal has to be held until the UID is known
+	is->Feed("* 1 FETCH (UID 10 BODY[1] {5}\r\nhello)\r\n");
+	is->Feed("* 2 FETCH (BODY[1] {5}\r\nworld UID 11)\r\n");
+	is->FeedLine("~A1 OK");
+
+	ASSERT_EQ( "~A2 UID FETCH 20 (UID BODY.PEEK[1] BODY.PEEK[2])", os->GetLine() );
+
+	// Nothing returned for email3
+	is->FeedLine("~A2 NO Some messages could not be FETCHed");
+	is->FlushBuffer();
+
+	RunMainLoop();
+
+	ASSERT_TRUE( doneSlot.Called() );
+
+	// Only the emails that got something back need to be re-read
+	ASSERT_EQ( (MojSize) 2, db.m_lastIds.size() );
+
+	ASSERT_EQ( 1, db.m_numUpdates );
+	ASSERT_EQ( (MojSize) 3, db.m_lastUpdated.size() );
+
+	const MojObject& email1 = db.m_lastUpdated.at(0);
+	EXPECT_EQ( fileCacheClient.GetPath(0), GetPartPath(email1, "part1") );
+	EXPECT_EQ( "/other/path", GetPartPath(email1, "part1b") );
+	EXPECT_EQ( "hello", DatabaseAdapter::GetOptionalString(email1, EmailSchema::SUMMARY) );
+
+	const MojObject& email2 = db.m_lastUpdated.at(1);
+	EXPECT_EQ( fileCacheClient.GetPath(1), GetPartPath(email2, "part2") );
+
+	// Server returned NO and nothing else; don't keep trying to download email3
+	const MojObject& email3 = db.m_lastUpdated.at(2);
+	EXPECT_EQ( "email3", DatabaseAdapter::GetOptionalString(email3, DatabaseAdapter::ID) );
+	EXPECT_FALSE( DatabaseAdapter::GetOptionalBool(email3, ImapEmailAdapter::AUTO_DOWNLOAD, true) );
+	EXPECT_FALSE( email3.contains(EmailSchema::PARTS) );
+}
+
+TEST(PrefetchPartsCommandTest, TestRemovePart)
+{
+	MockTestSetup setup;
+	PrefetchMockDatabase& db = setup.GetTestDatabase<PrefetchMockDatabase>();
+	MockImapSession& session = setup.GetSession();
+
+	const MockInputStreamPtr& is = session.GetMockInputStream();
+	const MockOutputStreamPtr& os = session.GetMockOutputStream();
+
+	MockFileCacheClient fileCacheClient(setup.GetClient());
+	session.SetFileCacheClient(fileCacheClient);
+
+	MojRefCountedPtr<PrefetchPartsCommand> command(new PrefetchPartsCommand(session, StringAsMojObject("folder")));
+
+	command->AddEmail(StringAsMojObject("email1"), 10);
+	command->AddPart(CreatePart(EmailPart::BODY, "part1", "1", "text/plain"), true);
+	command->AddPart(CreatePart(EmailPart::INLINE, "part1b", "2", "image/png"), false);
+
+	EXPECT_FALSE( command->RemovePart(StringAsMojObject("email2"), MojObject()) );
+
+	// A null part id means the body
+	EXPECT_TRUE( command->RemovePart(StringAsMojObject("email1"), MojObject()) );
+	EXPECT_FALSE( command->RemovePart(StringAsMojObject("email1"), StringAsMojObject("part1")) );
+
+	MockDoneSlot doneSlot;
+	command->Run(doneSlot.GetSlot());
+
+	fileCacheClient.ReplyAll();
+
+	ASSERT_EQ( "~A1 UID FETCH 10 (UID BODY.PEEK[2])", os->GetLine() );
+
+	// Removed after it was requested; the response is read but not saved
+	EXPECT_TRUE( command->RemovePart(StringAsMojObject("email1"), StringAsMojObject("part1b")) );
+
+	is->Feed("* 1 FETCH (UID 10 BODY[2] {5}\r\nimage)\r\n");
+	is->FeedLine("~A1 OK");
+	is->FlushBuffer();
+
+	RunMainLoop();
+
+	ASSERT_TRUE( doneSlot.Called() );
+	EXPECT_EQ( 0, db.m_numUpdates );
+}
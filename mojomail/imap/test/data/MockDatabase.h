@@ -38,6 +38,7 @@ public:
 	virtual void GetById(Signal::SlotRef slot, const MojObject& id) { DEFAULT }
 	virtual void GetByIds(Signal::SlotRef slot, const MojObject::ObjectVec& ids) { DEFAULT }
 	virtual void GetEmail(Signal::SlotRef slot, const MojObject& folderId, UID uid) { DEFAULT }
+	virtual void GetEmailsByUID(Signal::SlotRef slot, const MojObject& folderId, const std::vector<UID>& uids) { DEFAULT }
 
 	virtual void CreateFolders(Signal::SlotRef slot, const MojObject::ObjectVec& array) { DEFAULT }
 	virtual void ReserveIds(Signal::SlotRef slot, MojUInt32 num) { DEFAULT }
@@ -0,0 +1,124 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "parser/ParserArena.h"
+#include <boost/make_shared.hpp>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace std;
+
+struct CountedObject
+{
+	CountedObject(int value) : value(value) { s_live++; }
+	CountedObject(const CountedObject& other) : value(other.value) { s_live++; }
+	~CountedObject() { s_live--; }
+
+	int value;
+	static int s_live;
+};
+
+int CountedObject::s_live = 0;
+
+TEST(ParserArenaTest, TestAllocate)
+{
+	ParserArena arena;
+
+	char* a = static_cast<char*>( arena.Allocate(3) );
+	char* b = static_cast<char*>( arena.Allocate(8) );
+
+	// Allocations are aligned and come from the same block
+	EXPECT_EQ( (size_t) 0, ((size_t) b) % sizeof(void*) );
+	EXPECT_TRUE( b > a && b - a < 32 );
+
+	// Large allocations get their own block
+	arena.Allocate(ParserArena::BLOCK_SIZE);
+
+	const ParserArena::Stats& stats = arena.GetStats();
+	EXPECT_EQ( (size_t) 3, stats.numAllocations );
+	EXPECT_EQ( (size_t) 2, stats.numBlocks );
+}
+
+TEST(ParserArenaTest, TestSharedObjects)
+{
+	boost::shared_ptr<CountedObject> survivor;
+	size_t numBlocks = 0;
+
+	{
+		ParserArena arena;
+
+		for(int i = 0; i < 1000; i++) {
+			boost::shared_ptr<CountedObject> obj = boost::allocate_shared<CountedObject>(ArenaAllocator<CountedObject>(arena), i);
+
+			if(i == 500)
+				survivor = obj;
+		}
+
+		numBlocks = arena.GetStats().numBlocks;
+		EXPECT_EQ( (size_t) 1000, arena.GetStats().numAllocations );
+	}
+
+	// Only the object still referenced is alive; the arena memory is kept for it
+	EXPECT_TRUE( numBlocks < 10 );
+	EXPECT_EQ( 1, CountedObject::s_live );
+	EXPECT_EQ( 500, survivor->value );
+
+	survivor.reset();
+	EXPECT_EQ( 0, CountedObject::s_live );
+}
+
+TEST(ParserArenaTest, TestContainer)
+{
+	ParserArena arena;
+
+	vector<string, ArenaAllocator<string> > strings((ArenaAllocator<string>(arena)));
+
+	for(int i = 0; i < 100; i++) {
+		strings.push_back("test");
+	}
+
+	EXPECT_EQ( (size_t) 100, strings.size() );
+	EXPECT_EQ( "test", strings.back() );
+	EXPECT_TRUE( arena.GetStats().numAllocations > 0 );
+}
+
+TEST(ParserArenaTest, TestReset)
+{
+	ParserArena arena;
+
+	char* first = static_cast<char*>( arena.Allocate(16) );
+	arena.Allocate(ParserArena::BLOCK_SIZE);
+	arena.Reset();
+
+	// Nothing is alive, so the small block is reused
+	EXPECT_EQ( (size_t) 0, arena.GetStats().numBlocks );
+	EXPECT_EQ( first, arena.Allocate(16) );
+	EXPECT_EQ( (size_t) 0, arena.GetStats().numBlocks );
+
+	// An object from before the reset keeps its memory
+	boost::shared_ptr<CountedObject> survivor = boost::allocate_shared<CountedObject>(ArenaAllocator<CountedObject>(arena), 42);
+	arena.Reset();
+
+	arena.Allocate(16);
+	EXPECT_EQ( (size_t) 1, arena.GetStats().numBlocks );
+	EXPECT_EQ( 42, survivor->value );
+
+	survivor.reset();
+	EXPECT_EQ( 0, CountedObject::s_live );
+}
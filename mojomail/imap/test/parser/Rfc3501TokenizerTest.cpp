@@ -0,0 +1,139 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "parser/Rfc3501Tokenizer.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+
+TEST(Rfc3501TokenizerTest, TestTokens)
+{
+	Rfc3501Tokenizer t("* 12 FETCH (FLAGS (\\Seen) BODY[HEADER.FIELDS (TO)] NIL)\r\n", true);
+
+	ASSERT_EQ( TK_TEXT, t.next() );
+	EXPECT_EQ( "*", t.value() );
+	ASSERT_EQ( TK_SP, t.next() );
+	ASSERT_EQ( TK_TEXT, t.next() );
+	EXPECT_EQ( "12", t.value() );
+	ASSERT_EQ( TK_SP, t.next() );
+	ASSERT_EQ( TK_TEXT, t.next() );
+	EXPECT_TRUE( t.match("fetch") );
+	EXPECT_FALSE( t.match("FETCHX") );
+	ASSERT_EQ( TK_SP, t.next() );
+	ASSERT_EQ( TK_LPAREN, t.next() );
+	ASSERT_EQ( TK_TEXT, t.next() );
+	EXPECT_EQ( "FLAGS", t.value() );
+	ASSERT_EQ( TK_SP, t.next() );
+	ASSERT_EQ( TK_LPAREN, t.next() );
+	ASSERT_EQ( TK_BACKSLASH, t.next() );
+	ASSERT_EQ( TK_TEXT, t.next() );
+	EXPECT_TRUE( t.equalsIgnoreCase("SEEN", 4) );
+	ASSERT_EQ( TK_RPAREN, t.next() );
+	ASSERT_EQ( TK_SP, t.next() );
+	ASSERT_EQ( TK_TEXT, t.next() );
+	EXPECT_EQ( "BODY", t.value() );
+	ASSERT_EQ( TK_LBRACKET, t.next() );
+	ASSERT_EQ( TK_TEXT, t.next() );
+	EXPECT_EQ( "HEADER.FIELDS", t.value() );
+	ASSERT_EQ( TK_SP, t.next() );
+	ASSERT_EQ( TK_LPAREN, t.next() );
+	ASSERT_EQ( TK_TEXT, t.next() );
+	ASSERT_EQ( TK_RPAREN, t.next() );
+	ASSERT_EQ( TK_RBRACKET, t.next() );
+	ASSERT_EQ( TK_SP, t.next() );
+	ASSERT_EQ( TK_TEXT, t.next() );
+	EXPECT_EQ( "NIL", t.valueUpper() );
+	ASSERT_EQ( TK_RPAREN, t.next() );
+	ASSERT_EQ( TK_CR, t.next() );
+	ASSERT_EQ( TK_LF, t.next() );
+	ASSERT_EQ( TK_ERROR, t.next() );
+}
+
+TEST(Rfc3501TokenizerTest, TestQuotedString)
+{
+	Rfc3501Tokenizer t("\"plain\" \"with \\\"quotes\\\" and \\\\\" \"\"");
+
+	ASSERT_EQ( TK_QUOTED_STRING, t.next() );
+	EXPECT_EQ( "plain", t.value() );
+	EXPECT_EQ( (size_t) 5, t.size() );
+
+	ASSERT_EQ( TK_SP, t.next() );
+	ASSERT_EQ( TK_QUOTED_STRING, t.next() );
+	EXPECT_EQ( "with \"quotes\" and \\", t.value() );
+	EXPECT_TRUE( t.equalsIgnoreCase("WITH \"QUOTES\" AND \\", 19) );
+
+	ASSERT_EQ( TK_SP, t.next() );
+	ASSERT_EQ( TK_QUOTED_STRING, t.next() );
+	EXPECT_EQ( "", t.value() );
+
+	ASSERT_EQ( TK_ERROR, t.next() );
+}
+
+TEST(Rfc3501TokenizerTest, TestUnterminatedString)
+{
+	Rfc3501Tokenizer t("\"The quick brown fox j");
+
+	ASSERT_EQ( TK_QUOTED_STRING_WITHOUT_TERMINATION, t.next() );
+
+	// Rest of the string shows up on the next line
+	t.compact();
+	t.append("\r\numped\"");
+
+	ASSERT_EQ( TK_QUOTED_STRING, t.next() );
+	EXPECT_EQ( "The quick brown fox j\r\numped", t.value() );
+}
+
+TEST(Rfc3501TokenizerTest, TestLiteral)
+{
+	Rfc3501Tokenizer t("{5}\r\nhello {10}\r\nshort");
+
+	ASSERT_EQ( TK_QUOTED_STRING, t.next() );
+	EXPECT_EQ( "hello", t.value() );
+	EXPECT_FALSE( t.needsLiteralBytes() );
+
+	ASSERT_EQ( TK_SP, t.next() );
+	ASSERT_EQ( TK_ERROR, t.next() );
+	EXPECT_TRUE( t.needsLiteralBytes() );
+	EXPECT_EQ( 10, t.getBytesNeeded() );
+}
+
+TEST(Rfc3501TokenizerTest, TestNumberValue)
+{
+	long number = 0;
+	MojUInt32 uid = 0;
+
+	Rfc3501Tokenizer t("4294967295 4294967296 -12 abc");
+
+	t.next();
+	EXPECT_TRUE( t.numberValue(uid) );
+	EXPECT_EQ( 4294967295U, uid );
+
+	t.next();
+	t.next();
+	EXPECT_FALSE( t.numberValue(uid) );
+
+	t.next();
+	t.next();
+	EXPECT_TRUE( t.numberValue(number) );
+	EXPECT_EQ( -12, number );
+	EXPECT_FALSE( t.numberValue(uid) );
+
+	t.next();
+	t.next();
+	EXPECT_FALSE( t.numberValue(number) );
+}
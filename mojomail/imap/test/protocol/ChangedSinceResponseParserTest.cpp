@@ -0,0 +1,57 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include <gtest/gtest.h>
+#include "protocol/ChangedSinceResponseParser.h"
+#include "protocol/MockDoneSlot.h"
+#include "test/MockTestSetup.h"
+
+TEST(ChangedSinceResponseParserTest, TestChanges)
+{
+	MockTestSetup setup;
+	MockImapSession& session = setup.GetSession();
+
+	MockDoneSlot doneSlot;
+	SyncEngine::ChangeList changes;
+	UIDRangeSet vanished;
+
+	MojRefCountedPtr<ChangedSinceResponseParser> parser(new ChangedSinceResponseParser(session, doneSlot.GetSlot(), changes, vanished));
+
+	EXPECT_TRUE( parser->HandleUntaggedResponse("VANISHED (EARLIER) 300:302,310") );
+	EXPECT_TRUE( parser->HandleUntaggedResponse("12 FETCH (UID 100 FLAGS (\\Seen \\Answered $Forwarded) MODSEQ (65402))") );
+	EXPECT_TRUE( parser->HandleUntaggedResponse("13 FETCH (FLAGS (\\Flagged \\Deleted) UID 101 MODSEQ (65403))") );
+	EXPECT_FALSE( parser->HandleUntaggedResponse("14 EXPUNGE") );
+
+	// Live expunge; handled by the UntaggedUpdateParser
+	EXPECT_FALSE( parser->HandleUntaggedResponse("VANISHED 320") );
+
+	EXPECT_EQ( "300:302,310", vanished.ToString() );
+	EXPECT_EQ( (MojUInt64) 65403, parser->GetHighestModSeq() );
+
+	ASSERT_EQ( (size_t) 2, changes.size() );
+	EXPECT_EQ( UID(100), changes[0].uid );
+	EXPECT_TRUE( changes[0].flags.read );
+	EXPECT_TRUE( changes[0].flags.replied );
+	EXPECT_FALSE( changes[0].flags.flagged );
+	EXPECT_FALSE( changes[0].deleted );
+
+	EXPECT_EQ( UID(101), changes[1].uid );
+	EXPECT_FALSE( changes[1].flags.read );
+	EXPECT_TRUE( changes[1].flags.flagged );
+	EXPECT_TRUE( changes[1].deleted );
+}
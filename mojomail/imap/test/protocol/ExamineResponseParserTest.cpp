@@ -62,3 +62,18 @@ TEST(ExamineResponseParserTest, TestUIDValidityOverflow)
 
 	EXPECT_EQ( 100u, parser->GetUIDValidity() );
 }
+
+TEST(ExamineResponseParserTest, TestHighestModSeq)
+{
+	MockTestSetup setup;
+	MockImapSession& session = setup.GetSession();
+
+	MockDoneSlot doneSlot;
+	MojRefCountedPtr<ExamineResponseParser> parser(new ExamineResponseParser(session, doneSlot.GetSlot()));
+
+	parser->HandleUntaggedResponse("ENABLED QRESYNC");
+	parser->HandleUntaggedResponse("OK [HIGHESTMODSEQ 715194045007] Highest");
+
+	EXPECT_TRUE( parser->IsQResyncEnabled() );
+	EXPECT_EQ( 715194045007ull, parser->GetHighestModSeq() );
+}
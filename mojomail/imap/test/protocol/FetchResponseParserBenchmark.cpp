@@ -0,0 +1,127 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+/**
+ * Throughput of the FETCH response parser on ENVELOPE/BODYSTRUCTURE responses
+ * taken from FetchResponseParserTest.
+ *
+ * Prints MB/s for the tokenizer alone and for the full parser.
+ */
+
+#include "protocol/FetchResponseParser.h"
+#include "parser/Rfc3501Tokenizer.h"
+#include "client/MockImapSession.h"
+#include "protocol/MockDoneSlot.h"
+#include "MockTestSetup.h"
+#include "ImapPrivate.h"
+#include "BenchmarkUtils.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace std;
+
+// FETCH responses without the "* <num> FETCH " prefix
+static const char* const s_transcripts[] = {
+	"(FLAGS (\\Seen) INTERNALDATE \"16-Apr-2010 10:32:38 -0400\" RFC822.SIZE 8382 ENVELOPE (\"Fri, 16 Apr 2010 10:32:37 -0400\" \"Subject\" ((\"From Person\" NIL \"from\" \"example.com\")) ((\"Sender Person\" NIL \"sender\" \"example.com\")) ((\"ReplyTo Person\" NIL \"replyto\" \"example.com\")) ((\"To Person\" NIL \"to\" \"example.com\")) NIL NIL NIL \"<messageid>\"))",
+
+	"(UID 1024 BODYSTRUCTURE ((\"TEXT\" \"PLAIN\" (\"CHARSET\" \"iso-8859-1\") NIL NIL \"QUOTED-PRINTABLE\" 2518 94 NIL NIL NIL)(\"TEXT\" \"HTML\" (\"CHARSET\" \"iso-8859-1\") NIL NIL \"QUOTED-PRINTABLE\" 8504 162 NIL NIL NIL) \"ALTERNATIVE\" (\"BOUNDARY\" \"======1272494251854======\") NIL NIL))",
+
+	"(UID 1024 ENVELOPE (NIL \"Test rfc822\" ((NIL NIL \"username\" \"gmail.com\")) ((NIL NIL \"username\" \"gmail.com\")) ((NIL NIL \"username\" \"gmail.com\")) ((NIL NIL \"username\" \"gmail.com\")) NIL NIL NIL NIL) BODYSTRUCTURE ((\"TEXT\" \"HTML\" NIL NIL NIL \"7BIT\" 13 1 NIL NIL NIL NIL)(\"MESSAGE\" \"RFC822\" NIL NIL NIL \"7BIT\" 227 (NIL \"Test attached email\" ((NIL NIL \"username\" \"palm.com\")) ((NIL NIL \"username\" \"palm.com\")) ((NIL NIL \"username\" \"palm.com\")) ((NIL NIL \"username\" \"palm.com\")) NIL NIL NIL NIL) ((\"TEXT\" \"HTML\" NIL NIL NIL \"7BIT\" 22 1 NIL NIL NIL NIL) \"ALTERNATIVE\" (\"BOUNDARY\" \"INNER\") NIL NIL NIL) 12 NIL (\"attachment\" (\"FILENAME\" \"test.eml\")) NIL NIL) \"MIXED\" (\"BOUNDARY\" \"BOUNDARY\") NIL NIL NIL))",
+
+	"(BODYSTRUCTURE ((\"text\" \"plain\" (\"charset\" \"iso-8859-1\") NIL NIL \"7bit\" 870 31 NIL NIL NIL \"attachment.htm\" )(\"text\" \"html\" (\"charset\" \"us-ascii\") NIL NIL \"7bit\" 2285 6 NIL NIL NIL \"attachment.htm\" ) \"alternative\" (\"boundary\" \"----BOUNDARY\") NIL ) ENVELOPE (\"Sat, 01 Aug 2010 01:01:01 -0700\" \"Subject\" ((\"DisplayName\" NIL \"Name\" \"Domain\")) ((\"DisplayName\" NIL \"Name\" \"Domain\")) ((\"DisplayName\" NIL \"Name\" \"Domain\")) ((\"DisplayName\" NIL \"Name\" \"Domain\")) NIL NIL NIL \"<messageid>\") FLAGS (\\Seen) INTERNALDATE \"01-Sat-2010 01:01:01 +0000\" UID 12345)"
+};
+
+static const size_t NUM_TRANSCRIPTS = sizeof(s_transcripts) / sizeof(s_transcripts[0]);
+
+static void BuildResponses(int count, vector<string>& lines, size_t& totalBytes)
+{
+	totalBytes = 0;
+
+	for(int i = 0; i < count; ++i) {
+		stringstream ss;
+		ss << "* " << (i + 1) << " FETCH " << s_transcripts[i % NUM_TRANSCRIPTS];
+
+		lines.push_back(ss.str());
+		totalBytes += lines.back().size() + 2;
+	}
+}
+
+TEST(FetchResponseParserBenchmark, DISABLED_Tokenize)
+{
+	const int count = 20000;
+
+	vector<string> lines;
+	size_t totalBytes;
+	BuildResponses(count, lines, totalBytes);
+
+	size_t numTokens = 0;
+
+	double start = GetTimeSeconds();
+
+	Rfc3501Tokenizer t("", true);
+	for(vector<string>::const_iterator it = lines.begin(); it != lines.end(); ++it) {
+		t.reset(*it);
+		t.append("\r\n");
+
+		while(t.next() != TK_ERROR) {
+			numTokens++;
+		}
+	}
+
+	double done = GetTimeSeconds();
+
+	EXPECT_TRUE( numTokens > (size_t) count );
+	PrintThroughput("tokenizer", totalBytes, done - start);
+	PrintRate("tokenizer", count, "response", done - start);
+}
+
+TEST(FetchResponseParserBenchmark, DISABLED_Parse)
+{
+	const int count = 5000;
+
+	vector<string> lines;
+	size_t totalBytes;
+	BuildResponses(count, lines, totalBytes);
+
+	MockTestSetup setup;
+	MockImapSession& session = setup.GetSession();
+
+	const MockInputStreamPtr& is = session.GetMockInputStream();
+
+	MockDoneSlot slot;
+	MojRefCountedPtr<FetchResponseParser> parser(new FetchResponseParser(session, slot.GetSlot()));
+
+	session.SendRequest("UID FETCH 1:* (UID FLAGS INTERNALDATE RFC822.SIZE ENVELOPE BODYSTRUCTURE)", parser);
+
+	double start = GetTimeSeconds();
+
+	for(vector<string>::const_iterator it = lines.begin(); it != lines.end(); ++it) {
+		is->FeedLine(*it);
+	}
+
+	is->FeedLine("~A1 OK");
+	is->FlushBuffer();
+
+	double done = GetTimeSeconds();
+
+	parser->CheckStatus();
+	EXPECT_EQ( (size_t) count, parser->GetUpdates().size() );
+
+	PrintThroughput("parser", totalBytes, done - start);
+	PrintRate("parser", count, "response", done - start);
+}
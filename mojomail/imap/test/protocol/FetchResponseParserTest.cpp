@@ -29,7 +29,10 @@
 #include "data/EmailPart.h"
 #include <fstream>
 #include "data/ImapEmailAdapter.h"
+#include "parser/SemanticActions.h"
+#include "stream/ByteBufferOutputStream.h"
 #include "ImapPrivate.h"
+#include <map>
 #include <gtest/gtest.h>
 
 using namespace std;
@@ -593,3 +596,137 @@ TEST(FetchResponseParserTest, TestNoAlternatives)
 	is->FlushBuffer();
 #endif
 }
+
+// Collects each part into a separate buffer, keyed by "uid:section"
+class MockPartOutputStreamFactory : public PartOutputStreamFactory
+{
+public:
+	OutputStreamPtr GetPartOutputStream(UID uid, const std::string& section)
+	{
+		stringstream key;
+		key << uid << ":" << section;
+
+		MojRefCountedPtr<ByteBufferOutputStream> os(new ByteBufferOutputStream());
+		m_streams[key.str()] = os;
+		return os;
+	}
+
+	string GetPart(const string& key)
+	{
+		if(m_streams.find(key) == m_streams.end()) {
+			return "(missing)";
+		}
+
+		return m_streams[key]->GetBuffer();
+	}
+
+	size_t GetNumParts() const { return m_streams.size(); }
+
+protected:
+	map< string, MojRefCountedPtr<ByteBufferOutputStream> > m_streams;
+};
+
+TEST(FetchResponseParserTest, TestMultiplePartStreams)
+{
+#if TEST_ALL
+	MockTestSetup setup;
+	MockImapSession& session = setup.GetSession();
+
+	const MockInputStreamPtr& is = session.GetMockInputStream();
+
+	MockPartOutputStreamFactory factory;
+
+	MockDoneSlot slot;
+	MojRefCountedPtr<FetchResponseParser> parser(new FetchResponseParser(session, slot.GetSlot()));
+	parser->SetPartOutputStreamFactory(&factory);
+
+	session.SendRequest("UID FETCH 100,200,300 (UID BODY.PEEK[1] BODY.PEEK[2.1])", parser);
+
+	stringstream data;
+	data << "* 1 FETCH (UID 100 BODY[1] {5}\r\nhello BODY[2.1] {6}\r\nworld!)\r\n";
+	// UID after the body; the part has to be held until the UID is known
+	data << "* 2 FETCH (BODY[1] {7}\r\nsection BODY[2.1] \"quoted\" UID 200)\r\n";
+	data << "* 3 FETCH (UID 300 BODY[1] NIL BODY[2.1] {0}\r\n)\r\n";
+
+	is->Feed(data.str());
+
+	is->FeedLine("~A1 OK");
+	is->FlushBuffer();
+
+	parser->CheckStatus();
+	ASSERT_EQ( (size_t) 3, parser->GetUpdates().size() );
+
+	ASSERT_EQ( (size_t) 6, factory.GetNumParts() );
+	ASSERT_EQ( "hello", factory.GetPart("100:1") );
+	ASSERT_EQ( "world!", factory.GetPart("100:2.1") );
+	ASSERT_EQ( "section", factory.GetPart("200:1") );
+	ASSERT_EQ( "quoted", factory.GetPart("200:2.1") );
+	ASSERT_EQ( "", factory.GetPart("300:1") );
+	ASSERT_EQ( "", factory.GetPart("300:2.1") );
+#endif
+}
+
+TEST(FetchResponseParserTest, TestFlagsModSeq)
+{
+#if TEST_ALL
+	MockTestSetup setup;
+	MockImapSession& session = setup.GetSession();
+
+	const MockInputStreamPtr& is = session.GetMockInputStream();
+
+	MockDoneSlot slot;
+	MojRefCountedPtr<FetchResponseParser> parser(new FetchResponseParser(session, slot.GetSlot()));
+
+	session.SendRequest("FETCH 5 (FLAGS)", parser);
+
+	is->FeedLine("* 5 FETCH (FLAGS (\\Seen) MODSEQ (1234))");
+	is->FeedLine("~A1 OK");
+	is->FlushBuffer();
+
+	parser->CheckStatus();
+	ASSERT_FALSE( session.IsSafeMode() );
+
+	const vector<FetchUpdate>& updates = parser->GetUpdates();
+	ASSERT_EQ( (size_t) 1, updates.size() );
+	ASSERT_EQ( 5U, updates.at(0).msgNum );
+	ASSERT_TRUE( updates.at(0).flagsUpdated );
+	ASSERT_EQ( (MojUInt64) 1234, updates.at(0).modSeq );
+	ASSERT_TRUE( updates.at(0).email->IsRead() );
+#endif
+}
+
+TEST(FetchResponseParserTest, TestUidFlagsModSeq)
+{
+#if TEST_ALL
+	MockTestSetup setup;
+	MockImapSession& session = setup.GetSession();
+
+	const MockInputStreamPtr& is = session.GetMockInputStream();
+
+	MockDoneSlot slot;
+	MojRefCountedPtr<FetchResponseParser> parser(new FetchResponseParser(session, slot.GetSlot()));
+
+	session.SendRequest("UID FETCH 1:* (FLAGS) (CHANGEDSINCE 12345678900)", parser);
+
+	// MODSEQ values can exceed 32 bits
+	is->FeedLine("* 1 FETCH (UID 7 FLAGS () MODSEQ (12345678901))");
+	is->FeedLine("* 2 FETCH (UID 9 MODSEQ (12345678902) FLAGS (\\Flagged))");
+	is->FeedLine("~A1 OK");
+	is->FlushBuffer();
+
+	parser->CheckStatus();
+	ASSERT_FALSE( session.IsSafeMode() );
+
+	const vector<FetchUpdate>& updates = parser->GetUpdates();
+	ASSERT_EQ( (size_t) 2, updates.size() );
+
+	ASSERT_EQ( (UID) 7, updates.at(0).email->GetUID() );
+	ASSERT_TRUE( updates.at(0).flagsUpdated );
+	ASSERT_EQ( (MojUInt64) 12345678901ULL, updates.at(0).modSeq );
+	ASSERT_FALSE( updates.at(0).email->IsRead() );
+
+	ASSERT_EQ( (UID) 9, updates.at(1).email->GetUID() );
+	ASSERT_EQ( (MojUInt64) 12345678902ULL, updates.at(1).modSeq );
+	ASSERT_TRUE( updates.at(1).email->IsFlagged() );
+#endif
+}
@@ -17,6 +17,10 @@
 // LICENSE@@@
 
 #include "protocol/UidSearchResponseParser.h"
+#include "client/Capabilities.h"
+#include "client/ImapRequestManager.h"
+#include "protocol/MockDoneSlot.h"
+#include "MockTestSetup.h"
 #include <gtest/gtest.h>
 
 #include <sstream>
@@ -55,3 +59,166 @@ TEST(UidSearchResponseParserTest, TestStress)
 		EXPECT_EQ( i, uids.at(i-1) );
 	}
 }
+
+TEST(UidSearchResponseParserTest, TestPipelinedSearches)
+{
+	MockTestSetup setup;
+	MockImapSession& session = setup.GetSession();
+
+	MockDoneSlot doneSlot;
+	std::vector<UID> allUIDs, unseenUIDs;
+
+	MojRefCountedPtr<UidSearchResponseParser> allParser(new UidSearchResponseParser(session, allUIDs));
+	MojRefCountedPtr<UidSearchResponseParser> unseenParser(new UidSearchResponseParser(session, doneSlot.GetSlot(), unseenUIDs));
+	MojRefCountedPtr<ImapRequestManager> requestManager(new ImapRequestManager(session));
+
+	const MockInputStreamPtr& is = session.GetMockInputStream();
+
+	// Send both searches before the server responds
+	requestManager->SendRequest("UID SEARCH ALL", allParser, 0, true);
+	requestManager->SendRequest("UID SEARCH UNSEEN", unseenParser, 0, true);
+
+	is->FeedLine("* SEARCH 1 2 3");
+	is->FeedLine("~A1 OK SEARCH completed");
+	EXPECT_FALSE( doneSlot.Called() );
+
+	is->FeedLine("* SEARCH 2");
+	is->FeedLine("~A2 OK SEARCH completed");
+	EXPECT_TRUE( doneSlot.Called() );
+
+	ASSERT_EQ( (size_t) 3, allUIDs.size() );
+	ASSERT_EQ( (size_t) 1, unseenUIDs.size() );
+	EXPECT_EQ( UID(2), unseenUIDs[0] );
+
+	EXPECT_TRUE( allParser->GetStatus() == OK );
+	EXPECT_TRUE( unseenParser->GetStatus() == OK );
+}
+
+TEST(UidSearchResponseParserTest, TestParseEsearch)
+{
+	std::vector<UID> uids;
+	int count = -1;
+
+	EXPECT_TRUE( UidSearchResponseParser::ParseEsearch("(TAG \"~A1\") UID COUNT 6 ALL 4:6,10,20:21", uids, count) );
+	EXPECT_EQ( 6, count );
+	ASSERT_EQ( (size_t) 6, uids.size() );
+	EXPECT_EQ( UID(4), uids[0] );
+	EXPECT_EQ( UID(21), uids[5] );
+
+	// No matches
+	uids.clear();
+	count = -1;
+	EXPECT_TRUE( UidSearchResponseParser::ParseEsearch("(TAG \"~A3\") UID", uids, count) );
+	EXPECT_TRUE( uids.empty() );
+	EXPECT_EQ( -1, count );
+
+	// Count only
+	EXPECT_TRUE( UidSearchResponseParser::ParseEsearch("(TAG \"~A4\") UID COUNT 0", uids, count) );
+	EXPECT_TRUE( uids.empty() );
+	EXPECT_EQ( 0, count );
+
+	// Unknown result data is skipped
+	EXPECT_TRUE( UidSearchResponseParser::ParseEsearch("UID MIN 7 XFOO (1 2) ALL 3800", uids, count) );
+	ASSERT_EQ( (size_t) 1, uids.size() );
+	EXPECT_EQ( UID(3800), uids[0] );
+
+	// Invalid
+	EXPECT_FALSE( UidSearchResponseParser::ParseEsearch("UID COUNT", uids, count) );
+	EXPECT_FALSE( UidSearchResponseParser::ParseEsearch("UID COUNT -1", uids, count) );
+	EXPECT_FALSE( UidSearchResponseParser::ParseEsearch("UID ALL 1:*", uids, count) );
+}
+
+TEST(UidSearchResponseParserTest, TestParseEsearchTag)
+{
+	std::string tag;
+
+	EXPECT_TRUE( UidSearchResponseParser::ParseEsearchTag("(TAG \"~A12\") UID ALL 1:3", tag) );
+	EXPECT_EQ( "~A12", tag );
+
+	EXPECT_TRUE( UidSearchResponseParser::ParseEsearchTag("(tag A5)", tag) );
+	EXPECT_EQ( "A5", tag );
+
+	EXPECT_FALSE( UidSearchResponseParser::ParseEsearchTag("UID ALL 1:3", tag) );
+	EXPECT_FALSE( UidSearchResponseParser::ParseEsearchTag("", tag) );
+	EXPECT_FALSE( UidSearchResponseParser::ParseEsearchTag("(FOO \"~A1\") UID", tag) );
+}
+
+TEST(UidSearchResponseParserTest, TestBuildSearchCommand)
+{
+	Capabilities caps;
+
+	EXPECT_EQ( "UID SEARCH UNSEEN", UidSearchResponseParser::BuildSearchCommand(caps, "UNSEEN") );
+	EXPECT_EQ( "UID SEARCH UNSEEN", UidSearchResponseParser::BuildSearchCommand(caps, "UNSEEN", UidSearchResponseParser::RETURN_COUNT) );
+
+	caps.SetCapability(Capabilities::ESEARCH);
+
+	EXPECT_EQ( "UID SEARCH RETURN (ALL) ALL", UidSearchResponseParser::BuildSearchCommand(caps, "ALL") );
+	EXPECT_EQ( "UID SEARCH RETURN (COUNT) UNSEEN", UidSearchResponseParser::BuildSearchCommand(caps, "UNSEEN", UidSearchResponseParser::RETURN_COUNT) );
+}
+
+TEST(UidSearchResponseParserTest, TestPipelinedEsearch)
+{
+	MockTestSetup setup;
+	MockImapSession& session = setup.GetSession();
+
+	MockDoneSlot doneSlot;
+	std::vector<UID> allUIDs, unseenUIDs;
+
+	MojRefCountedPtr<UidSearchResponseParser> allParser(new UidSearchResponseParser(session, allUIDs));
+	MojRefCountedPtr<UidSearchResponseParser> unseenParser(new UidSearchResponseParser(session, doneSlot.GetSlot(), unseenUIDs));
+	MojRefCountedPtr<ImapRequestManager> requestManager(new ImapRequestManager(session));
+
+	const MockInputStreamPtr& is = session.GetMockInputStream();
+
+	requestManager->SendRequest("UID SEARCH RETURN (ALL) ALL", allParser, 0, true);
+	requestManager->SendRequest("UID SEARCH RETURN (ALL) UNSEEN", unseenParser, 0, true);
+
+	// Results are matched by tag, even if they arrive in a different order
+	is->FeedLine("* ESEARCH (TAG \"~A2\") UID ALL 7,9");
+	is->FeedLine("* ESEARCH (TAG \"~A1\") UID ALL 1:100000");
+	is->FeedLine("~A1 OK SEARCH completed");
+	is->FeedLine("~A2 OK SEARCH completed");
+	EXPECT_TRUE( doneSlot.Called() );
+
+	ASSERT_EQ( (size_t) 100000, allUIDs.size() );
+	EXPECT_EQ( UID(100000), allUIDs.back() );
+
+	ASSERT_EQ( (size_t) 2, unseenUIDs.size() );
+	EXPECT_EQ( UID(7), unseenUIDs[0] );
+	EXPECT_EQ( UID(9), unseenUIDs[1] );
+}
+
+TEST(UidSearchResponseParserTest, TestCount)
+{
+	MockTestSetup setup;
+	MockImapSession& session = setup.GetSession();
+
+	MockDoneSlot doneSlot;
+	std::vector<UID> allUIDs;
+
+	MojRefCountedPtr<UidSearchResponseParser> countParser(new UidSearchResponseParser(session));
+	MojRefCountedPtr<UidSearchResponseParser> allParser(new UidSearchResponseParser(session, doneSlot.GetSlot(), allUIDs));
+	MojRefCountedPtr<ImapRequestManager> requestManager(new ImapRequestManager(session));
+
+	const MockInputStreamPtr& is = session.GetMockInputStream();
+
+	requestManager->SendRequest("UID SEARCH RETURN (COUNT) UNSEEN", countParser, 0, true);
+	requestManager->SendRequest("UID SEARCH RETURN (ALL) ALL", allParser, 0, true);
+
+	EXPECT_EQ( -1, countParser->GetCount() );
+
+	is->FeedLine("* ESEARCH (TAG \"~A1\") UID COUNT 42");
+	is->FeedLine("~A1 OK SEARCH completed");
+	is->FeedLine("* ESEARCH (TAG \"~A2\") UID ALL 1:3");
+	is->FeedLine("~A2 OK SEARCH completed");
+	EXPECT_TRUE( doneSlot.Called() );
+
+	EXPECT_EQ( 42, countParser->GetCount() );
+	EXPECT_EQ( 3, allParser->GetCount() );
+	ASSERT_EQ( (size_t) 3, allUIDs.size() );
+
+	// Without ESEARCH, the UIDs are counted
+	MojRefCountedPtr<UidSearchResponseParser> plainParser(new UidSearchResponseParser(session));
+	EXPECT_TRUE( plainParser->HandleUntaggedResponse("SEARCH 5 8 13") );
+	EXPECT_EQ( 3, plainParser->GetCount() );
+}
@@ -0,0 +1,404 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "protocol/UntaggedUpdateParser.h"
+#include "protocol/UidSearchResponseParser.h"
+#include "client/FolderSession.h"
+#include "client/ImapRequestManager.h"
+#include "data/DatabaseAdapter.h"
+#include "data/EmailSchema.h"
+#include "data/ImapFolder.h"
+#include "sync/UIDMap.h"
+#include "TestUtils.h"
+#include "MockTestSetup.h"
+#include <boost/foreach.hpp>
+#include <glib.h>
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace std;
+
+// Records the lookups done by each HandleUpdateCommand.
+// If deferReplies is set, the lookups aren't answered until ReplyAll is called.
+class CoalesceMockDatabase : public MockDatabase
+{
+public:
+	CoalesceMockDatabase() : m_deferReplies(false), m_numLookups(0), m_numUIDs(0) {}
+
+	virtual void GetEmailsByUID(Signal::SlotRef slot, const MojObject& folderId, const std::vector<UID>& uids)
+	{
+		m_numLookups++;
+		m_numUIDs += uids.size();
+		m_lastUIDs = uids;
+		m_folderIds.push_back(folderId);
+
+		if(m_deferReplies) {
+			MojRefCountedPtr<PendingReply> reply(new PendingReply());
+			reply->m_signal.connect(slot);
+			m_pendingReplies.push_back(reply);
+		} else {
+			Default(__func__, slot);
+		}
+	}
+
+	virtual void MergeFlags(Signal::SlotRef slot, const MojObject::ObjectVec& array)
+	{
+		m_lastMerged = array;
+		Default(__func__, slot);
+	}
+
+	// Answers the deferred lookups with no matching emails
+	void ReplyAll()
+	{
+		vector< MojRefCountedPtr<PendingReply> > replies;
+		replies.swap(m_pendingReplies);
+
+		BOOST_FOREACH(const MojRefCountedPtr<PendingReply>& reply, replies) {
+			MojObject response = QUOTE_JSON_OBJ(( {"results": []} ));
+			reply->m_signal.fire(response, MojErrNone);
+		}
+	}
+
+	bool					m_deferReplies;
+	int						m_numLookups;
+	size_t					m_numUIDs;
+	std::vector<UID>		m_lastUIDs;
+	std::vector<MojObject>	m_folderIds;
+	MojObject::ObjectVec	m_lastMerged;
+
+protected:
+	class PendingReply : public MojSignalHandler
+	{
+	public:
+		PendingReply() : m_signal(this) {}
+
+		Signal m_signal;
+	};
+
+	vector< MojRefCountedPtr<PendingReply> >	m_pendingReplies;
+};
+
+// Exposes the collected updates
+class TestUntaggedUpdateParser : public UntaggedUpdateParser
+{
+public:
+	TestUntaggedUpdateParser(ImapSession& session) : UntaggedUpdateParser(session) {}
+
+	size_t GetNumPendingUpdates() const { return m_numPendingUpdates; }
+	size_t GetNumPendingRuns() const { return m_pendingUpdates.size(); }
+	bool IsWindowActive() const { return m_updateWindowTimer.IsActive(); }
+	bool IsCommandRunning() const { return m_handleUpdateCommand.get() != NULL; }
+};
+
+// Selects a folder whose UID map has the given UIDs for message numbers 1 and up
+static void SelectFolder(MockImapSession& session, const char* folderId, const vector<UID>& uids)
+{
+	ImapFolderPtr folder(new ImapFolder());
+	folder->SetId(StringAsMojObject(folderId));
+
+	boost::shared_ptr<FolderSession> folderSession(new FolderSession(folder));
+	folderSession->SetMessageCount(uids.size());
+	folderSession->SetUIDMap(boost::shared_ptr<UIDMap>(new UIDMap(uids, uids.size())));
+
+	session.SetFolderSession(folderSession);
+}
+
+static vector<UID> CreateUIDs(UID first, size_t count)
+{
+	vector<UID> uids;
+	for(size_t i = 0; i < count; ++i) {
+		uids.push_back(first + i);
+	}
+	return uids;
+}
+
+static void SetAccount(MockTestSetup& setup)
+{
+	boost::shared_ptr<ImapAccount> account(new ImapAccount());
+	setup.GetClient().SetAccount(account);
+}
+
+TEST(UntaggedUpdateParserTest, TestCoalesceUntilFlush)
+{
+	MockTestSetup setup;
+	CoalesceMockDatabase& db = setup.GetTestDatabase<CoalesceMockDatabase>();
+	MockImapSession& session = setup.GetSession();
+	SetAccount(setup);
+
+	SelectFolder(session, "folder1", CreateUIDs(10, 3));
+
+	MojRefCountedPtr<TestUntaggedUpdateParser> parser(new TestUntaggedUpdateParser(session));
+
+	parser->HandleUntaggedResponse("1 FETCH (FLAGS (\\Seen))");
+	parser->HandleUntaggedResponse("2 FETCH (FLAGS ())");
+	parser->HandleUntaggedResponse("1 FETCH (FLAGS (\\Seen \\Flagged))");
+	parser->HandleUntaggedResponse("3 FETCH (FLAGS (\\Seen))");
+
+	// Deleting msg 2 shifts msg 3 (UID 12) down
+	parser->HandleUntaggedResponse("2 EXPUNGE");
+	parser->HandleUntaggedResponse("2 FETCH (FLAGS ())");
+
+	// Nothing is written until the window expires or the updates are flushed
+	EXPECT_EQ( 0, db.m_numLookups );
+	EXPECT_TRUE( parser->IsWindowActive() );
+	EXPECT_EQ( (size_t) 3, parser->GetNumPendingUpdates() );
+	EXPECT_EQ( (size_t) 1, parser->GetNumPendingRuns() );
+
+	db.SetResponse("GetEmailsByUID", QUOTE_JSON_OBJ((
+		{"results":
+		[
+		 {"_id": "id10", "uid": 10},
+		 {"_id": "id12", "uid": 12}
+		]}
+	)));
+	db.SetResponse("DeleteEmailIds", QUOTE_JSON_OBJ(( {"results": []} )));
+	db.SetResponse("MergeFlags", QUOTE_JSON_OBJ(( {"results": []} )));
+
+	parser->FlushUpdates();
+
+	EXPECT_FALSE( parser->IsWindowActive() );
+	EXPECT_FALSE( parser->IsCommandRunning() );
+	EXPECT_EQ( (size_t) 0, parser->GetNumPendingUpdates() );
+
+	// One lookup for all the updates, one entry per UID
+	EXPECT_EQ( 1, db.m_numLookups );
+	ASSERT_EQ( (size_t) 3, db.m_lastUIDs.size() );
+	EXPECT_EQ( UID(10), db.m_lastUIDs[0] );
+	EXPECT_EQ( UID(11), db.m_lastUIDs[1] );
+	EXPECT_EQ( UID(12), db.m_lastUIDs[2] );
+
+	// Only the latest flags for each UID are written
+	ASSERT_EQ( (MojSize) 2, db.m_lastMerged.size() );
+
+	MojObject flags;
+	ASSERT_TRUE( db.m_lastMerged[0].get(EmailSchema::FLAGS, flags) );
+	EXPECT_TRUE( DatabaseAdapter::GetOptionalBool(flags, EmailSchema::Flags::READ) );
+	EXPECT_TRUE( DatabaseAdapter::GetOptionalBool(flags, EmailSchema::Flags::FLAGGED) );
+
+	ASSERT_TRUE( db.m_lastMerged[1].get(EmailSchema::FLAGS, flags) );
+	EXPECT_FALSE( DatabaseAdapter::GetOptionalBool(flags, EmailSchema::Flags::READ, true) );
+}
+
+TEST(UntaggedUpdateParserTest, TestDeleteNotUndone)
+{
+	MockTestSetup setup;
+	CoalesceMockDatabase& db = setup.GetTestDatabase<CoalesceMockDatabase>();
+	MockImapSession& session = setup.GetSession();
+	SetAccount(setup);
+
+	SelectFolder(session, "folder1", CreateUIDs(10, 2));
+
+	MojRefCountedPtr<TestUntaggedUpdateParser> parser(new TestUntaggedUpdateParser(session));
+
+	// Marked deleted, then a later flag change without \Deleted
+	parser->HandleUntaggedResponse("1 FETCH (FLAGS (\\Deleted))");
+	parser->HandleUntaggedResponse("1 FETCH (FLAGS (\\Seen))");
+	EXPECT_EQ( (size_t) 1, parser->GetNumPendingUpdates() );
+
+	db.SetResponse("GetEmailsByUID", QUOTE_JSON_OBJ(( {"results": [{"_id": "id10", "uid": 10}]} )));
+	db.SetResponse("DeleteEmailIds", QUOTE_JSON_OBJ(( {"results": [{"id": "id10", "rev": 100}]} )));
+	db.SetResponse("MergeFlags", QUOTE_JSON_OBJ(( {"results": []} )));
+
+	parser->FlushUpdates();
+
+	EXPECT_EQ( 1, db.m_numLookups );
+	EXPECT_TRUE( db.m_lastMerged.empty() );
+}
+
+TEST(UntaggedUpdateParserTest, TestUpdateWindow)
+{
+	MockTestSetup setup;
+	CoalesceMockDatabase& db = setup.GetTestDatabase<CoalesceMockDatabase>();
+	MockImapSession& session = setup.GetSession();
+	SetAccount(setup);
+
+	SelectFolder(session, "folder1", CreateUIDs(10, 2));
+
+	MojRefCountedPtr<TestUntaggedUpdateParser> parser(new TestUntaggedUpdateParser(session));
+
+	db.SetResponse("GetEmailsByUID", QUOTE_JSON_OBJ(( {"results": []} )));
+
+	parser->HandleUntaggedResponse("1 FETCH (FLAGS (\\Seen))");
+	parser->HandleUntaggedResponse("2 FETCH (FLAGS (\\Seen))");
+	ASSERT_TRUE( parser->IsWindowActive() );
+	EXPECT_EQ( 0, db.m_numLookups );
+
+	// Wait for the window to expire (UPDATE_WINDOW_MILLIS)
+	for(int i = 0; i < 100 && parser->IsWindowActive(); ++i) {
+		g_main_context_iteration(NULL, TRUE);
+	}
+
+	EXPECT_FALSE( parser->IsWindowActive() );
+	EXPECT_EQ( 1, db.m_numLookups );
+	EXPECT_EQ( (size_t) 2, db.m_numUIDs );
+}
+
+TEST(UntaggedUpdateParserTest, TestMaxPendingUpdates)
+{
+	MockTestSetup setup;
+	CoalesceMockDatabase& db = setup.GetTestDatabase<CoalesceMockDatabase>();
+	MockImapSession& session = setup.GetSession();
+	SetAccount(setup);
+
+	const size_t max = UntaggedUpdateParser::MAX_PENDING_UPDATES;
+	SelectFolder(session, "folder1", CreateUIDs(1, max));
+
+	MojRefCountedPtr<TestUntaggedUpdateParser> parser(new TestUntaggedUpdateParser(session));
+
+	db.SetResponse("GetEmailsByUID", QUOTE_JSON_OBJ(( {"results": []} )));
+
+	for(size_t i = 1; i < max; ++i) {
+		stringstream ss;
+		ss << i << " FETCH (FLAGS (\\Seen))";
+		parser->HandleUntaggedResponse(ss.str());
+	}
+
+	EXPECT_EQ( 0, db.m_numLookups );
+	EXPECT_EQ( max - 1, parser->GetNumPendingUpdates() );
+
+	// Repeats of the same UID don't count towards the limit
+	parser->HandleUntaggedResponse("1 FETCH (FLAGS ())");
+	EXPECT_EQ( 0, db.m_numLookups );
+
+	// Written right away without waiting for the window
+	stringstream ss;
+	ss << max << " FETCH (FLAGS (\\Seen))";
+	parser->HandleUntaggedResponse(ss.str());
+
+	EXPECT_FALSE( parser->IsWindowActive() );
+	EXPECT_EQ( (size_t) 0, parser->GetNumPendingUpdates() );
+	EXPECT_EQ( max, db.m_numUIDs );
+}
+
+TEST(UntaggedUpdateParserTest, TestPerFolderRuns)
+{
+	MockTestSetup setup;
+	CoalesceMockDatabase& db = setup.GetTestDatabase<CoalesceMockDatabase>();
+	MockImapSession& session = setup.GetSession();
+	SetAccount(setup);
+
+	MojRefCountedPtr<TestUntaggedUpdateParser> parser(new TestUntaggedUpdateParser(session));
+
+	db.SetResponse("GetEmailsByUID", QUOTE_JSON_OBJ(( {"results": []} )));
+
+	SelectFolder(session, "folder1", CreateUIDs(10, 2));
+	parser->HandleUntaggedResponse("1 FETCH (FLAGS (\\Seen))");
+	parser->HandleUntaggedResponse("2 FETCH (FLAGS (\\Seen))");
+
+	SelectFolder(session, "folder2", CreateUIDs(20, 2));
+	parser->HandleUntaggedResponse("1 FETCH (FLAGS (\\Seen))");
+
+	SelectFolder(session, "folder1", CreateUIDs(10, 2));
+	parser->HandleUntaggedResponse("1 FETCH (FLAGS ())");
+
+	// Updates are only merged with the run for the same folder right before them
+	EXPECT_EQ( (size_t) 3, parser->GetNumPendingRuns() );
+	EXPECT_EQ( (size_t) 4, parser->GetNumPendingUpdates() );
+
+	parser->FlushUpdates();
+
+	// Written in the order they came in, one command per run
+	ASSERT_EQ( 3, db.m_numLookups );
+	EXPECT_TRUE( db.m_folderIds[0] == StringAsMojObject("folder1") );
+	EXPECT_TRUE( db.m_folderIds[1] == StringAsMojObject("folder2") );
+	EXPECT_TRUE( db.m_folderIds[2] == StringAsMojObject("folder1") );
+	EXPECT_EQ( (size_t) 4, db.m_numUIDs );
+}
+
+TEST(UntaggedUpdateParserTest, TestDeferWhileRunning)
+{
+	MockTestSetup setup;
+	CoalesceMockDatabase& db = setup.GetTestDatabase<CoalesceMockDatabase>();
+	MockImapSession& session = setup.GetSession();
+	SetAccount(setup);
+
+	SelectFolder(session, "folder1", CreateUIDs(10, 3));
+
+	MojRefCountedPtr<TestUntaggedUpdateParser> parser(new TestUntaggedUpdateParser(session));
+
+	db.m_deferReplies = true;
+
+	parser->HandleUntaggedResponse("1 FETCH (FLAGS (\\Seen))");
+	parser->FlushUpdates();
+
+	ASSERT_EQ( 1, db.m_numLookups );
+	EXPECT_TRUE( parser->IsCommandRunning() );
+
+	// Only one update command runs at a time
+	parser->HandleUntaggedResponse("2 FETCH (FLAGS (\\Seen))");
+	parser->FlushUpdates();
+
+	EXPECT_EQ( 1, db.m_numLookups );
+	EXPECT_EQ( (size_t) 1, parser->GetNumPendingUpdates() );
+
+	// The next run starts when the first one is done
+	db.ReplyAll();
+
+	ASSERT_EQ( 2, db.m_numLookups );
+	ASSERT_EQ( (size_t) 1, db.m_lastUIDs.size() );
+	EXPECT_EQ( UID(11), db.m_lastUIDs[0] );
+
+	// Still waiting for more updates when the second run is done; not written yet
+	parser->HandleUntaggedResponse("3 FETCH (FLAGS (\\Seen))");
+	EXPECT_TRUE( parser->IsWindowActive() );
+
+	db.ReplyAll();
+
+	EXPECT_FALSE( parser->IsCommandRunning() );
+	EXPECT_EQ( 2, db.m_numLookups );
+
+	parser->FlushUpdates();
+
+	ASSERT_EQ( 3, db.m_numLookups );
+	EXPECT_EQ( UID(12), db.m_lastUIDs[0] );
+
+	db.ReplyAll();
+	EXPECT_FALSE( parser->IsCommandRunning() );
+}
+
+TEST(UntaggedUpdateParserTest, TestFlushOnTaggedResponse)
+{
+	MockTestSetup setup;
+	CoalesceMockDatabase& db = setup.GetTestDatabase<CoalesceMockDatabase>();
+	MockImapSession& session = setup.GetSession();
+	SetAccount(setup);
+
+	SelectFolder(session, "folder1", CreateUIDs(10, 2));
+
+	db.SetResponse("GetEmailsByUID", QUOTE_JSON_OBJ(( {"results": []} )));
+
+	std::vector<UID> uids;
+	MojRefCountedPtr<UidSearchResponseParser> searchParser(new UidSearchResponseParser(session, uids));
+	MojRefCountedPtr<ImapRequestManager> requestManager(new ImapRequestManager(session));
+
+	const MockInputStreamPtr& is = session.GetMockInputStream();
+
+	requestManager->SendRequest("UID SEARCH UNSEEN", searchParser, 0, true);
+
+	// Unsolicited updates while the command is running
+	is->FeedLine("* 1 FETCH (FLAGS (\\Seen))");
+	is->FeedLine("* 2 FETCH (FLAGS (\\Seen))");
+	is->FeedLine("* SEARCH");
+	EXPECT_EQ( 0, db.m_numLookups );
+
+	// Written as soon as the command completes
+	is->FeedLine("~A1 OK SEARCH completed");
+
+	EXPECT_EQ( 1, db.m_numLookups );
+	EXPECT_EQ( (size_t) 2, db.m_numUIDs );
+}
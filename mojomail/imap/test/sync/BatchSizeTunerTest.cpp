@@ -0,0 +1,75 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "sync/BatchSizeTuner.h"
+#include <gtest/gtest.h>
+
+TEST(BatchSizeTunerTest, TestLimits)
+{
+	BatchSizeTuner tuner(500, 1, 100);
+	EXPECT_EQ( 100, tuner.GetBatchSize() );
+
+	BatchSizeTuner tuner2(0, 5, 100);
+	EXPECT_EQ( 5, tuner2.GetBatchSize() );
+}
+
+TEST(BatchSizeTunerTest, TestGrow)
+{
+	BatchSizeTuner tuner(20, 1, 100);
+
+	tuner.FetchComplete(20, 100);
+	EXPECT_EQ( 40, tuner.GetBatchSize() );
+
+	// Partial batch doesn't count
+	tuner.FetchComplete(10, 100);
+	EXPECT_EQ( 40, tuner.GetBatchSize() );
+
+	tuner.FetchComplete(40, 100);
+	EXPECT_EQ( 80, tuner.GetBatchSize() );
+
+	tuner.FetchComplete(80, 100);
+	EXPECT_EQ( 100, tuner.GetBatchSize() );
+
+	// Neither fast nor slow
+	tuner.FetchComplete(100, 2000);
+	EXPECT_EQ( 100, tuner.GetBatchSize() );
+}
+
+TEST(BatchSizeTunerTest, TestShrink)
+{
+	BatchSizeTuner tuner(80, 10, 100);
+
+	tuner.FetchComplete(80, 5000);
+	EXPECT_EQ( 40, tuner.GetBatchSize() );
+
+	tuner.PutComplete(40, 5000);
+	EXPECT_EQ( 20, tuner.GetBatchSize() );
+
+	// Fast fetch, but the database is still slow
+	tuner.FetchComplete(20, 100);
+	EXPECT_EQ( 20, tuner.GetBatchSize() );
+
+	tuner.PutComplete(20, 5000);
+	tuner.PutComplete(20, 5000);
+	EXPECT_EQ( 10, tuner.GetBatchSize() );
+
+	// Database caught up
+	tuner.PutComplete(10, 50);
+	tuner.FetchComplete(10, 100);
+	EXPECT_EQ( 20, tuner.GetBatchSize() );
+}
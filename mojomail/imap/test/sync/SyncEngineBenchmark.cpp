@@ -0,0 +1,122 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+/**
+ * Timing for SyncEngine::Diff on large mailboxes.
+ *
+ * Prints how long it takes to build the sync engine from the UID SEARCH
+ * results and diff it against the local emails, plus the memory used by
+ * the remote UID table.
+ */
+
+#include "sync/SyncEngine.h"
+#include "ImapPrivate.h"
+#include "BenchmarkUtils.h"
+#include <gtest/gtest.h>
+
+class SyncEngineBenchmark : public SyncEngine
+{
+public:
+	SyncEngineBenchmark(const vector<UID>& remote, const vector<UID>& deleted, const vector<UID>& unseen,
+			const vector<UID>& answered, const vector<UID>& flagged)
+	: SyncEngine(remote, deleted, unseen, answered, flagged)
+	{
+	}
+
+	size_t GetTableMemoryUsage() const { return m_remoteTable.GetMemoryUsage(); }
+};
+
+static void RunDiff(size_t numRemote)
+{
+	vector<UID> remote, deleted, unseen, answered, flagged;
+	vector<SyncEngine::EmailStub> local;
+
+	size_t expectNew = 0, expectDeleted = 0;
+
+	MojString idStr;
+	idStr.assign("id");
+	MojObject id(idStr);
+
+	// Every 10th UID is missing on the server; most of the rest are local already
+	for(UID uid = 1; remote.size() < numRemote; ++uid) {
+		bool onServer = (uid % 10 != 0);
+		bool isLocal = (uid % 13 != 0);
+
+		if(onServer) {
+			remote.push_back(uid);
+
+			if(uid % 3 == 0) unseen.push_back(uid);
+			if(uid % 7 == 0) answered.push_back(uid);
+			if(uid % 11 == 0) flagged.push_back(uid);
+			if(uid % 50 == 1) deleted.push_back(uid);
+
+			if(!isLocal && uid % 50 != 1) expectNew++;
+		}
+
+		if(isLocal) {
+			local.push_back(SyncEngine::EmailStub(uid, id));
+
+			if(!onServer || uid % 50 == 1) expectDeleted++;
+		}
+	}
+
+	const size_t pageSize = 200; // same as the email sync list query
+
+	double start = GetTimeSeconds();
+
+	SyncEngineBenchmark engine(remote, deleted, unseen, answered, flagged);
+
+	double built = GetTimeSeconds();
+
+	size_t numNew = 0, numDeleted = 0;
+
+	for(size_t offset = 0; offset < local.size(); offset += pageSize) {
+		size_t end = std::min(offset + pageSize, local.size());
+		vector<SyncEngine::EmailStub> page(local.begin() + offset, local.begin() + end);
+
+		engine.Diff(page, end < local.size());
+
+		numNew += engine.GetNewUIDs().size();
+		numDeleted += engine.GetDeletedIds().size();
+		engine.Clear();
+	}
+
+	double done = GetTimeSeconds();
+
+	EXPECT_EQ( expectNew, numNew );
+	EXPECT_EQ( expectDeleted, numDeleted );
+
+	fprintf(stderr, "%8zu UIDs: build %.1f ms, diff %.1f ms, table %zu KB (UID lists %zu KB)\n",
+			numRemote, (built - start) * 1000, (done - built) * 1000, engine.GetTableMemoryUsage() / 1024,
+			(remote.size() + deleted.size() + unseen.size() + answered.size() + flagged.size()) * sizeof(UID) / 1024);
+}
+
+TEST(SyncEngineBenchmark, DISABLED_Diff10k)
+{
+	RunDiff(10000);
+}
+
+TEST(SyncEngineBenchmark, DISABLED_Diff100k)
+{
+	RunDiff(100000);
+}
+
+TEST(SyncEngineBenchmark, DISABLED_Diff1M)
+{
+	RunDiff(1000000);
+}
@@ -119,6 +119,39 @@ TEST(SyncEngineTest, TestBatch)
 	Expect(engine, 5, 2);
 }
 
+TEST(SyncEngineTest, TestClearPage)
+{
+	vector<SyncEngine::EmailStub> batch1, batch2;
+	vector<UID> remote, unseen, empty;
+
+	remote.push_back(10);
+	remote.push_back(30); unseen.push_back(30);
+
+	SyncEngine engine(remote, empty, unseen, empty, empty);
+
+	batch1.push_back(MakeStub(5, "id5"));
+	batch1.push_back(MakeStub(10, "id10"));
+
+	engine.Diff(batch1, true);
+	// Local:  5 10  N
+	// Remote: D 10 30
+	EXPECT_EQ( (size_t) 1, engine.GetDeletedIds().size() );
+	EXPECT_EQ( (size_t) 1, engine.GetModifiedFlags().size() );
+
+	// Page saved; new UIDs are kept until the end
+	engine.ClearDeletedAndModified();
+	Expect(engine, 0, 0);
+	EXPECT_EQ( (size_t) 0, engine.GetModifiedFlags().size() );
+
+	batch2.push_back(MakeStub(20, "id20"));
+
+	engine.Diff(batch2, false);
+	// Local:   N 20  N
+	// Remote: 10  D 30
+	Expect(engine, 1, 1);
+	EXPECT_EQ( UID(30), engine.GetNewUIDs()[0] );
+}
+
 TEST(SyncEngineTest, TestDeletedFlag)
 {
 	vector<SyncEngine::EmailStub> local;
@@ -133,3 +166,78 @@ TEST(SyncEngineTest, TestDeletedFlag)
 	engine.Diff(local, true);
 	Expect(engine, 0, 1); // one existing deleted, one never-downloaded deleted
 }
+
+TEST(SyncEngineTest, TestIncremental)
+{
+	vector<SyncEngine::EmailStub> local;
+	SyncEngine::ChangeList changes;
+	UIDRangeSet vanished;
+
+	local.push_back(MakeStub(10, "id10"));
+	local.push_back(MakeStub(20, "id20"));
+	local.push_back(MakeStub(30, "id30"));
+	local.push_back(MakeStub(40, "id40"));
+
+	// Changed message outside the sync window
+	changes.push_back(SyncEngine::RemoteChange(5));
+
+	// Flags changed
+	changes.push_back(SyncEngine::RemoteChange(20));
+	changes.back().flags.read = true;
+
+	// Marked deleted
+	changes.push_back(SyncEngine::RemoteChange(40));
+	changes.back().deleted = true;
+
+	// New messages
+	changes.push_back(SyncEngine::RemoteChange(50));
+	changes.push_back(SyncEngine::RemoteChange(60));
+
+	// Expunged
+	vanished.Add(30);
+
+	SyncEngine engine(changes, vanished);
+	engine.Diff(local, false);
+	Expect(engine, 2, 2);
+
+	ASSERT_EQ( (size_t) 1, engine.GetModifiedFlags().size() );
+	EXPECT_EQ( UID(20), engine.GetModifiedFlags()[0].first.uid );
+
+	ASSERT_EQ( (size_t) 4, engine.GetRemainingUIDs().size() );
+	EXPECT_EQ( UID(10), engine.GetRemainingUIDs()[0] );
+	EXPECT_EQ( UID(20), engine.GetRemainingUIDs()[1] );
+	EXPECT_EQ( UID(50), engine.GetRemainingUIDs()[2] );
+	EXPECT_EQ( UID(60), engine.GetRemainingUIDs()[3] );
+}
+
+TEST(SyncEngineTest, TestIncrementalMaxNew)
+{
+	vector<SyncEngine::EmailStub> local;
+	SyncEngine::ChangeList changes;
+	UIDRangeSet vanished;
+
+	local.push_back(MakeStub(10, "id10"));
+
+	for(UID uid = 11; uid <= 15; uid++) {
+		changes.push_back(SyncEngine::RemoteChange(uid));
+	}
+
+	// Only the two newest messages should be fetched
+	SyncEngine engine(changes, vanished, 2);
+	engine.Diff(local, false);
+	Expect(engine, 2, 0);
+	ASSERT_TRUE( engine.HasLocalEmails() );
+
+	EXPECT_EQ( UID(14), engine.GetNewUIDs()[0] );
+	EXPECT_EQ( UID(15), engine.GetNewUIDs()[1] );
+
+	ASSERT_EQ( (size_t) 3, engine.GetRemainingUIDs().size() );
+	EXPECT_EQ( UID(10), engine.GetRemainingUIDs()[0] );
+	EXPECT_EQ( UID(14), engine.GetRemainingUIDs()[1] );
+	EXPECT_EQ( UID(15), engine.GetRemainingUIDs()[2] );
+
+	// No local emails at all
+	SyncEngine emptyEngine(changes, vanished, 2);
+	emptyEngine.Diff(vector<SyncEngine::EmailStub>(), false);
+	ASSERT_FALSE( emptyEngine.HasLocalEmails() );
+}
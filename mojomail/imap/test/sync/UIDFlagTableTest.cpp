@@ -0,0 +1,109 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "sync/UIDFlagTable.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+
+TEST(UIDFlagTableTest, TestArray)
+{
+	UID arr[] = {3, 5, 8, 13, 70000, 70001, 200000};
+	vector<UID> uids(arr, arr + 7);
+
+	UIDFlagTable table;
+	table.AddUIDs(uids);
+	table.Add(100); // out of order; ignored
+
+	EXPECT_EQ( (size_t) 7, table.size() );
+	EXPECT_TRUE( table.Contains(5) );
+	EXPECT_TRUE( table.Contains(70001) );
+	EXPECT_FALSE( table.Contains(100) );
+	EXPECT_FALSE( table.Contains(70002) );
+
+	vector<UID> unseen;
+	unseen.push_back(4); // not in table
+	unseen.push_back(8);
+	unseen.push_back(70000);
+	unseen.push_back(100000); // not in table
+	table.SetFlag(unseen, UIDFlagTable::FLAG_UNSEEN);
+
+	vector<UID> flagged;
+	flagged.push_back(8);
+	flagged.push_back(200000);
+	table.SetFlag(flagged, UIDFlagTable::FLAG_FLAGGED);
+
+	EXPECT_EQ( 0u, table.GetFlags(3) );
+	EXPECT_EQ( (unsigned int) (UIDFlagTable::FLAG_UNSEEN | UIDFlagTable::FLAG_FLAGGED), table.GetFlags(8) );
+	EXPECT_EQ( (unsigned int) UIDFlagTable::FLAG_UNSEEN, table.GetFlags(70000) );
+	EXPECT_EQ( 0u, table.GetFlags(4) );
+
+	UIDFlagTable::Iterator it(table);
+	for(size_t i = 0; i < uids.size(); ++i) {
+		ASSERT_FALSE( it.AtEnd() );
+		EXPECT_EQ( uids[i], it.GetUID() );
+		EXPECT_EQ( table.GetFlags(uids[i]), it.GetFlags() );
+		it.Next();
+	}
+	EXPECT_TRUE( it.AtEnd() );
+}
+
+TEST(UIDFlagTableTest, TestBitmap)
+{
+	// Enough UIDs in one chunk to switch to a bitmap
+	vector<UID> uids, answered;
+	for(UID uid = 1; uid < 40000; uid += 2) {
+		uids.push_back(uid);
+
+		if(uid % 3 == 0) {
+			answered.push_back(uid);
+			answered.push_back(uid + 1); // not in table
+		}
+	}
+
+	UIDFlagTable table;
+	table.AddUIDs(uids);
+	table.SetFlag(answered, UIDFlagTable::FLAG_ANSWERED);
+
+	EXPECT_EQ( uids.size(), table.size() );
+	EXPECT_TRUE( table.Contains(39999) );
+	EXPECT_FALSE( table.Contains(40000) );
+	EXPECT_EQ( (unsigned int) UIDFlagTable::FLAG_ANSWERED, table.GetFlags(33) );
+	EXPECT_FALSE( table.Contains(34) );
+	EXPECT_EQ( 0u, table.GetFlags(35) );
+
+	// Smaller than a list of UIDs
+	EXPECT_LT( table.GetMemoryUsage(), uids.size() * sizeof(UID) );
+
+	size_t count = 0;
+	for(UIDFlagTable::Iterator it(table); !it.AtEnd(); it.Next()) {
+		ASSERT_EQ( uids[count], it.GetUID() );
+		EXPECT_EQ( it.GetUID() % 3 == 0, (it.GetFlags() & UIDFlagTable::FLAG_ANSWERED) != 0 );
+		count++;
+	}
+	EXPECT_EQ( uids.size(), count );
+}
+
+TEST(UIDFlagTableTest, TestEmpty)
+{
+	UIDFlagTable table;
+	UIDFlagTable::Iterator it(table);
+
+	EXPECT_TRUE( it.AtEnd() );
+	EXPECT_FALSE( table.Contains(1) );
+}
@@ -0,0 +1,84 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+/**
+ * Timing for UIDMap removals on a large folder.
+ *
+ * Prints how long a burst of EXPUNGE or VANISHED removals takes. With a
+ * linear remove, each of these takes several seconds.
+ */
+
+#include "sync/UIDMap.h"
+#include "BenchmarkUtils.h"
+#include <gtest/gtest.h>
+#include <stdlib.h>
+
+using namespace std;
+
+static const unsigned int MSG_COUNT = 200000;
+
+// Server-side purge of 50k messages, one EXPUNGE at a time
+TEST(UIDMapBenchmark, DISABLED_TestExpungeStorm)
+{
+	const unsigned int NUM_EXPUNGED = 50000;
+
+	vector<UID> uids;
+	for(UID uid = 1; uid <= MSG_COUNT; uid++) {
+		uids.push_back(uid);
+	}
+
+	UIDMap uidMap(uids, MSG_COUNT);
+
+	srand(2);
+	UID sum = 0;
+
+	double start = GetTimeSeconds();
+	for(unsigned int i = 0; i < NUM_EXPUNGED; i++) {
+		unsigned int num = 1 + rand() % (MSG_COUNT - i);
+		sum += uidMap.Remove(num);
+		sum += uidMap.GetUID(num);
+	}
+	double elapsed = GetTimeSeconds() - start;
+
+	PrintRate("Remove", NUM_EXPUNGED, "expunge", elapsed);
+
+	EXPECT_GT( sum, 0u );
+}
+
+// Purging the oldest half of the folder by UID
+TEST(UIDMapBenchmark, DISABLED_TestRemoveUIDStorm)
+{
+	vector<UID> uids;
+	for(UID uid = 1; uid <= MSG_COUNT; uid++) {
+		uids.push_back(uid * 2);
+	}
+
+	UIDMap uidMap(uids, MSG_COUNT);
+
+	unsigned int removed = 0;
+
+	double start = GetTimeSeconds();
+	for(UID uid = 2; uid <= MSG_COUNT; uid += 2) {
+		removed += uidMap.RemoveUID(uid);
+	}
+	double elapsed = GetTimeSeconds() - start;
+
+	PrintRate("RemoveUID", MSG_COUNT / 2, "removal", elapsed);
+
+	EXPECT_EQ( MSG_COUNT / 2, removed );
+}
@@ -17,7 +17,10 @@
 // LICENSE@@@
 
 #include "sync/UIDMap.h"
+#include "sync/UIDRangeSet.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <stdlib.h>
 
 using namespace std;
 
@@ -35,3 +38,196 @@ TEST(UIDMapTest, TestLimit)
 	EXPECT_EQ( UID(610), uidMap.GetUID(12) );
 	EXPECT_EQ( UID(0), uidMap.GetUID(10) ); // not in map
 }
+
+TEST(UIDMapTest, TestRemoveUIDs)
+{
+	UID arr[] = {3, 5, 8, 13, 21, 34, 55, 89, 144, 233};
+
+	vector<UID> uids;
+	uids.insert(uids.begin(), &arr[2], &arr[10]); // listed message numbers: 3 to 10
+
+	UIDMap uidMap(uids, 10);
+	ASSERT_EQ( UID(8), uidMap.GetUID(3) );
+
+	UIDRangeSet vanished;
+	vanished.Add(5); // before the map
+	vanished.AddRange(20, 40); // 21 and 34
+	vanished.Add(1000); // not in the folder
+
+	vector<UID> removed;
+	EXPECT_EQ( 3U, uidMap.RemoveUIDs(vanished, removed) );
+
+	ASSERT_EQ( (size_t) 2, removed.size() );
+	EXPECT_EQ( UID(21), removed[0] );
+	EXPECT_EQ( UID(34), removed[1] );
+
+	EXPECT_EQ( UID(8), uidMap.GetUID(2) );
+	EXPECT_EQ( UID(13), uidMap.GetUID(3) );
+	EXPECT_EQ( UID(55), uidMap.GetUID(4) );
+	EXPECT_EQ( UID(233), uidMap.GetUID(7) );
+	EXPECT_EQ( UID(0), uidMap.GetUID(8) );
+	EXPECT_EQ( (size_t) 6, uidMap.GetUIDs().size() );
+}
+
+// A bogus VANISHED range covering every possible UID
+TEST(UIDMapTest, TestRemoveAllUIDs)
+{
+	UID arr[] = {3, 5, 8, 13, 21};
+
+	vector<UID> uids(&arr[2], &arr[5]); // message numbers 3 to 5
+	UIDMap uidMap(uids, 5);
+
+	UIDRangeSet vanished;
+	vanished.AddRange(1, 0xFFFFFFFF);
+
+	vector<UID> removed;
+	EXPECT_EQ( 5U, uidMap.RemoveUIDs(vanished, removed) );
+	EXPECT_EQ( (size_t) 3, removed.size() );
+	EXPECT_EQ( 0U, uidMap.GetSize() );
+}
+
+TEST(UIDMapTest, TestDuplicates)
+{
+	UID arr[] = {3, 5, 5, 8, 8, 8, 13};
+
+	vector<UID> uids(&arr[0], &arr[7]);
+	UIDMap uidMap(uids, 4);
+
+	EXPECT_EQ( (size_t) 4, uidMap.GetUIDs().size() );
+	EXPECT_EQ( UID(3), uidMap.GetUID(1) );
+	EXPECT_EQ( UID(13), uidMap.GetUID(4) );
+}
+
+TEST(UIDMapTest, TestRemoveAndGrow)
+{
+	UID arr[] = {3, 5, 8, 13, 21, 34, 55, 89, 144, 233};
+
+	vector<UID> uids(&arr[0], &arr[10]);
+	UIDMap uidMap(uids, 10);
+
+	// Removing the first message doesn't change the other message numbers
+	EXPECT_EQ( UID(3), uidMap.Remove(1) );
+	EXPECT_EQ( UID(5), uidMap.GetUID(1) );
+
+	EXPECT_EQ( UID(13), uidMap.Remove(3) );
+	EXPECT_EQ( UID(21), uidMap.GetUID(3) );
+	EXPECT_EQ( 4u, uidMap.RemoveUID(34) );
+	EXPECT_EQ( 0u, uidMap.RemoveUID(34) );
+	EXPECT_EQ( UID(55), uidMap.GetUID(4) );
+
+	// Two new messages
+	uidMap.UpdateMsgCount(9);
+
+	vector<unsigned int> missing;
+	uidMap.GetMissingMsgNums(missing);
+	ASSERT_EQ( (size_t) 2, missing.size() );
+	EXPECT_EQ( 8u, missing[0] );
+	EXPECT_EQ( 9u, missing[1] );
+
+	uidMap.SetMsgUID(8, 300);
+	uidMap.SetMsgUID(9, 301);
+	EXPECT_EQ( 9u, uidMap.RemoveUID(301) );
+	EXPECT_EQ( 8u, uidMap.RemoveUID(300) );
+
+	// Shrink back down
+	uidMap.UpdateMsgCount(5);
+	EXPECT_EQ( UID(89), uidMap.GetUID(5) );
+	EXPECT_EQ( UID(0), uidMap.GetUID(6) );
+	EXPECT_EQ( (size_t) 5, uidMap.GetUIDs().size() );
+}
+
+// Simple vector-based map with the same behavior, for comparison
+class ReferenceUIDMap
+{
+public:
+	ReferenceUIDMap(const vector<UID>& uids, unsigned int msgCount)
+	: m_uids(uids), m_firstMsgNum(msgCount + 1 - uids.size()) {}
+
+	UID GetUID(unsigned int num) const
+	{
+		return num >= m_firstMsgNum && num - m_firstMsgNum < m_uids.size() ? m_uids[num - m_firstMsgNum] : 0;
+	}
+
+	UID Remove(unsigned int num)
+	{
+		UID uid = GetUID(num);
+		if(num >= m_firstMsgNum && num - m_firstMsgNum < m_uids.size())
+			m_uids.erase(m_uids.begin() + (num - m_firstMsgNum));
+		else if(num <= m_firstMsgNum)
+			--m_firstMsgNum;
+		return uid;
+	}
+
+	vector<UID>		m_uids;
+	unsigned int	m_firstMsgNum;
+};
+
+TEST(UIDMapTest, TestRandomRemoves)
+{
+	vector<UID> uids;
+	for(UID uid = 1; uid <= 5000; uid++) {
+		uids.push_back(uid * 3);
+	}
+
+	UIDMap uidMap(uids, 6000);
+	ReferenceUIDMap reference(uids, 6000);
+
+	srand(1);
+
+	for(int i = 0; i < 4000; i++) {
+		unsigned int num = 1 + rand() % (6000 - i);
+
+		ASSERT_EQ( reference.Remove(num), uidMap.Remove(num) );
+
+		unsigned int probe = 1 + rand() % 6000;
+		ASSERT_EQ( reference.GetUID(probe), uidMap.GetUID(probe) ) << probe;
+	}
+
+	EXPECT_TRUE( reference.m_uids == uidMap.GetUIDs() );
+}
+
+// Server-side purge of 50k messages from a 200k message folder, one EXPUNGE at a time
+TEST(UIDMapTest, TestExpungeStorm)
+{
+	const unsigned int MSG_COUNT = 200000;
+	const unsigned int NUM_EXPUNGED = 50000;
+
+	vector<UID> uids;
+	for(UID uid = 1; uid <= MSG_COUNT; uid++) {
+		uids.push_back(uid);
+	}
+
+	UIDMap uidMap(uids, MSG_COUNT);
+
+	srand(2);
+	UID sum = 0;
+
+	for(unsigned int i = 0; i < NUM_EXPUNGED; i++) {
+		unsigned int num = 1 + rand() % (MSG_COUNT - i);
+		sum += uidMap.Remove(num);
+		sum += uidMap.GetUID(num);
+	}
+
+	EXPECT_EQ( MSG_COUNT - NUM_EXPUNGED, uidMap.GetUIDs().size() );
+	EXPECT_GT( sum, 0u );
+}
+
+// Purging the oldest messages, e.g. emptying the trash, by UID
+TEST(UIDMapTest, TestRemoveUIDStorm)
+{
+	const unsigned int MSG_COUNT = 200000;
+
+	vector<UID> uids;
+	for(UID uid = 1; uid <= MSG_COUNT; uid++) {
+		uids.push_back(uid * 2);
+	}
+
+	UIDMap uidMap(uids, MSG_COUNT);
+
+	for(UID uid = 2; uid <= MSG_COUNT; uid += 2) {
+		ASSERT_EQ( 1u, uidMap.RemoveUID(uid) );
+	}
+
+	EXPECT_EQ( UID(MSG_COUNT + 2), uidMap.GetUID(1) );
+	EXPECT_EQ( UID(MSG_COUNT * 2), uidMap.GetUID(MSG_COUNT / 2) );
+}
@@ -0,0 +1,125 @@
+// @@@LICENSE
+//
+//      Copyright (c) 2010-2013 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// LICENSE@@@
+
+#include "sync/UIDRangeSet.h"
+#include <gtest/gtest.h>
+
+using namespace std;
+
+TEST(UIDRangeSetTest, TestAdd)
+{
+	UIDRangeSet set;
+	set.Add(5);
+	set.Add(6);
+	set.Add(7);
+	set.Add(10);
+	set.Add(1);
+	set.Add(9); // joins 10
+	set.Add(8); // joins everything from 5 to 10
+
+	EXPECT_EQ( "1,5:10", set.ToString() );
+	EXPECT_EQ( (size_t) 7, set.size() );
+	EXPECT_EQ( (size_t) 2, set.GetRanges().size() );
+
+	EXPECT_TRUE( set.Contains(1) );
+	EXPECT_FALSE( set.Contains(2) );
+	EXPECT_TRUE( set.Contains(8) );
+	EXPECT_FALSE( set.Contains(11) );
+
+	set.AddRange(3, 30);
+	EXPECT_EQ( "1,3:30", set.ToString() );
+
+	set.AddRange(0xFFFFFFF0, 0xFFFFFFFF);
+	set.Add(0xFFFFFFFF);
+	EXPECT_EQ( "1,3:30,4294967280:4294967295", set.ToString() );
+}
+
+TEST(UIDRangeSetTest, TestRemove)
+{
+	UIDRangeSet set;
+	set.AddRange(1, 10);
+
+	set.Remove(5);
+	EXPECT_EQ( "1:4,6:10", set.ToString() );
+
+	set.Remove(1);
+	set.Remove(10);
+	set.Remove(20);
+	EXPECT_EQ( "2:4,6:9", set.ToString() );
+
+	vector<UID> uids;
+	set.GetUIDs(uids);
+	ASSERT_EQ( (size_t) 7, uids.size() );
+	EXPECT_EQ( UID(2), uids[0] );
+	EXPECT_EQ( UID(6), uids[3] );
+	EXPECT_EQ( UID(9), uids[6] );
+}
+
+TEST(UIDRangeSetTest, TestParse)
+{
+	UIDRangeSet set;
+
+	EXPECT_TRUE( UIDRangeSet::Parse("41,43:45,50", set) );
+	EXPECT_EQ( (size_t) 5, set.size() );
+	EXPECT_EQ( "41,43:45,50", set.ToString() );
+
+	set.clear();
+	EXPECT_TRUE( UIDRangeSet::Parse("7:5", set) );
+	EXPECT_EQ( (size_t) 3, set.size() );
+
+	// Adds to the existing set
+	EXPECT_TRUE( UIDRangeSet::Parse("8,1", set) );
+	EXPECT_EQ( "1,5:8", set.ToString() );
+
+	EXPECT_FALSE( UIDRangeSet::Parse("1:x", set) );
+	EXPECT_FALSE( UIDRangeSet::Parse("1:*", set) );
+	EXPECT_FALSE( UIDRangeSet::Parse("", set) );
+	EXPECT_FALSE( UIDRangeSet::Parse("1,", set) );
+	EXPECT_FALSE( UIDRangeSet::Parse("0", set) );
+	EXPECT_FALSE( UIDRangeSet::Parse("4294967296", set) );
+}
+
+TEST(UIDRangeSetTest, TestSetOperations)
+{
+	UIDRangeSet a, b;
+	ASSERT_TRUE( UIDRangeSet::Parse("1:10,20:30,40", a) );
+	ASSERT_TRUE( UIDRangeSet::Parse("5:25,31,39:41,50", b) );
+
+	EXPECT_EQ( "1:31,39:41,50", a.Union(b).ToString() );
+	EXPECT_EQ( "5:10,20:25,40", a.Intersection(b).ToString() );
+	EXPECT_EQ( "1:4,26:30", a.Difference(b).ToString() );
+	EXPECT_EQ( "11:19,31,39,41,50", b.Difference(a).ToString() );
+
+	UIDRangeSet empty;
+	EXPECT_EQ( a, a.Union(empty) );
+	EXPECT_EQ( a, a.Difference(empty) );
+	EXPECT_TRUE( a.Intersection(empty).empty() );
+	EXPECT_TRUE( a.Difference(a).empty() );
+}
+
+TEST(UIDRangeSetTest, TestFromList)
+{
+	UID arr[] = {9, 3, 4, 5, 12, 10, 11};
+	vector<UID> uids(arr, arr + 7);
+
+	UIDRangeSet set(uids);
+	EXPECT_EQ( "3:5,9:12", set.ToString() );
+
+	UIDRangeSet reversed(uids.rbegin(), uids.rend());
+	EXPECT_EQ( set, reversed );
+}
@@ -715,6 +715,11 @@ MojErr PopBusDispatcher::Status(MojServiceMessage* msg, MojObject& payload)
 		err = status.put("clients", clients);
 		ErrorToException(err);
 
+		MojObject hostStatus;
+		SocketConnection::HostStatus(hostStatus);
+		err = status.put("hosts", hostStatus);
+		ErrorToException(err);
+
 		msg->replySuccess(status);
 
 	} catch(const std::exception& e) {
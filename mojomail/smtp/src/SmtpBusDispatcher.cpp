@@ -32,6 +32,7 @@
 #include "activity/ActivityParser.h"
 #include "exceptions/MojErrException.h"
 #include "SmtpConfig.h"
+#include "network/SocketConnection.h"
 
 MojLogger SmtpBusDispatcher::s_log("com.palm.smtp");
 
@@ -134,6 +135,11 @@ MojErr SmtpBusDispatcher::Status(MojServiceMessage* msg, MojObject& payload)
 		err = status.put("clients", clients);
 		ErrorToException(err);
 
+		MojObject hostStatus;
+		SocketConnection::HostStatus(hostStatus);
+		err = status.put("hosts", hostStatus);
+		ErrorToException(err);
+
 	} catch(const std::exception& e) {
 		msg->replyError(MojErrInternal, e.what());
 	} catch(...) {